@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Assertions.h>
+#include <AK/NumericLimits.h>
+#include <AK/Types.h>
+
+namespace AK {
+
+// A Bloom filter that supports removal, by keeping a small counter per bucket instead of a bit.
+// Each key is spread over two buckets, taken from the low and high halves of its (already hashed) value.
+// Counters that saturate are never decremented again, which keeps may_contain() free of false negatives.
+template<typename CounterType, size_t key_bits>
+class CountingBloomFilter {
+public:
+    static_assert(key_bits > 0 && key_bits <= 16);
+
+    void clear() { __builtin_memset(m_buckets, 0, sizeof(m_buckets)); }
+
+    void increment(u32 key)
+    {
+        increment_bucket(first_bucket_for_key(key));
+        increment_bucket(second_bucket_for_key(key));
+    }
+
+    void decrement(u32 key)
+    {
+        decrement_bucket(first_bucket_for_key(key));
+        decrement_bucket(second_bucket_for_key(key));
+    }
+
+    [[nodiscard]] bool may_contain(u32 key) const
+    {
+        return m_buckets[first_bucket_for_key(key)] != 0 && m_buckets[second_bucket_for_key(key)] != 0;
+    }
+
+private:
+    static constexpr size_t bucket_count = 1u << key_bits;
+    static constexpr u32 key_mask = bucket_count - 1;
+
+    static size_t first_bucket_for_key(u32 key) { return key & key_mask; }
+    static size_t second_bucket_for_key(u32 key) { return (key >> 16) & key_mask; }
+
+    void increment_bucket(size_t index)
+    {
+        if (m_buckets[index] != NumericLimits<CounterType>::max())
+            ++m_buckets[index];
+    }
+
+    void decrement_bucket(size_t index)
+    {
+        if (m_buckets[index] != NumericLimits<CounterType>::max()) {
+            VERIFY(m_buckets[index] != 0);
+            --m_buckets[index];
+        }
+    }
+
+    CounterType m_buckets[bucket_count] {};
+};
+
+}
+
+using AK::CountingBloomFilter;
@@ -95,6 +95,7 @@ set(IRQ_DEBUG ON)
 set(ISO9660_DEBUG ON)
 set(ISO9660_VERY_DEBUG ON)
 set(ITEM_RECTS_DEBUG ON)
+set(JIT_DEBUG ON)
 set(JOB_DEBUG ON)
 set(JPG_DEBUG ON)
 set(JS_BYTECODE_DEBUG ON)
@@ -188,6 +189,7 @@ set(TERMCAP_DEBUG ON)
 set(TERMINAL_DEBUG ON)
 set(TEXTEDITOR_DEBUG ON)
 set(THREAD_DEBUG ON)
+set(THREADING_DEBUG ON)
 set(TIME_ZONE_DEBUG ON)
 set(TLS_DEBUG ON)
 set(TLS_SSL_KEYLOG_DEBUG ON)
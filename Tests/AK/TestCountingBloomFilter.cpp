@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/CountingBloomFilter.h>
+
+TEST_CASE(increment_and_decrement)
+{
+    CountingBloomFilter<u8, 12> filter;
+    EXPECT(!filter.may_contain(0x12345678));
+
+    filter.increment(0x12345678);
+    filter.increment(0x12345678);
+    EXPECT(filter.may_contain(0x12345678));
+    EXPECT(!filter.may_contain(0x87654321));
+
+    filter.decrement(0x12345678);
+    EXPECT(filter.may_contain(0x12345678));
+    filter.decrement(0x12345678);
+    EXPECT(!filter.may_contain(0x12345678));
+}
+
+TEST_CASE(saturated_counters_are_sticky)
+{
+    CountingBloomFilter<u8, 8> filter;
+    for (size_t i = 0; i < 300; ++i)
+        filter.increment(42);
+    for (size_t i = 0; i < 300; ++i)
+        filter.decrement(42);
+    EXPECT(filter.may_contain(42));
+
+    filter.clear();
+    EXPECT(!filter.may_contain(42));
+}
@@ -6,8 +6,11 @@
 
 #include <LibTest/TestCase.h>
 
+#include <AK/Utf8View.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/Font/FontDatabase.h>
+#include <LibGfx/Font/ScaledFont.h>
+#include <LibGfx/Font/TrueType/Font.h>
 #include <LibGfx/Painter.h>
 #include <stdio.h>
 
@@ -61,3 +64,21 @@ BENCHMARK_CASE(fill_with_gradient)
         painter.fill_rect_with_gradient(bitmap->rect(), Color::Blue, Color::Red);
     }
 }
+
+BENCHMARK_CASE(draw_text_run_with_vector_font)
+{
+    int const run_count = 200;
+    int const bitmap_size = 1000;
+
+    auto font = TTF::Font::try_load_from_file("/res/fonts/LiberationSerif-Regular.ttf").release_value_but_fixme_should_propagate_errors();
+    auto scaled_font = adopt_ref(*new Gfx::ScaledFont(font, 12, 12));
+    auto bitmap = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, { bitmap_size, bitmap_size }).release_value_but_fixme_should_propagate_errors();
+    Gfx::Painter painter(bitmap);
+
+    auto text = "The quick brown fox jumps over the lazy dog, and then it does it again."sv;
+    int line_height = scaled_font->preferred_line_height();
+    for (int run = 0; run < run_count; run++) {
+        for (int y = line_height; y < bitmap_size; y += line_height)
+            painter.draw_text_run({ 10.0f + (y % 4) * 0.25f, static_cast<float>(y) }, Utf8View(text), *scaled_font, Color::Black);
+    }
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/Time.h>
+#include <AK/Vector.h>
+#include <LibCore/MappedFile.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/JPGLoader.h>
+#include <LibTest/TestCase.h>
+
+// Covers baseline JPEGs with each kind of chroma subsampling we support.
+static constexpr Array jpg_fixtures {
+    "/res/html/misc/jpgsuite_files/non-subsampled-lena.jpg"sv,
+    "/res/html/misc/jpgsuite_files/horizontally-halved-lena.jpg"sv,
+    "/res/html/misc/jpgsuite_files/vertically-halved-lena.jpg"sv,
+    "/res/html/misc/jpgsuite_files/chroma-quartered-lena.jpg"sv,
+    "/res/html/misc/jpgsuite_files/oh-lena.jpg"sv,
+};
+
+BENCHMARK_CASE(jpg_decode_throughput)
+{
+    int const run_count = 20;
+
+    Vector<NonnullRefPtr<Core::MappedFile>> files;
+    for (auto path : jpg_fixtures)
+        files.append(MUST(Core::MappedFile::map(path)));
+
+    size_t encoded_bytes = 0;
+    size_t decoded_pixels = 0;
+    auto start = Time::now_monotonic();
+    for (int run = 0; run < run_count; run++) {
+        for (auto& file : files) {
+            Gfx::JPGImageDecoderPlugin jpg(static_cast<u8 const*>(file->data()), file->size());
+            auto frame = MUST(jpg.frame(0));
+            encoded_bytes += file->size();
+            decoded_pixels += frame.image->width() * frame.image->height();
+        }
+    }
+    auto seconds = (Time::now_monotonic() - start).to_microseconds() / 1'000'000.0;
+
+    outln("Decoded {:.2} MB/s of JPEG data, {:.2} megapixels/s", encoded_bytes / seconds / MiB, decoded_pixels / seconds / 1'000'000.0);
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/Utf8View.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/Font/GlyphAtlas.h>
+#include <LibGfx/Font/ScaledFont.h>
+#include <LibGfx/Font/TrueType/Font.h>
+#include <LibGfx/Painter.h>
+
+// NOTE: The atlas is shared by the whole process, so every test uses font IDs of its own.
+
+static RefPtr<Gfx::Bitmap> make_glyph(Gfx::IntSize size, Color color)
+{
+    auto bitmap = MUST(Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRA8888, size));
+    bitmap->fill(color);
+    return bitmap;
+}
+
+static Color color_for(u32 glyph_id)
+{
+    return Color(glyph_id & 0xff, (glyph_id >> 8) & 0xff, 0x80);
+}
+
+static bool location_has_color(Gfx::GlyphAtlas::Location const& location, Color color)
+{
+    auto const& page = Gfx::GlyphAtlas::the().page(location.page_index);
+    for (int y = location.rect.top(); y <= location.rect.bottom(); ++y) {
+        for (int x = location.rect.left(); x <= location.rect.right(); ++x) {
+            if (page->get_pixel(x, y) != color)
+                return false;
+        }
+    }
+    return true;
+}
+
+TEST_CASE(test_glyph_atlas_stores_glyphs)
+{
+    auto& atlas = Gfx::GlyphAtlas::the();
+    Gfx::GlyphAtlasKey key { .font_id = 1, .x_scale = 10, .y_scale = 10, .glyph_id = 42, .subpixel_offset = {} };
+
+    size_t rasterize_count = 0;
+    auto ensure_glyph = [&] {
+        return atlas.ensure(key, [&] {
+            ++rasterize_count;
+            return make_glyph({ 10, 13 }, Color::Red);
+        });
+    };
+
+    auto location = ensure_glyph();
+    EXPECT(location.has_value());
+    EXPECT_EQ(location->rect.size(), Gfx::IntSize(10, 13));
+    EXPECT(location_has_color(*location, Color::Red));
+
+    // A glyph is only rasterized once.
+    auto same_location = ensure_glyph();
+    EXPECT_EQ(rasterize_count, 1u);
+    EXPECT_EQ(same_location->page_index, location->page_index);
+    EXPECT_EQ(same_location->rect, location->rect);
+
+    // Glyphs at another subpixel offset are separate glyphs.
+    auto shifted_key = key;
+    shifted_key.subpixel_offset.x = 2;
+    auto shifted_location = atlas.ensure(shifted_key, [] { return make_glyph({ 11, 13 }, Color::Blue); });
+    EXPECT(shifted_location.has_value());
+    EXPECT(!shifted_location->rect.intersects(location->rect) || shifted_location->page_index != location->page_index);
+    EXPECT(location_has_color(*location, Color::Red));
+    EXPECT(location_has_color(*shifted_location, Color::Blue));
+}
+
+TEST_CASE(test_glyph_atlas_rejects_large_glyphs)
+{
+    auto& atlas = Gfx::GlyphAtlas::the();
+    auto too_large = Gfx::GlyphAtlas::maximum_glyph_size + 1;
+    EXPECT(!atlas.ensure({ .font_id = 2, .x_scale = 1, .y_scale = 1, .glyph_id = 1, .subpixel_offset = {} }, [&] { return make_glyph({ too_large, 8 }, Color::Red); }).has_value());
+    EXPECT(!atlas.ensure({ .font_id = 2, .x_scale = 1, .y_scale = 1, .glyph_id = 2, .subpixel_offset = {} }, [&] { return make_glyph({ 8, too_large }, Color::Red); }).has_value());
+    EXPECT(!atlas.ensure({ .font_id = 2, .x_scale = 1, .y_scale = 1, .glyph_id = 3, .subpixel_offset = {} }, [] { return RefPtr<Gfx::Bitmap> {}; }).has_value());
+}
+
+TEST_CASE(test_glyph_atlas_empties_least_recently_used_page)
+{
+    auto& atlas = Gfx::GlyphAtlas::the();
+    auto size = Gfx::GlyphAtlas::maximum_glyph_size;
+    auto key_for = [](u32 glyph_id) { return Gfx::GlyphAtlasKey { .font_id = 3, .x_scale = 1, .y_scale = 1, .glyph_id = glyph_id, .subpixel_offset = {} }; };
+
+    // Glyph 0 is used after every other glyph, so its page is never the least recently used one.
+    auto hot_location = atlas.ensure(key_for(0), [&] { return make_glyph({ size, size }, color_for(0)); });
+    EXPECT(hot_location.has_value());
+
+    auto initial_generation = atlas.generation();
+    u32 cold_glyph_count = 0;
+    while (atlas.generation() == initial_generation && cold_glyph_count < 1000) {
+        ++cold_glyph_count;
+        auto location = atlas.ensure(key_for(cold_glyph_count), [&] { return make_glyph({ size, size }, color_for(cold_glyph_count)); });
+        EXPECT(location.has_value());
+        EXPECT(location->page_index < Gfx::GlyphAtlas::maximum_page_count);
+        (void)atlas.ensure(key_for(0), [] { return RefPtr<Gfx::Bitmap> {}; });
+    }
+    EXPECT_NE(atlas.generation(), initial_generation);
+
+    bool hot_glyph_was_rasterized_again = false;
+    auto location = atlas.ensure(key_for(0), [&] {
+        hot_glyph_was_rasterized_again = true;
+        return make_glyph({ size, size }, color_for(0));
+    });
+    EXPECT(!hot_glyph_was_rasterized_again);
+    EXPECT_EQ(location->rect, hot_location->rect);
+    EXPECT(location_has_color(*location, color_for(0)));
+
+    // Some of the others were thrown out, but whatever location we get has to hold the right glyph.
+    size_t rasterized_again_count = 0;
+    for (u32 glyph_id = 1; glyph_id <= cold_glyph_count; ++glyph_id) {
+        auto cold_location = atlas.ensure(key_for(glyph_id), [&] {
+            ++rasterized_again_count;
+            return make_glyph({ size, size }, color_for(glyph_id));
+        });
+        EXPECT(cold_location.has_value());
+        EXPECT(location_has_color(*cold_location, color_for(glyph_id)));
+    }
+    EXPECT(rasterized_again_count > 0);
+}
+
+TEST_CASE(test_text_run_after_atlas_pages_were_emptied)
+{
+    auto font = MUST(TTF::Font::try_load_from_file("/res/fonts/LiberationSerif-Regular.ttf"));
+    auto scaled_font = adopt_ref(*new Gfx::ScaledFont(font, 14, 14));
+    auto text = "The quick brown fox jumps over the lazy dog."sv;
+
+    auto draw_text = [&] {
+        auto bitmap = MUST(Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, { 400, 40 }));
+        Gfx::Painter painter(bitmap);
+        painter.clear_rect(bitmap->rect(), Color::White);
+        painter.draw_text_run({ 5.25f, 25.0f }, Utf8View(text), *scaled_font, Color::Black);
+        return bitmap;
+    };
+
+    auto reference = draw_text();
+    bool has_text = false;
+    for (int y = 0; y < reference->height(); ++y) {
+        for (int x = 0; x < reference->width(); ++x) {
+            if (reference->get_pixel(x, y) != Color::White)
+                has_text = true;
+        }
+    }
+    EXPECT(has_text);
+
+    // The cached run refers to atlas locations that are gone once every page has been emptied.
+    auto& atlas = Gfx::GlyphAtlas::the();
+    auto size = Gfx::GlyphAtlas::maximum_glyph_size;
+    auto initial_generation = atlas.generation();
+    for (u32 glyph_id = 0; atlas.generation() - initial_generation <= Gfx::GlyphAtlas::maximum_page_count && glyph_id < 10000; ++glyph_id)
+        (void)atlas.ensure({ .font_id = 4, .x_scale = 1, .y_scale = 1, .glyph_id = glyph_id, .subpixel_offset = {} }, [&] { return make_glyph({ size, size }, Color::Red); });
+    EXPECT(atlas.generation() - initial_generation > Gfx::GlyphAtlas::maximum_page_count);
+
+    EXPECT(draw_text()->visually_equals(*reference));
+}
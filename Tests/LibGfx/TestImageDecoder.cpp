@@ -21,6 +21,18 @@
 #include <stdlib.h>
 #include <string.h>
 
+// This makes sure that the tests will run both on target and in Lagom.
+#ifdef AK_OS_SERENITY
+#    define TEST_INPUT_DIR "/usr/Tests/LibGfx/test-inputs"
+#else
+#    define TEST_INPUT_DIR "test-inputs"
+#endif
+
+static NonnullRefPtr<Core::MappedFile> map_test_input(StringView file_name)
+{
+    return MUST(Core::MappedFile::map(String::formatted(TEST_INPUT_DIR "/{}", file_name)));
+}
+
 TEST_CASE(test_bmp)
 {
     auto file = Core::MappedFile::map("/res/html/misc/bmpsuite_files/rgba32-1.bmp"sv).release_value();
@@ -35,6 +47,40 @@ TEST_CASE(test_bmp)
     EXPECT(frame.duration == 0);
 }
 
+TEST_CASE(test_bmp_ideal_size)
+{
+    auto file = map_test_input("bmp-rgb24.bmp"sv);
+    auto decoder = Gfx::ImageDecoder::try_create(file->bytes());
+    EXPECT(decoder);
+    auto full_frame = MUST(decoder->frame(0));
+    EXPECT_EQ(full_frame.image->size(), Gfx::IntSize(61, 43));
+
+    // BMP can't be decoded at a reduced size, so ImageDecoder box filters it down by the largest whole factor that
+    // keeps it at least as large as the ideal size.
+    struct TestCase {
+        Gfx::IntSize ideal_size;
+        Gfx::IntSize expected_size;
+    };
+    for (auto test_case : { TestCase { { 40, 40 }, { 61, 43 } }, TestCase { { 30, 21 }, { 31, 22 } }, TestCase { { 20, 14 }, { 21, 15 } }, TestCase { { 20, 30 }, { 61, 43 } } }) {
+        auto frame = MUST(decoder->frame(0, test_case.ideal_size));
+        EXPECT_EQ(frame.image->size(), test_case.expected_size);
+    }
+
+    auto frame = MUST(decoder->frame(0, Gfx::IntSize { 20, 14 }));
+    int red = 0;
+    int green = 0;
+    int blue = 0;
+    for (int y = 3; y < 6; ++y) {
+        for (int x = 3; x < 6; ++x) {
+            auto color = full_frame.image->get_pixel(x, y);
+            red += color.red();
+            green += color.green();
+            blue += color.blue();
+        }
+    }
+    EXPECT_EQ(frame.image->get_pixel(1, 1), Gfx::Color(red / 9, green / 9, blue / 9));
+}
+
 TEST_CASE(test_gif)
 {
     auto file = Core::MappedFile::map("/res/graphics/download-animation.gif"sv).release_value();
@@ -77,6 +123,93 @@ TEST_CASE(test_jpg)
     EXPECT(frame.duration == 0);
 }
 
+// The two files only differ in that one has restart markers, so they decode to the same pixels.
+TEST_CASE(test_jpg_restart_intervals)
+{
+    auto file = map_test_input("jpg-restart-intervals.jpg"sv);
+    auto jpg = Gfx::JPGImageDecoderPlugin((u8 const*)file->data(), file->size());
+    auto frame = MUST(jpg.frame(0));
+
+    auto reference_file = map_test_input("jpg-no-restart-intervals.jpg"sv);
+    auto reference_jpg = Gfx::JPGImageDecoderPlugin((u8 const*)reference_file->data(), reference_file->size());
+    auto reference_frame = MUST(reference_jpg.frame(0));
+
+    EXPECT_EQ(frame.image->size(), Gfx::IntSize(512, 512));
+    EXPECT(frame.image->visually_equals(*reference_frame.image));
+}
+
+TEST_CASE(test_jpg_restart_intervals_in_parallel)
+{
+    auto file = map_test_input("jpg-restart-intervals.jpg"sv);
+    auto reference_file = map_test_input("jpg-no-restart-intervals.jpg"sv);
+    auto reference_jpg = Gfx::JPGImageDecoderPlugin((u8 const*)reference_file->data(), reference_file->size());
+    auto reference_frame = MUST(reference_jpg.frame(0));
+
+    Gfx::ImageDecoder::set_maximum_thread_count(4);
+    auto jpg = Gfx::JPGImageDecoderPlugin((u8 const*)file->data(), file->size());
+    auto frame = jpg.frame(0);
+    Gfx::ImageDecoder::set_maximum_thread_count(1);
+
+    EXPECT(!frame.is_error());
+    EXPECT(frame.value().image->visually_equals(*reference_frame.image));
+}
+
+TEST_CASE(test_jpg_incremental)
+{
+    static constexpr size_t chunk_size = 1000;
+
+    for (auto file_name : { "jpg-restart-intervals.jpg"sv, "jpg-no-restart-intervals.jpg"sv }) {
+        auto file = map_test_input(file_name);
+        auto bytes = file->bytes();
+        auto reference_jpg = Gfx::JPGImageDecoderPlugin(bytes.data(), bytes.size());
+        auto reference_frame = MUST(reference_jpg.frame(0));
+
+        auto jpg = Gfx::JPGImageDecoderPlugin(bytes.data(), chunk_size);
+        EXPECT(jpg.supports_incremental_decoding());
+        MUST(jpg.append_data({}));
+        for (size_t offset = chunk_size; offset < bytes.size(); offset += chunk_size) {
+            // Decoding what has arrived so far must not get in the way of decoding the rest.
+            (void)jpg.frame(0);
+            MUST(jpg.append_data(bytes.slice(offset, min(chunk_size, bytes.size() - offset))));
+        }
+        jpg.finish_data();
+
+        auto frame = MUST(jpg.frame(0));
+        EXPECT(frame.image->visually_equals(*reference_frame.image));
+    }
+}
+
+TEST_CASE(test_jpg_ideal_size)
+{
+    auto file = map_test_input("jpg-no-restart-intervals.jpg"sv);
+
+    // JPEG images can be decoded at 1/2, 1/4 and 1/8 of their size, the smallest of those that isn't below the ideal size is used.
+    struct TestCase {
+        Gfx::IntSize ideal_size;
+        Gfx::IntSize expected_size;
+    };
+    for (auto test_case : { TestCase { { 600, 600 }, { 512, 512 } }, TestCase { { 300, 300 }, { 512, 512 } }, TestCase { { 256, 256 }, { 256, 256 } }, TestCase { { 200, 100 }, { 256, 256 } }, TestCase { { 100, 100 }, { 128, 128 } }, TestCase { { 64, 64 }, { 64, 64 } }, TestCase { { 1, 1 }, { 64, 64 } } }) {
+        auto jpg = Gfx::JPGImageDecoderPlugin((u8 const*)file->data(), file->size());
+        auto frame = MUST(jpg.frame(0, test_case.ideal_size));
+        EXPECT_EQ(frame.image->size(), test_case.expected_size);
+        EXPECT(frame.image->width() >= min(test_case.ideal_size.width(), 512));
+        EXPECT(frame.image->height() >= min(test_case.ideal_size.height(), 512));
+    }
+}
+
+TEST_CASE(test_jpg_ideal_size_changes)
+{
+    auto file = map_test_input("jpg-no-restart-intervals.jpg"sv);
+    auto reference_jpg = Gfx::JPGImageDecoderPlugin((u8 const*)file->data(), file->size());
+    auto reference_frame = MUST(reference_jpg.frame(0));
+
+    auto jpg = Gfx::JPGImageDecoderPlugin((u8 const*)file->data(), file->size());
+    EXPECT_EQ(MUST(jpg.frame(0, Gfx::IntSize { 64, 64 })).image->size(), Gfx::IntSize(64, 64));
+    EXPECT_EQ(MUST(jpg.frame(0, Gfx::IntSize { 200, 200 })).image->size(), Gfx::IntSize(256, 256));
+    auto frame = MUST(jpg.frame(0));
+    EXPECT(frame.image->visually_equals(*reference_frame.image));
+}
+
 TEST_CASE(test_pbm)
 {
     auto file = Core::MappedFile::map("/res/html/misc/pbmsuite_files/buggie-raw.pbm"sv).release_value();
@@ -119,6 +252,59 @@ TEST_CASE(test_png)
     EXPECT(frame.duration == 0);
 }
 
+TEST_CASE(test_png_adam7_ideal_size)
+{
+    auto file = map_test_input("png-adam7.png"sv);
+    auto full_png = Gfx::PNGImageDecoderPlugin((u8 const*)file->data(), file->size());
+    auto full_frame = MUST(full_png.frame(0));
+    EXPECT_EQ(full_frame.image->size(), Gfx::IntSize(61, 43));
+
+    // Stopping after the first 5, 3 or 1 Adam7 passes yields exactly the pixels in every 2nd, 4th or 8th row and column.
+    struct TestCase {
+        Gfx::IntSize ideal_size;
+        int expected_factor;
+    };
+    for (auto test_case : { TestCase { { 40, 40 }, 1 }, TestCase { { 31, 22 }, 2 }, TestCase { { 16, 11 }, 4 }, TestCase { { 9, 6 }, 4 }, TestCase { { 8, 6 }, 8 }, TestCase { { 1, 1 }, 8 } }) {
+        auto png = Gfx::PNGImageDecoderPlugin((u8 const*)file->data(), file->size());
+        auto frame = MUST(png.frame(0, test_case.ideal_size));
+        auto factor = test_case.expected_factor;
+        EXPECT_EQ(frame.image->size(), Gfx::IntSize(ceil_div(61, factor), ceil_div(43, factor)));
+
+        bool has_expected_pixels = true;
+        for (int y = 0; y < frame.image->height(); ++y) {
+            for (int x = 0; x < frame.image->width(); ++x) {
+                if (frame.image->get_pixel(x, y) != full_frame.image->get_pixel(x * factor, y * factor))
+                    has_expected_pixels = false;
+            }
+        }
+        EXPECT(has_expected_pixels);
+    }
+
+    auto png = Gfx::PNGImageDecoderPlugin((u8 const*)file->data(), file->size());
+    EXPECT_EQ(MUST(png.frame(0, Gfx::IntSize { 8, 6 })).image->size(), Gfx::IntSize(8, 6));
+    EXPECT_EQ(MUST(png.frame(0, Gfx::IntSize { 31, 22 })).image->size(), Gfx::IntSize(31, 22));
+    EXPECT(MUST(png.frame(0)).image->visually_equals(*full_frame.image));
+}
+
+// Each set of files holds the same pixels, stored without filters, with every row using one of Sub, Up, Average and Paeth,
+// and with those filters in Adam7 passes. Their scanlines are split across many deflate blocks and IDAT chunks.
+TEST_CASE(test_png_filters)
+{
+    for (auto color_type : { "rgb"sv, "rgba"sv }) {
+        auto reference_file = map_test_input(String::formatted("png-{}-unfiltered.png", color_type));
+        auto reference_png = Gfx::PNGImageDecoderPlugin((u8 const*)reference_file->data(), reference_file->size());
+        auto reference_frame = MUST(reference_png.frame(0));
+        EXPECT_EQ(reference_frame.image->size(), Gfx::IntSize(37, 29));
+
+        for (auto variant : { "filtered"sv, "filtered-adam7"sv }) {
+            auto file = map_test_input(String::formatted("png-{}-{}.png", color_type, variant));
+            auto png = Gfx::PNGImageDecoderPlugin((u8 const*)file->data(), file->size());
+            auto frame = MUST(png.frame(0));
+            EXPECT(frame.image->visually_equals(*reference_frame.image));
+        }
+    }
+}
+
 TEST_CASE(test_ppm)
 {
     auto file = Core::MappedFile::map("/res/html/misc/ppmsuite_files/buggie-raw.ppm"sv).release_value();
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/ElapsedTimer.h>
+#include <LibJS/Bytecode/Generator.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Interpreter.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibJS/Script.h>
+#include <LibTest/TestCase.h>
+
+// Each benchmark runs a loop of `iterations` iterations through the bytecode interpreter and reports the rate.
+static void run_arithmetic_benchmark(StringView name, StringView source, size_t iterations)
+{
+    auto vm = JS::VM::create();
+    auto ast_interpreter = JS::Interpreter::create<JS::GlobalObject>(*vm);
+
+    auto script_or_error = JS::Script::parse(source, ast_interpreter->realm());
+    EXPECT(!script_or_error.is_error());
+    if (script_or_error.is_error())
+        return;
+
+    auto script = script_or_error.release_value();
+    JS::Bytecode::Interpreter bytecode_interpreter(ast_interpreter->realm());
+    auto executable = MUST(JS::Bytecode::Generator::generate(script->parse_node()));
+    JS::Bytecode::Interpreter::optimization_pipeline().perform(*executable);
+
+    auto timer = Core::ElapsedTimer::start_new();
+    auto result = bytecode_interpreter.run(*executable);
+    auto elapsed_ms = max(timer.elapsed(), 1);
+
+    EXPECT(!result.is_error());
+    outln("{}: {} ops/sec ({} iterations in {} ms)", name, iterations * 1000 / elapsed_ms, iterations, elapsed_ms);
+}
+
+BENCHMARK_CASE(int32_add_and_sub)
+{
+    run_arithmetic_benchmark("int32 add/sub"sv, "(() => { let x = 0; for (let i = 0; i < 10000000; ++i) x = x + i - 3; return x; })()"sv, 10'000'000);
+}
+
+BENCHMARK_CASE(int32_multiply_and_modulo)
+{
+    run_arithmetic_benchmark("int32 mul/mod"sv, "(() => { let x = 1; for (let i = 1; i < 10000000; ++i) x = (x * 3) % 1000003; return x; })()"sv, 10'000'000);
+}
+
+BENCHMARK_CASE(int32_bitwise)
+{
+    run_arithmetic_benchmark("int32 bitwise"sv, "(() => { let x = 0; for (let i = 0; i < 10000000; ++i) x = (x ^ (i << 3)) >> 1 | (i & 7); return x; })()"sv, 10'000'000);
+}
+
+BENCHMARK_CASE(int32_comparisons)
+{
+    run_arithmetic_benchmark("int32 comparisons"sv, "(() => { let count = 0; for (let i = 0; i < 10000000; ++i) { if (i <= 5000000) ++count; if (i === 42) --count; } return count; })()"sv, 10'000'000);
+}
+
+BENCHMARK_CASE(int32_overflow_into_doubles)
+{
+    run_arithmetic_benchmark("int32 overflow"sv, "(() => { let x = 2147483000; for (let i = 0; i < 10000000; ++i) x = (x + 1000) - 999; return x; })()"sv, 10'000'000);
+}
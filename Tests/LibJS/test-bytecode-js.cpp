@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibJS/Bytecode/ExecutableCache.h>
 #include <LibJS/Bytecode/Generator.h>
 #include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Interpreter.h>
@@ -39,10 +40,42 @@
     if (result_with_optimizations.is_error())                               \
         dbgln("Error: {}", MUST(result_with_optimizations.throw_completion().value()->to_string(vm)));
 
-#define EXPECT_NO_EXCEPTION_ALL(source)           \
-    SETUP_AND_PARSE("(() => {\n" source "\n})()") \
-    EXPECT_NO_EXCEPTION(executable)               \
-    EXPECT_NO_EXCEPTION_WITH_OPTIMIZATIONS(executable)
+#define EXPECT_NO_EXCEPTION_WITH_AGGRESSIVE_OPTIMIZATIONS()                                                      \
+    JS::Bytecode::Interpreter::set_optimization_level(JS::Bytecode::Interpreter::OptimizationLevel::Aggressive); \
+    auto aggressively_optimized_executable = MUST(JS::Bytecode::Generator::generate(program));                   \
+    JS::Bytecode::Interpreter::optimization_pipeline().perform(*aggressively_optimized_executable);              \
+                                                                                                                 \
+    auto result_with_aggressive_optimizations = bytecode_interpreter.run(*aggressively_optimized_executable);    \
+    JS::Bytecode::Interpreter::set_optimization_level(JS::Bytecode::Interpreter::OptimizationLevel::Default);    \
+                                                                                                                 \
+    EXPECT(!result_with_aggressive_optimizations.is_error());                                                    \
+    if (result_with_aggressive_optimizations.is_error())                                                         \
+        dbgln("Error: {}", MUST(result_with_aggressive_optimizations.throw_completion().value()->to_string(vm)));
+
+#define EXPECT_NO_EXCEPTION_ALL(source)                \
+    SETUP_AND_PARSE("(() => {\n" source "\n})()")      \
+    EXPECT_NO_EXCEPTION(executable)                    \
+    EXPECT_NO_EXCEPTION_WITH_OPTIMIZATIONS(executable) \
+    EXPECT_NO_EXCEPTION_WITH_AGGRESSIVE_OPTIMIZATIONS()
+
+#define EXPECT_NO_EXCEPTION_ALL_WITH_JIT(source)      \
+    JS::Bytecode::Interpreter::set_jit_threshold(0);  \
+    EXPECT_NO_EXCEPTION_ALL(source)                   \
+    JS::Bytecode::Interpreter::set_jit_threshold({});
+
+#define EXPECT_NO_EXCEPTION_AFTER_SERIALIZATION(source)                                   \
+    SETUP_AND_PARSE(source)                                                               \
+    auto executable = MUST(JS::Bytecode::Generator::generate(program));                   \
+    JS::Bytecode::Interpreter::optimization_pipeline().perform(*executable);              \
+    auto serialized = JS::Bytecode::serialize_executable(*executable);                    \
+    EXPECT(serialized.has_value());                                                       \
+    auto deserialized_executable = JS::Bytecode::deserialize_executable(*serialized);     \
+    EXPECT(deserialized_executable);                                                      \
+    EXPECT_EQ(deserialized_executable->bytecode_size(), executable->bytecode_size());     \
+    auto result_after_serialization = bytecode_interpreter.run(*deserialized_executable); \
+    EXPECT(!result_after_serialization.is_error());                                       \
+    if (result_after_serialization.is_error())                                            \
+        dbgln("Error: {}", MUST(result_after_serialization.throw_completion().value()->to_string(vm)));
 
 TEST_CASE(empty_program)
 {
@@ -138,3 +171,119 @@ TEST_CASE(catch_exception)
                             "if (hitCatch !== true) throw new Exception('failed');\n"
                             "if (hitFinally !== true) throw new Exception('failed');");
 }
+
+TEST_CASE(constant_folding)
+{
+    EXPECT_NO_EXCEPTION_ALL("if (1 + 2 * 3 !== 7) throw new Exception('failed');\n"
+                            "if (-(4 - 6) !== 2) throw new Exception('failed');\n"
+                            "if ((7 | 8) !== 15 || (-1 >>> 28) !== 15 || (1 << 33) !== 2) throw new Exception('failed');\n"
+                            "if (!(1 / 0 > 1e308) || (0 / 0 === 0 / 0)) throw new Exception('failed');");
+}
+
+TEST_CASE(constant_conditions)
+{
+    EXPECT_NO_EXCEPTION_ALL("var count = 0;\n"
+                            "while (true) { if (++count === 3) break; }\n"
+                            "if (count !== 3 || (null ?? 5) !== 5) throw new Exception('failed');");
+}
+
+TEST_CASE(registers_live_across_loops_and_calls)
+{
+    EXPECT_NO_EXCEPTION_ALL("function sum(array) { let total = 0; for (let i = 0; i < array.length; ++i) total += array[i]; return total; }\n"
+                            "var values = [1, 2, 3, [4, 5].length, sum([6, 7])];\n"
+                            "if (sum(values) !== 21) throw new Exception('failed');");
+}
+
+TEST_CASE(registers_read_by_exception_handler)
+{
+    EXPECT_NO_EXCEPTION_ALL("function f(o) { let x = 1; let result = 0; try { x = 2; o.missing(); } catch (e) { result = x; } return result; }\n"
+                            "if (f({}) !== 2) throw new Exception('failed');");
+}
+
+TEST_CASE(registers_live_across_yield)
+{
+    EXPECT_NO_EXCEPTION_ALL("function *g(a, b) { const sum = a + b; yield sum; yield sum * 2; }\n"
+                            "var gen = g(1, 2);\n"
+                            "if (gen.next().value !== 3 || gen.next().value !== 6) throw new Exception('failed');");
+}
+
+TEST_CASE(jit_int32_arithmetic_and_comparisons)
+{
+    EXPECT_NO_EXCEPTION_ALL_WITH_JIT("function sum(n) { let total = 0; for (let i = 0; i < n; ++i) total = total + i - 1; return total; }\n"
+                                     "if (sum(100) !== 4850) throw new Exception('failed');\n"
+                                     "if (sum(0) !== 0 || sum(-5) !== 0) throw new Exception('failed');\n"
+                                     "function compare(a, b) { return [a < b, a <= b, a > b, a >= b]; }\n"
+                                     "if (compare(1, 2).join() !== 'true,true,false,false' || compare(3, 3).join() !== 'false,true,false,true') throw new Exception('failed');\n"
+                                     "if (compare(-1, 'a').join() !== 'false,false,false,false') throw new Exception('failed');");
+}
+
+TEST_CASE(jit_int32_overflow_and_non_int32_operands)
+{
+    EXPECT_NO_EXCEPTION_ALL_WITH_JIT("function add(a, b) { return a + b; }\n"
+                                     "function inc(a) { return ++a; }\n"
+                                     "if (add(2147483647, 1) !== 2147483648 || add(-2147483648, -1) !== -2147483649) throw new Exception('failed');\n"
+                                     "if (inc(2147483647) !== 2147483648 || inc(1.5) !== 2.5) throw new Exception('failed');\n"
+                                     "if (add('a', 1) !== 'a1' || add(0.5, 0.25) !== 0.75) throw new Exception('failed');");
+}
+
+TEST_CASE(jit_conditional_jumps)
+{
+    EXPECT_NO_EXCEPTION_ALL_WITH_JIT("function truthy(x) { if (x) return 1; return 0; }\n"
+                                     "if (truthy(0) + truthy(1) + truthy(true) + truthy(false) + truthy('') + truthy('a') + truthy({}) !== 4) throw new Exception('failed');\n"
+                                     "function nullish(x) { return x ?? 'default'; }\n"
+                                     "if (nullish(null) !== 'default' || nullish(undefined) !== 'default' || nullish(0) !== 0) throw new Exception('failed');\n"
+                                     "function defaulted(o) { const { value = 'default' } = o; return value; }\n"
+                                     "if (defaulted({}) !== 'default' || defaulted({ value: 3 }) !== 3) throw new Exception('failed');");
+}
+
+TEST_CASE(jit_exceptions)
+{
+    EXPECT_NO_EXCEPTION_ALL_WITH_JIT("function f(o) { let x = 1; try { x = 2; o.missing(); } catch (e) { return x + 1; } return 0; }\n"
+                                     "if (f({}) !== 3) throw new Exception('failed');\n"
+                                     "function g() { throw 42; }\n"
+                                     "let caught;\n"
+                                     "try { g(); } catch (e) { caught = e; }\n"
+                                     "if (caught !== 42) throw new Exception('failed');");
+}
+
+TEST_CASE(jit_exception_unwinding_to_finalizer)
+{
+    // NOTE: The Promise constructor swallows the exception, so nothing else gets to replace the jump to the finalizer.
+    EXPECT_NO_EXCEPTION_ALL_WITH_JIT("function f() { try { throw 1; } finally { } }\n"
+                                     "new Promise(f);\n"
+                                     "var x = 1;\n"
+                                     "function g() { try { f(); } catch (e) { return e + x; } return 0; }\n"
+                                     "if (g() !== 2 || x !== 1) throw new Exception('failed');");
+}
+
+TEST_CASE(serialized_executable_with_loops_and_strings)
+{
+    EXPECT_NO_EXCEPTION_AFTER_SERIALIZATION("let total = 0; let text = '';\n"
+                                            "for (let i = 0; i < 10; ++i) { if (i % 2) continue; total += i; text += 'ab'; }\n"
+                                            "if (total !== 20 || text !== 'ababababab' || text.length !== 10) throw new Exception('failed');");
+}
+
+TEST_CASE(serialized_executable_with_exception_handlers)
+{
+    EXPECT_NO_EXCEPTION_AFTER_SERIALIZATION("let x = 0;\n"
+                                            "try { x = 1; null.foo; } catch (e) { x += 10; } finally { x += 100; }\n"
+                                            "var o = { a: 1, b: [1, 2, 3] };\n"
+                                            "if (x !== 111 || o.b.length !== 3 || /a+/.exec('caab')[0] !== 'aa') throw new Exception('failed');");
+}
+
+TEST_CASE(executables_referring_to_the_ast_are_not_serialized)
+{
+    SETUP_AND_PARSE("function f() { return 1; }\nf();");
+    auto executable = MUST(JS::Bytecode::Generator::generate(program));
+    EXPECT(!JS::Bytecode::serialize_executable(*executable).has_value());
+}
+
+TEST_CASE(truncated_serialized_executable_is_rejected)
+{
+    SETUP_AND_PARSE("let x = 1; while (x < 100) x *= 2;");
+    auto executable = MUST(JS::Bytecode::Generator::generate(program));
+    auto serialized = JS::Bytecode::serialize_executable(*executable);
+    EXPECT(serialized.has_value());
+    EXPECT(!JS::Bytecode::deserialize_executable(serialized->bytes().trim(serialized->size() - 1)));
+    EXPECT(!JS::Bytecode::deserialize_executable({}));
+}
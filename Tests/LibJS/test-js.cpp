@@ -49,6 +49,11 @@ TESTJS_GLOBAL_FUNCTION(get_weak_map_size, getWeakMapSize)
     return JS::Value(weak_map->values().size());
 }
 
+TESTJS_GLOBAL_FUNCTION(get_remembered_cell_count, getRememberedCellCount, 0)
+{
+    return JS::Value(vm.heap().remembered_cell_count());
+}
+
 TESTJS_GLOBAL_FUNCTION(mark_as_garbage, markAsGarbage)
 {
     auto argument = vm.argument(0);
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/Utf8View.h>
+#include <LibGfx/AntiAliasingPainter.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/Font/ScaledFont.h>
+#include <LibGfx/Font/TrueType/Font.h>
+#include <LibGfx/Painter.h>
+#include <LibWeb/Painting/BorderRadiusCornerClipper.h>
+#include <LibWeb/Painting/DisplayList.h>
+#include <LibWeb/Painting/RecordingPainter.h>
+
+static Gfx::IntSize const canvas_size { 200, 150 };
+
+static NonnullRefPtr<Gfx::Bitmap> make_canvas()
+{
+    auto bitmap = MUST(Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, canvas_size));
+    bitmap->fill(Color::White);
+    return bitmap;
+}
+
+static NonnullRefPtr<Gfx::Bitmap> replay(Web::Painting::DisplayList const& display_list, Optional<Gfx::IntPoint> scroll_offset = {})
+{
+    auto bitmap = make_canvas();
+    Gfx::Painter painter(bitmap);
+    display_list.execute(painter, scroll_offset);
+    return bitmap;
+}
+
+// Paints the same thing with a RecordingPainter and a Gfx::Painter, which share the interface used here.
+static void paint_shapes(auto& painter)
+{
+    painter.fill_rect({ 10, 10, 50, 30 }, Color::Red);
+    painter.draw_rect({ 5, 5, 60, 40 }, Color::Blue);
+    painter.draw_line({ 0, 100 }, { 199, 60 }, Color::Green, 3);
+    painter.draw_line({ 0, 140 }, { 199, 140 }, Color::Black, 1, Gfx::Painter::LineStyle::Dashed);
+
+    painter.save();
+    painter.translate(100, 20);
+    painter.add_clip_rect({ 0, 0, 40, 40 });
+    // Only the top left corner of this ends up inside the clip rect.
+    painter.fill_rect({ 20, 20, 60, 60 }, Color::Magenta);
+    painter.restore();
+
+    painter.fill_rect({ 120, 90, 20, 20 }, Color::Cyan);
+}
+
+TEST_CASE(replay_paints_like_a_painter)
+{
+    Web::Painting::DisplayList display_list;
+    Web::Painting::RecordingPainter recording_painter(display_list, { {}, canvas_size });
+    paint_shapes(recording_painter);
+
+    auto expected = make_canvas();
+    Gfx::Painter painter(expected);
+    paint_shapes(painter);
+
+    EXPECT(replay(display_list)->visually_equals(*expected));
+    EXPECT_EQ(expected->get_pixel(30, 20), Color(Color::Red));
+    EXPECT_EQ(expected->get_pixel(125, 45), Color(Color::Magenta));
+    EXPECT_EQ(expected->get_pixel(145, 65), Color(Color::White));
+}
+
+TEST_CASE(replay_paints_anti_aliased_shapes_like_a_painter)
+{
+    Gfx::Path path;
+    path.move_to({ 20, 120 });
+    path.line_to({ 60, 80 });
+    path.line_to({ 100, 130 });
+    path.close();
+
+    Web::Painting::DisplayList display_list;
+    Web::Painting::RecordingPainter recording_painter(display_list, { {}, canvas_size });
+    recording_painter.fill_rect_with_rounded_corners({ 10, 10, 80, 50 }, Color::Red, { 10, 10 }, { 20, 5 }, { 0, 0 }, { 15, 15 });
+    recording_painter.draw_anti_aliased_line({ 100.5f, 10.0f }, { 190.0f, 70.25f }, Color::Blue, 2.5f);
+    recording_painter.fill_ellipse({ 120, 80, 60, 40 }, Color::Green);
+    recording_painter.draw_ellipse({ 110, 70, 80, 60 }, Color::Black, 2);
+    recording_painter.fill_path(path, Color::Magenta, Gfx::Painter::WindingRule::Nonzero, { 5, 0 });
+    recording_painter.stroke_path(path, Color::Black, 1.5f, { 5, 0 });
+
+    auto expected = make_canvas();
+    Gfx::Painter painter(expected);
+    Gfx::AntiAliasingPainter aa_painter(painter);
+    aa_painter.fill_rect_with_rounded_corners({ 10, 10, 80, 50 }, Color::Red, { 10, 10 }, { 20, 5 }, { 0, 0 }, { 15, 15 });
+    aa_painter.draw_line({ 100.5f, 10.0f }, { 190.0f, 70.25f }, Color::Blue, 2.5f);
+    aa_painter.fill_ellipse({ 120, 80, 60, 40 }, Color::Green);
+    aa_painter.draw_ellipse({ 110, 70, 80, 60 }, Color::Black, 2);
+    aa_painter.translate(5, 0);
+    aa_painter.fill_path(path, Color::Magenta, Gfx::Painter::WindingRule::Nonzero);
+    aa_painter.stroke_path(path, Color::Black, 1.5f);
+
+    EXPECT(replay(display_list)->visually_equals(*expected));
+}
+
+TEST_CASE(replay_paints_text_like_a_painter)
+{
+    auto font = MUST(TTF::Font::try_load_from_file("/res/fonts/LiberationSerif-Regular.ttf"));
+    auto scaled_font = adopt_ref(*new Gfx::ScaledFont(font, 14, 14));
+    auto text = "The quick brown fox jumps over the lazy dog."sv;
+
+    Web::Painting::DisplayList display_list;
+    Web::Painting::RecordingPainter recording_painter(display_list, { {}, canvas_size });
+    recording_painter.draw_text_run({ 5.25f, 25.0f }, Utf8View(text), *scaled_font, Color::Black);
+    recording_painter.draw_text_run({ 5.0f, 60.0f }, Utf8View(""sv), *scaled_font, Color::Black);
+    EXPECT_EQ(display_list.command_count(), 1u);
+
+    auto expected = make_canvas();
+    Gfx::Painter painter(expected);
+    painter.draw_text_run({ 5.25f, 25.0f }, Utf8View(text), *scaled_font, Color::Black);
+
+    // The font caches the laid out run, so the second replay takes another path than the first one.
+    EXPECT(replay(display_list)->visually_equals(*expected));
+    EXPECT(replay(display_list)->visually_equals(*expected));
+}
+
+TEST_CASE(replay_at_another_scroll_offset)
+{
+    auto record = [](Web::Painting::DisplayList& display_list) {
+        Web::Painting::RecordingPainter recording_painter(display_list, { {}, canvas_size });
+        recording_painter.save();
+        recording_painter.apply_scroll_offset({ 0, 20 });
+        recording_painter.fill_rect({ 10, 40, 30, 30 }, Color::Red);
+        recording_painter.save();
+        // Fixed position content stays where it is, however far the page was scrolled.
+        recording_painter.reset_translation();
+        recording_painter.fill_rect({ 100, 10, 30, 30 }, Color::Blue);
+        recording_painter.restore();
+        recording_painter.restore();
+    };
+
+    Web::Painting::DisplayList display_list;
+    record(display_list);
+    EXPECT(display_list.has_fixed_position_content());
+    EXPECT(!display_list.depends_on_scroll_offset());
+
+    auto paint_expected = [](int scroll_offset) {
+        auto expected = make_canvas();
+        Gfx::Painter painter(expected);
+        painter.fill_rect({ 10, 40 - scroll_offset, 30, 30 }, Color::Red);
+        painter.fill_rect({ 100, 10, 30, 30 }, Color::Blue);
+        return expected;
+    };
+
+    EXPECT(replay(display_list)->visually_equals(*paint_expected(20)));
+    EXPECT(replay(display_list, Gfx::IntPoint { 0, 20 })->visually_equals(*paint_expected(20)));
+    EXPECT(replay(display_list, Gfx::IntPoint { 0, 0 })->visually_equals(*paint_expected(0)));
+    EXPECT(replay(display_list, Gfx::IntPoint { 0, 60 })->visually_equals(*paint_expected(60)));
+}
+
+TEST_CASE(replay_layer)
+{
+    auto contents = make<Web::Painting::DisplayList>();
+    {
+        Web::Painting::RecordingPainter layer_painter(*contents, { 20, 20, 60, 60 });
+        layer_painter.fill_rect({ 20, 20, 60, 60 }, Color::Black);
+    }
+
+    Web::Painting::DisplayList display_list;
+    Web::Painting::RecordingPainter recording_painter(display_list, { {}, canvas_size });
+    recording_painter.draw_layer(move(contents), { 20, 20, 60, 60 }, {}, { 50, 50 }, 0.5f);
+
+    // The layer is composited onto what's below it, at half opacity.
+    auto bitmap = replay(display_list);
+    auto color = bitmap->get_pixel(50, 50);
+    EXPECT(color.red() > 100 && color.red() < 155);
+    EXPECT_EQ(color.red(), color.green());
+    EXPECT_EQ(color.red(), color.blue());
+    EXPECT_EQ(bitmap->get_pixel(10, 10), Color(Color::White));
+    EXPECT_EQ(bitmap->get_pixel(90, 50), Color(Color::White));
+}
+
+TEST_CASE(replay_runs_callbacks_every_time)
+{
+    size_t call_count = 0;
+    Web::Painting::DisplayList display_list;
+    Web::Painting::RecordingPainter recording_painter(display_list, { {}, canvas_size });
+    recording_painter.fill_rect({ 0, 0, 100, 100 }, Color::Red);
+    recording_painter.paint_with_painter("invert"sv, [&](Gfx::Painter& painter) {
+        ++call_count;
+        // Callbacks see what has been painted before them.
+        painter.fill_rect({ 0, 0, 10, 10 }, painter.target()->get_pixel(50, 50).inverted());
+    });
+    EXPECT_EQ(call_count, 0u);
+
+    auto bitmap = replay(display_list);
+    EXPECT_EQ(call_count, 1u);
+    EXPECT_EQ(bitmap->get_pixel(5, 5), Color(Color::Red).inverted());
+
+    (void)replay(display_list);
+    EXPECT_EQ(call_count, 2u);
+}
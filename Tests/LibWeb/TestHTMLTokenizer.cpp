@@ -76,6 +76,28 @@ static Vector<Token> run_tokenizer(StringView input)
     return tokens;
 }
 
+static Vector<Token> run_tokenizer_on_chunks(StringView input, size_t chunk_size)
+{
+    Vector<Token> tokens;
+    Tokenizer tokenizer;
+    tokenizer.set_input_is_streamed();
+    auto take_available_tokens = [&] {
+        while (true) {
+            auto maybe_token = tokenizer.next_token();
+            if (!maybe_token.has_value())
+                break;
+            tokens.append(maybe_token.release_value());
+        }
+    };
+    for (size_t offset = 0; offset < input.length(); offset += chunk_size) {
+        tokenizer.append_input(input.substring_view(offset, min(chunk_size, input.length() - offset)));
+        take_available_tokens();
+    }
+    tokenizer.insert_eof();
+    take_available_tokens();
+    return tokens;
+}
+
 // FIXME: It's not very nice to rely on the format of HTMLToken::to_string() to stay the same.
 static u32 hash_tokens(Vector<Token> const& tokens)
 {
@@ -197,6 +219,25 @@ TEST_CASE(doctype)
     EXPECT_END_TAG_TOKEN(html);
 }
 
+TEST_CASE(unconsumed_input)
+{
+    Tokenizer tokenizer { "<p><script src=a.js></script>"sv, "UTF-8"sv };
+    EXPECT_EQ(tokenizer.unconsumed_input(), "<p><script src=a.js></script>"sv);
+
+    auto token = tokenizer.next_token();
+    EXPECT(token.has_value());
+    EXPECT_EQ(token->tag_name(), "p");
+    EXPECT_EQ(tokenizer.unconsumed_input(), "<script src=a.js></script>"sv);
+}
+
+TEST_CASE(streamed_input)
+{
+    auto input = "<!DOCTYPE html>\r\n<p class=\"a&amp;b\" id=x>caf&eacute; &notin &CounterClockwiseContourIntegral;</p><!-- comment --><script>if (a </b) {}</script>\r"sv;
+    auto expected_hash = hash_tokens(run_tokenizer(input));
+    for (size_t chunk_size = 1; chunk_size <= 8; ++chunk_size)
+        EXPECT_EQ(hash_tokens(run_tokenizer_on_chunks(input, chunk_size)), expected_hash);
+}
+
 // NOTE: This relies on the format of HTMLToken::to_string() staying the same.
 //       If that changes, or something is added to the test HTML, the hash needs to be adjusted.
 TEST_CASE(regression)
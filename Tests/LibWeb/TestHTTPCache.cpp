@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <LibWeb/Loader/HTTPCache.h>
+#include <LibWeb/Loader/LoadRequest.h>
+#include <stdlib.h>
+#include <time.h>
+
+using ResponseHeaders = HashMap<String, String, CaseInsensitiveStringTraits>;
+
+static Web::HTTPCache& cache()
+{
+    auto& cache = Web::HTTPCache::the();
+    if (!cache.is_enabled()) {
+        char directory[] = "/tmp/http-cache-test.XXXXXX";
+        VERIFY(mkdtemp(directory));
+        cache.set_directory(directory);
+    }
+    return cache;
+}
+
+static Web::LoadRequest request_for(StringView path)
+{
+    Web::LoadRequest request;
+    request.set_url(String::formatted("http://example.com/{}", path));
+    return request;
+}
+
+// Formats a time relative to now as an IMF-fixdate, e.g. "Sun, 06 Nov 1994 08:49:37 GMT".
+static String http_date(i64 seconds_from_now)
+{
+    time_t timestamp = time(nullptr) + seconds_from_now;
+    struct tm tm;
+    gmtime_r(&timestamp, &tm);
+    char buffer[64];
+    VERIFY(strftime(buffer, sizeof(buffer), "%a, %d %b %Y %H:%M:%S GMT", &tm));
+    return buffer;
+}
+
+// Stores a response for the path and returns what the cache makes of it.
+static StringView store_and_look_up(StringView path, ResponseHeaders const& response_headers, Web::LoadRequest const* lookup_request = nullptr)
+{
+    auto request = request_for(path);
+    cache().store(request, time(nullptr), 200, response_headers, "body"sv.bytes());
+    auto entry = cache().lookup(lookup_request ? *lookup_request : request);
+    if (!entry.has_value())
+        return "not stored"sv;
+    return entry->is_fresh() ? "fresh"sv : "stale"sv;
+}
+
+TEST_CASE(fresh_response_is_served_from_cache)
+{
+    auto request = request_for("fresh"sv);
+    ResponseHeaders headers;
+    headers.set("Cache-Control", "public, max-age=3600");
+    headers.set("Content-Type", "text/plain");
+    cache().store(request, time(nullptr), 200, headers, "Hello, cache!"sv.bytes());
+
+    auto entry = cache().lookup(request);
+    EXPECT(entry.has_value());
+    EXPECT(entry->is_fresh());
+    EXPECT_EQ(entry->status_code(), 200u);
+    EXPECT_EQ(StringView { entry->body() }, "Hello, cache!"sv);
+    EXPECT_EQ(entry->response_headers().get("content-type"sv).value_or({}), "text/plain");
+
+    EXPECT(!cache().lookup(request_for("never-stored"sv)).has_value());
+}
+
+TEST_CASE(freshness_lifetime)
+{
+    auto headers = [](std::initializer_list<Array<String, 2>> list) {
+        ResponseHeaders headers;
+        headers.set("Date", http_date(0));
+        for (auto& header : list)
+            headers.set(header[0], header[1]);
+        return headers;
+    };
+
+    EXPECT_EQ(store_and_look_up("max-age"sv, headers({ { "Cache-Control", "max-age=60" } })), "fresh"sv);
+    EXPECT_EQ(store_and_look_up("max-age-zero"sv, headers({ { "Cache-Control", "max-age=0" } })), "stale"sv);
+    EXPECT_EQ(store_and_look_up("max-age-quoted"sv, headers({ { "Cache-Control", "max-age=\"60\"" } })), "fresh"sv);
+    EXPECT_EQ(store_and_look_up("no-cache"sv, headers({ { "Cache-Control", "no-cache, max-age=60" } })), "stale"sv);
+
+    // max-age takes precedence over Expires.
+    EXPECT_EQ(store_and_look_up("max-age-and-expires"sv, headers({ { "Cache-Control", "max-age=0" }, { "Expires", http_date(3600) } })), "stale"sv);
+    EXPECT_EQ(store_and_look_up("expires"sv, headers({ { "Expires", http_date(3600) } })), "fresh"sv);
+    EXPECT_EQ(store_and_look_up("expired"sv, headers({ { "Expires", http_date(-3600) } })), "stale"sv);
+    EXPECT_EQ(store_and_look_up("invalid-expires"sv, headers({ { "Expires", "0" } })), "stale"sv);
+
+    // Without explicit expiration, the response stays fresh for 10% of the time since it was last modified.
+    EXPECT_EQ(store_and_look_up("heuristic"sv, headers({ { "Last-Modified", http_date(-100 * 86400) } })), "fresh"sv);
+    EXPECT_EQ(store_and_look_up("heuristic-just-modified"sv, headers({ { "Last-Modified", http_date(0) } })), "stale"sv);
+
+    // The age reported by an upstream cache counts against the freshness lifetime.
+    EXPECT_EQ(store_and_look_up("age"sv, headers({ { "Cache-Control", "max-age=60" }, { "Age", "30" } })), "fresh"sv);
+    EXPECT_EQ(store_and_look_up("too-old"sv, headers({ { "Cache-Control", "max-age=60" }, { "Age", "120" } })), "stale"sv);
+    // So does a Date header in the past.
+    auto old_response = headers({ { "Cache-Control", "max-age=60" } });
+    old_response.set("Date", http_date(-120));
+    EXPECT_EQ(store_and_look_up("old-date"sv, old_response), "stale"sv);
+}
+
+TEST_CASE(request_can_ask_for_revalidation)
+{
+    ResponseHeaders headers;
+    headers.set("Cache-Control", "max-age=3600");
+
+    auto request = request_for("request-no-cache"sv);
+    request.set_header("Cache-Control", "no-cache");
+    EXPECT_EQ(store_and_look_up("request-no-cache"sv, headers, &request), "stale"sv);
+
+    auto pragma_request = request_for("request-no-cache"sv);
+    pragma_request.set_header("Pragma", "no-cache");
+    EXPECT_EQ(store_and_look_up("request-no-cache"sv, headers, &pragma_request), "stale"sv);
+}
+
+TEST_CASE(responses_that_are_not_stored)
+{
+    auto headers = [](StringView name, StringView value) {
+        ResponseHeaders headers;
+        headers.set("Cache-Control", "max-age=3600");
+        headers.set(name, value);
+        return headers;
+    };
+
+    EXPECT_EQ(store_and_look_up("no-store"sv, headers("Cache-Control"sv, "no-store, max-age=3600"sv)), "not stored"sv);
+    EXPECT_EQ(store_and_look_up("set-cookie"sv, headers("Set-Cookie"sv, "a=b"sv)), "not stored"sv);
+    EXPECT_EQ(store_and_look_up("vary"sv, headers("Vary"sv, "Accept-Encoding, User-Agent"sv)), "not stored"sv);
+    EXPECT_EQ(store_and_look_up("vary-accept-encoding"sv, headers("Vary"sv, "accept-encoding"sv)), "fresh"sv);
+
+    // Without explicit expiration or a validator, a response could never be reused.
+    EXPECT_EQ(store_and_look_up("no-validators"sv, ResponseHeaders {}), "not stored"sv);
+
+    auto request = request_for("not-found"sv);
+    cache().store(request, time(nullptr), 404, headers("ETag"sv, "\"x\""sv), "body"sv.bytes());
+    EXPECT(!cache().lookup(request).has_value());
+}
+
+TEST_CASE(requests_that_bypass_the_cache)
+{
+    EXPECT(cache().can_use_cache_for(request_for("plain"sv)));
+
+    auto post = request_for("post"sv);
+    post.set_method("POST");
+    EXPECT(!cache().can_use_cache_for(post));
+
+    auto range = request_for("range"sv);
+    range.set_header("Range", "bytes=0-10");
+    EXPECT(!cache().can_use_cache_for(range));
+
+    auto conditional = request_for("conditional"sv);
+    conditional.set_header("If-None-Match", "\"x\"");
+    EXPECT(!cache().can_use_cache_for(conditional));
+
+    auto no_store = request_for("no-store"sv);
+    no_store.set_header("Cache-Control", "no-store");
+    EXPECT(!cache().can_use_cache_for(no_store));
+
+    Web::LoadRequest file;
+    file.set_url("file:///etc/passwd"sv);
+    EXPECT(!cache().can_use_cache_for(file));
+}
+
+TEST_CASE(revalidation)
+{
+    auto request = request_for("revalidation"sv);
+    ResponseHeaders headers;
+    headers.set("Cache-Control", "max-age=0");
+    headers.set("ETag", "\"version-1\"");
+    headers.set("Last-Modified", http_date(-86400));
+    cache().store(request, time(nullptr), 200, headers, "Stored body"sv.bytes());
+
+    auto entry = cache().lookup(request);
+    EXPECT(entry.has_value());
+    EXPECT(!entry->is_fresh());
+
+    HashMap<String, String> request_headers;
+    cache().add_revalidation_headers(*entry, request_headers);
+    EXPECT_EQ(request_headers.get("If-None-Match").value_or({}), "\"version-1\"");
+    EXPECT_EQ(request_headers.get("If-Modified-Since").value_or({}), headers.get("Last-Modified"sv).value_or({}));
+
+    // A 304 response refreshes the stored headers, except the ones that describe the body, which stays as it was.
+    ResponseHeaders not_modified_headers;
+    not_modified_headers.set("Cache-Control", "max-age=3600");
+    not_modified_headers.set("Content-Length", "0");
+    cache().did_revalidate(*entry, time(nullptr), not_modified_headers);
+
+    auto revalidated_entry = cache().lookup(request);
+    EXPECT(revalidated_entry.has_value());
+    EXPECT(revalidated_entry->is_fresh());
+    EXPECT_EQ(StringView { revalidated_entry->body() }, "Stored body"sv);
+    EXPECT_EQ(revalidated_entry->response_headers().get("ETag"sv).value_or({}), "\"version-1\"");
+    EXPECT(!revalidated_entry->response_headers().contains("Content-Length"sv));
+}
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <LibGfx/Bitmap.h>
+#include <LibWeb/Painting/BorderRadiusCornerClipper.h>
+#include <LibWeb/Painting/DisplayList.h>
+#include <LibWeb/Painting/RecordingPainter.h>
+#include <LibWeb/Painting/TileCache.h>
+
+static Gfx::IntRect const page_rect { 0, 0, 1024, 8192 };
+static Gfx::IntSize const viewport_size { 300, 200 };
+
+// A page filled with one color, so it's easy to tell which display list a tile was rasterized from.
+static NonnullOwnPtr<Web::Painting::DisplayList> page_filled_with(Color color)
+{
+    auto display_list = make<Web::Painting::DisplayList>();
+    Web::Painting::RecordingPainter painter(*display_list, page_rect);
+    painter.fill_rect(page_rect, color);
+    return display_list;
+}
+
+static NonnullRefPtr<Gfx::Bitmap> paint(Web::Painting::TileCache& tile_cache, Web::Painting::DisplayList const& display_list, Gfx::IntPoint scroll_offset = {}, int scale = 1)
+{
+    auto target = MUST(Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, viewport_size, scale));
+    tile_cache.paint(display_list, { scroll_offset, viewport_size }, target, Color::White);
+    return target;
+}
+
+TEST_CASE(tiles_are_kept_until_invalidated)
+{
+    Web::Painting::TileCache tile_cache;
+    auto red_page = page_filled_with(Color::Red);
+    auto blue_page = page_filled_with(Color::Blue);
+
+    auto bitmap = paint(tile_cache, *red_page);
+    EXPECT_EQ(tile_cache.tile_count(), 2u);
+    EXPECT_EQ(bitmap->get_pixel(10, 10), Color(Color::Red));
+    EXPECT_EQ(bitmap->get_pixel(290, 10), Color(Color::Red));
+
+    // Nothing was invalidated, so the tiles that were already rasterized are used as they are.
+    bitmap = paint(tile_cache, *blue_page);
+    EXPECT_EQ(bitmap->get_pixel(10, 10), Color(Color::Red));
+    EXPECT_EQ(bitmap->get_pixel(290, 10), Color(Color::Red));
+
+    // Only the tile the invalidated rect is in is rasterized again.
+    tile_cache.invalidate({ 10, 10, 5, 5 });
+    EXPECT_EQ(tile_cache.tile_count(), 1u);
+    bitmap = paint(tile_cache, *blue_page);
+    EXPECT_EQ(bitmap->get_pixel(10, 10), Color(Color::Blue));
+    EXPECT_EQ(bitmap->get_pixel(290, 10), Color(Color::Red));
+
+    // A rect across the edge of two tiles invalidates both of them.
+    tile_cache.invalidate({ Web::Painting::TileCache::tile_size - 5, 0, 10, 10 });
+    EXPECT_EQ(tile_cache.tile_count(), 0u);
+    bitmap = paint(tile_cache, *red_page);
+    EXPECT_EQ(bitmap->get_pixel(10, 10), Color(Color::Red));
+    EXPECT_EQ(bitmap->get_pixel(290, 10), Color(Color::Red));
+
+    tile_cache.clear();
+    EXPECT_EQ(tile_cache.tile_count(), 0u);
+    bitmap = paint(tile_cache, *blue_page);
+    EXPECT_EQ(bitmap->get_pixel(10, 10), Color(Color::Blue));
+}
+
+TEST_CASE(scrolling_only_rasterizes_exposed_tiles)
+{
+    Web::Painting::TileCache tile_cache;
+    auto red_page = page_filled_with(Color::Red);
+    auto blue_page = page_filled_with(Color::Blue);
+
+    (void)paint(tile_cache, *red_page);
+
+    // Scrolling down by a bit more than a tile exposes the second row of tiles, and keeps the first one.
+    auto scroll_offset = Gfx::IntPoint { 0, 300 };
+    auto bitmap = paint(tile_cache, *blue_page, scroll_offset);
+    EXPECT_EQ(tile_cache.tile_count(), 4u);
+    EXPECT_EQ(bitmap->get_pixel(10, 10), Color(Color::Blue));
+
+    bitmap = paint(tile_cache, *blue_page);
+    EXPECT_EQ(bitmap->get_pixel(10, 10), Color(Color::Red));
+    EXPECT_EQ(bitmap->get_pixel(10, 199), Color(Color::Red));
+
+    // Tiles far away from what's visible are thrown out.
+    bitmap = paint(tile_cache, *blue_page, { 0, 5000 });
+    EXPECT_EQ(tile_cache.tile_count(), 4u);
+    bitmap = paint(tile_cache, *blue_page);
+    EXPECT_EQ(bitmap->get_pixel(10, 10), Color(Color::Blue));
+}
+
+TEST_CASE(tiles_are_painted_at_their_place_in_the_document)
+{
+    auto display_list = make<Web::Painting::DisplayList>();
+    {
+        Web::Painting::RecordingPainter painter(*display_list, page_rect);
+        painter.apply_scroll_offset({});
+        // This straddles the corner of four tiles.
+        painter.fill_rect({ 250, 250, 12, 12 }, Color::Green);
+        painter.fill_rect({ 20, 520, 10, 10 }, Color::Blue);
+    }
+
+    Web::Painting::TileCache tile_cache;
+    auto bitmap = paint(tile_cache, *display_list, { 0, 200 });
+    for (int y = 50; y < 62; ++y) {
+        for (int x = 250; x < 262; ++x)
+            EXPECT_EQ(bitmap->get_pixel(x, y), Color(Color::Green));
+    }
+    EXPECT_EQ(bitmap->get_pixel(249, 50), Color(Color::White));
+    EXPECT_EQ(bitmap->get_pixel(262, 61), Color(Color::White));
+
+    bitmap = paint(tile_cache, *display_list, { 10, 500 });
+    EXPECT_EQ(bitmap->get_pixel(10, 20), Color(Color::Blue));
+    EXPECT_EQ(bitmap->get_pixel(9, 20), Color(Color::White));
+}
+
+TEST_CASE(fixed_position_content_discards_all_tiles)
+{
+    auto display_list = make<Web::Painting::DisplayList>();
+    {
+        Web::Painting::RecordingPainter painter(*display_list, page_rect);
+        painter.save();
+        painter.apply_scroll_offset({});
+        painter.fill_rect({ 0, 100, 50, 50 }, Color::Red);
+        painter.reset_translation();
+        painter.fill_rect({ 200, 0, 20, 20 }, Color::Blue);
+        painter.restore();
+    }
+
+    Web::Painting::TileCache tile_cache;
+    auto bitmap = paint(tile_cache, *display_list);
+    EXPECT_EQ(bitmap->get_pixel(210, 10), Color(Color::Blue));
+    EXPECT_EQ(bitmap->get_pixel(10, 110), Color(Color::Red));
+
+    // The fixed position box stays in the viewport, so no tile painted before the scroll can be used.
+    bitmap = paint(tile_cache, *display_list, { 0, 100 });
+    EXPECT_EQ(bitmap->get_pixel(210, 10), Color(Color::Blue));
+    EXPECT_EQ(bitmap->get_pixel(210, 110), Color(Color::White));
+    EXPECT_EQ(bitmap->get_pixel(10, 10), Color(Color::Red));
+
+    // Neither can any tile once something was invalidated, wherever it was.
+    EXPECT_NE(tile_cache.tile_count(), 0u);
+    tile_cache.invalidate({ 1000, 8000, 1, 1 });
+    EXPECT_EQ(tile_cache.tile_count(), 0u);
+}
+
+TEST_CASE(changing_the_scale_discards_all_tiles)
+{
+    Web::Painting::TileCache tile_cache;
+    auto red_page = page_filled_with(Color::Red);
+    auto blue_page = page_filled_with(Color::Blue);
+
+    (void)paint(tile_cache, *red_page);
+    auto bitmap = paint(tile_cache, *blue_page, {}, 2);
+    EXPECT_EQ(bitmap->get_pixel(20, 20), Color(Color::Blue));
+    EXPECT_EQ(bitmap->get_pixel(580, 20), Color(Color::Blue));
+}
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/JsonValue.h>
+#include <LibWeb/TraceEvents.h>
+#include <math.h>
+#include <unistd.h>
+
+// NOTE: The recorder is shared by the whole process and keeps every event, so every test uses event names of its own.
+
+static Vector<JsonObject> recorded_events_named(StringView name)
+{
+    auto trace = MUST(JsonValue::from_string(Web::TraceEventRecorder::the().to_chrome_trace_json()));
+    Vector<JsonObject> events;
+    trace.as_object().get("traceEvents"sv).as_array().for_each([&](auto& event) {
+        if (event.as_object().get("name"sv).as_string() == name)
+            events.append(event.as_object());
+    });
+    return events;
+}
+
+// Splits the summary line for the event into its columns: name, category, count, total and self time.
+static Vector<String> summary_line_for(StringView name)
+{
+    auto summary = Web::TraceEventRecorder::the().summary();
+    for (auto line : summary.split_view('\n')) {
+        auto columns = line.split_view(' ');
+        if (!columns.is_empty() && columns[0] == name) {
+            Vector<String> result;
+            for (auto column : columns)
+                result.append(column);
+            return result;
+        }
+    }
+    return {};
+}
+
+static double summary_milliseconds(String const& column)
+{
+    return strtod(column.characters(), nullptr);
+}
+
+TEST_CASE(recording_is_disabled_by_default)
+{
+    auto& recorder = Web::TraceEventRecorder::the();
+    EXPECT(!recorder.is_enabled());
+
+    {
+        Web::ScopedTraceEvent trace_event("Disabled"sv, "test"sv);
+    }
+    EXPECT_EQ(recorder.event_count(), 0u);
+
+    // Events that start while recording is off aren't recorded, even if it's turned on before they end.
+    {
+        Web::ScopedTraceEvent trace_event("StartedWhileDisabled"sv, "test"sv);
+        recorder.set_enabled(true);
+    }
+    recorder.set_enabled(false);
+    EXPECT_EQ(recorder.event_count(), 0u);
+}
+
+TEST_CASE(chrome_trace_json)
+{
+    auto& recorder = Web::TraceEventRecorder::the();
+    recorder.set_enabled(true);
+    {
+        Web::ScopedTraceEvent outer_event("JsonOuter"sv, "parse"sv);
+        usleep(1000);
+        {
+            Web::ScopedTraceEvent inner_event("JsonInner"sv, "script"sv, "inner.js");
+            usleep(5000);
+        }
+    }
+    recorder.set_enabled(false);
+    EXPECT_EQ(recorder.event_count(), 2u);
+
+    auto outer_events = recorded_events_named("JsonOuter"sv);
+    auto inner_events = recorded_events_named("JsonInner"sv);
+    EXPECT_EQ(outer_events.size(), 1u);
+    EXPECT_EQ(inner_events.size(), 1u);
+    auto const& outer = outer_events.first();
+    auto const& inner = inner_events.first();
+
+    EXPECT_EQ(outer.get("cat"sv).as_string(), "parse");
+    EXPECT_EQ(outer.get("ph"sv).as_string(), "X");
+    EXPECT(!outer.has("args"sv));
+    EXPECT_EQ(inner.get("cat"sv).as_string(), "script");
+    EXPECT_EQ(inner.get("args"sv).as_object().get("detail"sv).as_string(), "inner.js");
+
+    // The inner event lies within the outer one.
+    auto outer_start = outer.get("ts"sv).to_i64();
+    auto outer_end = outer_start + outer.get("dur"sv).to_i64();
+    auto inner_start = inner.get("ts"sv).to_i64();
+    auto inner_end = inner_start + inner.get("dur"sv).to_i64();
+    EXPECT(outer_start >= 0);
+    EXPECT(inner.get("dur"sv).to_i64() >= 5000);
+    EXPECT(inner_start >= outer_start);
+    EXPECT(inner_end <= outer_end);
+}
+
+TEST_CASE(summary_counts_self_time_and_recursion)
+{
+    auto& recorder = Web::TraceEventRecorder::the();
+    recorder.set_enabled(true);
+    {
+        Web::ScopedTraceEvent parent_event("SummaryParent"sv, "layout"sv);
+        Web::ScopedTraceEvent recursive_event("SummaryRecursive"sv, "style"sv);
+        usleep(2000);
+        {
+            Web::ScopedTraceEvent nested_recursive_event("SummaryRecursive"sv, "style"sv);
+            usleep(2000);
+            {
+                Web::ScopedTraceEvent innermost_recursive_event("SummaryRecursive"sv, "style"sv);
+                usleep(2000);
+            }
+        }
+    }
+    recorder.set_enabled(false);
+
+    auto recursive_events = recorded_events_named("SummaryRecursive"sv);
+    EXPECT_EQ(recursive_events.size(), 3u);
+    i64 outermost_duration = 0;
+    i64 sum_of_durations = 0;
+    for (auto& event : recursive_events) {
+        outermost_duration = max(outermost_duration, event.get("dur"sv).to_i64());
+        sum_of_durations += event.get("dur"sv).to_i64();
+    }
+
+    auto recursive_line = summary_line_for("SummaryRecursive"sv);
+    EXPECT_EQ(recursive_line.size(), 5u);
+    EXPECT_EQ(recursive_line[1], "style");
+    EXPECT_EQ(recursive_line[2], "3");
+    // Time spent in the nested calls is only counted once, and all of it is spent in this event itself.
+    auto total = summary_milliseconds(recursive_line[3]);
+    auto self = summary_milliseconds(recursive_line[4]);
+    EXPECT(fabs(total - outermost_duration / 1000.0) < 0.0015);
+    EXPECT(fabs(self - total) < 0.0035);
+    EXPECT(total * 1000 < sum_of_durations);
+
+    // The parent spends hardly any time of its own, since all it does is wait for its child.
+    auto parent_line = summary_line_for("SummaryParent"sv);
+    EXPECT_EQ(parent_line.size(), 5u);
+    EXPECT_EQ(parent_line[2], "1");
+    auto parent_total = summary_milliseconds(parent_line[3]);
+    auto parent_self = summary_milliseconds(parent_line[4]);
+    EXPECT(parent_total >= total);
+    EXPECT(parent_self < 1.0);
+    EXPECT(fabs(parent_total - parent_self - total) < 0.0025);
+}
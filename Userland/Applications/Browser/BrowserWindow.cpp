@@ -335,6 +335,16 @@ void BrowserWindow::build_menus()
             active_tab().view().debug_request("dump-style-sheets");
         },
         this));
+    debug_menu.add_action(GUI::Action::create(
+        "Dump Style Sharing Statistics", [this](auto&) {
+            active_tab().view().debug_request("dump-style-sharing-statistics");
+        },
+        this));
+    debug_menu.add_action(GUI::Action::create(
+        "Dump HTTP Cache Statistics", [this](auto&) {
+            active_tab().view().debug_request("dump-http-cache-statistics");
+        },
+        this));
     debug_menu.add_action(GUI::Action::create("Dump &History", { Mod_Ctrl, Key_H }, g_icon_bag.history, [this](auto&) {
         active_tab().m_history.dump();
     }));
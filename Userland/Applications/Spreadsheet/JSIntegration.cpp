@@ -96,6 +96,7 @@ SheetGlobalObject::SheetGlobalObject(JS::Realm& realm, Sheet& sheet)
     : JS::GlobalObject(realm)
     , m_sheet(sheet)
 {
+    set_has_exotic_property_access();
 }
 
 JS::ThrowCompletionOr<bool> SheetGlobalObject::internal_has_property(JS::PropertyKey const& name) const
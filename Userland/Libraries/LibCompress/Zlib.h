@@ -47,6 +47,9 @@ public:
     Optional<ByteBuffer> decompress();
     u32 checksum();
 
+    // The deflate stream inside the zlib container, e.g. to decompress it piece by piece with a DeflateDecompressor.
+    ReadonlyBytes deflate_data() const { return m_data_bytes; }
+
     static Optional<Zlib> try_create(ReadonlyBytes data);
     static Optional<ByteBuffer> decompress_all(ReadonlyBytes);
 
@@ -12,12 +12,14 @@
 #include <AK/StringBuilder.h>
 #include <LibCore/DirIterator.h>
 #include <LibCore/File.h>
+#include <LibCore/MappedFile.h>
 #include <LibCore/StandardPaths.h>
 #include <LibGUI/AbstractView.h>
 #include <LibGUI/FileIconProvider.h>
 #include <LibGUI/FileSystemModel.h>
 #include <LibGUI/Painter.h>
 #include <LibGfx/Bitmap.h>
+#include <LibGfx/ImageDecoder.h>
 #include <LibThreading/BackgroundAction.h>
 #include <grp.h>
 #include <pwd.h>
@@ -633,7 +635,15 @@ static HashMap<String, RefPtr<Gfx::Bitmap>> s_thumbnail_cache;
 
 static ErrorOr<NonnullRefPtr<Gfx::Bitmap>> render_thumbnail(StringView path)
 {
-    auto bitmap = TRY(Gfx::Bitmap::try_load_from_file(path));
+    auto file = TRY(Core::MappedFile::map(path));
+    auto decoder = Gfx::ImageDecoder::try_create(file->bytes());
+    if (!decoder)
+        return Error::from_string_literal("Unable to find a decoder for the image");
+    // Thumbnails are tiny, so let the decoder skip work where it can (e.g. by decoding a large JPEG at 1/8 of its size).
+    auto frame = TRY(decoder->frame(0, Gfx::IntSize { 32, 32 }));
+    if (!frame.image)
+        return Error::from_string_literal("Unable to decode the image");
+    auto bitmap = frame.image.release_nonnull();
     auto thumbnail = TRY(Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRA8888, { 32, 32 }));
 
     double scale = min(32 / (double)bitmap->width(), 32 / (double)bitmap->height());
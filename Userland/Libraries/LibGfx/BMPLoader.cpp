@@ -1353,7 +1353,7 @@ size_t BMPImageDecoderPlugin::frame_count()
     return 1;
 }
 
-ErrorOr<ImageFrameDescriptor> BMPImageDecoderPlugin::frame(size_t index)
+ErrorOr<ImageFrameDescriptor> BMPImageDecoderPlugin::frame(size_t index, Optional<IntSize>)
 {
     if (index > 0)
         return Error::from_string_literal("BMPImageDecoderPlugin: Invalid frame index");
@@ -991,7 +991,7 @@ size_t DDSImageDecoderPlugin::frame_count()
     return 1;
 }
 
-ErrorOr<ImageFrameDescriptor> DDSImageDecoderPlugin::frame(size_t index)
+ErrorOr<ImageFrameDescriptor> DDSImageDecoderPlugin::frame(size_t index, Optional<IntSize>)
 {
     if (index > 0)
         return Error::from_string_literal("DDSImageDecoderPlugin: Invalid frame index");
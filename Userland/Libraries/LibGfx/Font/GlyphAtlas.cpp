@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/Font/GlyphAtlas.h>
+
+namespace Gfx {
+
+// Glyphs are packed into horizontal shelves, whose heights are rounded up so glyphs of similar height can share one.
+static constexpr int shelf_height_granularity = 4;
+
+GlyphAtlas& GlyphAtlas::the()
+{
+    static GlyphAtlas atlas;
+    return atlas;
+}
+
+Optional<u16> GlyphAtlas::page_index_of(Bitmap const& bitmap) const
+{
+    for (size_t i = 0; i < m_pages.size(); ++i) {
+        if (m_pages[i].bitmap.ptr() == &bitmap)
+            return static_cast<u16>(i);
+    }
+    return {};
+}
+
+Optional<GlyphAtlas::Location> GlyphAtlas::ensure(GlyphAtlasKey const& key, Function<RefPtr<Bitmap>()> rasterize_glyph)
+{
+    if (auto location = m_locations.get(key); location.has_value()) {
+        touch_page(location->page_index);
+        return location;
+    }
+
+    auto glyph_bitmap = rasterize_glyph();
+    if (!glyph_bitmap || glyph_bitmap->scale() != 1 || glyph_bitmap->format() != BitmapFormat::BGRA8888)
+        return {};
+    if (glyph_bitmap->width() > maximum_glyph_size || glyph_bitmap->height() > maximum_glyph_size)
+        return {};
+
+    auto location = allocate(glyph_bitmap->size());
+    if (!location.has_value())
+        return {};
+
+    auto& page = *m_pages[location->page_index].bitmap;
+    for (int y = 0; y < glyph_bitmap->height(); ++y)
+        __builtin_memcpy(page.scanline(location->rect.y() + y) + location->rect.x(), glyph_bitmap->scanline(y), glyph_bitmap->width() * sizeof(ARGB32));
+
+    m_locations.set(key, *location);
+    touch_page(location->page_index);
+    return location;
+}
+
+Optional<IntPoint> GlyphAtlas::allocate_in_page(Page& page, IntSize size)
+{
+    auto shelf_height = static_cast<int>(align_up_to(size.height(), shelf_height_granularity));
+    for (auto& shelf : page.shelves) {
+        if (shelf.height != shelf_height || shelf.used_width + size.width() > page_size)
+            continue;
+        IntPoint position { shelf.used_width, shelf.y };
+        shelf.used_width += size.width();
+        return position;
+    }
+
+    int next_shelf_y = page.shelves.is_empty() ? 0 : page.shelves.last().y + page.shelves.last().height;
+    if (next_shelf_y + shelf_height > page_size)
+        return {};
+    page.shelves.append({ next_shelf_y, shelf_height, size.width() });
+    return IntPoint { 0, next_shelf_y };
+}
+
+Optional<GlyphAtlas::Location> GlyphAtlas::allocate(IntSize size)
+{
+    for (size_t i = 0; i < m_pages.size(); ++i) {
+        if (auto position = allocate_in_page(m_pages[i], size); position.has_value())
+            return Location { static_cast<u16>(i), { *position, size } };
+    }
+
+    if (m_pages.size() < maximum_page_count) {
+        if (auto result = add_page(); result.is_error()) {
+            dbgln("GlyphAtlas: Failed to allocate a page: {}", result.error());
+            return {};
+        }
+    } else {
+        empty_least_recently_used_page();
+    }
+
+    // Either way, there's an empty page now, which every glyph we accept fits into.
+    for (size_t i = 0; i < m_pages.size(); ++i) {
+        if (m_pages[i].shelves.is_empty())
+            return Location { static_cast<u16>(i), { allocate_in_page(m_pages[i], size).release_value(), size } };
+    }
+    VERIFY_NOT_REACHED();
+}
+
+ErrorOr<void> GlyphAtlas::add_page()
+{
+    auto bitmap = TRY(Bitmap::try_create(BitmapFormat::BGRA8888, { page_size, page_size }));
+    bitmap->fill(Color::Transparent);
+    TRY(m_pages.try_append({ move(bitmap), {}, 0 }));
+    return {};
+}
+
+void GlyphAtlas::empty_least_recently_used_page()
+{
+    size_t least_recently_used_index = 0;
+    for (size_t i = 1; i < m_pages.size(); ++i) {
+        if (m_pages[i].last_used < m_pages[least_recently_used_index].last_used)
+            least_recently_used_index = i;
+    }
+
+    auto& page = m_pages[least_recently_used_index];
+    page.bitmap->fill(Color::Transparent);
+    page.shelves.clear();
+    m_locations.remove_all_matching([&](auto&, auto& location) {
+        return location.page_index == least_recently_used_index;
+    });
+    ++m_generation;
+}
+
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/BitCast.h>
+#include <AK/Function.h>
+#include <AK/HashMap.h>
+#include <AK/Optional.h>
+#include <AK/Traits.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/Font/VectorFont.h>
+#include <LibGfx/Rect.h>
+
+namespace Gfx {
+
+struct GlyphAtlasKey {
+    u64 font_id { 0 };
+    float x_scale { 0 };
+    float y_scale { 0 };
+    u32 glyph_id { 0 };
+    GlyphSubpixelOffset subpixel_offset;
+
+    bool operator==(GlyphAtlasKey const&) const = default;
+};
+
+}
+
+namespace AK {
+
+template<>
+struct Traits<Gfx::GlyphAtlasKey> : public GenericTraits<Gfx::GlyphAtlasKey> {
+    static unsigned hash(Gfx::GlyphAtlasKey const& key)
+    {
+        auto hash = pair_int_hash(u64_hash(key.font_id), key.glyph_id);
+        hash = pair_int_hash(hash, bit_cast<u32>(key.x_scale));
+        hash = pair_int_hash(hash, bit_cast<u32>(key.y_scale));
+        return pair_int_hash(hash, key.subpixel_offset.x);
+    }
+};
+
+}
+
+namespace Gfx {
+
+// Rasterized glyphs of all vector fonts, packed into a few large bitmaps ("pages") that are shared by everyone
+// drawing text in this process. Glyphs are drawn straight out of the pages, which keeps the number of bitmaps
+// (and their per-allocation overhead) small, and lets a run of text be blitted from one or two pages.
+// When all pages are full, the least recently used page is emptied to make room.
+//
+// Like the rest of the font machinery, this must only be used from one thread.
+class GlyphAtlas {
+public:
+    static GlyphAtlas& the();
+
+    static constexpr int page_size = 512;
+    // Not more than 8, so users can keep track of a set of pages in one byte.
+    static constexpr size_t maximum_page_count = 8;
+
+    // Glyphs larger than this aren't put into the atlas, as they'd waste too much of a page.
+    static constexpr int maximum_glyph_size = page_size / 4;
+
+    struct Location {
+        u16 page_index { 0 };
+        IntRect rect;
+    };
+
+    // Returns where the glyph is stored, calling rasterize_glyph() to get its pixels if it's not stored yet.
+    // Returns an empty Optional if the glyph couldn't be rasterized or is too large for the atlas.
+    Optional<Location> ensure(GlyphAtlasKey const&, Function<RefPtr<Bitmap>()> rasterize_glyph);
+
+    NonnullRefPtr<Bitmap> const& page(u16 index) const { return m_pages[index].bitmap; }
+    Optional<u16> page_index_of(Bitmap const&) const;
+
+    // Bumped whenever a page is emptied, which invalidates all Locations handed out before.
+    u64 generation() const { return m_generation; }
+
+    // Marks the page as used, for picking the page to empty when the atlas is full.
+    void touch_page(u16 index) { m_pages[index].last_used = ++m_use_counter; }
+
+private:
+    GlyphAtlas() = default;
+
+    struct Shelf {
+        int y { 0 };
+        int height { 0 };
+        int used_width { 0 };
+    };
+
+    struct Page {
+        NonnullRefPtr<Bitmap> bitmap;
+        Vector<Shelf> shelves;
+        u64 last_used { 0 };
+    };
+
+    Optional<Location> allocate(IntSize);
+    static Optional<IntPoint> allocate_in_page(Page&, IntSize);
+    ErrorOr<void> add_page();
+    void empty_least_recently_used_page();
+
+    Vector<Page> m_pages;
+    HashMap<GlyphAtlasKey, Location> m_locations;
+    u64 m_use_counter { 0 };
+    u64 m_generation { 0 };
+};
+
+}
@@ -4,12 +4,17 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/CharacterTypes.h>
 #include <AK/Utf32View.h>
 #include <AK/Utf8View.h>
+#include <LibGfx/Font/Emoji.h>
 #include <LibGfx/Font/ScaledFont.h>
 
 namespace Gfx {
 
+// When the cache of laid out runs gets this large, the runs that weren't used recently are dropped.
+static constexpr size_t maximum_glyph_run_cache_size = 1024;
+
 int ScaledFont::width(StringView view) const { return unicode_view_width(Utf8View(view)); }
 int ScaledFont::width(Utf8View const& view) const { return unicode_view_width(view); }
 int ScaledFont::width(Utf32View const& view) const { return unicode_view_width(view); }
@@ -44,17 +49,151 @@ RefPtr<Gfx::Bitmap> ScaledFont::rasterize_glyph(u32 glyph_id) const
     if (glyph_iterator != m_cached_glyph_bitmaps.end())
         return glyph_iterator->value;
 
-    auto glyph_bitmap = m_font->rasterize_glyph(glyph_id, m_x_scale, m_y_scale);
+    auto glyph_bitmap = m_font->rasterize_glyph(glyph_id, m_x_scale, m_y_scale, {});
     m_cached_glyph_bitmaps.set(glyph_id, glyph_bitmap);
     return glyph_bitmap;
 }
 
 Gfx::Glyph ScaledFont::glyph(u32 code_point) const
+{
+    return glyph(code_point, {});
+}
+
+Gfx::Glyph ScaledFont::glyph(u32 code_point, GlyphSubpixelOffset subpixel_offset) const
 {
     auto id = glyph_id_for_code_point(code_point);
-    auto bitmap = rasterize_glyph(id);
     auto metrics = glyph_metrics(id);
-    return Gfx::Glyph(bitmap, metrics.left_side_bearing, metrics.advance_width, metrics.ascender);
+
+    // We already know this one is too large for the atlas.
+    if (auto it = m_cached_glyph_bitmaps.find(id); it != m_cached_glyph_bitmaps.end())
+        return Gfx::Glyph(it->value, metrics.left_side_bearing, metrics.advance_width, metrics.ascender);
+
+    auto& atlas = GlyphAtlas::the();
+    RefPtr<Gfx::Bitmap> rasterized_bitmap;
+    auto location = atlas.ensure({ m_font->glyph_cache_id(), m_x_scale, m_y_scale, id, subpixel_offset }, [&] {
+        rasterized_bitmap = m_font->rasterize_glyph(id, m_x_scale, m_y_scale, subpixel_offset);
+        return rasterized_bitmap;
+    });
+    if (location.has_value())
+        return Gfx::Glyph(atlas.page(location->page_index), location->rect, metrics.left_side_bearing, metrics.advance_width, metrics.ascender);
+
+    // Large glyphs are drawn from a bitmap of their own, on whole pixels.
+    if (rasterized_bitmap && subpixel_offset.x == 0)
+        m_cached_glyph_bitmaps.set(id, rasterized_bitmap);
+    return Gfx::Glyph(rasterize_glyph(id), metrics.left_side_bearing, metrics.advance_width, metrics.ascender);
+}
+
+GlyphRun const& ScaledFont::glyph_run(Utf8View const& string, GlyphSubpixelOffset origin_offset) const
+{
+    auto& atlas = GlyphAtlas::the();
+    auto text = string.as_string();
+    auto hash = pair_int_hash(text.hash(), origin_offset.x);
+    auto it = m_glyph_run_cache.find(hash, [&](auto& entry) {
+        return entry.key.origin_offset == origin_offset && entry.key.text == text;
+    });
+
+    if (it == m_glyph_run_cache.end()) {
+        if (m_glyph_run_cache.size() >= maximum_glyph_run_cache_size) {
+            auto oldest_use_to_keep = m_glyph_run_use_counter - maximum_glyph_run_cache_size / 2;
+            m_glyph_run_cache.remove_all_matching([&](auto&, auto& run) {
+                return run->last_used < oldest_use_to_keep;
+            });
+        }
+        GlyphRunKey key { text, origin_offset };
+        m_glyph_run_cache.set(key, lay_out_glyph_run(string, origin_offset));
+        it = m_glyph_run_cache.find(key);
+    } else if (it->value->atlas_generation != atlas.generation()) {
+        it->value = lay_out_glyph_run(string, origin_offset);
+    } else {
+        // Keep the pages with the run's glyphs from being emptied while the run is still in use.
+        for (u16 page_index = 0; page_index < GlyphAtlas::maximum_page_count; ++page_index) {
+            if (it->value->atlas_page_mask & (1 << page_index))
+                atlas.touch_page(page_index);
+        }
+    }
+
+    auto& run = *it->value;
+    run.last_used = ++m_glyph_run_use_counter;
+    return run;
+}
+
+// NOTE: This picks and positions the glyphs like Gfx::Painter::draw_text_run() and draw_glyph_or_emoji() do for other fonts.
+NonnullOwnPtr<GlyphRun> ScaledFont::lay_out_glyph_run(Utf8View const& string, GlyphSubpixelOffset origin_offset, bool is_retry) const
+{
+    // FIXME: These should live somewhere else.
+    constexpr u32 text_variation_selector = 0xFE0E;
+    constexpr u32 emoji_variation_selector = 0xFE0F;
+    constexpr u32 regional_indicator_symbol_a = 0x1F1E6;
+    constexpr u32 regional_indicator_symbol_z = 0x1F1FF;
+
+    auto& atlas = GlyphAtlas::the();
+    auto run = make<GlyphRun>();
+    run->atlas_generation = atlas.generation();
+
+    float x = origin_offset.to_float();
+    float space_width = glyph_or_emoji_width(' ');
+    u32 last_code_point = 0;
+
+    for (auto code_point_iterator = string.begin(); code_point_iterator != string.end(); ++code_point_iterator) {
+        auto code_point = *code_point_iterator;
+        if (is_ascii_space(code_point) || code_point == 0xa0) {
+            x += space_width + glyph_spacing();
+            last_code_point = code_point;
+            continue;
+        }
+
+        // FIXME: this is probably not the real space taken for complex emojis
+        x += glyphs_horizontal_kerning(last_code_point, code_point);
+
+        auto initial_iterator = code_point_iterator;
+        auto next_code_point = code_point_iterator.peek(1);
+        auto code_point_is_regional_indicator = code_point >= regional_indicator_symbol_a && code_point <= regional_indicator_symbol_z;
+        auto font_contains_glyph = contains_glyph(code_point);
+        auto check_for_emoji = code_point_is_regional_indicator || next_code_point == emoji_variation_selector;
+
+        Gfx::Bitmap const* emoji = nullptr;
+        if (!font_contains_glyph || check_for_emoji)
+            emoji = Emoji::emoji_for_code_point_iterator(code_point_iterator);
+
+        if (emoji) {
+            IntRect destination_rect { static_cast<int>(floorf(x)), 0, pixel_size() * emoji->width() / emoji->height(), pixel_size() };
+            run->glyphs.append({ destination_rect, emoji, emoji->rect(), true });
+        } else {
+            int glyph_x = floorf(x);
+            int subpixel_x = roundf((x - glyph_x) * GlyphSubpixelOffset::steps_per_pixel);
+            if (subpixel_x == GlyphSubpixelOffset::steps_per_pixel) {
+                ++glyph_x;
+                subpixel_x = 0;
+            }
+            auto glyph = this->glyph(font_contains_glyph ? code_point : 0xFFFD, { static_cast<u8>(subpixel_x) });
+            if (auto bitmap = glyph.bitmap()) {
+                IntRect destination_rect { { glyph_x + glyph.left_bearing(), 0 }, glyph.bitmap_rect().size() };
+                run->glyphs.append({ destination_rect, bitmap, glyph.bitmap_rect(), false });
+                if (auto page_index = atlas.page_index_of(*bitmap); page_index.has_value())
+                    run->atlas_page_mask |= 1 << *page_index;
+            }
+        }
+
+        // If we didn't advance the iterator to consume an emoji sequence, discard one code point if it's a variation selector.
+        if (initial_iterator == code_point_iterator) {
+            auto next_code_point = code_point_iterator.peek(1);
+            if (next_code_point == text_variation_selector || next_code_point == emoji_variation_selector)
+                ++code_point_iterator;
+        }
+
+        x += glyph_or_emoji_width(code_point) + glyph_spacing();
+        last_code_point = code_point;
+    }
+
+    for (auto const& glyph : run->glyphs)
+        run->bounding_rect = run->bounding_rect.united(glyph.destination_rect);
+
+    // If adding the later glyphs to the atlas emptied the page of an earlier one, lay the run out again. That can only
+    // happen once in a row, as the pages that were just used are the last ones to be emptied.
+    // FIXME: Unless the run has more distinct glyphs than fit into the whole atlas.
+    if (run->atlas_generation != atlas.generation() && !is_retry)
+        return lay_out_glyph_run(string, origin_offset, true);
+    return run;
 }
 
 u8 ScaledFont::glyph_width(u32 code_point) const
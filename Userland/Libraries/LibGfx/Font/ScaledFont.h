@@ -7,8 +7,11 @@
 #pragma once
 
 #include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Utf8View.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/Font/Font.h>
+#include <LibGfx/Font/GlyphAtlas.h>
 #include <LibGfx/Font/VectorFont.h>
 
 #define POINTS_PER_INCH 72.0f
@@ -16,6 +19,49 @@
 
 namespace Gfx {
 
+// A string laid out with a ScaledFont, ready to be drawn with Painter::draw_glyph_run().
+struct GlyphRun {
+    struct Glyph {
+        // Relative to the origin of the run: the start of its baseline rounded down to a whole pixel, and moved up
+        // to the top of the line.
+        IntRect destination_rect;
+        RefPtr<Bitmap const> bitmap;
+        IntRect source_rect;
+        // Emojis are scaled to destination_rect as they are, everything else is a glyph coverage mask drawn in the text color.
+        bool is_emoji { false };
+    };
+
+    Vector<Glyph> glyphs;
+    // The union of the glyphs' destination rects.
+    IntRect bounding_rect;
+
+    // Glyphs from the GlyphAtlas only stay where they are until it empties a page.
+    u64 atlas_generation { 0 };
+    // One bit for each page of the GlyphAtlas that holds glyphs of this run.
+    u8 atlas_page_mask { 0 };
+    u64 last_used { 0 };
+};
+
+struct GlyphRunKey {
+    String text;
+    GlyphSubpixelOffset origin_offset;
+
+    bool operator==(GlyphRunKey const&) const = default;
+};
+
+}
+
+namespace AK {
+
+template<>
+struct Traits<Gfx::GlyphRunKey> : public GenericTraits<Gfx::GlyphRunKey> {
+    static unsigned hash(Gfx::GlyphRunKey const& key) { return pair_int_hash(key.text.hash(), key.origin_offset.x); }
+};
+
+}
+
+namespace Gfx {
+
 class ScaledFont : public Gfx::Font {
 public:
     ScaledFont(NonnullRefPtr<VectorFont> font, float point_width, float point_height, unsigned dpi_x = DEFAULT_DPI, unsigned dpi_y = DEFAULT_DPI)
@@ -32,6 +78,13 @@ public:
     ScaledGlyphMetrics glyph_metrics(u32 glyph_id) const { return m_font->glyph_metrics(glyph_id, m_x_scale, m_y_scale); }
     RefPtr<Gfx::Bitmap> rasterize_glyph(u32 glyph_id) const;
 
+    // The glyph is usually part of a page of the GlyphAtlas, see Glyph::bitmap_rect().
+    Gfx::Glyph glyph(u32 code_point, GlyphSubpixelOffset) const;
+
+    // Lays out the string as Painter::draw_text_run() would draw it, starting origin_offset to the right of a whole pixel.
+    // Runs are cached, so drawing the same text again only has to blit it. The returned run is valid until the next call.
+    GlyphRun const& glyph_run(Utf8View const&, GlyphSubpixelOffset origin_offset) const;
+
     // ^Gfx::Font
     virtual NonnullRefPtr<Font> clone() const override { return *this; } // FIXME: clone() should not need to be implemented
     virtual u8 presentation_size() const override { return m_point_height; }
@@ -71,8 +124,14 @@ private:
     float m_y_scale { 0.0f };
     float m_point_width { 0.0f };
     float m_point_height { 0.0f };
+    // Glyphs that are too large for the GlyphAtlas.
     mutable HashMap<u32, RefPtr<Gfx::Bitmap>> m_cached_glyph_bitmaps;
 
+    mutable HashMap<GlyphRunKey, NonnullOwnPtr<GlyphRun>> m_glyph_run_cache;
+    mutable u64 m_glyph_run_use_counter { 0 };
+
+    NonnullOwnPtr<GlyphRun> lay_out_glyph_run(Utf8View const&, GlyphSubpixelOffset origin_offset, bool is_retry = false) const;
+
     template<typename T>
     int unicode_view_width(T const& view) const;
 };
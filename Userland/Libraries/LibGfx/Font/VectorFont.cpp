@@ -0,0 +1,19 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <LibGfx/Font/VectorFont.h>
+
+namespace Gfx {
+
+static Atomic<u64> s_next_glyph_cache_id { 1 };
+
+VectorFont::VectorFont()
+    : m_glyph_cache_id(s_next_glyph_cache_id.fetch_add(1))
+{
+}
+
+}
@@ -30,13 +30,26 @@ struct ScaledGlyphMetrics {
     int left_side_bearing;
 };
 
+// Glyphs can be rasterized shifted to the right by a fraction of a pixel, so text can be positioned more precisely
+// than on whole pixels. The offset is in steps of 1 / steps_per_pixel of a pixel.
+struct GlyphSubpixelOffset {
+    static constexpr int steps_per_pixel = 4;
+
+    u8 x { 0 };
+
+    float to_float() const { return static_cast<float>(x) / steps_per_pixel; }
+
+    bool operator==(GlyphSubpixelOffset const&) const = default;
+};
+
 class VectorFont : public RefCounted<VectorFont> {
 public:
+    VectorFont();
     virtual ~VectorFont() { }
     virtual ScaledFontMetrics metrics(float x_scale, float y_scale) const = 0;
     virtual ScaledGlyphMetrics glyph_metrics(u32 glyph_id, float x_scale, float y_scale) const = 0;
     virtual float glyphs_horizontal_kerning(u32 left_glyph_id, u32 right_glyph_id, float x_scale) const = 0;
-    virtual RefPtr<Gfx::Bitmap> rasterize_glyph(u32 glyph_id, float x_scale, float y_scale) const = 0;
+    virtual RefPtr<Gfx::Bitmap> rasterize_glyph(u32 glyph_id, float x_scale, float y_scale, GlyphSubpixelOffset) const = 0;
     virtual u32 glyph_count() const = 0;
     virtual u16 units_per_em() const = 0;
     virtual u32 glyph_id_for_code_point(u32 code_point) const = 0;
@@ -45,6 +58,12 @@ public:
     virtual u16 weight() const = 0;
     virtual u8 slope() const = 0;
     virtual bool is_fixed_width() const = 0;
+
+    // Unique for the lifetime of the process (unlike the address of the font), to identify its glyphs in the GlyphAtlas.
+    u64 glyph_cache_id() const { return m_glyph_cache_id; }
+
+private:
+    u64 m_glyph_cache_id { 0 };
 };
 
 }
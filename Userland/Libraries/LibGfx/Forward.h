@@ -15,6 +15,7 @@ class DisjointRectSet;
 class Emoji;
 class Font;
 class GlyphBitmap;
+struct GlyphRun;
 class ImageDecoder;
 struct FontPixelMetrics;
 
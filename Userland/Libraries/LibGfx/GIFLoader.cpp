@@ -692,7 +692,7 @@ size_t GIFImageDecoderPlugin::frame_count()
     return m_context->images.size();
 }
 
-ErrorOr<ImageFrameDescriptor> GIFImageDecoderPlugin::frame(size_t index)
+ErrorOr<ImageFrameDescriptor> GIFImageDecoderPlugin::frame(size_t index, Optional<IntSize>)
 {
     if (m_context->error_state >= GIFLoadingContext::ErrorState::FailedToDecodeAnyFrame) {
         return Error::from_string_literal("GIFImageDecoderPlugin: Decoding failed");
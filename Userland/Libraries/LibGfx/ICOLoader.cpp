@@ -339,7 +339,7 @@ size_t ICOImageDecoderPlugin::frame_count()
     return 1;
 }
 
-ErrorOr<ImageFrameDescriptor> ICOImageDecoderPlugin::frame(size_t index)
+ErrorOr<ImageFrameDescriptor> ICOImageDecoderPlugin::frame(size_t index, Optional<IntSize>)
 {
     if (index > 0)
         return Error::from_string_literal("ICOImageDecoderPlugin: Invalid frame index");
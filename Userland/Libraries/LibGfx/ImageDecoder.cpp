@@ -18,6 +18,18 @@
 
 namespace Gfx {
 
+static size_t s_maximum_thread_count = 1;
+
+void ImageDecoder::set_maximum_thread_count(size_t count)
+{
+    s_maximum_thread_count = max<size_t>(count, 1);
+}
+
+size_t ImageDecoder::maximum_thread_count()
+{
+    return s_maximum_thread_count;
+}
+
 RefPtr<ImageDecoder> ImageDecoder::try_create(ReadonlyBytes bytes)
 {
     auto* data = bytes.data();
@@ -79,4 +91,65 @@ ImageDecoder::ImageDecoder(NonnullOwnPtr<ImageDecoderPlugin> plugin)
 {
 }
 
+// Averages each factor x factor square of pixels into one pixel. Pixels are weighted by their alpha, so that the
+// (arbitrary) color of transparent pixels doesn't bleed into their neighbors.
+static ErrorOr<NonnullRefPtr<Bitmap>> box_downscaled(Bitmap const& bitmap, int factor)
+{
+    IntSize size { ceil_div(bitmap.width(), factor), ceil_div(bitmap.height(), factor) };
+    auto downscaled_bitmap = TRY(Bitmap::try_create(bitmap.format(), size));
+    bool has_alpha = bitmap.has_alpha_channel();
+
+    for (int y = 0; y < size.height(); ++y) {
+        auto* destination = downscaled_bitmap->scanline(y);
+        int first_source_y = y * factor;
+        int end_source_y = min(first_source_y + factor, bitmap.height());
+        for (int x = 0; x < size.width(); ++x) {
+            int first_source_x = x * factor;
+            int end_source_x = min(first_source_x + factor, bitmap.width());
+
+            u64 red = 0;
+            u64 green = 0;
+            u64 blue = 0;
+            u64 alpha = 0;
+            u64 total_weight = 0;
+            for (int source_y = first_source_y; source_y < end_source_y; ++source_y) {
+                auto const* source = bitmap.scanline(source_y);
+                for (int source_x = first_source_x; source_x < end_source_x; ++source_x) {
+                    auto color = Color::from_argb(source[source_x]);
+                    u64 weight = has_alpha ? color.alpha() : 1;
+                    red += color.red() * weight;
+                    green += color.green() * weight;
+                    blue += color.blue() * weight;
+                    alpha += color.alpha();
+                    total_weight += weight;
+                }
+            }
+
+            if (total_weight == 0) {
+                destination[x] = Color(Color::Transparent).value();
+                continue;
+            }
+            u64 pixel_count = (end_source_x - first_source_x) * (end_source_y - first_source_y);
+            destination[x] = Color(red / total_weight, green / total_weight, blue / total_weight, has_alpha ? alpha / pixel_count : 255).value();
+        }
+    }
+    return downscaled_bitmap;
+}
+
+ErrorOr<ImageFrameDescriptor> ImageDecoder::frame(size_t index, Optional<IntSize> ideal_size) const
+{
+    auto frame = TRY(m_plugin->frame(index, ideal_size));
+    if (!ideal_size.has_value() || ideal_size->is_empty() || !frame.image)
+        return frame;
+
+    auto& bitmap = *frame.image;
+    if (bitmap.format() != BitmapFormat::BGRx8888 && bitmap.format() != BitmapFormat::BGRA8888)
+        return frame;
+    auto factor = min(bitmap.width() / ideal_size->width(), bitmap.height() / ideal_size->height());
+    if (factor < 2)
+        return frame;
+    frame.image = TRY(box_downscaled(bitmap, factor));
+    return frame;
+}
+
 }
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/ByteBuffer.h>
+#include <AK/Optional.h>
 #include <AK/OwnPtr.h>
 #include <AK/RefCounted.h>
 #include <AK/RefPtr.h>
@@ -39,7 +40,18 @@ public:
     virtual bool is_animated() = 0;
     virtual size_t loop_count() = 0;
     virtual size_t frame_count() = 0;
-    virtual ErrorOr<ImageFrameDescriptor> frame(size_t index) = 0;
+
+    // If the image is going to be displayed smaller than its size(), ideal_size can be given as a hint.
+    // Decoders that can decode at a reduced size cheaply may then return a smaller bitmap, which is never smaller
+    // than ideal_size (unless the image itself is).
+    virtual ErrorOr<ImageFrameDescriptor> frame(size_t index, Optional<IntSize> ideal_size = {}) = 0;
+
+    // Decoders that support it can be given an image that's still arriving. The decoder keeps its own copy of the data
+    // from the first call to append_data() on, and frame() returns whatever part of the image could be decoded so far
+    // (the rest of it left blank) until finish_data() is called.
+    virtual bool supports_incremental_decoding() const { return false; }
+    virtual ErrorOr<void> append_data(ReadonlyBytes) { return Error::from_string_literal("ImageDecoderPlugin: Incremental decoding is not supported"); }
+    virtual void finish_data() { }
 
 protected:
     ImageDecoderPlugin() = default;
@@ -59,7 +71,17 @@ public:
     bool is_animated() const { return m_plugin->is_animated(); }
     size_t loop_count() const { return m_plugin->loop_count(); }
     size_t frame_count() const { return m_plugin->frame_count(); }
-    ErrorOr<ImageFrameDescriptor> frame(size_t index) const { return m_plugin->frame(index); }
+    // Unlike ImageDecoderPlugin::frame(), this also box filters the frame down by the largest whole factor that keeps it
+    // at least as large as ideal_size, for decoders that can't decode at a reduced size themselves.
+    ErrorOr<ImageFrameDescriptor> frame(size_t index, Optional<IntSize> ideal_size = {}) const;
+    bool supports_incremental_decoding() const { return m_plugin->supports_incremental_decoding(); }
+    ErrorOr<void> append_data(ReadonlyBytes bytes) { return m_plugin->append_data(bytes); }
+    void finish_data() { m_plugin->finish_data(); }
+
+    // Decoders may use up to this many threads for large images. It's 1 by default, as using threads requires the
+    // "thread" pledge.
+    static void set_maximum_thread_count(size_t);
+    static size_t maximum_thread_count();
 
 private:
     explicit ImageDecoder(NonnullOwnPtr<ImageDecoderPlugin>);
@@ -4,12 +4,18 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
+#include <AK/Atomic.h>
+#include <AK/BuiltinWrappers.h>
 #include <AK/Debug.h>
 #include <AK/HashMap.h>
 #include <AK/Math.h>
 #include <AK/MemoryStream.h>
+#include <AK/SIMDExtras.h>
+#include <AK/SIMDMath.h>
 #include <AK/Vector.h>
 #include <LibGfx/JPGLoader.h>
+#include <LibThreading/Thread.h>
 
 #define JPG_INVALID 0X0000
 
@@ -149,18 +155,34 @@ struct StartOfFrame {
     u16 width { 0 };
 };
 
+// Codes of up to this many bits are decoded with a single lookup, longer ones bit by bit (see get_next_symbol()).
+constexpr static u8 huffman_lookup_bits = 9;
+
 struct HuffmanTableSpec {
     u8 type { 0 };
     u8 destination_id { 0 };
     u8 code_counts[16] = { 0 };
     Vector<u8> symbols;
-    Vector<u16> codes;
+
+    // Indexed by the next `huffman_lookup_bits` bits of the stream, the length of the code they start with (in the
+    // high byte) and its symbol (in the low byte). Zero if they start with a longer code.
+    Array<u16, 1 << huffman_lookup_bits> lookup {};
+    // The largest code of each length (-1 if there are none), and the offset from a code of that length to the index
+    // of its symbol. See "F.2.2.3 Decoder tables" in the specification.
+    i32 max_codes[17] = { 0 };
+    i32 value_offsets[17] = { 0 };
 };
 
 struct HuffmanStreamState {
-    Vector<u8> stream;
-    u8 bit_offset { 0 };
+    ReadonlyBytes stream;
     size_t byte_offset { 0 };
+
+    // The bits that have been read from the stream but not consumed yet, starting at the most significant bit.
+    u64 bit_buffer { 0 };
+    u8 bit_buffer_length { 0 };
+
+    // DC coefficients are encoded as the difference to the previous block of the same component.
+    i32 previous_dc_values[3] = { 0 };
 };
 
 struct JPGLoadingContext {
@@ -168,6 +190,7 @@ struct JPGLoadingContext {
         NotDecoded = 0,
         Error,
         FrameDecoded,
+        HeaderDecoded,
         BitmapDecoded
     };
 
@@ -185,58 +208,117 @@ struct JPGLoadingContext {
     u16 dc_reset_interval { 0 };
     HashMap<u8, HuffmanTableSpec> dc_tables;
     HashMap<u8, HuffmanTableSpec> ac_tables;
-    HuffmanStreamState huffman_stream;
-    i32 previous_dc_values[3] = { 0 };
     MacroblockMeta mblock_meta;
+
+    // False while the data is still arriving, see JPGImageDecoderPlugin::append_data().
+    bool is_data_complete { true };
+
+    // The entropy-coded data of the scan, without the stuffed bytes and restart markers.
+    Vector<u8> huffman_data;
+    // Where each restart interval after the first one starts in the entropy-coded data.
+    Vector<size_t> restart_interval_offsets;
+    // How far the data has been scanned for entropy-coded data, and whether the end of the image has been reached.
+    size_t scanned_data_size { 0 };
+    bool has_scanned_end_of_image { false };
+
+    // The state of the Huffman decoder after the last MCU that has been decoded, to continue once more data arrives.
+    HuffmanStreamState huffman_stream;
+    u32 decoded_mcu_count { 0 };
+    u32 converted_mcu_row_count { 0 };
+    Vector<Macroblock> macroblocks;
+
+    // The size the caller would like the bitmap to be, see ImageDecoderPlugin::frame().
+    Optional<IntSize> ideal_size;
+    // How many pixels each block is decoded to in each direction: 8 for the full size, or 4, 2 or 1 to decode the
+    // image at 1/2, 1/4 or 1/8 of its size.
+    u8 block_size { 8 };
 };
 
 static void generate_huffman_codes(HuffmanTableSpec& table)
 {
-    unsigned code = 0;
-    for (auto number_of_codes : table.code_counts) {
-        for (int i = 0; i < number_of_codes; i++)
-            table.codes.append(code++);
+    table.lookup.fill(0);
+
+    i32 code = 0;
+    size_t symbol_index = 0;
+    for (u8 length = 1; length <= 16; length++) {
+        auto number_of_codes = table.code_counts[length - 1];
+        if (number_of_codes == 0) {
+            table.max_codes[length] = -1;
+        } else {
+            table.value_offsets[length] = static_cast<i32>(symbol_index) - code;
+            table.max_codes[length] = code + number_of_codes - 1;
+        }
+
+        for (int i = 0; i < number_of_codes; i++, code++, symbol_index++) {
+            // Codes are only valid while they fit in their length, malformed tables can have too many of them.
+            if (length > huffman_lookup_bits || code >= (1 << length))
+                continue;
+            auto first_entry = code << (huffman_lookup_bits - length);
+            auto entry_count = 1 << (huffman_lookup_bits - length);
+            for (int j = 0; j < entry_count; j++)
+                table.lookup[first_entry + j] = (length << 8) | table.symbols[symbol_index];
+        }
         code <<= 1;
     }
 }
 
+// Makes sure there are at least 57 bits in the bit buffer, unless the stream ends before that.
+static ALWAYS_INLINE void refill_huffman_bits(HuffmanStreamState& hstream)
+{
+    while (hstream.bit_buffer_length <= 56 && hstream.byte_offset < hstream.stream.size()) {
+        hstream.bit_buffer |= static_cast<u64>(hstream.stream[hstream.byte_offset++]) << (56 - hstream.bit_buffer_length);
+        hstream.bit_buffer_length += 8;
+    }
+}
+
+static ALWAYS_INLINE void consume_huffman_bits(HuffmanStreamState& hstream, u8 count)
+{
+    hstream.bit_buffer <<= count;
+    hstream.bit_buffer_length -= count;
+}
+
 static Optional<size_t> read_huffman_bits(HuffmanStreamState& hstream, size_t count = 1)
 {
-    if (count > (8 * sizeof(size_t))) {
+    if (count > 32) {
         dbgln_if(JPG_DEBUG, "Can't read {} bits at once!", count);
         return {};
     }
-    size_t value = 0;
-    while (count--) {
-        if (hstream.byte_offset >= hstream.stream.size()) {
-            dbgln_if(JPG_DEBUG, "Huffman stream exhausted. This could be an error!");
-            return {};
-        }
-        u8 current_byte = hstream.stream[hstream.byte_offset];
-        u8 current_bit = 1u & (u32)(current_byte >> (7 - hstream.bit_offset)); // MSB first.
-        hstream.bit_offset++;
-        value = (value << 1) | (size_t)current_bit;
-        if (hstream.bit_offset == 8) {
-            hstream.byte_offset++;
-            hstream.bit_offset = 0;
-        }
+    if (count == 0)
+        return 0;
+    refill_huffman_bits(hstream);
+    if (hstream.bit_buffer_length < count) {
+        dbgln_if(JPG_DEBUG, "Huffman stream exhausted. This could be an error!");
+        return {};
     }
+    size_t value = hstream.bit_buffer >> (64 - count);
+    consume_huffman_bits(hstream, count);
     return value;
 }
 
 static Optional<u8> get_next_symbol(HuffmanStreamState& hstream, HuffmanTableSpec const& table)
 {
-    unsigned code = 0;
-    size_t code_cursor = 0;
-    for (int i = 0; i < 16; i++) { // Codes can't be longer than 16 bits.
-        auto result = read_huffman_bits(hstream);
-        if (!result.has_value())
+    refill_huffman_bits(hstream);
+
+    // Once the stream ends, the bit buffer is padded with zeroes, which are only a problem if we end up consuming them.
+    auto entry = table.lookup[hstream.bit_buffer >> (64 - huffman_lookup_bits)];
+    if (entry != 0) {
+        u8 length = entry >> 8;
+        if (length > hstream.bit_buffer_length)
+            return {};
+        consume_huffman_bits(hstream, length);
+        return entry & 0xFF;
+    }
+
+    for (u8 length = huffman_lookup_bits + 1; length <= 16; length++) { // Codes can't be longer than 16 bits.
+        if (length > hstream.bit_buffer_length)
             return {};
-        code = (code << 1) | (i32)result.release_value();
-        for (int j = 0; j < table.code_counts[i]; j++) {
-            if (code == table.codes[code_cursor])
-                return table.symbols[code_cursor];
-            code_cursor++;
+        i32 code = hstream.bit_buffer >> (64 - length);
+        if (code <= table.max_codes[length]) {
+            auto symbol_index = code + table.value_offsets[length];
+            if (symbol_index < 0 || static_cast<size_t>(symbol_index) >= table.symbols.size())
+                return {};
+            consume_huffman_bits(hstream, length);
+            return table.symbols[symbol_index];
         }
     }
 
@@ -271,7 +353,7 @@ static inline i32* get_component(Macroblock& block, unsigned component)
  * macroblocks that share the chrominance data. Next two iterations (assuming that
  * we are dealing with three components) will fill up the blocks with chroma data.
  */
-static bool build_macroblocks(JPGLoadingContext& context, Vector<Macroblock>& macroblocks, u32 hcursor, u32 vcursor)
+static bool build_macroblocks(JPGLoadingContext const& context, Vector<Macroblock>& macroblocks, HuffmanStreamState& hstream, u32 hcursor, u32 vcursor)
 {
     for (unsigned component_i = 0; component_i < context.component_count; component_i++) {
         auto& component = context.components[component_i];
@@ -281,15 +363,15 @@ static bool build_macroblocks(JPGLoadingContext& context, Vector<Macroblock>& ma
         if (component.ac_destination_id >= context.ac_tables.size())
             return false;
 
+        auto& dc_table = context.dc_tables.find(component.dc_destination_id)->value;
+        auto& ac_table = context.ac_tables.find(component.ac_destination_id)->value;
+
         for (u8 vfactor_i = 0; vfactor_i < component.vsample_factor; vfactor_i++) {
             for (u8 hfactor_i = 0; hfactor_i < component.hsample_factor; hfactor_i++) {
                 u32 mb_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hfactor_i + hcursor);
                 Macroblock& block = macroblocks[mb_index];
 
-                auto& dc_table = context.dc_tables.find(component.dc_destination_id)->value;
-                auto& ac_table = context.ac_tables.find(component.ac_destination_id)->value;
-
-                auto symbol_or_error = get_next_symbol(context.huffman_stream, dc_table);
+                auto symbol_or_error = get_next_symbol(hstream, dc_table);
                 if (!symbol_or_error.has_value())
                     return false;
 
@@ -300,7 +382,7 @@ static bool build_macroblocks(JPGLoadingContext& context, Vector<Macroblock>& ma
                     return false;
                 }
 
-                auto coeff_or_error = read_huffman_bits(context.huffman_stream, dc_length);
+                auto coeff_or_error = read_huffman_bits(hstream, dc_length);
                 if (!coeff_or_error.has_value())
                     return false;
 
@@ -312,12 +394,12 @@ static bool build_macroblocks(JPGLoadingContext& context, Vector<Macroblock>& ma
                     dc_diff -= (1 << dc_length) - 1;
 
                 auto select_component = get_component(block, component_i);
-                auto& previous_dc = context.previous_dc_values[component_i];
+                auto& previous_dc = hstream.previous_dc_values[component_i];
                 select_component[0] = previous_dc += dc_diff;
 
                 // Compute the AC coefficients.
                 for (int j = 1; j < 64;) {
-                    symbol_or_error = get_next_symbol(context.huffman_stream, ac_table);
+                    symbol_or_error = get_next_symbol(hstream, ac_table);
                     if (!symbol_or_error.has_value())
                         return false;
 
@@ -344,7 +426,7 @@ static bool build_macroblocks(JPGLoadingContext& context, Vector<Macroblock>& ma
                     }
 
                     if (coeff_length != 0) {
-                        coeff_or_error = read_huffman_bits(context.huffman_stream, coeff_length);
+                        coeff_or_error = read_huffman_bits(hstream, coeff_length);
                         if (!coeff_or_error.has_value())
                             return false;
                         i32 ac_coefficient = coeff_or_error.release_value();
@@ -361,11 +443,90 @@ static bool build_macroblocks(JPGLoadingContext& context, Vector<Macroblock>& ma
     return true;
 }
 
-static Optional<Vector<Macroblock>> decode_huffman_stream(JPGLoadingContext& context)
+static u32 mcus_per_row(JPGLoadingContext const& context)
 {
-    Vector<Macroblock> macroblocks;
-    macroblocks.resize(context.mblock_meta.padded_total);
+    return context.mblock_meta.hpadded_count / context.hsample_factor;
+}
+
+static u32 mcu_row_count(JPGLoadingContext const& context)
+{
+    return context.mblock_meta.vpadded_count / context.vsample_factor;
+}
+
+// Decodes the MCUs [first_mcu, end_mcu) of the scan. Decoding can start anywhere the previous MCU ended, or at the
+// start of any restart interval.
+static bool decode_mcus(JPGLoadingContext const& context, Vector<Macroblock>& macroblocks, HuffmanStreamState& hstream, u32 first_mcu, u32 end_mcu)
+{
+    for (u32 mcu = first_mcu; mcu < end_mcu; mcu++) {
+        if (context.dc_reset_interval > 0 && mcu % context.dc_reset_interval == 0) {
+            hstream.previous_dc_values[0] = 0;
+            hstream.previous_dc_values[1] = 0;
+            hstream.previous_dc_values[2] = 0;
+
+            // Restart intervals start at byte boundaries, which we remembered while collecting the entropy-coded data.
+            auto interval = mcu / context.dc_reset_interval;
+            if (interval > context.restart_interval_offsets.size())
+                return false;
+            hstream.byte_offset = interval == 0 ? 0 : context.restart_interval_offsets[interval - 1];
+            hstream.bit_buffer = 0;
+            hstream.bit_buffer_length = 0;
+        }
+
+        u32 hcursor = (mcu % mcus_per_row(context)) * context.hsample_factor;
+        u32 vcursor = (mcu / mcus_per_row(context)) * context.vsample_factor;
+        if (!build_macroblocks(context, macroblocks, hstream, hcursor, vcursor)) {
+            if constexpr (JPG_DEBUG) {
+                dbgln("Failed to build Macroblock {}", vcursor * context.mblock_meta.hpadded_count + hcursor);
+                dbgln("Huffman stream byte offset {}", hstream.byte_offset - (hstream.bit_buffer_length + 7) / 8);
+                dbgln("Huffman stream bit offset {}", (8 - hstream.bit_buffer_length % 8) % 8);
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
+// Calls `callback` with up to `thread_count` consecutive parts of [0, count), each on its own thread.
+template<typename Callback>
+static bool for_each_part_in_parallel(u32 count, u32 thread_count, Callback callback)
+{
+    if (thread_count <= 1)
+        return callback(0u, count);
+
+    Atomic<bool> has_failed { false };
+    Vector<NonnullRefPtr<Threading::Thread>> threads;
+    for (u32 i = 1; i < thread_count; i++) {
+        u32 first = static_cast<u64>(count) * i / thread_count;
+        u32 end = static_cast<u64>(count) * (i + 1) / thread_count;
+        auto thread = Threading::Thread::construct([&callback, &has_failed, first, end]() -> intptr_t {
+            if (!callback(first, end))
+                has_failed = true;
+            return 0;
+        },
+            "JPG decoder"sv);
+        thread->start();
+        threads.append(move(thread));
+    }
+    if (!callback(0u, count / thread_count))
+        has_failed = true;
+    for (auto& thread : threads)
+        (void)thread->join();
+    return !has_failed;
+}
 
+// Spreading the work over several threads only pays off for larger images.
+constexpr static u32 minimum_macroblocks_per_thread = 2048;
+
+static u32 thread_count_for(JPGLoadingContext const& context, u32 maximum)
+{
+    auto thread_count = min<size_t>(ImageDecoder::maximum_thread_count(), context.mblock_meta.padded_total / minimum_macroblocks_per_thread);
+    return clamp<size_t>(thread_count, 1, maximum);
+}
+
+// Decodes as many MCUs as the entropy-coded data that has arrived so far covers. Running out of data isn't an error
+// until all of it has arrived, decoding then continues after the last complete MCU.
+static bool decode_huffman_stream(JPGLoadingContext& context)
+{
     if constexpr (JPG_DEBUG) {
         dbgln("Image width: {}", context.frame.width);
         dbgln("Image height: {}", context.frame.height);
@@ -374,48 +535,49 @@ static Optional<Vector<Macroblock>> decode_huffman_stream(JPGLoadingContext& con
         dbgln("Macroblock meta padded total: {}", context.mblock_meta.padded_total);
     }
 
-    // Compute huffman codes for DC and AC tables.
-    for (auto it = context.dc_tables.begin(); it != context.dc_tables.end(); ++it)
-        generate_huffman_codes(it->value);
-
-    for (auto it = context.ac_tables.begin(); it != context.ac_tables.end(); ++it)
-        generate_huffman_codes(it->value);
-
-    for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.vsample_factor) {
-        for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.hsample_factor) {
-            u32 i = vcursor * context.mblock_meta.hpadded_count + hcursor;
-            if (context.dc_reset_interval > 0) {
-                if (i % context.dc_reset_interval == 0) {
-                    context.previous_dc_values[0] = 0;
-                    context.previous_dc_values[1] = 0;
-                    context.previous_dc_values[2] = 0;
-
-                    // Restart markers are stored in byte boundaries. Advance the huffman stream cursor to
-                    //  the 0th bit of the next byte.
-                    if (context.huffman_stream.byte_offset < context.huffman_stream.stream.size()) {
-                        if (context.huffman_stream.bit_offset > 0) {
-                            context.huffman_stream.bit_offset = 0;
-                            context.huffman_stream.byte_offset++;
-                        }
+    auto mcu_count = mcus_per_row(context) * mcu_row_count(context);
+
+    // Restart intervals can be decoded independently of each other, so with all of them at hand we can decode them in parallel.
+    if (context.decoded_mcu_count == 0 && context.has_scanned_end_of_image && context.dc_reset_interval > 0) {
+        auto interval_count = context.restart_interval_offsets.size() + 1;
+        auto thread_count = thread_count_for(context, interval_count);
+        if (thread_count > 1) {
+            bool success = for_each_part_in_parallel(interval_count, thread_count, [&](u32 first_interval, u32 end_interval) {
+                HuffmanStreamState hstream;
+                hstream.stream = context.huffman_data.span();
+                auto first_mcu = min(first_interval * context.dc_reset_interval, mcu_count);
+                auto end_mcu = min(end_interval * context.dc_reset_interval, mcu_count);
+                return decode_mcus(context, context.macroblocks, hstream, first_mcu, end_mcu);
+            });
+            if (!success)
+                return false;
+            context.decoded_mcu_count = mcu_count;
+            return true;
+        }
+    }
 
-                        // Skip the restart marker (RSTn).
-                        context.huffman_stream.byte_offset++;
-                    }
-                }
-            }
+    auto& hstream = context.huffman_stream;
+    hstream.stream = context.huffman_data.span();
+    while (context.decoded_mcu_count < mcu_count) {
+        auto saved_hstream = hstream;
+        if (decode_mcus(context, context.macroblocks, hstream, context.decoded_mcu_count, context.decoded_mcu_count + 1)) {
+            context.decoded_mcu_count++;
+            continue;
+        }
+        if (context.has_scanned_end_of_image)
+            return false;
 
-            if (!build_macroblocks(context, macroblocks, hcursor, vcursor)) {
-                if constexpr (JPG_DEBUG) {
-                    dbgln("Failed to build Macroblock {}", i);
-                    dbgln("Huffman stream byte offset {}", context.huffman_stream.byte_offset);
-                    dbgln("Huffman stream bit offset {}", context.huffman_stream.bit_offset);
-                }
-                return {};
-            }
+        // Try again once more data has arrived. Blocks are expected to start out as zero, so undo what we decoded of this MCU.
+        hstream = saved_hstream;
+        u32 hcursor = (context.decoded_mcu_count % mcus_per_row(context)) * context.hsample_factor;
+        u32 vcursor = (context.decoded_mcu_count / mcus_per_row(context)) * context.vsample_factor;
+        for (u32 vfactor_i = 0; vfactor_i < context.vsample_factor; vfactor_i++) {
+            for (u32 hfactor_i = 0; hfactor_i < context.hsample_factor; hfactor_i++)
+                context.macroblocks[(vcursor + vfactor_i) * context.mblock_meta.hpadded_count + hcursor + hfactor_i] = {};
         }
+        break;
     }
-
-    return macroblocks;
+    return true;
 }
 
 static inline bool bounds_okay(const size_t cursor, const size_t delta, const size_t bound)
@@ -623,7 +785,7 @@ static bool read_huffman_table(InputMemoryStream& stream, JPGLoadingContext& con
             table.code_counts[i] = count;
         }
 
-        table.codes.ensure_capacity(total_codes);
+        table.symbols.ensure_capacity(total_codes);
 
         // Read symbols. Read X bytes, where X is the sum of the counts of codes read in the previous step.
         for (u32 i = 0; i < total_codes; i++) {
@@ -843,9 +1005,24 @@ static bool skip_marker_with_length(InputMemoryStream& stream)
     return !stream.handle_any_error();
 }
 
-static void dequantize(JPGLoadingContext& context, Vector<Macroblock>& macroblocks)
+using AK::SIMD::f32x4;
+using AK::SIMD::i32x4;
+
+static ALWAYS_INLINE i32x4 load_i32x4(i32 const* data)
+{
+    i32x4 value;
+    __builtin_memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+static ALWAYS_INLINE void store_i32x4(i32* data, i32x4 value)
+{
+    __builtin_memcpy(data, &value, sizeof(value));
+}
+
+static void dequantize(JPGLoadingContext const& context, Vector<Macroblock>& macroblocks, u32 first_mcu_row, u32 end_mcu_row)
 {
-    for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.vsample_factor) {
+    for (u32 vcursor = first_mcu_row * context.vsample_factor; vcursor < min(end_mcu_row * context.vsample_factor, context.mblock_meta.vcount); vcursor += context.vsample_factor) {
         for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.hsample_factor) {
             for (u32 i = 0; i < context.component_count; i++) {
                 auto& component = context.components[i];
@@ -855,8 +1032,10 @@ static void dequantize(JPGLoadingContext& context, Vector<Macroblock>& macrobloc
                         u32 mb_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hfactor_i + hcursor);
                         Macroblock& block = macroblocks[mb_index];
                         int* block_component = get_component(block, i);
-                        for (u32 k = 0; k < 64; k++)
-                            block_component[k] *= table[k];
+                        for (u32 k = 0; k < 64; k += 4) {
+                            auto quantization_factors = load_i32x4(reinterpret_cast<i32 const*>(&table[k]));
+                            store_i32x4(&block_component[k], load_i32x4(&block_component[k]) * quantization_factors);
+                        }
                     }
                 }
             }
@@ -864,7 +1043,8 @@ static void dequantize(JPGLoadingContext& context, Vector<Macroblock>& macrobloc
     }
 }
 
-static void inverse_dct(JPGLoadingContext const& context, Vector<Macroblock>& macroblocks)
+// One pass of the inverse DCT, over the columns of 4 neighboring columns at once.
+static ALWAYS_INLINE void inverse_dct_columns(i32* columns)
 {
     static float const m0 = 2.0f * AK::cos(1.0f / 16.0f * 2.0f * AK::Pi<float>);
     static float const m1 = 2.0f * AK::cos(2.0f / 16.0f * 2.0f * AK::Pi<float>);
@@ -881,7 +1061,128 @@ static void inverse_dct(JPGLoadingContext const& context, Vector<Macroblock>& ma
     static float const s6 = AK::cos(6.0f / 16.0f * AK::Pi<float>) / 2.0f;
     static float const s7 = AK::cos(7.0f / 16.0f * AK::Pi<float>) / 2.0f;
 
-    for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.vsample_factor) {
+    f32x4 const g0 = AK::SIMD::to_f32x4(load_i32x4(&columns[0 * 8])) * s0;
+    f32x4 const g1 = AK::SIMD::to_f32x4(load_i32x4(&columns[4 * 8])) * s4;
+    f32x4 const g2 = AK::SIMD::to_f32x4(load_i32x4(&columns[2 * 8])) * s2;
+    f32x4 const g3 = AK::SIMD::to_f32x4(load_i32x4(&columns[6 * 8])) * s6;
+    f32x4 const g4 = AK::SIMD::to_f32x4(load_i32x4(&columns[5 * 8])) * s5;
+    f32x4 const g5 = AK::SIMD::to_f32x4(load_i32x4(&columns[1 * 8])) * s1;
+    f32x4 const g6 = AK::SIMD::to_f32x4(load_i32x4(&columns[7 * 8])) * s7;
+    f32x4 const g7 = AK::SIMD::to_f32x4(load_i32x4(&columns[3 * 8])) * s3;
+
+    f32x4 const f0 = g0;
+    f32x4 const f1 = g1;
+    f32x4 const f2 = g2;
+    f32x4 const f3 = g3;
+    f32x4 const f4 = g4 - g7;
+    f32x4 const f5 = g5 + g6;
+    f32x4 const f6 = g5 - g6;
+    f32x4 const f7 = g4 + g7;
+
+    f32x4 const e0 = f0;
+    f32x4 const e1 = f1;
+    f32x4 const e2 = f2 - f3;
+    f32x4 const e3 = f2 + f3;
+    f32x4 const e4 = f4;
+    f32x4 const e5 = f5 - f7;
+    f32x4 const e6 = f6;
+    f32x4 const e7 = f5 + f7;
+    f32x4 const e8 = f4 + f6;
+
+    f32x4 const d0 = e0;
+    f32x4 const d1 = e1;
+    f32x4 const d2 = e2 * m1;
+    f32x4 const d3 = e3;
+    f32x4 const d4 = e4 * m2;
+    f32x4 const d5 = e5 * m3;
+    f32x4 const d6 = e6 * m4;
+    f32x4 const d7 = e7;
+    f32x4 const d8 = e8 * m5;
+
+    f32x4 const c0 = d0 + d1;
+    f32x4 const c1 = d0 - d1;
+    f32x4 const c2 = d2 - d3;
+    f32x4 const c3 = d3;
+    f32x4 const c4 = d4 + d8;
+    f32x4 const c5 = d5 + d7;
+    f32x4 const c6 = d6 - d8;
+    f32x4 const c7 = d7;
+    f32x4 const c8 = c5 - c6;
+
+    f32x4 const b0 = c0 + c3;
+    f32x4 const b1 = c1 + c2;
+    f32x4 const b2 = c1 - c2;
+    f32x4 const b3 = c0 - c3;
+    f32x4 const b4 = c4 - c8;
+    f32x4 const b5 = c8;
+    f32x4 const b6 = c6 - c7;
+    f32x4 const b7 = c7;
+
+    store_i32x4(&columns[0 * 8], AK::SIMD::to_i32x4(b0 + b7));
+    store_i32x4(&columns[1 * 8], AK::SIMD::to_i32x4(b1 + b6));
+    store_i32x4(&columns[2 * 8], AK::SIMD::to_i32x4(b2 + b5));
+    store_i32x4(&columns[3 * 8], AK::SIMD::to_i32x4(b3 + b4));
+    store_i32x4(&columns[4 * 8], AK::SIMD::to_i32x4(b3 - b4));
+    store_i32x4(&columns[5 * 8], AK::SIMD::to_i32x4(b2 - b5));
+    store_i32x4(&columns[6 * 8], AK::SIMD::to_i32x4(b1 - b6));
+    store_i32x4(&columns[7 * 8], AK::SIMD::to_i32x4(b0 - b7));
+}
+
+static ALWAYS_INLINE void transpose_block_component(i32* block_component)
+{
+    for (u32 row = 0; row < 8; ++row) {
+        for (u32 column = row + 1; column < 8; ++column)
+            swap(block_component[row * 8 + column], block_component[column * 8 + row]);
+    }
+}
+
+// The inverse DCT of only the lowest block_size x block_size frequencies of a block, which yields the block at
+// 1/2, 1/4 or 1/8 of its size. The pixels end up in the top left corner of the block.
+static void inverse_dct_reduced(i32* block_component, u8 block_size)
+{
+    if (block_size == 1) {
+        block_component[0] /= 8;
+        return;
+    }
+
+    // factors[n][x * 4 + u] is the weight of frequency u in pixel x of a block of size n.
+    static auto const factors = [] {
+        Array<Array<float, 16>, 5> factors {};
+        for (u8 size : { 2, 4 }) {
+            for (u8 x = 0; x < size; ++x) {
+                for (u8 u = 0; u < size; ++u) {
+                    float normalization = u == 0 ? AK::rsqrt(2.0f) : 1.0f;
+                    factors[size][x * 4 + u] = normalization * AK::cos((2 * x + 1) * u * AK::Pi<float> / (2 * size));
+                }
+            }
+        }
+        return factors;
+    }();
+    auto const& block_factors = factors[block_size];
+
+    // The columns first, then the rows.
+    float columns[4 * 4];
+    for (u8 y = 0; y < block_size; ++y) {
+        for (u8 u = 0; u < block_size; ++u) {
+            float sum = 0;
+            for (u8 v = 0; v < block_size; ++v)
+                sum += block_factors[y * 4 + v] * static_cast<float>(block_component[v * 8 + u]);
+            columns[y * 4 + u] = sum;
+        }
+    }
+    for (u8 y = 0; y < block_size; ++y) {
+        for (u8 x = 0; x < block_size; ++x) {
+            float sum = 0;
+            for (u8 u = 0; u < block_size; ++u)
+                sum += block_factors[x * 4 + u] * columns[y * 4 + u];
+            block_component[y * 8 + x] = static_cast<i32>(sum / 4.0f);
+        }
+    }
+}
+
+static void inverse_dct(JPGLoadingContext const& context, Vector<Macroblock>& macroblocks, u32 first_mcu_row, u32 end_mcu_row)
+{
+    for (u32 vcursor = first_mcu_row * context.vsample_factor; vcursor < min(end_mcu_row * context.vsample_factor, context.mblock_meta.vcount); vcursor += context.vsample_factor) {
         for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.hsample_factor) {
             for (u32 component_i = 0; component_i < context.component_count; component_i++) {
                 auto& component = context.components[component_i];
@@ -890,140 +1191,19 @@ static void inverse_dct(JPGLoadingContext const& context, Vector<Macroblock>& ma
                         u32 mb_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hfactor_i + hcursor);
                         Macroblock& block = macroblocks[mb_index];
                         i32* block_component = get_component(block, component_i);
-                        for (u32 k = 0; k < 8; ++k) {
-                            float const g0 = block_component[0 * 8 + k] * s0;
-                            float const g1 = block_component[4 * 8 + k] * s4;
-                            float const g2 = block_component[2 * 8 + k] * s2;
-                            float const g3 = block_component[6 * 8 + k] * s6;
-                            float const g4 = block_component[5 * 8 + k] * s5;
-                            float const g5 = block_component[1 * 8 + k] * s1;
-                            float const g6 = block_component[7 * 8 + k] * s7;
-                            float const g7 = block_component[3 * 8 + k] * s3;
-
-                            float const f0 = g0;
-                            float const f1 = g1;
-                            float const f2 = g2;
-                            float const f3 = g3;
-                            float const f4 = g4 - g7;
-                            float const f5 = g5 + g6;
-                            float const f6 = g5 - g6;
-                            float const f7 = g4 + g7;
-
-                            float const e0 = f0;
-                            float const e1 = f1;
-                            float const e2 = f2 - f3;
-                            float const e3 = f2 + f3;
-                            float const e4 = f4;
-                            float const e5 = f5 - f7;
-                            float const e6 = f6;
-                            float const e7 = f5 + f7;
-                            float const e8 = f4 + f6;
-
-                            float const d0 = e0;
-                            float const d1 = e1;
-                            float const d2 = e2 * m1;
-                            float const d3 = e3;
-                            float const d4 = e4 * m2;
-                            float const d5 = e5 * m3;
-                            float const d6 = e6 * m4;
-                            float const d7 = e7;
-                            float const d8 = e8 * m5;
-
-                            float const c0 = d0 + d1;
-                            float const c1 = d0 - d1;
-                            float const c2 = d2 - d3;
-                            float const c3 = d3;
-                            float const c4 = d4 + d8;
-                            float const c5 = d5 + d7;
-                            float const c6 = d6 - d8;
-                            float const c7 = d7;
-                            float const c8 = c5 - c6;
-
-                            float const b0 = c0 + c3;
-                            float const b1 = c1 + c2;
-                            float const b2 = c1 - c2;
-                            float const b3 = c0 - c3;
-                            float const b4 = c4 - c8;
-                            float const b5 = c8;
-                            float const b6 = c6 - c7;
-                            float const b7 = c7;
-
-                            block_component[0 * 8 + k] = b0 + b7;
-                            block_component[1 * 8 + k] = b1 + b6;
-                            block_component[2 * 8 + k] = b2 + b5;
-                            block_component[3 * 8 + k] = b3 + b4;
-                            block_component[4 * 8 + k] = b3 - b4;
-                            block_component[5 * 8 + k] = b2 - b5;
-                            block_component[6 * 8 + k] = b1 - b6;
-                            block_component[7 * 8 + k] = b0 - b7;
-                        }
-                        for (u32 l = 0; l < 8; ++l) {
-                            float const g0 = block_component[l * 8 + 0] * s0;
-                            float const g1 = block_component[l * 8 + 4] * s4;
-                            float const g2 = block_component[l * 8 + 2] * s2;
-                            float const g3 = block_component[l * 8 + 6] * s6;
-                            float const g4 = block_component[l * 8 + 5] * s5;
-                            float const g5 = block_component[l * 8 + 1] * s1;
-                            float const g6 = block_component[l * 8 + 7] * s7;
-                            float const g7 = block_component[l * 8 + 3] * s3;
-
-                            float const f0 = g0;
-                            float const f1 = g1;
-                            float const f2 = g2;
-                            float const f3 = g3;
-                            float const f4 = g4 - g7;
-                            float const f5 = g5 + g6;
-                            float const f6 = g5 - g6;
-                            float const f7 = g4 + g7;
-
-                            float const e0 = f0;
-                            float const e1 = f1;
-                            float const e2 = f2 - f3;
-                            float const e3 = f2 + f3;
-                            float const e4 = f4;
-                            float const e5 = f5 - f7;
-                            float const e6 = f6;
-                            float const e7 = f5 + f7;
-                            float const e8 = f4 + f6;
-
-                            float const d0 = e0;
-                            float const d1 = e1;
-                            float const d2 = e2 * m1;
-                            float const d3 = e3;
-                            float const d4 = e4 * m2;
-                            float const d5 = e5 * m3;
-                            float const d6 = e6 * m4;
-                            float const d7 = e7;
-                            float const d8 = e8 * m5;
-
-                            float const c0 = d0 + d1;
-                            float const c1 = d0 - d1;
-                            float const c2 = d2 - d3;
-                            float const c3 = d3;
-                            float const c4 = d4 + d8;
-                            float const c5 = d5 + d7;
-                            float const c6 = d6 - d8;
-                            float const c7 = d7;
-                            float const c8 = c5 - c6;
-
-                            float const b0 = c0 + c3;
-                            float const b1 = c1 + c2;
-                            float const b2 = c1 - c2;
-                            float const b3 = c0 - c3;
-                            float const b4 = c4 - c8;
-                            float const b5 = c8;
-                            float const b6 = c6 - c7;
-                            float const b7 = c7;
-
-                            block_component[l * 8 + 0] = b0 + b7;
-                            block_component[l * 8 + 1] = b1 + b6;
-                            block_component[l * 8 + 2] = b2 + b5;
-                            block_component[l * 8 + 3] = b3 + b4;
-                            block_component[l * 8 + 4] = b3 - b4;
-                            block_component[l * 8 + 5] = b2 - b5;
-                            block_component[l * 8 + 6] = b1 - b6;
-                            block_component[l * 8 + 7] = b0 - b7;
+
+                        if (context.block_size < 8) {
+                            inverse_dct_reduced(block_component, context.block_size);
+                            continue;
                         }
+
+                        // The columns first, then the rows (as the columns of the transposed block).
+                        inverse_dct_columns(&block_component[0]);
+                        inverse_dct_columns(&block_component[4]);
+                        transpose_block_component(block_component);
+                        inverse_dct_columns(&block_component[0]);
+                        inverse_dct_columns(&block_component[4]);
+                        transpose_block_component(block_component);
                     }
                 }
             }
@@ -1031,9 +1211,11 @@ static void inverse_dct(JPGLoadingContext const& context, Vector<Macroblock>& ma
     }
 }
 
-static void ycbcr_to_rgb(JPGLoadingContext const& context, Vector<Macroblock>& macroblocks)
+// Like ycbcr_to_rgb(), for images decoded at a reduced size.
+static void ycbcr_to_rgb_reduced(JPGLoadingContext const& context, Vector<Macroblock>& macroblocks, u32 first_mcu_row, u32 end_mcu_row)
 {
-    for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.vsample_factor) {
+    u8 const block_size = context.block_size;
+    for (u32 vcursor = first_mcu_row * context.vsample_factor; vcursor < min(end_mcu_row * context.vsample_factor, context.mblock_meta.vcount); vcursor += context.vsample_factor) {
         for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.hsample_factor) {
             const u32 chroma_block_index = vcursor * context.mblock_meta.hpadded_count + hcursor;
             Macroblock const& chroma = macroblocks[chroma_block_index];
@@ -1044,18 +1226,18 @@ static void ycbcr_to_rgb(JPGLoadingContext const& context, Vector<Macroblock>& m
                     i32* y = macroblocks[mb_index].y;
                     i32* cb = macroblocks[mb_index].cb;
                     i32* cr = macroblocks[mb_index].cr;
-                    for (u8 i = 7; i < 8; --i) {
-                        for (u8 j = 7; j < 8; --j) {
+                    for (u8 i = block_size - 1; i < block_size; --i) {
+                        const u32 chroma_pxrow = (i / context.vsample_factor) + block_size / 2 * vfactor_i;
+                        for (u8 j = block_size - 1; j < block_size; --j) {
+                            const u32 chroma_pxcol = (j / context.hsample_factor) + block_size / 2 * hfactor_i;
                             const u8 pixel = i * 8 + j;
-                            const u32 chroma_pxrow = (i / context.vsample_factor) + 4 * vfactor_i;
-                            const u32 chroma_pxcol = (j / context.hsample_factor) + 4 * hfactor_i;
                             const u32 chroma_pixel = chroma_pxrow * 8 + chroma_pxcol;
-                            int r = y[pixel] + 1.402f * chroma.cr[chroma_pixel] + 128;
-                            int g = y[pixel] - 0.344f * chroma.cb[chroma_pixel] - 0.714f * chroma.cr[chroma_pixel] + 128;
-                            int b = y[pixel] + 1.772f * chroma.cb[chroma_pixel] + 128;
-                            y[pixel] = r < 0 ? 0 : (r > 255 ? 255 : r);
-                            cb[pixel] = g < 0 ? 0 : (g > 255 ? 255 : g);
-                            cr[pixel] = b < 0 ? 0 : (b > 255 ? 255 : b);
+                            float luma = y[pixel];
+                            float chroma_cb = chroma.cb[chroma_pixel];
+                            float chroma_cr = chroma.cr[chroma_pixel];
+                            y[pixel] = clamp(luma + 1.402f * chroma_cr + 128.0f, 0.0f, 255.0f);
+                            cb[pixel] = clamp(luma - 0.344f * chroma_cb - 0.714f * chroma_cr + 128.0f, 0.0f, 255.0f);
+                            cr[pixel] = clamp(luma + 1.772f * chroma_cb + 128.0f, 0.0f, 255.0f);
                         }
                     }
                 }
@@ -1064,29 +1246,74 @@ static void ycbcr_to_rgb(JPGLoadingContext const& context, Vector<Macroblock>& m
     }
 }
 
-static bool compose_bitmap(JPGLoadingContext& context, Vector<Macroblock> const& macroblocks)
+static void ycbcr_to_rgb(JPGLoadingContext const& context, Vector<Macroblock>& macroblocks, u32 first_mcu_row, u32 end_mcu_row)
 {
-    auto bitmap_or_error = Bitmap::try_create(BitmapFormat::BGRx8888, { context.frame.width, context.frame.height });
-    if (bitmap_or_error.is_error())
-        return false;
-    context.bitmap = bitmap_or_error.release_value_but_fixme_should_propagate_errors();
-    if (bitmap_or_error.is_error())
-        return false;
+    if (context.block_size < 8)
+        return ycbcr_to_rgb_reduced(context, macroblocks, first_mcu_row, end_mcu_row);
 
-    for (u32 y = context.frame.height - 1; y < context.frame.height; y--) {
-        const u32 block_row = y / 8;
-        const u32 pixel_row = y % 8;
-        for (u32 x = 0; x < context.frame.width; x++) {
-            const u32 block_column = x / 8;
+    for (u32 vcursor = first_mcu_row * context.vsample_factor; vcursor < min(end_mcu_row * context.vsample_factor, context.mblock_meta.vcount); vcursor += context.vsample_factor) {
+        for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.hsample_factor) {
+            const u32 chroma_block_index = vcursor * context.mblock_meta.hpadded_count + hcursor;
+            Macroblock const& chroma = macroblocks[chroma_block_index];
+            // Overflows are intentional.
+            for (u8 vfactor_i = context.vsample_factor - 1; vfactor_i < context.vsample_factor; --vfactor_i) {
+                for (u8 hfactor_i = context.hsample_factor - 1; hfactor_i < context.hsample_factor; --hfactor_i) {
+                    u32 mb_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hcursor + hfactor_i);
+                    i32* y = macroblocks[mb_index].y;
+                    i32* cb = macroblocks[mb_index].cb;
+                    i32* cr = macroblocks[mb_index].cr;
+                    for (u8 i = 7; i < 8; --i) {
+                        const u32 chroma_pxrow = (i / context.vsample_factor) + 4 * vfactor_i;
+                        i32 const* chroma_cb_row = &chroma.cb[chroma_pxrow * 8];
+                        i32 const* chroma_cr_row = &chroma.cr[chroma_pxrow * 8];
+
+                        // Four pixels at a time, going backwards like the loops above: The chroma block is converted
+                        // in place, so its pixels can only be overwritten once they have been read for all pixels.
+                        for (u8 j = 4; j < 8; j -= 4) {
+                            const u8 pixel = i * 8 + j;
+                            u32 chroma_pxcol[4];
+                            for (u8 k = 0; k < 4; ++k)
+                                chroma_pxcol[k] = ((j + k) / context.hsample_factor) + 4 * hfactor_i;
+
+                            auto luma = AK::SIMD::to_f32x4(load_i32x4(&y[pixel]));
+                            auto chroma_cb = AK::SIMD::to_f32x4(i32x4 { chroma_cb_row[chroma_pxcol[0]], chroma_cb_row[chroma_pxcol[1]], chroma_cb_row[chroma_pxcol[2]], chroma_cb_row[chroma_pxcol[3]] });
+                            auto chroma_cr = AK::SIMD::to_f32x4(i32x4 { chroma_cr_row[chroma_pxcol[0]], chroma_cr_row[chroma_pxcol[1]], chroma_cr_row[chroma_pxcol[2]], chroma_cr_row[chroma_pxcol[3]] });
+
+                            auto r = luma + 1.402f * chroma_cr + 128.0f;
+                            auto g = luma - 0.344f * chroma_cb - 0.714f * chroma_cr + 128.0f;
+                            auto b = luma + 1.772f * chroma_cb + 128.0f;
+                            store_i32x4(&y[pixel], AK::SIMD::to_i32x4(AK::SIMD::clamp(r, 0.0f, 255.0f)));
+                            store_i32x4(&cb[pixel], AK::SIMD::to_i32x4(AK::SIMD::clamp(g, 0.0f, 255.0f)));
+                            store_i32x4(&cr[pixel], AK::SIMD::to_i32x4(AK::SIMD::clamp(b, 0.0f, 255.0f)));
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void compose_bitmap(JPGLoadingContext& context, Vector<Macroblock> const& macroblocks, u32 first_mcu_row, u32 end_mcu_row)
+{
+    // The block size is a power of two.
+    u32 const block_size_shift = count_trailing_zeroes(static_cast<u32>(context.block_size));
+    u32 const block_size_mask = context.block_size - 1;
+    u32 const first_y = first_mcu_row * context.vsample_factor * context.block_size;
+    u32 const end_y = min<u32>(end_mcu_row * context.vsample_factor * context.block_size, context.bitmap->height());
+    u32 const width = context.bitmap->width();
+    for (u32 y = first_y; y < end_y; y++) {
+        const u32 block_row = y >> block_size_shift;
+        const u32 pixel_row = y & block_size_mask;
+        auto* scanline = context.bitmap->scanline(y);
+        for (u32 x = 0; x < width; x++) {
+            const u32 block_column = x >> block_size_shift;
             auto& block = macroblocks[block_row * context.mblock_meta.hpadded_count + block_column];
-            const u32 pixel_column = x % 8;
+            const u32 pixel_column = x & block_size_mask;
             const u32 pixel_index = pixel_row * 8 + pixel_column;
             const Color color { (u8)block.y[pixel_index], (u8)block.cb[pixel_index], (u8)block.cr[pixel_index] };
-            context.bitmap->set_pixel(x, y, color);
+            scanline[x] = color.value();
         }
     }
-
-    return true;
 }
 
 static bool parse_header(InputMemoryStream& stream, JPGLoadingContext& context)
@@ -1156,73 +1383,132 @@ static bool parse_header(InputMemoryStream& stream, JPGLoadingContext& context)
     VERIFY_NOT_REACHED();
 }
 
-static bool scan_huffman_stream(InputMemoryStream& stream, JPGLoadingContext& context)
+// Collects the entropy-coded data that follows the header, up to the end of the image. If the data is still arriving,
+// this stops at the end of what has arrived so far and continues from there next time.
+static bool scan_huffman_stream(JPGLoadingContext& context)
 {
-    u8 last_byte;
-    u8 current_byte = 0;
-    stream >> current_byte;
-    if (stream.handle_any_error())
-        return false;
-
-    for (;;) {
-        last_byte = current_byte;
-        stream >> current_byte;
-        if (stream.handle_any_error()) {
-            dbgln_if(JPG_DEBUG, "{}: EOI not found!", stream.offset());
-            return false;
+    auto& offset = context.scanned_data_size;
+    while (offset < context.data_size) {
+        u8 current_byte = context.data[offset];
+        if (current_byte != 0xFF) {
+            context.huffman_data.append(current_byte);
+            offset++;
+            continue;
         }
 
-        if (last_byte == 0xFF) {
-            if (current_byte == 0xFF)
-                continue;
-            if (current_byte == 0x00) {
-                stream >> current_byte;
-                if (stream.handle_any_error())
-                    return false;
-                context.huffman_stream.stream.append(last_byte);
-                continue;
-            }
-            Marker marker = 0xFF00 | current_byte;
-            if (marker == JPG_EOI)
-                return true;
-            if (marker >= JPG_RST0 && marker <= JPG_RST7) {
-                context.huffman_stream.stream.append(marker);
-                stream >> current_byte;
-                if (stream.handle_any_error())
-                    return false;
-                continue;
-            }
-            dbgln_if(JPG_DEBUG, "{}: Invalid marker: {:x}!", stream.offset(), marker);
-            return false;
-        } else {
-            context.huffman_stream.stream.append(last_byte);
+        // Wait for the second byte of the marker.
+        if (offset + 1 >= context.data_size)
+            break;
+
+        u8 next_byte = context.data[offset + 1];
+        if (next_byte == 0xFF) {
+            offset++;
+            continue;
         }
+        if (next_byte == 0x00) {
+            context.huffman_data.append(current_byte);
+            offset += 2;
+            continue;
+        }
+        Marker marker = 0xFF00 | next_byte;
+        if (marker == JPG_EOI) {
+            offset += 2;
+            context.has_scanned_end_of_image = true;
+            return true;
+        }
+        if (marker >= JPG_RST0 && marker <= JPG_RST7) {
+            context.restart_interval_offsets.append(context.huffman_data.size());
+            offset += 2;
+            continue;
+        }
+        dbgln_if(JPG_DEBUG, "{}: Invalid marker: {:x}!", offset, marker);
+        return false;
     }
 
-    VERIFY_NOT_REACHED();
+    if (context.is_data_complete) {
+        dbgln_if(JPG_DEBUG, "{}: EOI not found!", offset);
+        return false;
+    }
+    return true;
+}
+
+// Turns the MCU rows that have been decoded since the last call into pixels.
+static void convert_decoded_mcu_rows(JPGLoadingContext& context)
+{
+    auto decoded_mcu_row_count = context.decoded_mcu_count / mcus_per_row(context);
+    if (decoded_mcu_row_count <= context.converted_mcu_row_count)
+        return;
+
+    auto first_mcu_row = context.converted_mcu_row_count;
+    auto row_count = decoded_mcu_row_count - first_mcu_row;
+    for_each_part_in_parallel(row_count, thread_count_for(context, row_count), [&](u32 first, u32 end) {
+        dequantize(context, context.macroblocks, first_mcu_row + first, first_mcu_row + end);
+        inverse_dct(context, context.macroblocks, first_mcu_row + first, first_mcu_row + end);
+        ycbcr_to_rgb(context, context.macroblocks, first_mcu_row + first, first_mcu_row + end);
+        compose_bitmap(context, context.macroblocks, first_mcu_row + first, first_mcu_row + end);
+        return true;
+    });
+    context.converted_mcu_row_count = decoded_mcu_row_count;
+}
+
+// The smallest block size that still decodes the image to at least the ideal size.
+static u8 block_size_for_ideal_size(JPGLoadingContext const& context, Optional<IntSize> ideal_size)
+{
+    if (!ideal_size.has_value() || ideal_size->is_empty())
+        return 8;
+
+    u8 block_size = 8;
+    while (block_size > 1) {
+        u8 smaller_block_size = block_size / 2;
+        if (ceil_div(context.frame.width * smaller_block_size, 8) < ideal_size->width()
+            || ceil_div(context.frame.height * smaller_block_size, 8) < ideal_size->height())
+            break;
+        block_size = smaller_block_size;
+    }
+    return block_size;
 }
 
 static bool decode_jpg(JPGLoadingContext& context)
 {
-    InputMemoryStream stream { { context.data, context.data_size } };
+    if (context.state < JPGLoadingContext::State::HeaderDecoded) {
+        InputMemoryStream stream { { context.data, context.data_size } };
+        if (!parse_header(stream, context))
+            return false;
+        context.scanned_data_size = stream.offset();
 
-    if (!parse_header(stream, context))
-        return false;
-    if (!scan_huffman_stream(stream, context))
+        // Compute huffman codes for DC and AC tables.
+        for (auto it = context.dc_tables.begin(); it != context.dc_tables.end(); ++it)
+            generate_huffman_codes(it->value);
+        for (auto it = context.ac_tables.begin(); it != context.ac_tables.end(); ++it)
+            generate_huffman_codes(it->value);
+
+        if (context.macroblocks.try_resize(context.mblock_meta.padded_total).is_error())
+            return false;
+        context.block_size = block_size_for_ideal_size(context, context.ideal_size);
+        IntSize bitmap_size { ceil_div(context.frame.width * context.block_size, 8), ceil_div(context.frame.height * context.block_size, 8) };
+        auto bitmap_or_error = Bitmap::try_create(BitmapFormat::BGRx8888, bitmap_size);
+        if (bitmap_or_error.is_error())
+            return false;
+        context.bitmap = bitmap_or_error.release_value();
+        context.state = JPGLoadingContext::State::HeaderDecoded;
+    }
+
+    if (!scan_huffman_stream(context))
         return false;
 
-    auto result = decode_huffman_stream(context);
-    if (!result.has_value()) {
-        dbgln_if(JPG_DEBUG, "{}: Failed to decode Macroblocks!", stream.offset());
+    if (!decode_huffman_stream(context)) {
+        dbgln_if(JPG_DEBUG, "Failed to decode Macroblocks!");
         return false;
     }
 
-    auto macroblocks = result.release_value();
-    dequantize(context, macroblocks);
-    inverse_dct(context, macroblocks);
-    ycbcr_to_rgb(context, macroblocks);
-    if (!compose_bitmap(context, macroblocks))
-        return false;
+    convert_decoded_mcu_rows(context);
+
+    if (context.decoded_mcu_count == mcus_per_row(context) * mcu_row_count(context)) {
+        context.state = JPGLoadingContext::State::BitmapDecoded;
+        // We're done with these, and they're about as large as the bitmap.
+        context.macroblocks.clear();
+        context.huffman_data.clear();
+    }
     return true;
 }
 
@@ -1231,7 +1517,7 @@ JPGImageDecoderPlugin::JPGImageDecoderPlugin(u8 const* data, size_t size)
     m_context = make<JPGLoadingContext>();
     m_context->data = data;
     m_context->data_size = size;
-    m_context->huffman_stream.stream.ensure_capacity(50 * KiB);
+    m_context->huffman_data.ensure_capacity(size);
 }
 
 JPGImageDecoderPlugin::~JPGImageDecoderPlugin() = default;
@@ -1282,7 +1568,7 @@ size_t JPGImageDecoderPlugin::frame_count()
     return 1;
 }
 
-ErrorOr<ImageFrameDescriptor> JPGImageDecoderPlugin::frame(size_t index)
+ErrorOr<ImageFrameDescriptor> JPGImageDecoderPlugin::frame(size_t index, Optional<IntSize> ideal_size)
 {
     if (index > 0)
         return Error::from_string_literal("JPGImageDecoderPlugin: Invalid frame index");
@@ -1290,15 +1576,57 @@ ErrorOr<ImageFrameDescriptor> JPGImageDecoderPlugin::frame(size_t index)
     if (m_context->state == JPGLoadingContext::State::Error)
         return Error::from_string_literal("JPGImageDecoderPlugin: Decoding failed");
 
+    if (m_context->state == JPGLoadingContext::State::BitmapDecoded && !m_is_incremental
+        && block_size_for_ideal_size(*m_context, ideal_size) != m_context->block_size) {
+        // The image was decoded at a different size, so decode it again.
+        reset_context();
+    }
+
+    if (m_context->state < JPGLoadingContext::State::HeaderDecoded)
+        m_context->ideal_size = ideal_size;
+
     if (m_context->state < JPGLoadingContext::State::BitmapDecoded) {
         if (!decode_jpg(*m_context)) {
+            if (!m_context->is_data_complete && m_context->state < JPGLoadingContext::State::HeaderDecoded) {
+                // The header might just not have arrived completely yet, so start over once there's more data.
+                reset_context();
+                return Error::from_string_literal("JPGImageDecoderPlugin: Not enough data to decode the header yet");
+            }
             m_context->state = JPGLoadingContext::State::Error;
             return Error::from_string_literal("JPGImageDecoderPlugin: Decoding failed");
         }
-        m_context->state = JPGLoadingContext::State::BitmapDecoded;
     }
 
     return ImageFrameDescriptor { m_context->bitmap, 0 };
 }
 
+void JPGImageDecoderPlugin::reset_context()
+{
+    auto context = make<JPGLoadingContext>();
+    context->data = m_context->data;
+    context->data_size = m_context->data_size;
+    context->is_data_complete = m_context->is_data_complete;
+    context->ideal_size = m_context->ideal_size;
+    m_context = move(context);
+}
+
+ErrorOr<void> JPGImageDecoderPlugin::append_data(ReadonlyBytes bytes)
+{
+    if (!m_is_incremental) {
+        // Until now, the context has been looking at data we don't own.
+        TRY(m_incremental_data.try_append(m_context->data, m_context->data_size));
+        m_is_incremental = true;
+    }
+    TRY(m_incremental_data.try_append(bytes));
+    m_context->data = m_incremental_data.data();
+    m_context->data_size = m_incremental_data.size();
+    m_context->is_data_complete = false;
+    return {};
+}
+
+void JPGImageDecoderPlugin::finish_data()
+{
+    m_context->is_data_complete = true;
+}
+
 }
@@ -23,9 +23,16 @@ public:
     virtual bool is_animated() override;
     virtual size_t loop_count() override;
     virtual size_t frame_count() override;
-    virtual ErrorOr<ImageFrameDescriptor> frame(size_t index) override;
+    virtual ErrorOr<ImageFrameDescriptor> frame(size_t index, Optional<IntSize> ideal_size = {}) override;
+    virtual bool supports_incremental_decoding() const override { return true; }
+    virtual ErrorOr<void> append_data(ReadonlyBytes) override;
+    virtual void finish_data() override;
 
 private:
+    void reset_context();
+
     OwnPtr<JPGLoadingContext> m_context;
+    bool m_is_incremental { false };
+    ByteBuffer m_incremental_data;
 };
 }
@@ -8,7 +8,11 @@
 #include <AK/Array.h>
 #include <AK/Debug.h>
 #include <AK/Endian.h>
+#include <AK/MemoryStream.h>
+#include <AK/SIMD.h>
+#include <AK/ScopeGuard.h>
 #include <AK/Vector.h>
+#include <LibCompress/Deflate.h>
 #include <LibCompress/Zlib.h>
 #include <LibGfx/PNGLoader.h>
 #include <LibGfx/PNGShared.h>
@@ -28,11 +32,6 @@ struct PNG_IHDR {
 
 static_assert(AssertSize<PNG_IHDR, 13>());
 
-struct Scanline {
-    PNG::FilterType filter;
-    ReadonlyBytes data {};
-};
-
 struct [[gnu::packed]] PaletteEntry {
     u8 r;
     u8 g;
@@ -90,11 +89,13 @@ struct PNGLoadingContext {
     u8 channels { 0 };
     bool has_seen_zlib_header { false };
     bool has_alpha() const { return to_underlying(color_type) & 4 || palette_transparency_data.size() > 0; }
-    Vector<Scanline> scanlines;
-    ByteBuffer unfiltered_data;
     RefPtr<Gfx::Bitmap> bitmap;
-    ByteBuffer* decompression_buffer { nullptr };
     Vector<u8> compressed_data;
+
+    // The size the caller would like the bitmap to be, see ImageDecoderPlugin::frame().
+    Optional<IntSize> ideal_size;
+    // Interlaced images are decoded at 1/downscale_factor of their size if that's enough, see decode_png_adam7().
+    int downscale_factor { 1 };
     Vector<PaletteEntry> palette_data;
     Vector<u8> palette_transparency_data;
 
@@ -173,10 +174,114 @@ union [[gnu::packed]] Pixel {
 };
 static_assert(AssertSize<Pixel, 4>());
 
+// The Sub, Average and Paeth filters depend on the byte one pixel to the left, so instead of working on many bytes at
+// once, we work on all bytes of one pixel at once. Intermediate values are kept as i16 so that they don't overflow.
+template<size_t bytes_per_pixel>
+ALWAYS_INLINE static AK::SIMD::i16x4 load_pixel(u8 const* data)
+{
+    if constexpr (bytes_per_pixel == 4) {
+        AK::SIMD::u8x4 pixel;
+        memcpy(&pixel, data, sizeof(pixel));
+        return __builtin_convertvector(pixel, AK::SIMD::i16x4);
+    } else {
+        static_assert(bytes_per_pixel == 3);
+        return AK::SIMD::i16x4 { data[0], data[1], data[2], 0 };
+    }
+}
+
+template<size_t bytes_per_pixel>
+ALWAYS_INLINE static void store_pixel(u8* data, AK::SIMD::i16x4 pixel)
+{
+    if constexpr (bytes_per_pixel == 4) {
+        auto bytes = __builtin_convertvector(pixel, AK::SIMD::u8x4);
+        memcpy(data, &bytes, sizeof(bytes));
+    } else {
+        static_assert(bytes_per_pixel == 3);
+        data[0] = pixel[0];
+        data[1] = pixel[1];
+        data[2] = pixel[2];
+    }
+}
+
+ALWAYS_INLINE static AK::SIMD::i16x4 absolute_value(AK::SIMD::i16x4 value)
+{
+    auto sign = value >> 15;
+    return (value ^ sign) - sign;
+}
+
+template<size_t bytes_per_pixel>
+static void unfilter_scanline_by_pixel(PNG::FilterType filter, Bytes scanline_data, ReadonlyBytes previous_scanlines_data)
+{
+    using AK::SIMD::i16x4;
+
+    auto* data = scanline_data.data();
+    auto const* previous_data = previous_scanlines_data.data();
+    // Pixels to the left of the first one are treated as 0.
+    i16x4 left {};
+    i16x4 upper_left {};
+
+    switch (filter) {
+    case PNG::FilterType::Sub:
+        for (size_t i = 0; i < scanline_data.size(); i += bytes_per_pixel) {
+            left = (load_pixel<bytes_per_pixel>(data + i) + left) & 0xff;
+            store_pixel<bytes_per_pixel>(data + i, left);
+        }
+        break;
+    case PNG::FilterType::Average:
+        for (size_t i = 0; i < scanline_data.size(); i += bytes_per_pixel) {
+            auto above = load_pixel<bytes_per_pixel>(previous_data + i);
+            left = (load_pixel<bytes_per_pixel>(data + i) + ((left + above) >> 1)) & 0xff;
+            store_pixel<bytes_per_pixel>(data + i, left);
+        }
+        break;
+    case PNG::FilterType::Paeth:
+        for (size_t i = 0; i < scanline_data.size(); i += bytes_per_pixel) {
+            auto above = load_pixel<bytes_per_pixel>(previous_data + i);
+            // With predictor = left + above - upper_left, these are the distances from the predictor to left, above and upper_left.
+            auto predictor_left = absolute_value(above - upper_left);
+            auto predictor_above = absolute_value(left - upper_left);
+            auto predictor_upper_left = absolute_value(above - upper_left + left - upper_left);
+            // Comparisons yield all bits set in the lanes where they hold.
+            auto use_left = (predictor_left <= predictor_above) & (predictor_left <= predictor_upper_left);
+            auto use_above = ~use_left & (predictor_above <= predictor_upper_left);
+            auto use_upper_left = ~(use_left | use_above);
+            auto nearest = (left & use_left) | (above & use_above) | (upper_left & use_upper_left);
+            left = (load_pixel<bytes_per_pixel>(data + i) + nearest) & 0xff;
+            store_pixel<bytes_per_pixel>(data + i, left);
+            upper_left = above;
+        }
+        break;
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
 static void unfilter_scanline(PNG::FilterType filter, Bytes scanline_data, ReadonlyBytes previous_scanlines_data, u8 bytes_per_complete_pixel)
 {
     VERIFY(filter != PNG::FilterType::None);
 
+    if (filter == PNG::FilterType::Up) {
+        // Every byte only depends on the one above it, so we can do 16 of them at a time.
+        size_t i = 0;
+        for (; i + sizeof(AK::SIMD::u8x16) <= scanline_data.size(); i += sizeof(AK::SIMD::u8x16)) {
+            AK::SIMD::u8x16 current;
+            AK::SIMD::u8x16 above;
+            memcpy(&current, scanline_data.data() + i, sizeof(current));
+            memcpy(&above, previous_scanlines_data.data() + i, sizeof(above));
+            current += above;
+            memcpy(scanline_data.data() + i, &current, sizeof(current));
+        }
+        for (; i < scanline_data.size(); ++i)
+            scanline_data[i] += previous_scanlines_data[i];
+        return;
+    }
+
+    // 8-bit RGB and RGBA images are by far the most common, so they get a faster path.
+    if (bytes_per_complete_pixel == 3)
+        return unfilter_scanline_by_pixel<3>(filter, scanline_data, previous_scanlines_data);
+    if (bytes_per_complete_pixel == 4)
+        return unfilter_scanline_by_pixel<4>(filter, scanline_data, previous_scanlines_data);
+
     switch (filter) {
     case PNG::FilterType::Sub:
         // This loop starts at bytes_per_complete_pixel because all bytes before that are
@@ -189,12 +294,6 @@ static void unfilter_scanline(PNG::FilterType filter, Bytes scanline_data, Reado
             scanline_data[i] += left;
         }
         break;
-    case PNG::FilterType::Up:
-        for (size_t i = 0; i < scanline_data.size(); ++i) {
-            u8 above = previous_scanlines_data[i];
-            scanline_data[i] += above;
-        }
-        break;
     case PNG::FilterType::Average:
         for (size_t i = 0; i < scanline_data.size(); ++i) {
             u32 left = (i < bytes_per_complete_pixel) ? 0 : scanline_data[i - bytes_per_complete_pixel];
@@ -229,132 +328,82 @@ static void unfilter_scanline(PNG::FilterType filter, Bytes scanline_data, Reado
 }
 
 template<typename T>
-ALWAYS_INLINE static void unpack_grayscale_without_alpha(PNGLoadingContext& context)
-{
-    for (int y = 0; y < context.height; ++y) {
-        auto* gray_values = reinterpret_cast<const T*>(context.scanlines[y].data.data());
-        for (int i = 0; i < context.width; ++i) {
-            auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-            pixel.r = gray_values[i];
-            pixel.g = gray_values[i];
-            pixel.b = gray_values[i];
-            pixel.a = 0xff;
-        }
+ALWAYS_INLINE static void unpack_grayscale_without_alpha(ReadonlyBytes scanline, Pixel* pixels, int width)
+{
+    auto* gray_values = reinterpret_cast<const T*>(scanline.data());
+    for (int i = 0; i < width; ++i) {
+        auto& pixel = pixels[i];
+        pixel.r = gray_values[i];
+        pixel.g = gray_values[i];
+        pixel.b = gray_values[i];
+        pixel.a = 0xff;
     }
 }
 
 template<typename T>
-ALWAYS_INLINE static void unpack_grayscale_with_alpha(PNGLoadingContext& context)
-{
-    for (int y = 0; y < context.height; ++y) {
-        auto* tuples = reinterpret_cast<Tuple<T> const*>(context.scanlines[y].data.data());
-        for (int i = 0; i < context.width; ++i) {
-            auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-            pixel.r = tuples[i].gray;
-            pixel.g = tuples[i].gray;
-            pixel.b = tuples[i].gray;
-            pixel.a = tuples[i].a;
-        }
+ALWAYS_INLINE static void unpack_grayscale_with_alpha(ReadonlyBytes scanline, Pixel* pixels, int width)
+{
+    auto* tuples = reinterpret_cast<Tuple<T> const*>(scanline.data());
+    for (int i = 0; i < width; ++i) {
+        auto& pixel = pixels[i];
+        pixel.r = tuples[i].gray;
+        pixel.g = tuples[i].gray;
+        pixel.b = tuples[i].gray;
+        pixel.a = tuples[i].a;
     }
 }
 
 template<typename T>
-ALWAYS_INLINE static void unpack_triplets_without_alpha(PNGLoadingContext& context)
-{
-    for (int y = 0; y < context.height; ++y) {
-        auto* triplets = reinterpret_cast<Triplet<T> const*>(context.scanlines[y].data.data());
-        for (int i = 0; i < context.width; ++i) {
-            auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-            pixel.r = triplets[i].r;
-            pixel.g = triplets[i].g;
-            pixel.b = triplets[i].b;
-            pixel.a = 0xff;
-        }
+ALWAYS_INLINE static void unpack_triplets_without_alpha(ReadonlyBytes scanline, Pixel* pixels, int width)
+{
+    auto* triplets = reinterpret_cast<Triplet<T> const*>(scanline.data());
+    for (int i = 0; i < width; ++i) {
+        auto& pixel = pixels[i];
+        pixel.r = triplets[i].r;
+        pixel.g = triplets[i].g;
+        pixel.b = triplets[i].b;
+        pixel.a = 0xff;
     }
 }
 
 template<typename T>
-ALWAYS_INLINE static void unpack_triplets_with_transparency_value(PNGLoadingContext& context, Triplet<T> transparency_value)
-{
-    for (int y = 0; y < context.height; ++y) {
-        auto* triplets = reinterpret_cast<Triplet<T> const*>(context.scanlines[y].data.data());
-        for (int i = 0; i < context.width; ++i) {
-            auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-            pixel.r = triplets[i].r;
-            pixel.g = triplets[i].g;
-            pixel.b = triplets[i].b;
-            if (triplets[i] == transparency_value)
-                pixel.a = 0x00;
-            else
-                pixel.a = 0xff;
-        }
+ALWAYS_INLINE static void unpack_triplets_with_transparency_value(ReadonlyBytes scanline, Pixel* pixels, int width, Triplet<T> transparency_value)
+{
+    auto* triplets = reinterpret_cast<Triplet<T> const*>(scanline.data());
+    for (int i = 0; i < width; ++i) {
+        auto& pixel = pixels[i];
+        pixel.r = triplets[i].r;
+        pixel.g = triplets[i].g;
+        pixel.b = triplets[i].b;
+        if (triplets[i] == transparency_value)
+            pixel.a = 0x00;
+        else
+            pixel.a = 0xff;
     }
 }
 
-NEVER_INLINE FLATTEN static ErrorOr<void> unfilter(PNGLoadingContext& context)
+// Unpacks an unfiltered scanline of `width` pixels to BGRA.
+NEVER_INLINE FLATTEN static ErrorOr<void> unpack_scanline(PNGLoadingContext const& context, ReadonlyBytes scanline, Pixel* pixels, int width)
 {
-    // First unfilter the scanlines:
-
-    // FIXME: Instead of creating a separate buffer for the scanlines that need to be
-    //        mutated, the mutation could be done in place (if the data was non-const).
-    size_t bytes_per_scanline = context.scanlines[0].data.size();
-    size_t bytes_needed_for_all_unfiltered_scanlines = 0;
-    for (int y = 0; y < context.height; ++y) {
-        if (context.scanlines[y].filter != PNG::FilterType::None) {
-            bytes_needed_for_all_unfiltered_scanlines += bytes_per_scanline;
-        }
-    }
-    context.unfiltered_data = TRY(ByteBuffer::create_uninitialized(bytes_needed_for_all_unfiltered_scanlines));
-
-    // From section 6.3 of http://www.libpng.org/pub/png/spec/1.2/PNG-Filters.html
-    // "bpp is defined as the number of bytes per complete pixel, rounding up to one.
-    // For example, for color type 2 with a bit depth of 16, bpp is equal to 6
-    // (three samples, two bytes per sample); for color type 0 with a bit depth of 2,
-    // bpp is equal to 1 (rounding up); for color type 4 with a bit depth of 16, bpp
-    // is equal to 4 (two-byte grayscale sample, plus two-byte alpha sample)."
-    u8 bytes_per_complete_pixel = (context.bit_depth + 7) / 8 * context.channels;
-
-    u8 dummy_scanline_bytes[bytes_per_scanline];
-    memset(dummy_scanline_bytes, 0, sizeof(dummy_scanline_bytes));
-    auto previous_scanlines_data = ReadonlyBytes { dummy_scanline_bytes, sizeof(dummy_scanline_bytes) };
-
-    for (int y = 0, data_start = 0; y < context.height; ++y) {
-        if (context.scanlines[y].filter != PNG::FilterType::None) {
-            auto scanline_data_slice = context.unfiltered_data.bytes().slice(data_start, bytes_per_scanline);
-
-            // Copy the current values over and set the scanline's data to the to-be-mutated slice
-            context.scanlines[y].data.copy_to(scanline_data_slice);
-            context.scanlines[y].data = scanline_data_slice;
-
-            unfilter_scanline(context.scanlines[y].filter, scanline_data_slice, previous_scanlines_data, bytes_per_complete_pixel);
-
-            data_start += bytes_per_scanline;
-        }
-        previous_scanlines_data = context.scanlines[y].data;
-    }
-
-    // Now unpack the scanlines to RGBA:
     switch (context.color_type) {
     case PNG::ColorType::Greyscale:
         if (context.bit_depth == 8) {
-            unpack_grayscale_without_alpha<u8>(context);
+            unpack_grayscale_without_alpha<u8>(scanline, pixels, width);
         } else if (context.bit_depth == 16) {
-            unpack_grayscale_without_alpha<u16>(context);
+            unpack_grayscale_without_alpha<u16>(scanline, pixels, width);
         } else if (context.bit_depth == 1 || context.bit_depth == 2 || context.bit_depth == 4) {
             auto bit_depth_squared = context.bit_depth * context.bit_depth;
             auto pixels_per_byte = 8 / context.bit_depth;
             auto mask = (1 << context.bit_depth) - 1;
-            for (int y = 0; y < context.height; ++y) {
-                auto* gray_values = context.scanlines[y].data.data();
-                for (int x = 0; x < context.width; ++x) {
-                    auto bit_offset = (8 - context.bit_depth) - (context.bit_depth * (x % pixels_per_byte));
-                    auto value = (gray_values[x / pixels_per_byte] >> bit_offset) & mask;
-                    auto& pixel = (Pixel&)context.bitmap->scanline(y)[x];
-                    pixel.r = value * (0xff / bit_depth_squared);
-                    pixel.g = value * (0xff / bit_depth_squared);
-                    pixel.b = value * (0xff / bit_depth_squared);
-                    pixel.a = 0xff;
-                }
+            auto* gray_values = scanline.data();
+            for (int x = 0; x < width; ++x) {
+                auto bit_offset = (8 - context.bit_depth) - (context.bit_depth * (x % pixels_per_byte));
+                auto value = (gray_values[x / pixels_per_byte] >> bit_offset) & mask;
+                auto& pixel = pixels[x];
+                pixel.r = value * (0xff / bit_depth_squared);
+                pixel.g = value * (0xff / bit_depth_squared);
+                pixel.b = value * (0xff / bit_depth_squared);
+                pixel.a = 0xff;
             }
         } else {
             VERIFY_NOT_REACHED();
@@ -362,9 +411,9 @@ NEVER_INLINE FLATTEN static ErrorOr<void> unfilter(PNGLoadingContext& context)
         break;
     case PNG::ColorType::GreyscaleWithAlpha:
         if (context.bit_depth == 8) {
-            unpack_grayscale_with_alpha<u8>(context);
+            unpack_grayscale_with_alpha<u8>(scanline, pixels, width);
         } else if (context.bit_depth == 16) {
-            unpack_grayscale_with_alpha<u16>(context);
+            unpack_grayscale_with_alpha<u16>(scanline, pixels, width);
         } else {
             VERIFY_NOT_REACHED();
         }
@@ -372,39 +421,35 @@ NEVER_INLINE FLATTEN static ErrorOr<void> unfilter(PNGLoadingContext& context)
     case PNG::ColorType::Truecolor:
         if (context.palette_transparency_data.size() == 6) {
             if (context.bit_depth == 8) {
-                unpack_triplets_with_transparency_value<u8>(context, Triplet<u8> { context.palette_transparency_data[0], context.palette_transparency_data[2], context.palette_transparency_data[4] });
+                unpack_triplets_with_transparency_value<u8>(scanline, pixels, width, Triplet<u8> { context.palette_transparency_data[0], context.palette_transparency_data[2], context.palette_transparency_data[4] });
             } else if (context.bit_depth == 16) {
                 u16 tr = context.palette_transparency_data[0] | context.palette_transparency_data[1] << 8;
                 u16 tg = context.palette_transparency_data[2] | context.palette_transparency_data[3] << 8;
                 u16 tb = context.palette_transparency_data[4] | context.palette_transparency_data[5] << 8;
-                unpack_triplets_with_transparency_value<u16>(context, Triplet<u16> { tr, tg, tb });
+                unpack_triplets_with_transparency_value<u16>(scanline, pixels, width, Triplet<u16> { tr, tg, tb });
             } else {
                 VERIFY_NOT_REACHED();
             }
         } else {
             if (context.bit_depth == 8)
-                unpack_triplets_without_alpha<u8>(context);
+                unpack_triplets_without_alpha<u8>(scanline, pixels, width);
             else if (context.bit_depth == 16)
-                unpack_triplets_without_alpha<u16>(context);
+                unpack_triplets_without_alpha<u16>(scanline, pixels, width);
             else
                 VERIFY_NOT_REACHED();
         }
         break;
     case PNG::ColorType::TruecolorWithAlpha:
         if (context.bit_depth == 8) {
-            for (int y = 0; y < context.height; ++y) {
-                memcpy(context.bitmap->scanline(y), context.scanlines[y].data.data(), context.scanlines[y].data.size());
-            }
+            memcpy(pixels, scanline.data(), scanline.size());
         } else if (context.bit_depth == 16) {
-            for (int y = 0; y < context.height; ++y) {
-                auto* quartets = reinterpret_cast<Quartet<u16> const*>(context.scanlines[y].data.data());
-                for (int i = 0; i < context.width; ++i) {
-                    auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-                    pixel.r = quartets[i].r & 0xFF;
-                    pixel.g = quartets[i].g & 0xFF;
-                    pixel.b = quartets[i].b & 0xFF;
-                    pixel.a = quartets[i].a & 0xFF;
-                }
+            auto* quartets = reinterpret_cast<Quartet<u16> const*>(scanline.data());
+            for (int i = 0; i < width; ++i) {
+                auto& pixel = pixels[i];
+                pixel.r = quartets[i].r & 0xFF;
+                pixel.g = quartets[i].g & 0xFF;
+                pixel.b = quartets[i].b & 0xFF;
+                pixel.a = quartets[i].a & 0xFF;
             }
         } else {
             VERIFY_NOT_REACHED();
@@ -412,42 +457,38 @@ NEVER_INLINE FLATTEN static ErrorOr<void> unfilter(PNGLoadingContext& context)
         break;
     case PNG::ColorType::IndexedColor:
         if (context.bit_depth == 8) {
-            for (int y = 0; y < context.height; ++y) {
-                auto* palette_index = context.scanlines[y].data.data();
-                for (int i = 0; i < context.width; ++i) {
-                    auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-                    if (palette_index[i] >= context.palette_data.size())
-                        return Error::from_string_literal("PNGImageDecoderPlugin: Palette index out of range");
-                    auto& color = context.palette_data.at((int)palette_index[i]);
-                    auto transparency = context.palette_transparency_data.size() >= palette_index[i] + 1u
-                        ? context.palette_transparency_data.data()[palette_index[i]]
-                        : 0xff;
-                    pixel.r = color.r;
-                    pixel.g = color.g;
-                    pixel.b = color.b;
-                    pixel.a = transparency;
-                }
+            auto* palette_index = scanline.data();
+            for (int i = 0; i < width; ++i) {
+                auto& pixel = pixels[i];
+                if (palette_index[i] >= context.palette_data.size())
+                    return Error::from_string_literal("PNGImageDecoderPlugin: Palette index out of range");
+                auto& color = context.palette_data.at((int)palette_index[i]);
+                auto transparency = context.palette_transparency_data.size() >= palette_index[i] + 1u
+                    ? context.palette_transparency_data.data()[palette_index[i]]
+                    : 0xff;
+                pixel.r = color.r;
+                pixel.g = color.g;
+                pixel.b = color.b;
+                pixel.a = transparency;
             }
         } else if (context.bit_depth == 1 || context.bit_depth == 2 || context.bit_depth == 4) {
             auto pixels_per_byte = 8 / context.bit_depth;
             auto mask = (1 << context.bit_depth) - 1;
-            for (int y = 0; y < context.height; ++y) {
-                auto* palette_indices = context.scanlines[y].data.data();
-                for (int i = 0; i < context.width; ++i) {
-                    auto bit_offset = (8 - context.bit_depth) - (context.bit_depth * (i % pixels_per_byte));
-                    auto palette_index = (palette_indices[i / pixels_per_byte] >> bit_offset) & mask;
-                    auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-                    if ((size_t)palette_index >= context.palette_data.size())
-                        return Error::from_string_literal("PNGImageDecoderPlugin: Palette index out of range");
-                    auto& color = context.palette_data.at(palette_index);
-                    auto transparency = context.palette_transparency_data.size() >= palette_index + 1u
-                        ? context.palette_transparency_data.data()[palette_index]
-                        : 0xff;
-                    pixel.r = color.r;
-                    pixel.g = color.g;
-                    pixel.b = color.b;
-                    pixel.a = transparency;
-                }
+            auto* palette_indices = scanline.data();
+            for (int i = 0; i < width; ++i) {
+                auto bit_offset = (8 - context.bit_depth) - (context.bit_depth * (i % pixels_per_byte));
+                auto palette_index = (palette_indices[i / pixels_per_byte] >> bit_offset) & mask;
+                auto& pixel = pixels[i];
+                if ((size_t)palette_index >= context.palette_data.size())
+                    return Error::from_string_literal("PNGImageDecoderPlugin: Palette index out of range");
+                auto& color = context.palette_data.at(palette_index);
+                auto transparency = context.palette_transparency_data.size() >= palette_index + 1u
+                    ? context.palette_transparency_data.data()[palette_index]
+                    : 0xff;
+                pixel.r = color.r;
+                pixel.g = color.g;
+                pixel.b = color.b;
+                pixel.a = transparency;
             }
         } else {
             VERIFY_NOT_REACHED();
@@ -459,17 +500,57 @@ NEVER_INLINE FLATTEN static ErrorOr<void> unfilter(PNGLoadingContext& context)
     }
 
     // Swap r and b values:
-    for (int y = 0; y < context.height; ++y) {
-        auto* pixels = (Pixel*)context.bitmap->scanline(y);
-        for (int i = 0; i < context.bitmap->width(); ++i) {
-            auto& x = pixels[i];
-            swap(x.r, x.b);
-        }
+    for (int i = 0; i < width; ++i) {
+        auto& x = pixels[i];
+        swap(x.r, x.b);
     }
 
     return {};
 }
 
+// Reads `height` scanlines of `width` pixels from the decompressed image data, unfilters them and hands them to
+// `on_scanline` one at a time. Only the current and the previous scanline are kept in memory.
+template<typename Callback>
+static ErrorOr<void> decode_scanlines(PNGLoadingContext& context, InputStream& decompressor, int width, int height, Callback on_scanline)
+{
+    auto row_size = context.compute_row_size_for_width(width);
+    if (row_size.has_overflow())
+        return Error::from_string_literal("PNGImageDecoderPlugin: Row size overflow");
+
+    // From section 6.3 of http://www.libpng.org/pub/png/spec/1.2/PNG-Filters.html
+    // "bpp is defined as the number of bytes per complete pixel, rounding up to one.
+    // For example, for color type 2 with a bit depth of 16, bpp is equal to 6
+    // (three samples, two bytes per sample); for color type 0 with a bit depth of 2,
+    // bpp is equal to 1 (rounding up); for color type 4 with a bit depth of 16, bpp
+    // is equal to 4 (two-byte grayscale sample, plus two-byte alpha sample)."
+    u8 bytes_per_complete_pixel = (context.bit_depth + 7) / 8 * context.channels;
+
+    // The scanline above the first one is treated as all zeroes.
+    auto scanline_buffer = TRY(ByteBuffer::create_zeroed(row_size.value() * 2));
+    auto previous_scanline = scanline_buffer.bytes().slice(0, row_size.value());
+    auto scanline = scanline_buffer.bytes().slice(row_size.value());
+
+    for (int y = 0; y < height; ++y) {
+        u8 filter = 0;
+        if (!decompressor.read_or_error({ &filter, sizeof(filter) }) || !decompressor.read_or_error(scanline)) {
+            context.state = PNGLoadingContext::State::Error;
+            return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
+        }
+
+        if (filter > 4) {
+            context.state = PNGLoadingContext::State::Error;
+            return Error::from_string_literal("PNGImageDecoderPlugin: Invalid PNG filter");
+        }
+
+        if (auto filter_type = static_cast<PNG::FilterType>(filter); filter_type != PNG::FilterType::None)
+            unfilter_scanline(filter_type, scanline, previous_scanline, bytes_per_complete_pixel);
+
+        TRY(on_scanline(y, scanline));
+        swap(previous_scanline, scanline);
+    }
+    return {};
+}
+
 static bool decode_png_header(PNGLoadingContext& context)
 {
     if (context.state >= PNGLoadingContext::HeaderDecoded)
@@ -547,36 +628,12 @@ static bool decode_png_chunks(PNGLoadingContext& context)
     return true;
 }
 
-static ErrorOr<void> decode_png_bitmap_simple(PNGLoadingContext& context)
+static ErrorOr<void> decode_png_bitmap_simple(PNGLoadingContext& context, InputStream& decompressor)
 {
-    Streamer streamer(context.decompression_buffer->data(), context.decompression_buffer->size());
-
-    for (int y = 0; y < context.height; ++y) {
-        PNG::FilterType filter;
-        if (!streamer.read(filter)) {
-            context.state = PNGLoadingContext::State::Error;
-            return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
-        }
-
-        if (to_underlying(filter) > 4) {
-            context.state = PNGLoadingContext::State::Error;
-            return Error::from_string_literal("PNGImageDecoderPlugin: Invalid PNG filter");
-        }
-
-        context.scanlines.append({ filter });
-        auto& scanline_buffer = context.scanlines.last().data;
-        auto row_size = context.compute_row_size_for_width(context.width);
-        if (row_size.has_overflow())
-            return Error::from_string_literal("PNGImageDecoderPlugin: Row size overflow");
-
-        if (!streamer.wrap_bytes(scanline_buffer, row_size.value())) {
-            context.state = PNGLoadingContext::State::Error;
-            return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
-        }
-    }
-
     context.bitmap = TRY(Bitmap::try_create(context.has_alpha() ? BitmapFormat::BGRA8888 : BitmapFormat::BGRx8888, { context.width, context.height }));
-    return unfilter(context);
+    return decode_scanlines(context, decompressor, context.width, context.height, [&](int y, ReadonlyBytes scanline) {
+        return unpack_scanline(context, scanline, reinterpret_cast<Pixel*>(context.bitmap->scanline(y)), context.width);
+    });
 }
 
 static int adam7_height(PNGLoadingContext& context, int pass)
@@ -629,65 +686,72 @@ static int adam7_startx[8] = { 0, 0, 4, 0, 2, 0, 1, 0 };
 static int adam7_stepy[8] = { 1, 8, 8, 8, 4, 4, 2, 2 };
 static int adam7_stepx[8] = { 1, 8, 8, 4, 4, 2, 2, 1 };
 
-static ErrorOr<void> decode_adam7_pass(PNGLoadingContext& context, Streamer& streamer, int pass)
+static ErrorOr<void> decode_adam7_pass(PNGLoadingContext& context, InputStream& decompressor, int pass)
 {
-    PNGLoadingContext subimage_context;
-    subimage_context.width = adam7_width(context, pass);
-    subimage_context.height = adam7_height(context, pass);
-    subimage_context.channels = context.channels;
-    subimage_context.color_type = context.color_type;
-    subimage_context.palette_data = context.palette_data;
-    subimage_context.palette_transparency_data = context.palette_transparency_data;
-    subimage_context.bit_depth = context.bit_depth;
-    subimage_context.filter_method = context.filter_method;
+    auto width = adam7_width(context, pass);
+    auto height = adam7_height(context, pass);
 
     // For small images, some passes might be empty
-    if (!subimage_context.width || !subimage_context.height)
+    if (!width || !height)
         return {};
 
-    subimage_context.scanlines.clear_with_capacity();
-    for (int y = 0; y < subimage_context.height; ++y) {
-        PNG::FilterType filter;
-        if (!streamer.read(filter)) {
-            context.state = PNGLoadingContext::State::Error;
-            return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
-        }
-
-        if (to_underlying(filter) > 4) {
-            context.state = PNGLoadingContext::State::Error;
-            return Error::from_string_literal("PNGImageDecoderPlugin: Invalid PNG filter");
-        }
+    Vector<Pixel> pixels;
+    TRY(pixels.try_resize(width));
+    return decode_scanlines(context, decompressor, width, height, [&](int y, ReadonlyBytes scanline) -> ErrorOr<void> {
+        TRY(unpack_scanline(context, scanline, pixels.data(), width));
 
-        subimage_context.scanlines.append({ filter });
-        auto& scanline_buffer = subimage_context.scanlines.last().data;
+        // Copy the pass's pixels into the main image according to the pass pattern
+        auto dy = adam7_starty[pass] + y * adam7_stepy[pass];
+        if (dy >= context.height)
+            return {};
+        auto* destination = context.bitmap->scanline(dy / context.downscale_factor);
+        for (int x = 0, dx = adam7_startx[pass]; x < width && dx < context.width; ++x, dx += adam7_stepx[pass])
+            destination[dx / context.downscale_factor] = pixels[x].rgba;
+        return {};
+    });
+}
 
-        auto row_size = context.compute_row_size_for_width(subimage_context.width);
-        if (row_size.has_overflow())
-            return Error::from_string_literal("PNGImageDecoderPlugin: Row size overflow");
-        if (!streamer.wrap_bytes(scanline_buffer, row_size.value())) {
-            context.state = PNGLoadingContext::State::Error;
-            return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
-        }
+// The first pass of an interlaced image has every 8th pixel of every 8th row, the first three passes have every 4th
+// pixel of every 4th row, and the first five passes have every other pixel of every other row. So we can decode the
+// image at 1/8, 1/4 or 1/2 of its size by stopping after those passes.
+static int adam7_pass_count_for_downscale_factor(int downscale_factor)
+{
+    switch (downscale_factor) {
+    case 8:
+        return 1;
+    case 4:
+        return 3;
+    case 2:
+        return 5;
+    default:
+        return 7;
     }
+}
 
-    subimage_context.bitmap = TRY(Bitmap::try_create(context.bitmap->format(), { subimage_context.width, subimage_context.height }));
-    TRY(unfilter(subimage_context));
-
-    // Copy the subimage data into the main image according to the pass pattern
-    for (int y = 0, dy = adam7_starty[pass]; y < subimage_context.height && dy < context.height; ++y, dy += adam7_stepy[pass]) {
-        for (int x = 0, dx = adam7_startx[pass]; x < subimage_context.width && dy < context.width; ++x, dx += adam7_stepx[pass]) {
-            context.bitmap->set_pixel(dx, dy, subimage_context.bitmap->get_pixel(x, y));
-        }
+// The largest factor that still decodes the image to at least the ideal size.
+static int downscale_factor_for_ideal_size(PNGLoadingContext const& context, Optional<IntSize> ideal_size)
+{
+    if (context.interlace_method != PngInterlaceMethod::Adam7 || !ideal_size.has_value() || ideal_size->is_empty())
+        return 1;
+
+    int downscale_factor = 1;
+    while (downscale_factor < 8) {
+        int larger_downscale_factor = downscale_factor * 2;
+        if (ceil_div(context.width, larger_downscale_factor) < ideal_size->width()
+            || ceil_div(context.height, larger_downscale_factor) < ideal_size->height())
+            break;
+        downscale_factor = larger_downscale_factor;
     }
-    return {};
+    return downscale_factor;
 }
 
-static ErrorOr<void> decode_png_adam7(PNGLoadingContext& context)
+static ErrorOr<void> decode_png_adam7(PNGLoadingContext& context, InputStream& decompressor)
 {
-    Streamer streamer(context.decompression_buffer->data(), context.decompression_buffer->size());
-    context.bitmap = TRY(Bitmap::try_create(context.has_alpha() ? BitmapFormat::BGRA8888 : BitmapFormat::BGRx8888, { context.width, context.height }));
-    for (int pass = 1; pass <= 7; ++pass)
-        TRY(decode_adam7_pass(context, streamer, pass));
+    context.downscale_factor = downscale_factor_for_ideal_size(context, context.ideal_size);
+    IntSize size { ceil_div(context.width, context.downscale_factor), ceil_div(context.height, context.downscale_factor) };
+    context.bitmap = TRY(Bitmap::try_create(context.has_alpha() ? BitmapFormat::BGRA8888 : BitmapFormat::BGRx8888, size));
+    for (int pass = 1; pass <= adam7_pass_count_for_downscale_factor(context.downscale_factor); ++pass)
+        TRY(decode_adam7_pass(context, decompressor, pass));
     return {};
 }
 
@@ -707,28 +771,33 @@ static ErrorOr<void> decode_png_bitmap(PNGLoadingContext& context)
     if (context.color_type == PNG::ColorType::IndexedColor && context.palette_data.is_empty())
         return Error::from_string_literal("PNGImageDecoderPlugin: Didn't see a PLTE chunk for a palletized image, or it was empty.");
 
-    auto result = Compress::Zlib::decompress_all(context.compressed_data.span());
-    if (!result.has_value()) {
+    auto zlib = Compress::Zlib::try_create(context.compressed_data.span());
+    if (!zlib.has_value()) {
         context.state = PNGLoadingContext::State::Error;
         return Error::from_string_literal("PNGImageDecoderPlugin: Decompression failed");
     }
-    context.decompression_buffer = &result.value();
-    context.compressed_data.clear();
 
-    context.scanlines.ensure_capacity(context.height);
+    // The image data is decompressed as it's being decoded, so it never has to be in memory all at once.
+    InputMemoryStream compressed_stream { zlib->deflate_data() };
+    Compress::DeflateDecompressor decompressor { compressed_stream };
+    ScopeGuard handle_stream_errors = [&] {
+        decompressor.handle_any_error();
+        compressed_stream.handle_any_error();
+    };
+
     switch (context.interlace_method) {
     case PngInterlaceMethod::Null:
-        TRY(decode_png_bitmap_simple(context));
+        TRY(decode_png_bitmap_simple(context, decompressor));
         break;
     case PngInterlaceMethod::Adam7:
-        TRY(decode_png_adam7(context));
+        TRY(decode_png_adam7(context, decompressor));
         break;
     default:
         context.state = PNGLoadingContext::State::Error;
         return Error::from_string_literal("PNGImageDecoderPlugin: Invalid interlace method");
     }
 
-    context.decompression_buffer = nullptr;
+    context.compressed_data.clear();
 
     context.state = PNGLoadingContext::State::BitmapDecoded;
     return {};
@@ -934,7 +1003,7 @@ size_t PNGImageDecoderPlugin::frame_count()
     return 1;
 }
 
-ErrorOr<ImageFrameDescriptor> PNGImageDecoderPlugin::frame(size_t index)
+ErrorOr<ImageFrameDescriptor> PNGImageDecoderPlugin::frame(size_t index, Optional<IntSize> ideal_size)
 {
     if (index > 0)
         return Error::from_string_literal("PNGImageDecoderPlugin: Invalid frame index");
@@ -942,7 +1011,17 @@ ErrorOr<ImageFrameDescriptor> PNGImageDecoderPlugin::frame(size_t index)
     if (m_context->state == PNGLoadingContext::State::Error)
         return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
 
+    if (m_context->state == PNGLoadingContext::State::BitmapDecoded
+        && downscale_factor_for_ideal_size(*m_context, ideal_size) != m_context->downscale_factor) {
+        // The image was decoded at a different size, so decode it again.
+        auto context = make<PNGLoadingContext>();
+        context->data = m_context->data;
+        context->data_size = m_context->data_size;
+        m_context = move(context);
+    }
+
     if (m_context->state < PNGLoadingContext::State::BitmapDecoded) {
+        m_context->ideal_size = ideal_size;
         // NOTE: This forces the chunk decoding to happen.
         TRY(decode_png_bitmap(*m_context));
     }
@@ -94,6 +94,8 @@ public:
 
     // Streamlined text drawing routine that does no wrapping/elision/alignment.
     void draw_text_run(FloatPoint const& baseline_start, Utf8View const&, Font const&, Color);
+    // Draws a run laid out by ScaledFont::glyph_run(), with origin at the top left of the line where the run starts.
+    void draw_glyph_run(IntPoint const& origin, GlyphRun const&, Color);
 
     enum class CornerOrientation {
         TopLeft,
@@ -164,6 +166,7 @@ protected:
     void fill_physical_scanline_with_draw_op(int y, int x, int width, Color const& color);
     void fill_rect_with_draw_op(IntRect const&, Color);
     void blit_with_opacity(IntPoint const&, Gfx::Bitmap const&, IntRect const& src_rect, float opacity, bool apply_alpha = true);
+    void blit_glyph(IntPoint const&, Gfx::Bitmap const&, IntRect const& src_rect, Color);
     void draw_physical_pixel(IntPoint const&, Color, int thickness = 1);
 
     struct State {
@@ -62,7 +62,7 @@ public:
     virtual bool is_animated() override;
     virtual size_t loop_count() override;
     virtual size_t frame_count() override;
-    virtual ErrorOr<ImageFrameDescriptor> frame(size_t index) override;
+    virtual ErrorOr<ImageFrameDescriptor> frame(size_t index, Optional<IntSize> ideal_size = {}) override;
 
 private:
     OwnPtr<TContext> m_context;
@@ -142,7 +142,7 @@ size_t PortableImageDecoderPlugin<TContext>::frame_count()
 }
 
 template<typename TContext>
-ErrorOr<ImageFrameDescriptor> PortableImageDecoderPlugin<TContext>::frame(size_t index)
+ErrorOr<ImageFrameDescriptor> PortableImageDecoderPlugin<TContext>::frame(size_t index, Optional<IntSize>)
 {
     if (index > 0)
         return Error::from_string_literal("PortableImageDecoderPlugin: Invalid frame index");
@@ -229,7 +229,7 @@ bool QOIImageDecoderPlugin::sniff()
     return !decode_qoi_header(stream).is_error();
 }
 
-ErrorOr<ImageFrameDescriptor> QOIImageDecoderPlugin::frame(size_t index)
+ErrorOr<ImageFrameDescriptor> QOIImageDecoderPlugin::frame(size_t index, Optional<IntSize>)
 {
     if (index > 0)
         return Error::from_string_literal("Invalid frame index");
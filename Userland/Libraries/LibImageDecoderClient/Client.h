@@ -30,7 +30,9 @@ class Client final
     IPC_CLIENT_CONNECTION(Client, "/tmp/session/%sid/portal/image"sv);
 
 public:
-    Optional<DecodedImage> decode_image(ReadonlyBytes);
+    // If the image is going to be displayed at a smaller size, passing that size lets the decoder skip work,
+    // in which case the frames may be smaller than the image (but not smaller than ideal_size).
+    Optional<DecodedImage> decode_image(ReadonlyBytes, Optional<Gfx::IntSize> ideal_size = {});
 
     Function<void()> on_death;
 
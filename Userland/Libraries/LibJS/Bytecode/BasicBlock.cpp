@@ -64,4 +64,33 @@ void BasicBlock::grow(size_t additional_size)
     VERIFY(m_buffer_size <= m_buffer_capacity);
 }
 
+void BasicBlock::remove_instructions(Vector<size_t> const& offsets)
+{
+    if (offsets.is_empty())
+        return;
+
+    size_t write_offset = 0;
+    size_t next_offset_to_remove = 0;
+    Bytecode::InstructionStreamIterator it(instruction_stream());
+    while (!it.at_end()) {
+        auto offset = it.offset();
+        auto& instruction = const_cast<Instruction&>(*it);
+        auto length = instruction.length();
+        ++it;
+
+        if (next_offset_to_remove < offsets.size() && offsets[next_offset_to_remove] == offset) {
+            ++next_offset_to_remove;
+            Instruction::destroy(instruction);
+            continue;
+        }
+
+        if (write_offset != offset)
+            __builtin_memmove(m_buffer + write_offset, m_buffer + offset, length);
+        write_offset += length;
+    }
+
+    VERIFY(next_offset_to_remove == offsets.size());
+    m_buffer_size = write_offset;
+}
+
 }
@@ -6,25 +6,58 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/FlyString.h>
 #include <AK/NonnullOwnPtrVector.h>
+#include <AK/WeakPtr.h>
 #include <LibJS/Bytecode/BasicBlock.h>
 #include <LibJS/Bytecode/IdentifierTable.h>
 #include <LibJS/Bytecode/StringTable.h>
+#include <LibJS/JIT/NativeExecutable.h>
+#include <LibJS/Runtime/Shape.h>
 
 namespace JS::Bytecode {
 
+// Remembers where GetById/PutById found their property for the last few receiver shapes.
+// NOTE: These live in the Executable rather than in the instructions themselves, since instructions get
+//       memcpy'd around by the optimization passes and must not own anything.
+struct PropertyLookupCache {
+    static constexpr size_t max_number_of_shapes = 4;
+
+    struct Entry {
+        WeakPtr<Shape> shape;
+        u32 property_offset { 0 };
+
+        // Only set for properties found on the prototype chain, which additionally
+        // require the VM's prototype chain validity to be unchanged.
+        Object* prototype { nullptr };
+        u64 prototype_chain_validity { 0 };
+    };
+
+    AK::Array<Entry, max_number_of_shapes> entries;
+    size_t next_entry_to_replace { 0 };
+};
+
 struct Executable {
     FlyString name;
     NonnullOwnPtrVector<BasicBlock> basic_blocks;
+    mutable Vector<PropertyLookupCache> property_lookup_caches;
     NonnullOwnPtr<StringTable> string_table;
     NonnullOwnPtr<IdentifierTable> identifier_table;
     size_t number_of_registers { 0 };
     bool is_strict_mode { false };
 
+    // Compiled lazily by the interpreter, once the executable has been run often enough.
+    mutable OwnPtr<JIT::NativeExecutable> native_executable;
+    mutable u32 run_count { 0 };
+    mutable bool did_try_to_compile { false };
+
     String const& get_string(StringTableIndex index) const { return string_table->get(index); }
     FlyString const& get_identifier(IdentifierTableIndex index) const { return identifier_table->get(index); }
 
+    size_t instruction_count() const;
+    size_t bytecode_size() const;
+
     void dump() const;
 };
 
@@ -0,0 +1,369 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <AK/Hex.h>
+#include <AK/LexicalPath.h>
+#include <LibCore/Stream.h>
+#include <LibCore/System.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <LibJS/Bytecode/ExecutableCache.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Label.h>
+#include <LibJS/Bytecode/Op.h>
+#include <errno.h>
+#include <unistd.h>
+
+namespace JS::Bytecode {
+
+static constexpr u32 serialized_executable_magic = 0x4342534a; // "JSBC"
+static constexpr u32 serialized_executable_version = 1;
+
+static constexpr size_t number_of_instruction_types = 0
+#define __BYTECODE_OP(op) +1
+    ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+    ;
+
+static size_t fixed_size_of(Instruction::Type type)
+{
+#define __BYTECODE_OP(op)       \
+    case Instruction::Type::op: \
+        return sizeof(Op::op);
+
+    switch (type) {
+        ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+    default:
+        VERIFY_NOT_REACHED();
+    }
+
+#undef __BYTECODE_OP
+}
+
+static bool can_serialize(Instruction const& instruction)
+{
+    switch (instruction.type()) {
+    case Instruction::Type::NewBigInt:
+    case Instruction::Type::NewClass:
+    case Instruction::Type::NewFunction:
+    case Instruction::Type::PushDeclarativeEnvironment:
+        return false;
+    case Instruction::Type::LoadImmediate:
+        return !static_cast<Op::LoadImmediate const&>(instruction).value().is_cell();
+    default:
+        return true;
+    }
+}
+
+class ExecutableEncoder {
+public:
+    template<typename T>
+    void write(T value) requires(IsIntegral<T>)
+    {
+        m_buffer.append(&value, sizeof(value));
+    }
+
+    void write(ReadonlyBytes bytes)
+    {
+        write<u32>(bytes.size());
+        m_buffer.append(bytes);
+    }
+
+    void write(StringView string) { write(string.bytes()); }
+
+    ByteBuffer release_buffer() { return move(m_buffer); }
+
+private:
+    ByteBuffer m_buffer;
+};
+
+class ExecutableDecoder {
+public:
+    explicit ExecutableDecoder(ReadonlyBytes bytes)
+        : m_bytes(bytes)
+    {
+    }
+
+    bool at_end() const { return m_offset == m_bytes.size(); }
+
+    template<typename T>
+    Optional<T> read() requires(IsIntegral<T>)
+    {
+        if (m_bytes.size() - m_offset < sizeof(T))
+            return {};
+        T value;
+        __builtin_memcpy(&value, m_bytes.offset_pointer(m_offset), sizeof(T));
+        m_offset += sizeof(T);
+        return value;
+    }
+
+    Optional<ReadonlyBytes> read_bytes()
+    {
+        auto size = read<u32>();
+        if (!size.has_value() || m_bytes.size() - m_offset < *size)
+            return {};
+        auto bytes = m_bytes.slice(m_offset, *size);
+        m_offset += *size;
+        return bytes;
+    }
+
+    Optional<String> read_string()
+    {
+        auto bytes = read_bytes();
+        if (!bytes.has_value())
+            return {};
+        return String { *bytes };
+    }
+
+private:
+    ReadonlyBytes m_bytes;
+    size_t m_offset { 0 };
+};
+
+Optional<ByteBuffer> serialize_executable(Executable const& executable)
+{
+    HashMap<BasicBlock const*, u32> block_indices;
+    for (size_t i = 0; i < executable.basic_blocks.size(); ++i)
+        block_indices.set(&executable.basic_blocks[i], i);
+
+    ExecutableEncoder encoder;
+    encoder.write<u32>(serialized_executable_magic);
+    encoder.write<u32>(serialized_executable_version);
+    encoder.write<u8>(executable.is_strict_mode);
+    encoder.write<u32>(executable.number_of_registers);
+    encoder.write<u32>(executable.property_lookup_caches.size());
+
+    auto& strings = executable.string_table->strings();
+    encoder.write<u32>(strings.size());
+    for (auto& string : strings)
+        encoder.write(string.view());
+
+    auto& identifiers = executable.identifier_table->identifiers();
+    encoder.write<u32>(identifiers.size());
+    for (auto& identifier : identifiers)
+        encoder.write(identifier.view());
+
+    encoder.write<u32>(executable.basic_blocks.size());
+    for (auto& block : executable.basic_blocks) {
+        Vector<u32> label_targets;
+        InstructionStreamIterator it(block.instruction_stream());
+        while (!it.at_end()) {
+            auto& instruction = const_cast<Instruction&>(*it);
+            if (!can_serialize(instruction))
+                return {};
+            bool has_unknown_target = false;
+            instruction.visit_labels([&](Label& label) {
+                auto target = block_indices.get(&label.block());
+                if (!target.has_value()) {
+                    has_unknown_target = true;
+                    return;
+                }
+                label_targets.append(*target);
+            });
+            if (has_unknown_target)
+                return {};
+            ++it;
+        }
+
+        encoder.write(block.name().view());
+        encoder.write(block.instruction_stream());
+        encoder.write<u32>(label_targets.size());
+        for (auto target : label_targets)
+            encoder.write<u32>(target);
+    }
+
+    return encoder.release_buffer();
+}
+
+// Checks that the instruction stream splits cleanly into instructions we know how to load.
+// NOTE: This guards against truncated or stale cache files, not against maliciously crafted ones;
+//       the cache directory is trusted as much as the scripts themselves.
+static bool validate_instruction_stream(ReadonlyBytes bytes)
+{
+    size_t offset = 0;
+    while (offset < bytes.size()) {
+        auto remaining = bytes.size() - offset;
+        if (remaining < sizeof(Instruction) || offset % alignof(void*) != 0)
+            return false;
+        auto const& instruction = *reinterpret_cast<Instruction const*>(bytes.offset_pointer(offset));
+        if (static_cast<size_t>(to_underlying(instruction.type())) >= number_of_instruction_types)
+            return false;
+        if (remaining < fixed_size_of(instruction.type()) || !can_serialize(instruction))
+            return false;
+        auto length = instruction.length();
+        if (length > remaining)
+            return false;
+        offset += length;
+    }
+    return true;
+}
+
+OwnPtr<Executable> deserialize_executable(ReadonlyBytes bytes)
+{
+    ExecutableDecoder decoder(bytes);
+    if (decoder.read<u32>() != serialized_executable_magic || decoder.read<u32>() != serialized_executable_version)
+        return {};
+
+    auto is_strict_mode = decoder.read<u8>();
+    auto number_of_registers = decoder.read<u32>();
+    auto number_of_property_lookup_caches = decoder.read<u32>();
+    if (!is_strict_mode.has_value() || !number_of_registers.has_value() || !number_of_property_lookup_caches.has_value())
+        return {};
+
+    auto string_table = make<StringTable>();
+    auto string_count = decoder.read<u32>();
+    if (!string_count.has_value())
+        return {};
+    for (u32 i = 0; i < *string_count; ++i) {
+        auto string = decoder.read_string();
+        // NOTE: The tables never contain duplicates, so re-inserting the entries in order reproduces the original indices.
+        if (!string.has_value() || string_table->insert(string.release_value()).value() != i)
+            return {};
+    }
+
+    auto identifier_table = make<IdentifierTable>();
+    auto identifier_count = decoder.read<u32>();
+    if (!identifier_count.has_value())
+        return {};
+    for (u32 i = 0; i < *identifier_count; ++i) {
+        auto identifier = decoder.read_string();
+        if (!identifier.has_value() || identifier_table->insert(identifier.release_value()).value() != i)
+            return {};
+    }
+
+    auto block_count = decoder.read<u32>();
+    if (!block_count.has_value() || *block_count == 0)
+        return {};
+
+    NonnullOwnPtrVector<BasicBlock> basic_blocks;
+    Vector<Vector<u32>> label_targets_per_block;
+    for (u32 i = 0; i < *block_count; ++i) {
+        auto name = decoder.read_string();
+        auto instruction_stream = decoder.read_bytes();
+        if (!name.has_value() || !instruction_stream.has_value() || !validate_instruction_stream(*instruction_stream))
+            return {};
+
+        auto label_count = decoder.read<u32>();
+        if (!label_count.has_value())
+            return {};
+        Vector<u32> label_targets;
+        for (u32 j = 0; j < *label_count; ++j) {
+            auto target = decoder.read<u32>();
+            if (!target.has_value() || *target >= *block_count)
+                return {};
+            label_targets.append(*target);
+        }
+
+        auto block = BasicBlock::create(name.release_value(), instruction_stream->size());
+        __builtin_memcpy(block->next_slot(), instruction_stream->data(), instruction_stream->size());
+        block->grow(instruction_stream->size());
+        basic_blocks.append(move(block));
+        label_targets_per_block.append(move(label_targets));
+    }
+
+    if (!decoder.at_end())
+        return {};
+
+    // Now that all blocks exist, point the labels (which still hold the addresses from the serializing process) at them.
+    for (size_t i = 0; i < basic_blocks.size(); ++i) {
+        auto& label_targets = label_targets_per_block[i];
+        size_t next_label = 0;
+        bool has_mismatched_labels = false;
+        InstructionStreamIterator it(basic_blocks[i].instruction_stream());
+        while (!it.at_end()) {
+            const_cast<Instruction&>(*it).visit_labels([&](Label& label) {
+                if (next_label >= label_targets.size()) {
+                    has_mismatched_labels = true;
+                    return;
+                }
+                label = Label { basic_blocks[label_targets[next_label++]] };
+            });
+            ++it;
+        }
+        if (has_mismatched_labels || next_label != label_targets.size())
+            return {};
+    }
+
+    Vector<PropertyLookupCache> property_lookup_caches;
+    property_lookup_caches.resize(*number_of_property_lookup_caches);
+
+    return adopt_own(*new Executable {
+        .name = {},
+        .basic_blocks = move(basic_blocks),
+        .property_lookup_caches = move(property_lookup_caches),
+        .string_table = move(string_table),
+        .identifier_table = move(identifier_table),
+        .number_of_registers = *number_of_registers,
+        .is_strict_mode = *is_strict_mode != 0,
+        .native_executable = {} });
+}
+
+ExecutableCache::ExecutableCache(String directory)
+    : m_directory(move(directory))
+{
+}
+
+String ExecutableCache::path_for(StringView source, Optimized optimized) const
+{
+    Crypto::Hash::SHA256 hash;
+
+    // Instructions are stored verbatim, so anything that changes their layout has to invalidate the cache.
+    auto update = [&](auto value) { hash.update(reinterpret_cast<u8 const*>(&value), sizeof(value)); };
+    update(serialized_executable_version);
+#define __BYTECODE_OP(op)      \
+    hash.update(#op##sv);      \
+    update(sizeof(Op::op));    \
+    update(alignof(Op::op));
+    ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+
+    update(optimized);
+    hash.update(source);
+
+    auto digest = hash.digest();
+    return LexicalPath::join(m_directory, String::formatted("{}.jsbc", encode_hex(digest.bytes()))).string();
+}
+
+OwnPtr<Executable> ExecutableCache::load(StringView source, Optimized optimized) const
+{
+    auto path = path_for(source, optimized);
+    auto file_or_error = Core::Stream::File::open(path, Core::Stream::OpenMode::Read);
+    if (file_or_error.is_error())
+        return {};
+
+    auto bytes_or_error = file_or_error.value()->read_all();
+    if (bytes_or_error.is_error())
+        return {};
+
+    auto executable = deserialize_executable(bytes_or_error.value());
+    dbgln_if(JS_BYTECODE_DEBUG, "ExecutableCache: {} {}", executable ? "Loaded" : "Rejected", path);
+    return executable;
+}
+
+ErrorOr<void> ExecutableCache::store(StringView source, Optimized optimized, Executable const& executable) const
+{
+    auto bytes = serialize_executable(executable);
+    if (!bytes.has_value())
+        return AK::Error::from_string_literal("Executable can't be serialized");
+
+    if (auto result = Core::System::mkdir(m_directory, 0700); result.is_error() && result.error().code() != EEXIST)
+        return result.release_error();
+
+    // Write to a temporary file first, so concurrent loads never see a partially written executable.
+    auto path = path_for(source, optimized);
+    auto temporary_path = String::formatted("{}.{}.tmp", path, getpid());
+    {
+        auto file = TRY(Core::Stream::File::open(temporary_path, Core::Stream::OpenMode::Write | Core::Stream::OpenMode::Truncate, 0600));
+        if (!file->write_or_error(*bytes))
+            return AK::Error::from_string_literal("Failed to write serialized executable");
+    }
+    TRY(Core::System::rename(temporary_path, path));
+
+    dbgln_if(JS_BYTECODE_DEBUG, "ExecutableCache: Stored {} ({} bytes)", path, bytes->size());
+    return {};
+}
+
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/Error.h>
+#include <AK/OwnPtr.h>
+#include <AK/String.h>
+#include <LibJS/Bytecode/Executable.h>
+
+namespace JS::Bytecode {
+
+// Executables are serialized as their tables followed by the raw instruction stream of each basic block,
+// with the block pointers in labels swapped out for block indices.
+// NOTE: Instructions that refer back into the AST (NewFunction, NewClass) or own heap data (NewBigInt,
+//       PushDeclarativeEnvironment, LoadImmediate of a cell) can't be serialized, so neither can executables containing them.
+//       Executables should be serialized before they first run, so no inline cache state gets written out.
+Optional<ByteBuffer> serialize_executable(Executable const&);
+OwnPtr<Executable> deserialize_executable(ReadonlyBytes);
+
+// A directory of serialized executables, keyed by a hash of the source text they were generated from
+// and of the instruction layout of the running build.
+class ExecutableCache {
+public:
+    enum class Optimized {
+        No,
+        Yes,
+    };
+
+    explicit ExecutableCache(String directory);
+
+    OwnPtr<Executable> load(StringView source, Optimized) const;
+    ErrorOr<void> store(StringView source, Optimized, Executable const&) const;
+
+private:
+    String path_for(StringView source, Optimized) const;
+
+    String m_directory;
+};
+
+}
@@ -25,6 +25,7 @@ public:
     FlyString const& get(IdentifierTableIndex) const;
     void dump() const;
     bool is_empty() const { return m_identifiers.is_empty(); }
+    Vector<FlyString> const& identifiers() const { return m_identifiers; }
 
 private:
     Vector<FlyString> m_identifiers;
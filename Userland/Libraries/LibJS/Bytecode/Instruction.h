@@ -103,12 +103,20 @@ public:
 #undef __BYTECODE_OP
     };
 
+    enum class RegisterAccess {
+        Read,
+        Write,
+        ReadWrite,
+    };
+
     bool is_terminator() const;
     Type type() const { return m_type; }
     size_t length() const;
     String to_string(Bytecode::Executable const&) const;
     ThrowCompletionOr<void> execute(Bytecode::Interpreter&) const;
     void replace_references(BasicBlock const&, BasicBlock const&);
+    void visit_registers(Function<void(Register&, RegisterAccess)> const&);
+    void visit_labels(Function<void(Label&)> const&);
     static void destroy(Instruction&);
 
 protected:
@@ -117,6 +125,12 @@ protected:
     {
     }
 
+    // Instructions that refer to registers (other than the accumulator) shadow this, so the optimization passes can see and rename them.
+    void visit_registers_impl(Function<void(Register&, RegisterAccess)> const&) { }
+
+    // Instructions that jump to other basic blocks shadow this, so their targets can be rewritten when an executable is loaded from disk.
+    void visit_labels_impl(Function<void(Label&)> const&) { }
+
 private:
     Type m_type {};
 };
@@ -11,6 +11,7 @@
 #include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Bytecode/Op.h>
 #include <LibJS/Interpreter.h>
+#include <LibJS/JIT/Compiler.h>
 #include <LibJS/Runtime/GlobalEnvironment.h>
 #include <LibJS/Runtime/GlobalObject.h>
 #include <LibJS/Runtime/Realm.h>
@@ -69,64 +70,59 @@ Interpreter::ValueAndFrame Interpreter::run_and_return_frame(Executable const& e
 
     registers().resize(executable.number_of_registers);
 
-    for (;;) {
-        Bytecode::InstructionStreamIterator pc(block->instruction_stream());
-        bool will_jump = false;
-        bool will_return = false;
-        while (!pc.at_end()) {
-            auto& instruction = *pc;
-            auto ran_or_error = instruction.execute(*this);
-            if (ran_or_error.is_error()) {
-                auto exception_value = *ran_or_error.throw_completion().value();
-                m_saved_exception = make_handle(exception_value);
-                if (m_unwind_contexts.is_empty())
-                    break;
-                auto& unwind_context = m_unwind_contexts.last();
-                if (unwind_context.executable != m_current_executable)
-                    break;
-                if (unwind_context.handler) {
-                    block = unwind_context.handler;
-                    unwind_context.handler = nullptr;
-
-                    // If there's no finalizer, there's nowhere for the handler block to unwind to, so the unwind context is no longer needed.
-                    if (!unwind_context.finalizer)
-                        m_unwind_contexts.take_last();
+    if (s_jit_threshold.has_value() && !executable.did_try_to_compile && ++executable.run_count > *s_jit_threshold) {
+        executable.did_try_to_compile = true;
+        executable.native_executable = JIT::Compiler::compile(executable);
+    }
 
-                    accumulator() = exception_value;
-                    m_saved_exception = {};
-                    will_jump = true;
+    if (executable.native_executable) {
+        for (;;) {
+            auto exit_reason = executable.native_executable->run(*this, registers().data(), *block);
+            if (exit_reason != JIT::NativeExecutable::ExitReason::Jump)
+                break;
+            // NOTE: The jump is taken off even when we stop here, or it would be taken by whatever runs next.
+            block = m_pending_jump.release_value();
+            // NOTE: Like the interpreter loop below, we stop when jumping to a finalizer with an exception pending.
+            if (!m_saved_exception.is_null())
+                break;
+        }
+    } else {
+        for (;;) {
+            Bytecode::InstructionStreamIterator pc(block->instruction_stream());
+            bool will_jump = false;
+            bool will_return = false;
+            while (!pc.at_end()) {
+                auto& instruction = *pc;
+                ++m_dispatch_count;
+                auto ran_or_error = instruction.execute(*this);
+                if (ran_or_error.is_error()) {
+                    if (auto* handler = unwind_for_exception(*ran_or_error.throw_completion().value())) {
+                        block = handler;
+                        will_jump = true;
+                    }
                     break;
                 }
-                if (unwind_context.finalizer) {
-                    block = unwind_context.finalizer;
-                    m_unwind_contexts.take_last();
+                if (m_pending_jump.has_value()) {
+                    block = m_pending_jump.release_value();
                     will_jump = true;
                     break;
                 }
-                // An unwind context with no handler or finalizer? We have nowhere to jump, and continuing on will make us crash on the next `Call` to a non-native function if there's an exception! So let's crash here instead.
-                // If you run into this, you probably forgot to remove the current unwind_context somewhere.
-                VERIFY_NOT_REACHED();
-            }
-            if (m_pending_jump.has_value()) {
-                block = m_pending_jump.release_value();
-                will_jump = true;
-                break;
-            }
-            if (!m_return_value.is_empty()) {
-                will_return = true;
-                break;
+                if (!m_return_value.is_empty()) {
+                    will_return = true;
+                    break;
+                }
+                ++pc;
             }
-            ++pc;
-        }
 
-        if (will_return)
-            break;
+            if (will_return)
+                break;
 
-        if (pc.at_end() && !will_jump)
-            break;
+            if (pc.at_end() && !will_jump)
+                break;
 
-        if (!m_saved_exception.is_null())
-            break;
+            if (!m_saved_exception.is_null())
+                break;
+        }
     }
 
     dbgln_if(JS_BYTECODE_DEBUG, "Bytecode::Interpreter did run unit {:p}", &executable);
@@ -175,6 +171,34 @@ Interpreter::ValueAndFrame Interpreter::run_and_return_frame(Executable const& e
     return { return_value, nullptr };
 }
 
+BasicBlock const* Interpreter::unwind_for_exception(Value exception)
+{
+    m_saved_exception = make_handle(exception);
+    if (m_unwind_contexts.is_empty())
+        return nullptr;
+    auto& unwind_context = m_unwind_contexts.last();
+    if (unwind_context.executable != m_current_executable)
+        return nullptr;
+    if (auto* handler = unwind_context.handler) {
+        unwind_context.handler = nullptr;
+
+        // If there's no finalizer, there's nowhere for the handler block to unwind to, so the unwind context is no longer needed.
+        if (!unwind_context.finalizer)
+            m_unwind_contexts.take_last();
+
+        accumulator() = exception;
+        m_saved_exception = {};
+        return handler;
+    }
+    if (auto* finalizer = unwind_context.finalizer) {
+        m_unwind_contexts.take_last();
+        return finalizer;
+    }
+    // An unwind context with no handler or finalizer? We have nowhere to jump, and continuing on will make us crash on the next `Call` to a non-native function if there's an exception! So let's crash here instead.
+    // If you run into this, you probably forgot to remove the current unwind_context somewhere.
+    VERIFY_NOT_REACHED();
+}
+
 void Interpreter::enter_unwind_context(Optional<Label> handler_target, Optional<Label> finalizer_target)
 {
     m_unwind_contexts.empend(m_current_executable, handler_target.has_value() ? &handler_target->block() : nullptr, finalizer_target.has_value() ? &finalizer_target->block() : nullptr);
@@ -206,18 +230,20 @@ VM::InterpreterExecutionScope Interpreter::ast_interpreter_scope()
 }
 
 AK::Array<OwnPtr<PassManager>, static_cast<UnderlyingType<Interpreter::OptimizationLevel>>(Interpreter::OptimizationLevel::__Count)> Interpreter::s_optimization_pipelines {};
+Interpreter::OptimizationLevel Interpreter::s_optimization_level { Interpreter::OptimizationLevel::Default };
+Optional<u32> Interpreter::s_jit_threshold;
 
 Bytecode::PassManager& Interpreter::optimization_pipeline(Interpreter::OptimizationLevel level)
 {
     auto underlying_level = to_underlying(level);
-    VERIFY(underlying_level <= to_underlying(Interpreter::OptimizationLevel::__Count));
+    VERIFY(underlying_level < to_underlying(Interpreter::OptimizationLevel::__Count));
     auto& entry = s_optimization_pipelines[underlying_level];
 
     if (entry)
         return *entry;
 
     auto pm = make<PassManager>();
-    if (level == OptimizationLevel::Default) {
+    if (level == OptimizationLevel::Default || level == OptimizationLevel::Aggressive) {
         pm->add<Passes::GenerateCFG>();
         pm->add<Passes::UnifySameBlocks>();
         pm->add<Passes::GenerateCFG>();
@@ -226,6 +252,18 @@ Bytecode::PassManager& Interpreter::optimization_pipeline(Interpreter::Optimizat
         pm->add<Passes::UnifySameBlocks>();
         pm->add<Passes::GenerateCFG>();
         pm->add<Passes::MergeBlocks>();
+        if (level == OptimizationLevel::Aggressive) {
+            pm->add<Passes::FoldConstants>();
+            pm->add<Passes::ThreadJumps>();
+            pm->add<Passes::ComputeLiveness>();
+            pm->add<Passes::EliminateDeadStores>();
+            pm->add<Passes::EliminateRedundantLoads>();
+            pm->add<Passes::ComputeLiveness>();
+            pm->add<Passes::CoalesceRegisters>();
+            pm->add<Passes::EliminateRedundantLoads>();
+            pm->add<Passes::GenerateCFG>();
+            pm->add<Passes::MergeBlocks>();
+        }
         pm->add<Passes::GenerateCFG>();
         pm->add<Passes::PlaceBlocks>();
     } else {
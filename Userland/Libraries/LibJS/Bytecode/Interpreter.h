@@ -59,6 +59,13 @@ public:
     }
     void do_return(Value return_value) { m_return_value = return_value; }
 
+    bool has_pending_jump() const { return m_pending_jump.has_value(); }
+    bool has_return_value() const { return !m_return_value.is_empty(); }
+
+    // Records the exception and finds the block that should handle it, if it's handled within the current executable.
+    // Returns null if the exception propagates out of it.
+    BasicBlock const* unwind_for_exception(Value exception);
+
     void enter_unwind_context(Optional<Label> handler_target, Optional<Label> finalizer_target);
     void leave_unwind_context();
     ThrowCompletionOr<void> continue_pending_unwind(Label const& resume_label);
@@ -67,9 +74,20 @@ public:
 
     enum class OptimizationLevel {
         Default,
+        // Additionally runs the dataflow passes (constant folding, jump threading, dead store elimination and register coalescing).
+        Aggressive,
         __Count,
     };
-    static Bytecode::PassManager& optimization_pipeline(OptimizationLevel = OptimizationLevel::Default);
+    static Bytecode::PassManager& optimization_pipeline(OptimizationLevel);
+    static Bytecode::PassManager& optimization_pipeline() { return optimization_pipeline(s_optimization_level); }
+    static void set_optimization_level(OptimizationLevel level) { s_optimization_level = level; }
+
+    // Executables are compiled to machine code after they have been run this many times, if at all.
+    static constexpr u32 default_jit_threshold = 10;
+    static void set_jit_threshold(Optional<u32> threshold) { s_jit_threshold = threshold; }
+
+    // The number of instructions executed by this interpreter so far.
+    u64 dispatch_count() const { return m_dispatch_count; }
 
     VM::InterpreterExecutionScope ast_interpreter_scope();
 
@@ -87,6 +105,8 @@ private:
     MarkedVector<Value>& registers() { return window().registers; }
 
     static AK::Array<OwnPtr<PassManager>, static_cast<UnderlyingType<Interpreter::OptimizationLevel>>(Interpreter::OptimizationLevel::__Count)> s_optimization_pipelines;
+    static OptimizationLevel s_optimization_level;
+    static Optional<u32> s_jit_threshold;
 
     VM& m_vm;
     Realm& m_realm;
@@ -97,6 +117,7 @@ private:
     Vector<UnwindInfo> m_unwind_contexts;
     Handle<Value> m_saved_exception;
     OwnPtr<JS::Interpreter> m_ast_interpreter;
+    u64 m_dispatch_count { 0 };
 };
 
 extern bool g_dump_bytecode;
@@ -125,18 +125,83 @@ static ThrowCompletionOr<Value> typed_equals(VM&, Value src1, Value src2)
     return Value(is_strictly_equal(src1, src2));
 }
 
-#define JS_DEFINE_COMMON_BINARY_OP(OpTitleCase, op_snake_case)                                  \
-    ThrowCompletionOr<void> OpTitleCase::execute_impl(Bytecode::Interpreter& interpreter) const \
-    {                                                                                           \
-        auto& vm = interpreter.vm();                                                            \
-        auto lhs = interpreter.reg(m_lhs_reg);                                                  \
-        auto rhs = interpreter.accumulator();                                                   \
-        interpreter.accumulator() = TRY(op_snake_case(vm, lhs, rhs));                           \
-        return {};                                                                              \
-    }                                                                                           \
-    String OpTitleCase::to_string_impl(Bytecode::Executable const&) const                       \
-    {                                                                                           \
-        return String::formatted(#OpTitleCase " {}", m_lhs_reg);                                \
+// Computes the result of a binary operation on two int32s without going through the generic conversions.
+// Returns an empty Optional for the operations (and operands) that need the full treatment.
+template<Instruction::Type type>
+ALWAYS_INLINE static Optional<Value> binary_operation_on_int32s(i32 lhs, i32 rhs)
+{
+    i32 result;
+    switch (type) {
+    case Instruction::Type::Add:
+        if (__builtin_add_overflow(lhs, rhs, &result))
+            return Value(static_cast<double>(lhs) + static_cast<double>(rhs));
+        return Value(result);
+    case Instruction::Type::Sub:
+        if (__builtin_sub_overflow(lhs, rhs, &result))
+            return Value(static_cast<double>(lhs) - static_cast<double>(rhs));
+        return Value(result);
+    case Instruction::Type::Mul:
+        if (__builtin_mul_overflow(lhs, rhs, &result))
+            return Value(static_cast<double>(lhs) * static_cast<double>(rhs));
+        // NOTE: A zero product with a negative operand is -0, which can't be represented as an int32.
+        if (result == 0 && (lhs < 0 || rhs < 0))
+            return Value(-0.0);
+        return Value(result);
+    case Instruction::Type::Mod:
+        // NOTE: This leaves out negative operands, and with them -0 results and INT32_MIN % -1.
+        if (lhs < 0 || rhs <= 0)
+            return {};
+        return Value(lhs % rhs);
+    case Instruction::Type::LessThan:
+        return Value(lhs < rhs);
+    case Instruction::Type::LessThanEquals:
+        return Value(lhs <= rhs);
+    case Instruction::Type::GreaterThan:
+        return Value(lhs > rhs);
+    case Instruction::Type::GreaterThanEquals:
+        return Value(lhs >= rhs);
+    case Instruction::Type::LooselyEquals:
+    case Instruction::Type::StrictlyEquals:
+        return Value(lhs == rhs);
+    case Instruction::Type::LooselyInequals:
+    case Instruction::Type::StrictlyInequals:
+        return Value(lhs != rhs);
+    case Instruction::Type::BitwiseAnd:
+        return Value(lhs & rhs);
+    case Instruction::Type::BitwiseOr:
+        return Value(lhs | rhs);
+    case Instruction::Type::BitwiseXor:
+        return Value(lhs ^ rhs);
+    case Instruction::Type::LeftShift:
+        return Value(static_cast<i32>(static_cast<u32>(lhs) << (static_cast<u32>(rhs) & 0x1f)));
+    case Instruction::Type::RightShift:
+        return Value(lhs >> (static_cast<u32>(rhs) & 0x1f));
+    case Instruction::Type::UnsignedRightShift:
+        return Value(static_cast<double>(static_cast<u32>(lhs) >> (static_cast<u32>(rhs) & 0x1f)));
+    default:
+        return {};
+    }
+}
+
+#define JS_DEFINE_COMMON_BINARY_OP(OpTitleCase, op_snake_case)                                                    \
+    ThrowCompletionOr<void> OpTitleCase::execute_impl(Bytecode::Interpreter& interpreter) const                   \
+    {                                                                                                             \
+        auto& vm = interpreter.vm();                                                                              \
+        auto lhs = interpreter.reg(m_lhs_reg);                                                                    \
+        auto rhs = interpreter.accumulator();                                                                     \
+        if (lhs.is_int32() && rhs.is_int32()) {                                                                   \
+            auto result = binary_operation_on_int32s<Instruction::Type::OpTitleCase>(lhs.as_i32(), rhs.as_i32()); \
+            if (result.has_value()) {                                                                             \
+                interpreter.accumulator() = *result;                                                              \
+                return {};                                                                                        \
+            }                                                                                                     \
+        }                                                                                                         \
+        interpreter.accumulator() = TRY(op_snake_case(vm, lhs, rhs));                                             \
+        return {};                                                                                                \
+    }                                                                                                             \
+    String OpTitleCase::to_string_impl(Bytecode::Executable const&) const                                         \
+    {                                                                                                             \
+        return String::formatted(#OpTitleCase " {}", m_lhs_reg);                                                  \
     }
 
 JS_ENUMERATE_COMMON_BINARY_OPS(JS_DEFINE_COMMON_BINARY_OP)
@@ -176,7 +241,7 @@ ThrowCompletionOr<void> NewArray::execute_impl(Bytecode::Interpreter& interprete
     auto* array = MUST(Array::create(interpreter.realm(), 0));
     for (size_t i = 0; i < m_element_count; i++) {
         auto& value = interpreter.reg(Register(m_elements[0].index() + i));
-        array->indexed_properties().put(i, value, default_attributes);
+        array->put_indexed_property(i, value, default_attributes);
     }
     interpreter.accumulator() = array;
     return {};
@@ -224,7 +289,7 @@ ThrowCompletionOr<void> Append::execute_impl(Bytecode::Interpreter& interpreter)
 
     // Note: We know from codegen, that lhs is a plain array with only indexed properties
     auto& lhs = interpreter.reg(m_lhs).as_array();
-    auto lhs_size = lhs.indexed_properties().array_like_size();
+    auto lhs_size = static_cast<Array const&>(lhs).indexed_properties().array_like_size();
 
     auto rhs = interpreter.accumulator();
 
@@ -232,12 +297,12 @@ ThrowCompletionOr<void> Append::execute_impl(Bytecode::Interpreter& interpreter)
         // ...rhs
         size_t i = lhs_size;
         TRY(get_iterator_values(vm, rhs, [&i, &lhs](Value iterator_value) -> Optional<Completion> {
-            lhs.indexed_properties().put(i, iterator_value, default_attributes);
+            lhs.put_indexed_property(i, iterator_value, default_attributes);
             ++i;
             return {};
         }));
     } else {
-        lhs.indexed_properties().put(lhs_size, rhs, default_attributes);
+        lhs.put_indexed_property(lhs_size, rhs, default_attributes);
     }
 
     return {};
@@ -347,7 +412,11 @@ ThrowCompletionOr<void> CopyObjectExcludingProperties::execute_impl(Bytecode::In
 ThrowCompletionOr<void> ConcatString::execute_impl(Bytecode::Interpreter& interpreter) const
 {
     auto& vm = interpreter.vm();
-    interpreter.reg(m_lhs) = TRY(add(vm, interpreter.reg(m_lhs), interpreter.accumulator()));
+    // NOTE: Template literal substitutions go through ToString() rather than the + operator, and the
+    //       result is a rope, so building up a long string piece by piece doesn't copy it each time.
+    auto* lhs = TRY(interpreter.reg(m_lhs).to_primitive_string(vm));
+    auto* rhs = TRY(interpreter.accumulator().to_primitive_string(vm));
+    interpreter.reg(m_lhs) = js_rope_string(vm, *lhs, *rhs);
     return {};
 }
 
@@ -466,21 +535,101 @@ ThrowCompletionOr<void> SetVariable::execute_impl(Bytecode::Interpreter& interpr
     return {};
 }
 
+static PropertyLookupCache::Entry const* find_property_lookup_cache_entry(PropertyLookupCache const& cache, Object const& object, VM& vm)
+{
+    if (object.has_exotic_property_access())
+        return nullptr;
+    auto const* shape = &object.shape();
+    for (auto const& entry : cache.entries) {
+        if (entry.shape.ptr() != shape)
+            continue;
+        if (entry.prototype && entry.prototype_chain_validity != vm.prototype_chain_validity())
+            return nullptr;
+        return &entry;
+    }
+    return nullptr;
+}
+
+static void update_property_lookup_cache(PropertyLookupCache& cache, Object& object, CacheablePropertyMetadata const& metadata, VM& vm)
+{
+    PropertyLookupCache::Entry* entry_to_replace = nullptr;
+    for (auto& entry : cache.entries) {
+        if (!entry.shape || entry.shape.ptr() == &object.shape()) {
+            entry_to_replace = &entry;
+            break;
+        }
+    }
+    if (!entry_to_replace) {
+        entry_to_replace = &cache.entries[cache.next_entry_to_replace];
+        cache.next_entry_to_replace = (cache.next_entry_to_replace + 1) % PropertyLookupCache::max_number_of_shapes;
+    }
+
+    entry_to_replace->shape = object.shape();
+    entry_to_replace->property_offset = metadata.property_offset;
+    entry_to_replace->prototype = metadata.prototype;
+    entry_to_replace->prototype_chain_validity = vm.prototype_chain_validity();
+}
+
 ThrowCompletionOr<void> GetById::execute_impl(Bytecode::Interpreter& interpreter) const
 {
     auto& vm = interpreter.vm();
-    auto* object = TRY(interpreter.accumulator().to_object(vm));
-    interpreter.accumulator() = TRY(object->get(interpreter.current_executable().get_identifier(m_property)));
+    auto base_value = interpreter.accumulator();
+    auto& cache = interpreter.current_executable().property_lookup_caches[m_cache_index];
+
+    if (base_value.is_object()) {
+        auto& object = base_value.as_object();
+        if (auto const* entry = find_property_lookup_cache_entry(cache, object, vm)) {
+            auto value = entry->prototype ? entry->prototype->get_direct(entry->property_offset) : object.get_direct(entry->property_offset);
+            // NOTE: Redefining a data property as an accessor with the same attributes doesn't change the shape.
+            if (!value.is_accessor()) {
+                interpreter.accumulator() = value;
+                return {};
+            }
+        }
+    }
+
+    auto* object = TRY(base_value.to_object(vm));
+    auto const& name = interpreter.current_executable().get_identifier(m_property);
+    interpreter.accumulator() = TRY(object->get(name));
+
+    // Primitive base values get a fresh wrapper object every time, so there's nothing to remember for them.
+    if (base_value.is_object()) {
+        if (auto metadata = object->cacheable_property_lookup(name); metadata.has_value())
+            update_property_lookup_cache(cache, *object, *metadata, vm);
+    }
     return {};
 }
 
 ThrowCompletionOr<void> PutById::execute_impl(Bytecode::Interpreter& interpreter) const
 {
     auto& vm = interpreter.vm();
-    auto* object = TRY(interpreter.reg(m_base).to_object(vm));
-    PropertyKey name = interpreter.current_executable().get_identifier(m_property);
+    auto base_value = interpreter.reg(m_base);
     auto value = interpreter.accumulator();
-    return put_by_property_key(object, value, name, interpreter, m_kind);
+    auto& cache = interpreter.current_executable().property_lookup_caches[m_cache_index];
+
+    // NOTE: Only plain assignments to existing own data properties are cached, as they never change the shape.
+    bool is_cacheable = m_kind == PropertyKind::KeyValue && base_value.is_object();
+
+    if (is_cacheable) {
+        auto& object = base_value.as_object();
+        if (auto const* entry = find_property_lookup_cache_entry(cache, object, vm); entry && !entry->prototype) {
+            if (!object.get_direct(entry->property_offset).is_accessor()) {
+                object.put_direct(entry->property_offset, value);
+                return {};
+            }
+        }
+    }
+
+    auto* object = TRY(base_value.to_object(vm));
+    PropertyKey name = interpreter.current_executable().get_identifier(m_property);
+    TRY(put_by_property_key(object, value, name, interpreter, m_kind));
+
+    if (is_cacheable) {
+        auto metadata = object->cacheable_property_lookup(name);
+        if (metadata.has_value() && !metadata->prototype && metadata->attributes.is_writable())
+            update_property_lookup_cache(cache, *object, *metadata, vm);
+    }
+    return {};
 }
 
 ThrowCompletionOr<void> DeleteById::execute_impl(Bytecode::Interpreter& interpreter) const
@@ -569,7 +718,7 @@ static MarkedVector<Value> argument_list_evaluation(Bytecode::Interpreter& inter
     MarkedVector<Value> argument_values { vm.heap() };
     auto arguments = interpreter.accumulator();
 
-    auto& argument_array = arguments.as_array();
+    auto const& argument_array = arguments.as_array();
     auto array_length = argument_array.indexed_properties().array_like_size();
 
     argument_values.ensure_capacity(array_length);
@@ -688,6 +837,11 @@ ThrowCompletionOr<void> Return::execute_impl(Bytecode::Interpreter& interpreter)
 
 ThrowCompletionOr<void> Increment::execute_impl(Bytecode::Interpreter& interpreter) const
 {
+    if (auto value = interpreter.accumulator(); value.is_int32() && value.as_i32() != NumericLimits<i32>::max()) {
+        interpreter.accumulator() = Value(value.as_i32() + 1);
+        return {};
+    }
+
     auto& vm = interpreter.vm();
     auto old_value = TRY(interpreter.accumulator().to_numeric(vm));
 
@@ -700,6 +854,11 @@ ThrowCompletionOr<void> Increment::execute_impl(Bytecode::Interpreter& interpret
 
 ThrowCompletionOr<void> Decrement::execute_impl(Bytecode::Interpreter& interpreter) const
 {
+    if (auto value = interpreter.accumulator(); value.is_int32() && value.as_i32() != NumericLimits<i32>::min()) {
+        interpreter.accumulator() = Value(value.as_i32() - 1);
+        return {};
+    }
+
     auto& vm = interpreter.vm();
     auto old_value = TRY(interpreter.accumulator().to_numeric(vm));
 
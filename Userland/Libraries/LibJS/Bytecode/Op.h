@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <AK/Function.h>
 #include <AK/StdLibExtras.h>
 #include <LibCrypto/BigInt/SignedBigInteger.h>
 #include <LibJS/Bytecode/IdentifierTable.h>
@@ -34,6 +35,9 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(Function<void(Register&, RegisterAccess)> const& visitor) { visitor(m_src, RegisterAccess::Read); }
+
+    Register src() const { return m_src; }
 
 private:
     Register m_src;
@@ -51,6 +55,8 @@ public:
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
 
+    Value value() const { return m_value; }
+
 private:
     Value m_value;
 };
@@ -66,6 +72,9 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(Function<void(Register&, RegisterAccess)> const& visitor) { visitor(m_dst, RegisterAccess::Write); }
+
+    Register dst() const { return m_dst; }
 
 private:
     Register m_dst;
@@ -95,21 +104,27 @@ private:
     O(RightShift, right_shift)                \
     O(UnsignedRightShift, unsigned_right_shift)
 
-#define JS_DECLARE_COMMON_BINARY_OP(OpTitleCase, op_snake_case)                \
-    class OpTitleCase final : public Instruction {                             \
-    public:                                                                    \
-        explicit OpTitleCase(Register lhs_reg)                                 \
-            : Instruction(Type::OpTitleCase)                                   \
-            , m_lhs_reg(lhs_reg)                                               \
-        {                                                                      \
-        }                                                                      \
-                                                                               \
-        ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;    \
-        String to_string_impl(Bytecode::Executable const&) const;              \
-        void replace_references_impl(BasicBlock const&, BasicBlock const&) { } \
-                                                                               \
-    private:                                                                   \
-        Register m_lhs_reg;                                                    \
+#define JS_DECLARE_COMMON_BINARY_OP(OpTitleCase, op_snake_case)                             \
+    class OpTitleCase final : public Instruction {                                          \
+    public:                                                                                 \
+        explicit OpTitleCase(Register lhs_reg)                                              \
+            : Instruction(Type::OpTitleCase)                                                \
+            , m_lhs_reg(lhs_reg)                                                            \
+        {                                                                                   \
+        }                                                                                   \
+                                                                                            \
+        ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;                 \
+        String to_string_impl(Bytecode::Executable const&) const;                           \
+        void replace_references_impl(BasicBlock const&, BasicBlock const&) { }              \
+        void visit_registers_impl(Function<void(Register&, RegisterAccess)> const& visitor) \
+        {                                                                                   \
+            visitor(m_lhs_reg, RegisterAccess::Read);                                       \
+        }                                                                                   \
+                                                                                            \
+        Register lhs() const { return m_lhs_reg; }                                          \
+                                                                                            \
+    private:                                                                                \
+        Register m_lhs_reg;                                                                 \
     };
 
 JS_ENUMERATE_COMMON_BINARY_OPS(JS_DECLARE_COMMON_BINARY_OP)
@@ -199,6 +214,12 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(Function<void(Register&, RegisterAccess)> const& visitor)
+    {
+        visitor(m_from_object, RegisterAccess::Read);
+        for (size_t i = 0; i < m_excluded_names_count; i++)
+            visitor(m_excluded_names[i], RegisterAccess::Read);
+    }
 
     size_t length_impl() const { return sizeof(*this) + sizeof(Register) * m_excluded_names_count; }
 
@@ -250,6 +271,19 @@ public:
         return sizeof(*this) + sizeof(Register) * (m_element_count == 0 ? 0 : 2);
     }
 
+    // NOTE: Only the two ends of the element range are visited. Since the elements must stay in consecutive registers,
+    //       passes that rename registers have to leave the whole range alone.
+    void visit_registers_impl(Function<void(Register&, RegisterAccess)> const& visitor)
+    {
+        if (m_element_count == 0)
+            return;
+        visitor(m_elements[0], RegisterAccess::Read);
+        visitor(m_elements[1], RegisterAccess::Read);
+    }
+
+    size_t element_count() const { return m_element_count; }
+    Register first_element() const { return m_elements[0]; }
+
 private:
     size_t m_element_count { 0 };
     Register m_elements[];
@@ -267,6 +301,7 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(Function<void(Register&, RegisterAccess)> const& visitor) { visitor(m_lhs, RegisterAccess::Read); }
 
 private:
     Register m_lhs;
@@ -296,6 +331,7 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(Function<void(Register&, RegisterAccess)> const& visitor) { visitor(m_lhs, RegisterAccess::ReadWrite); }
 
 private:
     Register m_lhs;
@@ -417,9 +453,10 @@ private:
 
 class GetById final : public Instruction {
 public:
-    explicit GetById(IdentifierTableIndex property)
+    GetById(IdentifierTableIndex property, u32 cache_index)
         : Instruction(Type::GetById)
         , m_property(property)
+        , m_cache_index(cache_index)
     {
     }
 
@@ -429,6 +466,7 @@ public:
 
 private:
     IdentifierTableIndex m_property;
+    u32 m_cache_index { 0 };
 };
 
 enum class PropertyKind {
@@ -441,22 +479,25 @@ enum class PropertyKind {
 
 class PutById final : public Instruction {
 public:
-    explicit PutById(Register base, IdentifierTableIndex property, PropertyKind kind = PropertyKind::KeyValue)
+    PutById(Register base, IdentifierTableIndex property, u32 cache_index, PropertyKind kind = PropertyKind::KeyValue)
         : Instruction(Type::PutById)
         , m_base(base)
         , m_property(property)
         , m_kind(kind)
+        , m_cache_index(cache_index)
     {
     }
 
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(Function<void(Register&, RegisterAccess)> const& visitor) { visitor(m_base, RegisterAccess::Read); }
 
 private:
     Register m_base;
     IdentifierTableIndex m_property;
     PropertyKind m_kind;
+    u32 m_cache_index { 0 };
 };
 
 class DeleteById final : public Instruction {
@@ -486,6 +527,7 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(Function<void(Register&, RegisterAccess)> const& visitor) { visitor(m_base, RegisterAccess::Read); }
 
 private:
     Register m_base;
@@ -504,6 +546,11 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(Function<void(Register&, RegisterAccess)> const& visitor)
+    {
+        visitor(m_base, RegisterAccess::Read);
+        visitor(m_property, RegisterAccess::Read);
+    }
 
 private:
     Register m_base;
@@ -522,6 +569,7 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(Function<void(Register&, RegisterAccess)> const& visitor) { visitor(m_base, RegisterAccess::Read); }
 
 private:
     Register m_base;
@@ -554,6 +602,13 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&);
+    void visit_labels_impl(Function<void(Label&)> const& visitor)
+    {
+        if (m_true_target.has_value())
+            visitor(*m_true_target);
+        if (m_false_target.has_value())
+            visitor(*m_false_target);
+    }
 
     auto& true_target() const { return m_true_target; }
     auto& false_target() const { return m_false_target; }
@@ -616,6 +671,11 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(Function<void(Register&, RegisterAccess)> const& visitor)
+    {
+        visitor(m_callee, RegisterAccess::Read);
+        visitor(m_this_value, RegisterAccess::Read);
+    }
 
     Completion throw_type_error_for_callee(Bytecode::Interpreter&, StringView callee_type) const;
 
@@ -742,6 +802,14 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&);
+    void visit_labels_impl(Function<void(Label&)> const& visitor)
+    {
+        visitor(m_entry_point);
+        if (m_handler_target.has_value())
+            visitor(*m_handler_target);
+        if (m_finalizer_target.has_value())
+            visitor(*m_finalizer_target);
+    }
 
     auto& entry_point() const { return m_entry_point; }
     auto& handler_target() const { return m_handler_target; }
@@ -792,6 +860,9 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&);
+    void visit_labels_impl(Function<void(Label&)> const& visitor) { visitor(m_next_target); }
+
+    auto& next_target() const { return m_next_target; }
 
 private:
     Label m_next_target;
@@ -810,6 +881,7 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&);
+    void visit_labels_impl(Function<void(Label&)> const& visitor) { visitor(m_resume_target); }
 
     auto& resume_target() const { return m_resume_target; }
 
@@ -835,6 +907,11 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&);
+    void visit_labels_impl(Function<void(Label&)> const& visitor)
+    {
+        if (m_continuation_label.has_value())
+            visitor(*m_continuation_label);
+    }
 
     auto& continuation() const { return m_continuation_label; }
 
@@ -992,6 +1069,36 @@ ALWAYS_INLINE void Instruction::replace_references(BasicBlock const& from, Basic
 #undef __BYTECODE_OP
 }
 
+ALWAYS_INLINE void Instruction::visit_registers(Function<void(Register&, RegisterAccess)> const& visitor)
+{
+#define __BYTECODE_OP(op)       \
+    case Instruction::Type::op: \
+        return static_cast<Bytecode::Op::op&>(*this).visit_registers_impl(visitor);
+
+    switch (type()) {
+        ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+    default:
+        VERIFY_NOT_REACHED();
+    }
+
+#undef __BYTECODE_OP
+}
+
+ALWAYS_INLINE void Instruction::visit_labels(Function<void(Label&)> const& visitor)
+{
+#define __BYTECODE_OP(op)       \
+    case Instruction::Type::op: \
+        return static_cast<Bytecode::Op::op&>(*this).visit_labels_impl(visitor);
+
+    switch (type()) {
+        ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+    default:
+        VERIFY_NOT_REACHED();
+    }
+
+#undef __BYTECODE_OP
+}
+
 ALWAYS_INLINE size_t Instruction::length() const
 {
     if (type() == Type::NewArray)
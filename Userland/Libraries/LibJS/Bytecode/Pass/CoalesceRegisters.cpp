@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/QuickSort.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+// Renumbers the registers so that ones which are never live at the same time share an index.
+// Registers that are only copied into one another (`Load $a, Store $b`) are merged first where possible,
+// which turns the copy into a no-op for EliminateRedundantLoads to remove.
+void CoalesceRegisters::perform(PassPipelineExecutable& executable)
+{
+    started();
+
+    VERIFY(executable.liveness.has_value());
+    auto liveness = executable.liveness.release_value();
+
+    HashTable<u32> registers;
+    // Registers that have to keep their index: the ones that may be read by an unwind handler, and the consecutive element ranges of NewArray.
+    HashTable<u32> pinned_registers;
+    HashMap<u32, HashTable<u32>> interference;
+    Vector<AK::Array<u32, 2>> copies;
+
+    auto add_interference = [&](u32 a, u32 b) {
+        if (a == b)
+            return;
+        interference.ensure(a).set(b);
+        interference.ensure(b).set(a);
+    };
+
+    for (auto reg : liveness.always_live)
+        pinned_registers.set(reg);
+
+    for (auto& block : executable.executable.basic_blocks) {
+        Vector<Instruction const*> instructions;
+        for (InstructionStreamIterator it(block.instruction_stream()); !it.at_end(); ++it)
+            instructions.append(&*it);
+
+        auto live = liveness.live_out.get(&block).value();
+
+        for (size_t i = instructions.size(); i > 0; --i) {
+            auto& instruction = *instructions[i - 1];
+
+            // A copy doesn't make its source and destination interfere, since they hold the same value.
+            Optional<u32> copy_source;
+            if (instruction.type() == Instruction::Type::Store && i > 1 && instructions[i - 2]->type() == Instruction::Type::Load) {
+                copy_source = static_cast<Op::Load const&>(*instructions[i - 2]).src().index();
+                auto dst = static_cast<Op::Store const&>(instruction).dst().index();
+                if (*copy_source != Register::accumulator_index && dst != Register::accumulator_index)
+                    copies.append({ *copy_source, dst });
+            }
+
+            for_each_register_access(instruction, [&](u32 reg, Instruction::RegisterAccess access) {
+                registers.set(reg);
+                if (instruction.type() == Instruction::Type::NewArray)
+                    pinned_registers.set(reg);
+                if (access == Instruction::RegisterAccess::Read)
+                    return;
+                for (auto live_reg : live) {
+                    if (live_reg != copy_source)
+                        add_interference(reg, live_reg);
+                }
+            });
+            for_each_register_access(instruction, [&](u32 reg, Instruction::RegisterAccess access) {
+                if (access == Instruction::RegisterAccess::Write)
+                    live.remove(reg);
+            });
+            for_each_register_access(instruction, [&](u32 reg, Instruction::RegisterAccess access) {
+                if (access != Instruction::RegisterAccess::Write)
+                    live.set(reg);
+            });
+        }
+
+        // Registers that are read before ever being written are all live on entry, and would otherwise never be found to interfere.
+        if (&block == &executable.executable.basic_blocks.first()) {
+            for (auto a : live) {
+                for (auto b : live)
+                    add_interference(a, b);
+            }
+        }
+    }
+
+    if (registers.is_empty()) {
+        finished();
+        return;
+    }
+
+    HashMap<u32, u32> representatives;
+    auto find_representative = [&](u32 reg) {
+        for (;;) {
+            auto representative = representatives.get(reg);
+            if (!representative.has_value())
+                return reg;
+            reg = *representative;
+        }
+    };
+
+    for (auto& copy : copies) {
+        auto source = find_representative(copy[0]);
+        auto destination = find_representative(copy[1]);
+        if (source == destination)
+            continue;
+        if (pinned_registers.contains(source) || pinned_registers.contains(destination))
+            continue;
+        if (auto it = interference.find(source); it != interference.end() && it->value.contains(destination))
+            continue;
+
+        // Merge the destination into the source.
+        representatives.set(destination, source);
+        if (auto it = interference.find(destination); it != interference.end()) {
+            auto neighbors = move(it->value);
+            interference.remove(it);
+            for (auto neighbor : neighbors) {
+                interference.find(neighbor)->value.remove(destination);
+                add_interference(source, neighbor);
+            }
+        }
+    }
+
+    Vector<u32> registers_to_color;
+    u32 lowest_register = NumericLimits<u32>::max();
+    for (auto reg : registers) {
+        lowest_register = min(lowest_register, reg);
+        if (find_representative(reg) == reg && !pinned_registers.contains(reg))
+            registers_to_color.append(reg);
+    }
+    quick_sort(registers_to_color);
+
+    // Give every register the lowest index that isn't taken by something it interferes with.
+    // NOTE: We never go below the lowest register the generator handed out.
+    HashMap<u32, u32> colors;
+    for (auto reg : registers_to_color) {
+        HashTable<u32> taken;
+        if (auto it = interference.find(reg); it != interference.end()) {
+            for (auto neighbor : it->value) {
+                if (pinned_registers.contains(neighbor))
+                    taken.set(neighbor);
+                else if (auto color = colors.get(neighbor); color.has_value())
+                    taken.set(*color);
+            }
+        }
+
+        auto color = lowest_register;
+        while (taken.contains(color) || liveness.always_live.contains(color))
+            ++color;
+        colors.set(reg, color);
+    }
+
+    u32 highest_register = 0;
+    for (auto& block : executable.executable.basic_blocks) {
+        for (InstructionStreamIterator it(block.instruction_stream()); !it.at_end(); ++it) {
+            const_cast<Instruction&>(*it).visit_registers([&](Register& reg, Instruction::RegisterAccess) {
+                if (reg.index() == Register::accumulator_index)
+                    return;
+                auto representative = find_representative(reg.index());
+                if (!pinned_registers.contains(representative))
+                    reg = Register { colors.get(representative).value() };
+                highest_register = max(highest_register, reg.index());
+            });
+        }
+    }
+
+    for (auto reg : pinned_registers)
+        highest_register = max(highest_register, reg);
+
+    executable.executable.number_of_registers = static_cast<size_t>(highest_register) + 1;
+
+    finished();
+}
+
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+void ComputeLiveness::perform(PassPipelineExecutable& executable)
+{
+    started();
+
+    struct BlockSummary {
+        HashTable<u32> uses;
+        HashTable<u32> defs;
+        Vector<BasicBlock const*> successors;
+    };
+
+    HashMap<BasicBlock const*, BlockSummary> summaries;
+    HashTable<BasicBlock const*> unwind_targets;
+
+    for (auto& block : executable.executable.basic_blocks) {
+        BlockSummary summary;
+        for (InstructionStreamIterator it(block.instruction_stream()); !it.at_end(); ++it) {
+            auto& instruction = *it;
+            // Reads happen before writes, so a ReadWrite access counts as a use unless the block already wrote the register.
+            for_each_register_access(instruction, [&](u32 reg, Instruction::RegisterAccess access) {
+                if (access != Instruction::RegisterAccess::Write && !summary.defs.contains(reg))
+                    summary.uses.set(reg);
+            });
+            for_each_register_access(instruction, [&](u32 reg, Instruction::RegisterAccess access) {
+                if (access != Instruction::RegisterAccess::Read)
+                    summary.defs.set(reg);
+            });
+
+            if (instruction.type() == Instruction::Type::EnterUnwindContext) {
+                auto& enter = static_cast<Op::EnterUnwindContext const&>(instruction);
+                if (enter.handler_target().has_value())
+                    unwind_targets.set(&enter.handler_target()->block());
+                if (enter.finalizer_target().has_value())
+                    unwind_targets.set(&enter.finalizer_target()->block());
+            }
+        }
+        for_each_successor(block, [&](BasicBlock const& successor) {
+            summary.successors.append(&successor);
+        });
+        summaries.set(&block, move(summary));
+    }
+
+    RegisterLiveness liveness;
+    for (auto& block : executable.executable.basic_blocks) {
+        liveness.live_in.set(&block, {});
+        liveness.live_out.set(&block, {});
+    }
+
+    // Iterate to a fixed point, visiting blocks in reverse order since liveness flows backwards.
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (size_t i = executable.executable.basic_blocks.size(); i > 0; --i) {
+            auto const* block = &executable.executable.basic_blocks[i - 1];
+            auto& summary = summaries.find(block)->value;
+
+            auto& live_out = liveness.live_out.find(block)->value;
+            for (auto const* successor : summary.successors) {
+                for (auto reg : liveness.live_in.find(successor)->value)
+                    live_out.set(reg);
+            }
+
+            auto& live_in = liveness.live_in.find(block)->value;
+            auto size_before = live_in.size();
+            for (auto reg : summary.uses)
+                live_in.set(reg);
+            for (auto reg : live_out) {
+                if (!summary.defs.contains(reg))
+                    live_in.set(reg);
+            }
+            if (live_in.size() != size_before)
+                changed = true;
+        }
+    }
+
+    for (auto const* block : unwind_targets) {
+        for (auto reg : liveness.live_in.find(block)->value)
+            liveness.always_live.set(reg);
+    }
+
+    executable.liveness = move(liveness);
+
+    finished();
+}
+
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+void EliminateDeadStores::perform(PassPipelineExecutable& executable)
+{
+    started();
+
+    VERIFY(executable.liveness.has_value());
+    auto liveness = executable.liveness.release_value();
+
+    for (auto& block : executable.executable.basic_blocks) {
+        Vector<Instruction const*> instructions;
+        Vector<size_t> offsets;
+        for (InstructionStreamIterator it(block.instruction_stream()); !it.at_end(); ++it) {
+            instructions.append(&*it);
+            offsets.append(it.offset());
+        }
+
+        auto live = liveness.live_out.get(&block).value();
+        Vector<size_t> instructions_to_remove;
+
+        for (size_t i = instructions.size(); i > 0; --i) {
+            auto& instruction = *instructions[i - 1];
+
+            if (instruction.type() == Instruction::Type::Store) {
+                auto dst = static_cast<Op::Store const&>(instruction).dst().index();
+                if (!live.contains(dst) && !liveness.always_live.contains(dst)) {
+                    instructions_to_remove.append(offsets[i - 1]);
+                    continue;
+                }
+            }
+
+            for_each_register_access(instruction, [&](u32 reg, Instruction::RegisterAccess access) {
+                if (access == Instruction::RegisterAccess::Write)
+                    live.remove(reg);
+            });
+            for_each_register_access(instruction, [&](u32 reg, Instruction::RegisterAccess access) {
+                if (access != Instruction::RegisterAccess::Write)
+                    live.set(reg);
+            });
+        }
+
+        instructions_to_remove.reverse();
+        block.remove_instructions(instructions_to_remove);
+    }
+
+    finished();
+}
+
+}
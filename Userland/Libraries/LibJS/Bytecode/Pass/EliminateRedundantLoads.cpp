@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/QuickSort.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+// Removes accumulator traffic that has no effect within a basic block:
+// - A Load or Store of a register that is already known to hold the accumulator's value.
+// - A Load or LoadImmediate whose value is replaced by the next instruction before anything reads it.
+void EliminateRedundantLoads::perform(PassPipelineExecutable& executable)
+{
+    started();
+
+    for (auto& block : executable.executable.basic_blocks) {
+        Optional<u32> register_holding_accumulator;
+        Optional<size_t> unread_accumulator_write;
+        Vector<size_t> instructions_to_remove;
+
+        for (InstructionStreamIterator it(block.instruction_stream()); !it.at_end(); ++it) {
+            auto& instruction = *it;
+
+            switch (instruction.type()) {
+            case Instruction::Type::Load: {
+                auto src = static_cast<Op::Load const&>(instruction).src().index();
+                if (register_holding_accumulator == src) {
+                    instructions_to_remove.append(it.offset());
+                    continue;
+                }
+                if (unread_accumulator_write.has_value())
+                    instructions_to_remove.append(*unread_accumulator_write);
+                unread_accumulator_write = it.offset();
+                register_holding_accumulator = src;
+                continue;
+            }
+            case Instruction::Type::LoadImmediate:
+                if (unread_accumulator_write.has_value())
+                    instructions_to_remove.append(*unread_accumulator_write);
+                unread_accumulator_write = it.offset();
+                register_holding_accumulator = {};
+                continue;
+            case Instruction::Type::Store: {
+                auto dst = static_cast<Op::Store const&>(instruction).dst().index();
+                unread_accumulator_write = {};
+                if (register_holding_accumulator == dst) {
+                    instructions_to_remove.append(it.offset());
+                    continue;
+                }
+                register_holding_accumulator = dst;
+                continue;
+            }
+            default:
+                // Anything else may read or replace the accumulator, or write to registers.
+                unread_accumulator_write = {};
+                register_holding_accumulator = {};
+                continue;
+            }
+        }
+
+        quick_sort(instructions_to_remove);
+        block.remove_instructions(instructions_to_remove);
+    }
+
+    finished();
+}
+
+}
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Math.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+static bool is_foldable_constant(Value value)
+{
+    // Only these can be operated on without a VM, and without allocating or running user code.
+    return value.is_number() || value.is_boolean() || value.is_nullish();
+}
+
+// The bitwise operators are only folded for integral numbers in the int32 range, so we don't have to reimplement ToInt32 here.
+static Optional<i32> as_int32(Value value)
+{
+    if (!value.is_number())
+        return {};
+    auto number = value.as_double();
+    if (number < NumericLimits<i32>::min() || number > NumericLimits<i32>::max() || trunc(number) != number)
+        return {};
+    return static_cast<i32>(number);
+}
+
+static Optional<Value> fold_unary_operation(Instruction::Type type, Value value)
+{
+    switch (type) {
+    case Instruction::Type::Not:
+        return Value(!value.to_boolean());
+    case Instruction::Type::UnaryMinus:
+        if (value.is_number())
+            return Value(-value.as_double());
+        return {};
+    case Instruction::Type::UnaryPlus:
+        if (value.is_number())
+            return value;
+        return {};
+    case Instruction::Type::BitwiseNot:
+        if (auto number = as_int32(value); number.has_value())
+            return Value(~*number);
+        return {};
+    default:
+        return {};
+    }
+}
+
+static Optional<Value> fold_binary_operation(Instruction::Type type, Value lhs, Value rhs)
+{
+    if (!lhs.is_number() || !rhs.is_number())
+        return {};
+
+    auto a = lhs.as_double();
+    auto b = rhs.as_double();
+
+    switch (type) {
+    case Instruction::Type::Add:
+        return Value(a + b);
+    case Instruction::Type::Sub:
+        return Value(a - b);
+    case Instruction::Type::Mul:
+        return Value(a * b);
+    case Instruction::Type::Div:
+        return Value(a / b);
+    case Instruction::Type::LessThan:
+        return Value(a < b);
+    case Instruction::Type::LessThanEquals:
+        return Value(a <= b);
+    case Instruction::Type::GreaterThan:
+        return Value(a > b);
+    case Instruction::Type::GreaterThanEquals:
+        return Value(a >= b);
+    // NOTE: For two numbers, loose and strict equality are the same thing.
+    case Instruction::Type::StrictlyEquals:
+    case Instruction::Type::LooselyEquals:
+        return Value(a == b);
+    case Instruction::Type::StrictlyInequals:
+    case Instruction::Type::LooselyInequals:
+        return Value(a != b);
+    default:
+        break;
+    }
+
+    auto lhs_int32 = as_int32(lhs);
+    auto rhs_int32 = as_int32(rhs);
+    if (!lhs_int32.has_value() || !rhs_int32.has_value())
+        return {};
+
+    auto x = *lhs_int32;
+    auto y = *rhs_int32;
+    auto shift_count = static_cast<u32>(y) & 0x1f;
+
+    switch (type) {
+    case Instruction::Type::BitwiseAnd:
+        return Value(x & y);
+    case Instruction::Type::BitwiseOr:
+        return Value(x | y);
+    case Instruction::Type::BitwiseXor:
+        return Value(x ^ y);
+    case Instruction::Type::LeftShift:
+        return Value(static_cast<i32>(static_cast<u32>(x) << shift_count));
+    case Instruction::Type::RightShift:
+        return Value(x >> shift_count);
+    case Instruction::Type::UnsignedRightShift:
+        return Value(static_cast<double>(static_cast<u32>(x) >> shift_count));
+    default:
+        return {};
+    }
+}
+
+static Optional<u32> binary_operation_lhs(Instruction const& instruction)
+{
+    switch (instruction.type()) {
+#define __BYTECODE_OP(OpTitleCase, op_snake_case) \
+    case Instruction::Type::OpTitleCase:           \
+        return static_cast<Op::OpTitleCase const&>(instruction).lhs().index();
+        JS_ENUMERATE_COMMON_BINARY_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+    default:
+        return {};
+    }
+}
+
+// Folds operations on constants within a basic block. The LoadImmediate that produced the accumulator
+// is rewritten to hold the result, and the operation itself is removed. Any Store of the operands is
+// left in place for EliminateDeadStores to clean up.
+void FoldConstants::perform(PassPipelineExecutable& executable)
+{
+    started();
+
+    for (auto& block : executable.executable.basic_blocks) {
+        HashMap<u32, Value> register_constants;
+
+        // The LoadImmediate whose value is in the accumulator, if nothing has read or replaced it since.
+        Op::LoadImmediate* foldable_load = nullptr;
+        Optional<Value> accumulator_constant;
+        Vector<size_t> instructions_to_remove;
+
+        for (InstructionStreamIterator it(block.instruction_stream()); !it.at_end(); ++it) {
+            auto& instruction = const_cast<Instruction&>(*it);
+
+            Optional<Value> folded_value;
+            if (foldable_load) {
+                if (auto lhs = binary_operation_lhs(instruction); lhs.has_value()) {
+                    if (auto constant = register_constants.get(*lhs); constant.has_value())
+                        folded_value = fold_binary_operation(instruction.type(), *constant, *accumulator_constant);
+                } else {
+                    folded_value = fold_unary_operation(instruction.type(), *accumulator_constant);
+                }
+            }
+
+            if (folded_value.has_value()) {
+                VERIFY(is_foldable_constant(*folded_value));
+                new (foldable_load) Op::LoadImmediate(*folded_value);
+                accumulator_constant = *folded_value;
+                instructions_to_remove.append(it.offset());
+                continue;
+            }
+
+            switch (instruction.type()) {
+            case Instruction::Type::LoadImmediate: {
+                auto value = static_cast<Op::LoadImmediate const&>(instruction).value();
+                if (is_foldable_constant(value)) {
+                    foldable_load = &static_cast<Op::LoadImmediate&>(instruction);
+                    accumulator_constant = value;
+                } else {
+                    foldable_load = nullptr;
+                    accumulator_constant = {};
+                }
+                continue;
+            }
+            case Instruction::Type::Store: {
+                // The register now holds a copy of the accumulator, so the LoadImmediate can no longer be rewritten.
+                auto dst = static_cast<Op::Store const&>(instruction).dst().index();
+                if (accumulator_constant.has_value())
+                    register_constants.set(dst, *accumulator_constant);
+                else
+                    register_constants.remove(dst);
+                foldable_load = nullptr;
+                continue;
+            }
+            default:
+                break;
+            }
+
+            for_each_register_access(instruction, [&](u32 reg, Instruction::RegisterAccess access) {
+                if (access != Instruction::RegisterAccess::Read)
+                    register_constants.remove(reg);
+            });
+            foldable_load = nullptr;
+            accumulator_constant = {};
+        }
+
+        block.remove_instructions(instructions_to_remove);
+    }
+
+    finished();
+}
+
+}
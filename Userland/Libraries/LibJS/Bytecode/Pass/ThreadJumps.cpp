@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+// Rewriting a conditional jump into an unconditional one happens in place.
+static_assert(sizeof(Op::Jump) == sizeof(Op::JumpConditional));
+static_assert(sizeof(Op::Jump) == sizeof(Op::JumpNullish));
+static_assert(sizeof(Op::Jump) == sizeof(Op::JumpUndefined));
+
+static constexpr size_t max_threading_hops = 8;
+
+static bool is_conditional_jump(Instruction const& instruction)
+{
+    return instruction.type() == Instruction::Type::JumpConditional
+        || instruction.type() == Instruction::Type::JumpNullish
+        || instruction.type() == Instruction::Type::JumpUndefined;
+}
+
+static Optional<Label> resolve_conditional_jump(Op::Jump const& jump, Optional<Value> accumulator)
+{
+    if (&jump.true_target()->block() == &jump.false_target()->block())
+        return jump.true_target();
+
+    if (!accumulator.has_value())
+        return {};
+
+    bool condition = false;
+    switch (jump.type()) {
+    case Instruction::Type::JumpConditional:
+        condition = accumulator->to_boolean();
+        break;
+    case Instruction::Type::JumpNullish:
+        condition = accumulator->is_nullish();
+        break;
+    case Instruction::Type::JumpUndefined:
+        condition = accumulator->is_undefined();
+        break;
+    default:
+        VERIFY_NOT_REACHED();
+    }
+    return condition ? jump.true_target() : jump.false_target();
+}
+
+// Follows jumps to blocks that immediately jump somewhere else, as long as it's known where they go.
+static Label thread_target(Label target, Optional<Value> accumulator)
+{
+    for (size_t hops = 0; hops < max_threading_hops; ++hops) {
+        auto stream = target.block().instruction_stream();
+        if (stream.is_empty())
+            break;
+
+        InstructionStreamIterator it(stream);
+        auto& first_instruction = *it;
+        Optional<Label> next_target;
+        if (first_instruction.type() == Instruction::Type::Jump)
+            next_target = static_cast<Op::Jump const&>(first_instruction).true_target();
+        else if (is_conditional_jump(first_instruction))
+            next_target = resolve_conditional_jump(static_cast<Op::Jump const&>(first_instruction), accumulator);
+
+        if (!next_target.has_value() || &next_target->block() == &target.block())
+            break;
+        target = *next_target;
+    }
+    return target;
+}
+
+void ThreadJumps::perform(PassPipelineExecutable& executable)
+{
+    started();
+
+    for (auto& block : executable.executable.basic_blocks) {
+        // The accumulator is preserved across jumps, so a constant loaded before the jump lets us resolve the conditional jumps after it.
+        Optional<Value> accumulator_constant;
+
+        for (InstructionStreamIterator it(block.instruction_stream()); !it.at_end(); ++it) {
+            auto& instruction = const_cast<Instruction&>(*it);
+
+            if (instruction.type() == Instruction::Type::LoadImmediate) {
+                auto value = static_cast<Op::LoadImmediate const&>(instruction).value();
+                if (value.is_number() || value.is_boolean() || value.is_nullish())
+                    accumulator_constant = value;
+                else
+                    accumulator_constant = {};
+                continue;
+            }
+
+            if (instruction.type() == Instruction::Type::Store)
+                continue;
+
+            if (instruction.type() == Instruction::Type::Jump) {
+                auto& jump = static_cast<Op::Jump&>(instruction);
+                auto target = thread_target(*jump.true_target(), accumulator_constant);
+                jump.set_targets(target, {});
+                break;
+            }
+
+            if (is_conditional_jump(instruction)) {
+                auto& jump = static_cast<Op::Jump&>(instruction);
+                if (auto resolved = resolve_conditional_jump(jump, accumulator_constant); resolved.has_value()) {
+                    auto target = thread_target(*resolved, accumulator_constant);
+                    new (&instruction) Op::Jump(target);
+                } else {
+                    // Which way we go depends on the accumulator, so we can only skip over unconditional jumps here.
+                    auto true_target = thread_target(*jump.true_target(), {});
+                    auto false_target = thread_target(*jump.false_target(), {});
+                    jump.set_targets(true_target, false_target);
+                }
+                break;
+            }
+
+            accumulator_constant = {};
+        }
+    }
+
+    // The CFG has changed, and needs to be regenerated.
+    executable.cfg = {};
+    executable.inverted_cfg = {};
+
+    finished();
+}
+
+}
@@ -13,13 +13,87 @@
 
 namespace JS::Bytecode {
 
+struct RegisterLiveness {
+    HashMap<BasicBlock const*, HashTable<u32>> live_in;
+    HashMap<BasicBlock const*, HashTable<u32>> live_out;
+
+    // Registers read by an exception handler or finalizer. Since those can be entered from any instruction
+    // in the protected region, these registers are considered to be live everywhere.
+    HashTable<u32> always_live;
+};
+
 struct PassPipelineExecutable {
     Executable& executable;
     Optional<HashMap<BasicBlock const*, HashTable<BasicBlock const*>>> cfg {};
     Optional<HashMap<BasicBlock const*, HashTable<BasicBlock const*>>> inverted_cfg {};
     Optional<HashTable<BasicBlock const*>> exported_blocks {};
+    Optional<RegisterLiveness> liveness {};
 };
 
+// Calls the callback with the index and access kind of every register (other than the accumulator) the instruction refers to.
+// NOTE: NewArray reads its whole element range, not just the two registers it stores.
+template<typename Callback>
+inline void for_each_register_access(Instruction const& instruction, Callback callback)
+{
+    if (instruction.type() == Instruction::Type::NewArray) {
+        auto& new_array = static_cast<Op::NewArray const&>(instruction);
+        for (size_t i = 0; i < new_array.element_count(); ++i)
+            callback(static_cast<u32>(new_array.first_element().index() + i), Instruction::RegisterAccess::Read);
+        return;
+    }
+
+    const_cast<Instruction&>(instruction).visit_registers([&](Register& reg, Instruction::RegisterAccess access) {
+        if (reg.index() != Register::accumulator_index)
+            callback(reg.index(), access);
+    });
+}
+
+// Calls the callback with every block control can flow to from the given block, including the ones
+// only entered through an unwind context, a generator resumption or a FinishUnwind.
+template<typename Callback>
+inline void for_each_successor(BasicBlock const& block, Callback callback)
+{
+    for (InstructionStreamIterator it(block.instruction_stream()); !it.at_end(); ++it) {
+        auto& instruction = *it;
+        switch (instruction.type()) {
+        case Instruction::Type::Jump:
+        case Instruction::Type::JumpConditional:
+        case Instruction::Type::JumpNullish:
+        case Instruction::Type::JumpUndefined: {
+            auto& jump = static_cast<Op::Jump const&>(instruction);
+            if (jump.true_target().has_value())
+                callback(jump.true_target()->block());
+            if (jump.false_target().has_value())
+                callback(jump.false_target()->block());
+            break;
+        }
+        case Instruction::Type::EnterUnwindContext: {
+            auto& enter = static_cast<Op::EnterUnwindContext const&>(instruction);
+            callback(enter.entry_point().block());
+            if (enter.handler_target().has_value())
+                callback(enter.handler_target()->block());
+            if (enter.finalizer_target().has_value())
+                callback(enter.finalizer_target()->block());
+            break;
+        }
+        case Instruction::Type::ContinuePendingUnwind:
+            callback(static_cast<Op::ContinuePendingUnwind const&>(instruction).resume_target().block());
+            break;
+        case Instruction::Type::FinishUnwind:
+            callback(static_cast<Op::FinishUnwind const&>(instruction).next_target().block());
+            break;
+        case Instruction::Type::Yield: {
+            auto& continuation = static_cast<Op::Yield const&>(instruction).continuation();
+            if (continuation.has_value())
+                callback(continuation->block());
+            break;
+        }
+        default:
+            break;
+        }
+    }
+}
+
 class Pass {
 public:
     Pass() = default;
@@ -60,6 +134,17 @@ public:
     PassManager() = default;
     ~PassManager() override = default;
 
+    // Accumulated over every executable this pipeline has been run on.
+    struct Statistics {
+        size_t executables { 0 };
+        size_t instructions_before { 0 };
+        size_t instructions_after { 0 };
+        size_t bytes_before { 0 };
+        size_t bytes_after { 0 };
+        size_t registers_before { 0 };
+        size_t registers_after { 0 };
+    };
+
     void add(NonnullOwnPtr<Pass> pass) { m_passes.append(move(pass)); }
 
     template<typename PassT, typename... Args>
@@ -67,8 +152,22 @@ public:
 
     void perform(Executable& executable)
     {
+        m_statistics.executables++;
+        m_statistics.instructions_before += executable.instruction_count();
+        m_statistics.bytes_before += executable.bytecode_size();
+        m_statistics.registers_before += executable.number_of_registers;
+
         PassPipelineExecutable pipeline_executable { executable };
         perform(pipeline_executable);
+
+        // Any machine code was compiled from the bytecode we just rewrote.
+        executable.native_executable = nullptr;
+        executable.run_count = 0;
+        executable.did_try_to_compile = false;
+
+        m_statistics.instructions_after += executable.instruction_count();
+        m_statistics.bytes_after += executable.bytecode_size();
+        m_statistics.registers_after += executable.number_of_registers;
     }
 
     virtual void perform(PassPipelineExecutable& executable) override
@@ -79,8 +178,11 @@ public:
         finished();
     }
 
+    Statistics const& statistics() const { return m_statistics; }
+
 private:
     NonnullOwnPtrVector<Pass> m_passes;
+    Statistics m_statistics;
 };
 
 namespace Passes {
@@ -121,6 +223,60 @@ private:
     virtual void perform(PassPipelineExecutable&) override;
 };
 
+class FoldConstants : public Pass {
+public:
+    FoldConstants() = default;
+    ~FoldConstants() override = default;
+
+private:
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+class ThreadJumps : public Pass {
+public:
+    ThreadJumps() = default;
+    ~ThreadJumps() override = default;
+
+private:
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+class ComputeLiveness : public Pass {
+public:
+    ComputeLiveness() = default;
+    ~ComputeLiveness() override = default;
+
+private:
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+class EliminateDeadStores : public Pass {
+public:
+    EliminateDeadStores() = default;
+    ~EliminateDeadStores() override = default;
+
+private:
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+class EliminateRedundantLoads : public Pass {
+public:
+    EliminateRedundantLoads() = default;
+    ~EliminateRedundantLoads() override = default;
+
+private:
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+class CoalesceRegisters : public Pass {
+public:
+    CoalesceRegisters() = default;
+    ~CoalesceRegisters() override = default;
+
+private:
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
 class DumpCFG : public Pass {
 public:
     DumpCFG(FILE* file)
@@ -25,6 +25,7 @@ public:
     String const& get(StringTableIndex) const;
     void dump() const;
     bool is_empty() const { return m_strings.is_empty(); }
+    Vector<String> const& strings() const { return m_strings; }
 
 private:
     Vector<String> m_strings;
@@ -282,6 +282,7 @@ struct Executable;
 class Generator;
 class Instruction;
 class Interpreter;
+class Label;
 class Register;
 }
 
@@ -24,6 +24,14 @@ public:                                            \
     }                                              \
     friend class JS::Heap;
 
+// Opts a cell class into the generational write barrier. Every store of a cell pointer into an
+// instance of the class must be followed by a call to write_barrier(). Subclasses inherit this
+// unless they override visit_edges(), since edges of their own may be stored without a barrier.
+// Those have to opt in separately, see Heap::has_write_barrier().
+#define JS_CELL_HAS_WRITE_BARRIER(class_) \
+public:                                   \
+    using WriteBarrierClass = class_;
+
 class Cell {
     AK_MAKE_NONCOPYABLE(Cell);
     AK_MAKE_NONMOVABLE(Cell);
@@ -32,10 +40,11 @@ public:
     virtual void initialize(Realm&) { }
     virtual ~Cell() = default;
 
-    bool is_marked() const { return m_mark; }
-    void set_marked(bool b) { m_mark = b; }
+    // NOTE: The mark bits live in a bitmap in the HeapBlock, see HeapBlock.h.
+    bool is_marked() const;
+    void set_marked(bool);
 
-    enum class State {
+    enum class State : u8 {
         Live,
         Dead,
     };
@@ -43,6 +52,31 @@ public:
     State state() const { return m_state; }
     void set_state(State state) { m_state = state; }
 
+    // Whether the last collection found the cell to be unreachable. Its block may not have been swept yet,
+    // so anything that holds on to cells weakly has to check this before handing one out.
+    bool is_dead() const;
+
+    // Cells that have survived a garbage collection are old, and only get collected by a full collection.
+    bool is_old() const { return m_old; }
+    void set_old(bool b) { m_old = b; }
+
+    // Old cells whose edges are visited during a young generation collection.
+    bool is_remembered() const { return m_remembered; }
+    void set_remembered(bool b) { m_remembered = b; }
+
+    bool has_write_barrier() const { return m_has_write_barrier; }
+    void set_has_write_barrier(bool b) { m_has_write_barrier = b; }
+
+    // Must be called after storing a pointer to another cell in this cell, so the young generation collector can find it.
+    ALWAYS_INLINE void write_barrier()
+    {
+        if (m_old && !m_remembered)
+            remember();
+    }
+
+    // For when a cell hands out mutable references to its edges, and stores through them can't be tracked.
+    void disable_write_barrier();
+
     virtual StringView class_name() const = 0;
 
     class Visitor {
@@ -84,8 +118,12 @@ protected:
     Cell() = default;
 
 private:
-    bool m_mark : 1 { false };
-    State m_state : 7 { State::Live };
+    void remember();
+
+    bool m_old : 1 { false };
+    bool m_remembered : 1 { false };
+    bool m_has_write_barrier : 1 { false };
+    State m_state { State::Live };
 };
 
 }
@@ -19,9 +19,16 @@ CellAllocator::CellAllocator(size_t cell_size)
 
 Cell* CellAllocator::allocate_cell(Heap& heap)
 {
+    while (m_usable_blocks.is_empty() && !m_blocks_to_sweep.is_empty())
+        sweep_block(heap, *m_blocks_to_sweep.first());
+
     if (m_usable_blocks.is_empty()) {
-        auto block = HeapBlock::create_with_cell_size(heap, m_cell_size);
-        m_usable_blocks.append(*block.leak_ptr());
+        if (!m_empty_blocks.is_empty()) {
+            m_usable_blocks.append(*m_empty_blocks.first());
+        } else {
+            auto block = HeapBlock::create_with_cell_size(heap, m_cell_size);
+            m_usable_blocks.append(*block.leak_ptr());
+        }
     }
 
     auto& block = *m_usable_blocks.last();
@@ -34,8 +41,13 @@ Cell* CellAllocator::allocate_cell(Heap& heap)
 
 void CellAllocator::block_did_become_empty(Badge<Heap>, HeapBlock& block)
 {
-    auto& heap = block.heap();
     block.m_list_node.remove();
+    deallocate_block(block);
+}
+
+void CellAllocator::deallocate_block(HeapBlock& block)
+{
+    auto& heap = block.heap();
     // NOTE: HeapBlocks are managed by the BlockAllocator, so we don't want to `delete` the block here.
     block.~HeapBlock();
     heap.block_allocator().deallocate_block(&block);
@@ -47,4 +59,40 @@ void CellAllocator::block_did_become_usable(Badge<Heap>, HeapBlock& block)
     m_usable_blocks.append(block);
 }
 
+void CellAllocator::schedule_sweep(Badge<Heap>)
+{
+    for (auto* list : { &m_full_blocks, &m_usable_blocks }) {
+        while (!list->is_empty()) {
+            auto* block = list->take_first();
+            block->set_needs_sweep(true);
+            m_blocks_to_sweep.append(*block);
+        }
+    }
+}
+
+void CellAllocator::finish_sweeping(Heap& heap)
+{
+    while (!m_blocks_to_sweep.is_empty())
+        sweep_block(heap, *m_blocks_to_sweep.first());
+}
+
+void CellAllocator::deallocate_empty_blocks(Badge<Heap>)
+{
+    while (!m_empty_blocks.is_empty())
+        deallocate_block(*m_empty_blocks.take_first());
+}
+
+void CellAllocator::sweep_block(Heap& heap, HeapBlock& block)
+{
+    block.m_list_node.remove();
+    block.set_needs_sweep(false);
+
+    if (!heap.sweep_block({}, block))
+        m_empty_blocks.append(block);
+    else if (block.is_full())
+        m_full_blocks.append(block);
+    else
+        m_usable_blocks.append(block);
+}
+
 }
@@ -33,18 +33,35 @@ public:
             if (callback(block) == IterationDecision::Break)
                 return IterationDecision::Break;
         }
+        for (auto& block : m_blocks_to_sweep) {
+            if (callback(block) == IterationDecision::Break)
+                return IterationDecision::Break;
+        }
         return IterationDecision::Continue;
     }
 
     void block_did_become_empty(Badge<Heap>, HeapBlock&);
     void block_did_become_usable(Badge<Heap>, HeapBlock&);
 
+    // Defers sweeping all blocks until they are needed for allocation, or finish_sweeping() is called.
+    void schedule_sweep(Badge<Heap>);
+    void finish_sweeping(Heap&);
+    void deallocate_empty_blocks(Badge<Heap>);
+
 private:
+    void sweep_block(Heap&, HeapBlock&);
+    void deallocate_block(HeapBlock&);
+
     const size_t m_cell_size;
 
     using BlockList = IntrusiveList<&HeapBlock::m_list_node>;
     BlockList m_full_blocks;
     BlockList m_usable_blocks;
+    BlockList m_blocks_to_sweep;
+
+    // Blocks that sweeping left empty. They can still be allocated into, but are only given back once every allocator
+    // is done sweeping, since the destructor of a dead cell may look at the block of another dead cell.
+    BlockList m_empty_blocks;
 };
 
 }
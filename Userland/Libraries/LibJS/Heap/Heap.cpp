@@ -5,8 +5,10 @@
  */
 
 #include <AK/Badge.h>
+#include <AK/BinarySearch.h>
 #include <AK/Debug.h>
 #include <AK/HashTable.h>
+#include <AK/QuickSort.h>
 #include <AK/StackInfo.h>
 #include <AK/TemporaryChange.h>
 #include <LibCore/ElapsedTimer.h>
@@ -77,13 +79,24 @@ Cell* Heap::allocate_cell(size_t size)
         collect_garbage();
     } else if (m_allocations_since_last_gc > m_max_allocations_between_gc) {
         m_allocations_since_last_gc = 0;
-        collect_garbage();
+        collect_garbage(should_collect_everything() ? CollectionType::CollectGarbage : CollectionType::CollectYoungGeneration);
     } else {
         ++m_allocations_since_last_gc;
     }
 
     auto& allocator = allocator_for_size(size);
-    return allocator.allocate_cell(*this);
+    auto* cell = allocator.allocate_cell(*this);
+    auto* block = HeapBlock::from_cell(cell);
+    if (!block->has_young_cells()) {
+        block->set_has_young_cells(true);
+        m_blocks_with_young_cells.append(block);
+    }
+    return cell;
+}
+
+bool Heap::should_collect_everything() const
+{
+    return m_cells_promoted_since_last_full_gc > max(m_old_cells_after_last_full_gc, m_max_allocations_between_gc);
 }
 
 void Heap::collect_garbage(CollectionType collection_type, bool print_report)
@@ -96,38 +109,38 @@ void Heap::collect_garbage(CollectionType collection_type, bool print_report)
     perf_event(PERF_EVENT_SIGNPOST, gc_perf_string_id, global_gc_counter++);
 #endif
 
+    // NOTE: Marking relies on every cell's state being accurate, so whatever the previous collection left unswept has to go first.
+    finish_sweeping();
+
     auto collection_measurement_timer = Core::ElapsedTimer::start_new();
-    if (collection_type == CollectionType::CollectGarbage) {
+    if (collection_type != CollectionType::CollectEverything) {
         if (m_gc_deferrals) {
             m_should_gc_when_deferral_ends = true;
             return;
         }
-        HashTable<Cell*> roots;
-        gather_roots(roots);
-        mark_live_cells(roots);
+        mark_live_cells(collection_type);
     }
-    sweep_dead_cells(print_report, collection_measurement_timer);
+    if (collection_type == CollectionType::CollectYoungGeneration)
+        sweep_young_cells(print_report, collection_measurement_timer);
+    else
+        sweep_dead_cells(collection_type, print_report, collection_measurement_timer);
 }
 
-void Heap::gather_roots(HashTable<Cell*>& roots)
+void Heap::gather_roots(Cell::Visitor& visitor)
 {
-    vm().gather_roots(roots);
-    gather_conservative_roots(roots);
+    dbgln_if(HEAP_DEBUG, "gather_roots:");
+
+    vm().gather_roots(visitor);
+    gather_conservative_roots(visitor);
 
     for (auto& handle : m_handles)
-        roots.set(handle.cell());
+        visitor.visit(handle.cell());
 
     for (auto& vector : m_marked_vectors)
-        vector.gather_roots(roots);
-
-    if constexpr (HEAP_DEBUG) {
-        dbgln("gather_roots:");
-        for (auto* root : roots)
-            dbgln("  + {}", root);
-    }
+        vector.gather_roots(visitor);
 }
 
-__attribute__((no_sanitize("address"))) void Heap::gather_conservative_roots(HashTable<Cell*>& roots)
+__attribute__((no_sanitize("address"))) void Heap::gather_conservative_roots(Cell::Visitor& visitor)
 {
     FlatPtr dummy;
 
@@ -136,7 +149,7 @@ __attribute__((no_sanitize("address"))) void Heap::gather_conservative_roots(Has
     jmp_buf buf;
     setjmp(buf);
 
-    HashTable<FlatPtr> possible_pointers;
+    Vector<FlatPtr> possible_pointers;
 
     auto* raw_jmp_buf = reinterpret_cast<FlatPtr const*>(buf);
 
@@ -146,14 +159,14 @@ __attribute__((no_sanitize("address"))) void Heap::gather_conservative_roots(Has
             // match any pointer-backed tag, in that case we have to extract the pointer to its
             // canonical form and add that as a possible pointer.
             if ((data & SHIFTED_IS_CELL_PATTERN) == SHIFTED_IS_CELL_PATTERN)
-                possible_pointers.set(Value::extract_pointer_bits(data));
+                possible_pointers.append(Value::extract_pointer_bits(data));
             else
-                possible_pointers.set(data);
+                possible_pointers.append(data);
         } else {
             static_assert((sizeof(Value) % sizeof(FlatPtr*)) == 0);
             // In the 32-bit case we will look at the top and bottom part of Value separately we just
             // add both the upper and lower bytes as possible pointers.
-            possible_pointers.set(data);
+            possible_pointers.append(data);
         }
     };
 
@@ -178,22 +191,25 @@ __attribute__((no_sanitize("address"))) void Heap::gather_conservative_roots(Has
         }
     }
 
-    HashTable<HeapBlock*> all_live_heap_blocks;
+    // NOTE: The block addresses are kept sorted, so checking whether a possible pointer is into the heap is a binary search.
+    Vector<FlatPtr> all_live_heap_blocks;
     for_each_block([&](auto& block) {
-        all_live_heap_blocks.set(&block);
+        all_live_heap_blocks.append(reinterpret_cast<FlatPtr>(&block));
         return IterationDecision::Continue;
     });
+    quick_sort(all_live_heap_blocks);
 
     for (auto possible_pointer : possible_pointers) {
         if (!possible_pointer)
             continue;
         dbgln_if(HEAP_DEBUG, "  ? {}", (void const*)possible_pointer);
         auto* possible_heap_block = HeapBlock::from_cell(reinterpret_cast<Cell const*>(possible_pointer));
-        if (all_live_heap_blocks.contains(possible_heap_block)) {
+        auto possible_heap_block_address = reinterpret_cast<FlatPtr>(possible_heap_block);
+        if (binary_search(all_live_heap_blocks, possible_heap_block_address)) {
             if (auto* cell = possible_heap_block->cell_from_possible_pointer(possible_pointer)) {
                 if (cell->state() == Cell::State::Live) {
                     dbgln_if(HEAP_DEBUG, "  ?-> {}", (void const*)cell);
-                    roots.set(cell);
+                    visitor.visit(*cell);
                 } else {
                     dbgln_if(HEAP_DEBUG, "  #-> {}", (void const*)cell);
                 }
@@ -204,66 +220,251 @@ __attribute__((no_sanitize("address"))) void Heap::gather_conservative_roots(Has
 
 class MarkingVisitor final : public Cell::Visitor {
 public:
-    MarkingVisitor() = default;
+    MarkingVisitor(Heap::CollectionType collection_type, Vector<Cell*>& unbarriered_old_cells)
+        : m_only_young_cells(collection_type == Heap::CollectionType::CollectYoungGeneration)
+        , m_unbarriered_old_cells(unbarriered_old_cells)
+    {
+    }
 
     virtual void visit_impl(Cell& cell) override
     {
         if (cell.is_marked())
             return;
+        // NOTE: Old cells are never collected by a young generation collection, so there's no need to mark them,
+        //       or to follow their edges. The ones that may point to young cells are visited by mark_live_cells().
+        if (m_only_young_cells && cell.is_old())
+            return;
         dbgln_if(HEAP_DEBUG, "  ! {}", &cell);
 
         cell.set_marked(true);
-        cell.visit_edges(*this);
+
+        // NOTE: Everything that survives a full collection is old. This happens while marking rather than sweeping,
+        //       since the mutator may store into a cell that hasn't been swept yet.
+        if (!m_only_young_cells) {
+            cell.set_old(true);
+            cell.set_remembered(!cell.has_write_barrier());
+            if (cell.is_remembered())
+                m_unbarriered_old_cells.append(&cell);
+            ++m_marked_cells;
+        }
+
+        m_work_queue.append(&cell);
     }
+
+    // NOTE: Cells are only queued when they're marked, and their edges visited from here.
+    //       This keeps deep object graphs from recursing through visit_edges() until we run out of stack.
+    void mark_all_live_cells()
+    {
+        while (!m_work_queue.is_empty())
+            m_work_queue.take_last()->visit_edges(*this);
+    }
+
+    size_t marked_cells() const { return m_marked_cells; }
+
+private:
+    bool m_only_young_cells { false };
+    Vector<Cell*>& m_unbarriered_old_cells;
+    Vector<Cell*> m_work_queue;
+    size_t m_marked_cells { 0 };
 };
 
-void Heap::mark_live_cells(HashTable<Cell*> const& roots)
+void Heap::mark_live_cells(CollectionType collection_type)
 {
     dbgln_if(HEAP_DEBUG, "mark_live_cells:");
 
-    MarkingVisitor visitor;
-    for (auto* root : roots)
-        visitor.visit(root);
+    bool only_young_cells = collection_type == CollectionType::CollectYoungGeneration;
+
+    // Nothing is remembered after a full collection until it's written to again.
+    if (!only_young_cells) {
+        m_remembered_cells.clear();
+        m_unbarriered_old_cells.clear();
+        for (auto* block : m_blocks_with_young_cells)
+            block->set_has_young_cells(false);
+        m_blocks_with_young_cells.clear();
+    }
+
+    MarkingVisitor visitor(collection_type, m_unbarriered_old_cells);
+    gather_roots(visitor);
+
+    if (only_young_cells) {
+        for (auto* cell : m_remembered_cells)
+            cell->visit_edges(visitor);
+        for (auto* cell : m_unbarriered_old_cells)
+            cell->visit_edges(visitor);
+    }
+
+    visitor.mark_all_live_cells();
 
     for (auto& inverse_root : m_uprooted_cells)
         inverse_root->set_marked(false);
 
+    // Old cells can only be collected by a full collection, so they stay uprooted until then.
+    if (only_young_cells) {
+        m_uprooted_cells.remove_all_matching([](Cell* cell) { return !cell->is_old(); });
+        return;
+    }
+
+    if (!m_uprooted_cells.is_empty())
+        m_unbarriered_old_cells.remove_all_matching([](Cell* cell) { return !cell->is_marked(); });
+    m_old_cells_after_last_full_gc = visitor.marked_cells();
+    m_cells_promoted_since_last_full_gc = 0;
     m_uprooted_cells.clear();
 }
 
-void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measurement_timer)
+void Heap::promote_cell(Cell& cell)
+{
+    cell.set_old(true);
+    ++m_cells_promoted_since_last_full_gc;
+    if (!cell.has_write_barrier()) {
+        cell.set_remembered(true);
+        m_unbarriered_old_cells.append(&cell);
+    }
+}
+
+void Heap::sweep_dead_cells(CollectionType collection_type, bool print_report, Core::ElapsedTimer const& measurement_timer)
 {
     dbgln_if(HEAP_DEBUG, "sweep_dead_cells:");
+
+    auto mark_time = measurement_timer.elapsed();
+
+    if (collection_type == CollectionType::CollectEverything) {
+        m_remembered_cells.clear();
+        m_unbarriered_old_cells.clear();
+        for (auto* block : m_blocks_with_young_cells)
+            block->set_has_young_cells(false);
+        m_blocks_with_young_cells.clear();
+    }
+
+    m_sweep_statistics = {};
+    for (auto& allocator : m_allocators)
+        allocator->schedule_sweep({});
+
+    // NOTE: This has to happen before any block is swept, while the dead cells are still around to look at,
+    //       but after the blocks are scheduled for sweeping, since that is what tells Cell::is_dead() to look at the marks.
+    for (auto& weak_container : m_weak_containers)
+        weak_container.remove_dead_cells({});
+
+    // Sweeping is left to the allocators, which sweep a block whenever they run out of room to allocate in.
+    // That spreads the cost of it over many short pauses, instead of a single one that grows with the size of the heap.
+    if (collection_type != CollectionType::CollectEverything && !print_report)
+        return;
+
+    auto sweep_measurement_timer = Core::ElapsedTimer::start_new();
+    finish_sweeping();
+    auto sweep_time = sweep_measurement_timer.elapsed();
+
+    if constexpr (HEAP_DEBUG) {
+        for_each_block([&](auto& block) {
+            dbgln(" > Live HeapBlock @ {}: cell_size={}", &block, block.cell_size());
+            return IterationDecision::Continue;
+        });
+    }
+
+    if (print_report) {
+        size_t live_block_count = 0;
+        for_each_block([&](auto&) {
+            ++live_block_count;
+            return IterationDecision::Continue;
+        });
+
+        auto& statistics = m_sweep_statistics;
+        dbgln("Garbage collection report");
+        dbgln("=============================================");
+        dbgln("     Collection: full");
+        dbgln("     Time spent: {} ms", mark_time + sweep_time);
+        dbgln("      Mark time: {} ms", mark_time);
+        dbgln("     Sweep time: {} ms", sweep_time);
+        dbgln("     Live cells: {} ({} bytes)", statistics.live_cells, statistics.live_cell_bytes);
+        dbgln("Collected cells: {} ({} bytes)", statistics.collected_cells, statistics.collected_cell_bytes);
+        dbgln("    Live blocks: {} ({} bytes)", live_block_count, live_block_count * HeapBlock::block_size);
+        dbgln("   Freed blocks: {} ({} bytes)", statistics.freed_blocks, statistics.freed_blocks * HeapBlock::block_size);
+        dbgln("=============================================");
+    }
+}
+
+bool Heap::sweep_block(Badge<CellAllocator>, HeapBlock& block)
+{
+    dbgln_if(HEAP_DEBUG, "sweep_block: {}", &block);
+    VERIFY(!block.has_young_cells());
+
+    bool block_has_live_cells = false;
+    block.for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+        if (!block.is_marked(cell)) {
+            dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
+            block.deallocate(cell);
+            ++m_sweep_statistics.collected_cells;
+            m_sweep_statistics.collected_cell_bytes += block.cell_size();
+        } else {
+            block_has_live_cells = true;
+            ++m_sweep_statistics.live_cells;
+            m_sweep_statistics.live_cell_bytes += block.cell_size();
+        }
+    });
+    block.clear_marks();
+
+    if (!block_has_live_cells) {
+        dbgln_if(HEAP_DEBUG, " - HeapBlock empty @ {}: cell_size={}", &block, block.cell_size());
+        ++m_sweep_statistics.freed_blocks;
+    }
+    return block_has_live_cells;
+}
+
+void Heap::finish_sweeping()
+{
+    for (auto& allocator : m_allocators)
+        allocator->finish_sweeping(*this);
+    for (auto& allocator : m_allocators)
+        allocator->deallocate_empty_blocks({});
+}
+
+void Heap::sweep_young_cells(bool print_report, Core::ElapsedTimer const& measurement_timer)
+{
+    dbgln_if(HEAP_DEBUG, "sweep_young_cells:");
+
+    auto mark_time = measurement_timer.elapsed();
     Vector<HeapBlock*, 32> empty_blocks;
     Vector<HeapBlock*, 32> full_blocks_that_became_usable;
 
     size_t collected_cells = 0;
-    size_t live_cells = 0;
+    size_t promoted_cells = 0;
     size_t collected_cell_bytes = 0;
-    size_t live_cell_bytes = 0;
+    size_t promoted_cell_bytes = 0;
 
-    for_each_block([&](auto& block) {
+    for (auto* block : m_blocks_with_young_cells) {
         bool block_has_live_cells = false;
-        bool block_was_full = block.is_full();
-        block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
-            if (!cell->is_marked()) {
+        bool block_was_full = block->is_full();
+        block->set_has_young_cells(false);
+        block->for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+            if (cell->is_old()) {
+                block_has_live_cells = true;
+            } else if (!block->is_marked(cell)) {
                 dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
-                block.deallocate(cell);
+                block->deallocate(cell);
                 ++collected_cells;
-                collected_cell_bytes += block.cell_size();
+                collected_cell_bytes += block->cell_size();
             } else {
-                cell->set_marked(false);
+                promote_cell(*cell);
                 block_has_live_cells = true;
-                ++live_cells;
-                live_cell_bytes += block.cell_size();
+                ++promoted_cells;
+                promoted_cell_bytes += block->cell_size();
             }
         });
+        block->clear_marks();
         if (!block_has_live_cells)
-            empty_blocks.append(&block);
-        else if (block_was_full != block.is_full())
-            full_blocks_that_became_usable.append(&block);
-        return IterationDecision::Continue;
-    });
+            empty_blocks.append(block);
+        else if (block_was_full != block->is_full())
+            full_blocks_that_became_usable.append(block);
+    }
+    m_blocks_with_young_cells.clear();
+
+    auto remembered_cells = m_remembered_cells.size() + m_unbarriered_old_cells.size();
+
+    // Every cell the remembered cells could point to is old now.
+    for (auto* cell : m_remembered_cells) {
+        if (cell->has_write_barrier())
+            cell->set_remembered(false);
+    }
+    m_remembered_cells.clear();
 
     for (auto& weak_container : m_weak_containers)
         weak_container.remove_dead_cells({});
@@ -278,28 +479,18 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
         allocator_for_size(block->cell_size()).block_did_become_usable({}, *block);
     }
 
-    if constexpr (HEAP_DEBUG) {
-        for_each_block([&](auto& block) {
-            dbgln(" > Live HeapBlock @ {}: cell_size={}", &block, block.cell_size());
-            return IterationDecision::Continue;
-        });
-    }
-
     int time_spent = measurement_timer.elapsed();
 
     if (print_report) {
-        size_t live_block_count = 0;
-        for_each_block([&](auto&) {
-            ++live_block_count;
-            return IterationDecision::Continue;
-        });
-
         dbgln("Garbage collection report");
         dbgln("=============================================");
+        dbgln("     Collection: young generation");
         dbgln("     Time spent: {} ms", time_spent);
-        dbgln("     Live cells: {} ({} bytes)", live_cells, live_cell_bytes);
+        dbgln("      Mark time: {} ms", mark_time);
+        dbgln("     Sweep time: {} ms", time_spent - mark_time);
+        dbgln(" Promoted cells: {} ({} bytes)", promoted_cells, promoted_cell_bytes);
         dbgln("Collected cells: {} ({} bytes)", collected_cells, collected_cell_bytes);
-        dbgln("    Live blocks: {} ({} bytes)", live_block_count, live_block_count * HeapBlock::block_size);
+        dbgln("Remembered cells: {}", remembered_cells);
         dbgln("   Freed blocks: {} ({} bytes)", empty_blocks.size(), empty_blocks.size() * HeapBlock::block_size);
         dbgln("=============================================");
     }
@@ -363,6 +554,36 @@ void Heap::uproot_cell(Cell* cell)
     m_uprooted_cells.append(cell);
 }
 
+void Heap::did_write_to_old_cell(Badge<Cell>, Cell& cell)
+{
+    VERIFY(cell.is_old());
+    VERIFY(cell.has_write_barrier());
+    cell.set_remembered(true);
+    m_remembered_cells.append(&cell);
+}
+
+void Heap::did_disable_write_barrier(Badge<Cell>, Cell& cell)
+{
+    // A young cell will be added to the unbarriered cells once it's promoted.
+    if (!cell.is_old())
+        return;
+    cell.set_remembered(true);
+    m_unbarriered_old_cells.append(&cell);
+}
+
+void Cell::remember()
+{
+    heap().did_write_to_old_cell({}, *this);
+}
+
+void Cell::disable_write_barrier()
+{
+    if (!m_has_write_barrier)
+        return;
+    m_has_write_barrier = false;
+    heap().did_disable_write_barrier({}, *this);
+}
+
 void register_safe_function_closure(void* base, size_t size)
 {
     if (!s_custom_ranges_for_conservative_scan) {
@@ -37,6 +37,7 @@ public:
     {
         auto* memory = allocate_cell(sizeof(T));
         new (memory) T(forward<Args>(args)...);
+        memory->set_has_write_barrier(has_write_barrier<T>());
         return static_cast<T*>(memory);
     }
 
@@ -45,6 +46,7 @@ public:
     {
         auto* memory = allocate_cell(sizeof(T));
         new (memory) T(forward<Args>(args)...);
+        memory->set_has_write_barrier(has_write_barrier<T>());
         auto* cell = static_cast<T*>(memory);
         memory->initialize(realm);
         return cell;
@@ -52,6 +54,7 @@ public:
 
     enum class CollectionType {
         CollectGarbage,
+        CollectYoungGeneration,
         CollectEverything,
     };
 
@@ -62,6 +65,9 @@ public:
     bool should_collect_on_every_allocation() const { return m_should_collect_on_every_allocation; }
     void set_should_collect_on_every_allocation(bool b) { m_should_collect_on_every_allocation = b; }
 
+    // The old cells a young generation collection has to visit the edges of, in addition to the roots.
+    size_t remembered_cell_count() const { return m_remembered_cells.size() + m_unbarriered_old_cells.size(); }
+
     void did_create_handle(Badge<HandleImpl>, HandleImpl&);
     void did_destroy_handle(Badge<HandleImpl>, HandleImpl&);
 
@@ -78,13 +84,43 @@ public:
 
     void uproot_cell(Cell* cell);
 
+    // Deallocates the dead cells in a block that was left unswept by the last full collection.
+    // Returns whether the block still has any live cells.
+    bool sweep_block(Badge<CellAllocator>, HeapBlock&);
+
+    void did_write_to_old_cell(Badge<Cell>, Cell&);
+    void did_disable_write_barrier(Badge<Cell>, Cell&);
+
 private:
+    template<typename>
+    struct ClassOfMemberFunction;
+    template<typename Class, typename Return, typename... Parameters>
+    struct ClassOfMemberFunction<Return (Class::*)(Parameters...)> {
+        using Type = Class;
+    };
+
+    // A class that opts into the write barrier vouches for the edges of itself and its base classes, so it covers
+    // the subclasses that visit no more edges than that. This is checked here since Heap is a friend of every cell.
+    template<typename T>
+    static constexpr bool has_write_barrier()
+    {
+        if constexpr (requires { typename T::WriteBarrierClass; }) {
+            using ClassWithEdges = typename ClassOfMemberFunction<decltype(&T::visit_edges)>::Type;
+            return IsBaseOf<ClassWithEdges, typename T::WriteBarrierClass>;
+        }
+        return false;
+    }
+
     Cell* allocate_cell(size_t);
 
-    void gather_roots(HashTable<Cell*>&);
-    void gather_conservative_roots(HashTable<Cell*>&);
-    void mark_live_cells(HashTable<Cell*> const& live_cells);
-    void sweep_dead_cells(bool print_report, Core::ElapsedTimer const&);
+    void gather_roots(Cell::Visitor&);
+    void gather_conservative_roots(Cell::Visitor&);
+    void mark_live_cells(CollectionType);
+    void sweep_dead_cells(CollectionType, bool print_report, Core::ElapsedTimer const&);
+    void sweep_young_cells(bool print_report, Core::ElapsedTimer const&);
+    void finish_sweeping();
+    void promote_cell(Cell&);
+    bool should_collect_everything() const;
 
     CellAllocator& allocator_for_size(size_t);
 
@@ -100,6 +136,19 @@ private:
     size_t m_max_allocations_between_gc { 100000 };
     size_t m_allocations_since_last_gc { 0 };
 
+    // A full collection happens once more cells have been promoted than were alive after the previous one.
+    size_t m_old_cells_after_last_full_gc { 0 };
+    size_t m_cells_promoted_since_last_full_gc { 0 };
+
+    struct SweepStatistics {
+        size_t collected_cells { 0 };
+        size_t collected_cell_bytes { 0 };
+        size_t live_cells { 0 };
+        size_t live_cell_bytes { 0 };
+        size_t freed_blocks { 0 };
+    };
+    SweepStatistics m_sweep_statistics;
+
     bool m_should_collect_on_every_allocation { false };
 
     VM& m_vm;
@@ -112,6 +161,16 @@ private:
 
     Vector<Cell*> m_uprooted_cells;
 
+    // NOTE: The young generation isn't a separate space, cells are promoted where they were allocated.
+    //       These are the blocks that a young generation collection has to sweep.
+    Vector<HeapBlock*> m_blocks_with_young_cells;
+
+    // Old cells with a write barrier that had a cell pointer stored in them since the last collection.
+    Vector<Cell*> m_remembered_cells;
+
+    // Old cells without a write barrier, which are always remembered.
+    Vector<Cell*> m_unbarriered_old_cells;
+
     BlockAllocator m_block_allocator;
 
     size_t m_gc_deferrals { 0 };
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/IntrusiveList.h>
 #include <AK/Platform.h>
 #include <AK/StringView.h>
@@ -68,6 +69,14 @@ public:
 
     Heap& heap() { return m_heap; }
 
+    // Whether this block has cells that were found dead by the last collection, but haven't been deallocated yet.
+    bool needs_sweep() const { return m_needs_sweep; }
+    void set_needs_sweep(bool b) { m_needs_sweep = b; }
+
+    // Whether cells have been allocated in this block since the last collection.
+    bool has_young_cells() const { return m_has_young_cells; }
+    void set_has_young_cells(bool b) { m_has_young_cells = b; }
+
     static HeapBlock* from_cell(Cell const* cell)
     {
         return reinterpret_cast<HeapBlock*>((FlatPtr)cell & ~(block_size - 1));
@@ -89,6 +98,23 @@ public:
         return cell_from_possible_pointer((FlatPtr)cell);
     }
 
+    ALWAYS_INLINE bool is_marked(Cell const* cell) const
+    {
+        auto index = cell_index(cell);
+        return m_mark_bits[index / 64] & (1ull << (index % 64));
+    }
+
+    ALWAYS_INLINE void set_marked(Cell const* cell, bool marked)
+    {
+        auto index = cell_index(cell);
+        if (marked)
+            m_mark_bits[index / 64] |= 1ull << (index % 64);
+        else
+            m_mark_bits[index / 64] &= ~(1ull << (index % 64));
+    }
+
+    void clear_marks() { m_mark_bits.fill(0); }
+
     IntrusiveListNode<HeapBlock> m_list_node;
 
 private:
@@ -107,9 +133,20 @@ private:
         return reinterpret_cast<Cell*>(&m_storage[index * cell_size()]);
     }
 
+    size_t cell_index(Cell const* cell) const
+    {
+        return (reinterpret_cast<FlatPtr>(cell) - reinterpret_cast<FlatPtr>(m_storage)) / m_cell_size;
+    }
+
+    // One bit per cell, enough for the smallest cell size any CellAllocator uses.
+    static constexpr size_t max_cell_count = block_size / 16;
+
     Heap& m_heap;
     size_t m_cell_size { 0 };
     size_t m_next_lazy_freelist_index { 0 };
+    bool m_has_young_cells { false };
+    bool m_needs_sweep { false };
+    AK::Array<u64, max_cell_count / 64> m_mark_bits {};
     FreelistEntry* m_freelist { nullptr };
     alignas(Cell) u8 m_storage[];
 
@@ -117,4 +154,22 @@ public:
     static constexpr size_t min_possible_cell_size = sizeof(FreelistEntry);
 };
 
+inline bool Cell::is_marked() const
+{
+    return HeapBlock::from_cell(this)->is_marked(this);
+}
+
+inline void Cell::set_marked(bool marked)
+{
+    HeapBlock::from_cell(this)->set_marked(this, marked);
+}
+
+inline bool Cell::is_dead() const
+{
+    if (m_state != State::Live)
+        return true;
+    auto* block = HeapBlock::from_cell(this);
+    return block->needs_sweep() && !block->is_marked(this);
+}
+
 }
@@ -17,7 +17,7 @@ namespace JS {
 
 class MarkedVectorBase {
 public:
-    virtual void gather_roots(HashTable<Cell*>&) const = 0;
+    virtual void gather_roots(Cell::Visitor&) const = 0;
 
 protected:
     explicit MarkedVectorBase(Heap&);
@@ -64,16 +64,10 @@ public:
         return *this;
     }
 
-    virtual void gather_roots(HashTable<Cell*>& roots) const override
+    virtual void gather_roots(Cell::Visitor& visitor) const override
     {
-        for (auto& value : *this) {
-            if constexpr (IsSame<Value, T>) {
-                if (value.is_cell())
-                    roots.set(&const_cast<T&>(value).as_cell());
-            } else {
-                roots.set(value);
-            }
-        }
+        for (auto& value : *this)
+            visitor.visit(value);
     };
 };
 
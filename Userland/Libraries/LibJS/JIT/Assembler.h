@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+
+namespace JS::JIT {
+
+// A tiny x86-64 assembler, covering just the instructions the baseline compiler emits.
+class Assembler {
+public:
+    explicit Assembler(Vector<u8>& output)
+        : m_output(output)
+    {
+    }
+
+    enum class Reg {
+        RAX = 0,
+        RCX = 1,
+        RDX = 2,
+        RBX = 3,
+        RSP = 4,
+        RBP = 5,
+        RSI = 6,
+        RDI = 7,
+        R8 = 8,
+        R9 = 9,
+        R10 = 10,
+        R11 = 11,
+        R12 = 12,
+        R13 = 13,
+        R14 = 14,
+        R15 = 15,
+    };
+
+    enum class Condition {
+        Overflow = 0x0,
+        EqualTo = 0x4,
+        NotEqualTo = 0x5,
+        SignedLessThan = 0xC,
+        SignedGreaterThanOrEqualTo = 0xD,
+        SignedLessThanOrEqualTo = 0xE,
+        SignedGreaterThan = 0xF,
+    };
+
+    struct Label {
+        Optional<size_t> offset;
+        Vector<size_t> jump_slot_offsets;
+    };
+
+    size_t size() const { return m_output.size(); }
+
+    void link(Label& label)
+    {
+        VERIFY(!label.offset.has_value());
+        label.offset = m_output.size();
+        for (auto jump_slot_offset : label.jump_slot_offsets)
+            patch_rel32(jump_slot_offset, *label.offset);
+        label.jump_slot_offsets.clear();
+    }
+
+    // mov dst, imm64
+    void mov64(Reg dst, u64 immediate)
+    {
+        emit_rex(true, Reg::RAX, dst);
+        emit8(0xb8 | encode(dst));
+        emit64(immediate);
+    }
+
+    // mov dst, src
+    void mov64(Reg dst, Reg src)
+    {
+        emit_rex(true, src, dst);
+        emit8(0x89);
+        emit_modrm_direct(src, dst);
+    }
+
+    // mov dst, [base + displacement]
+    void load64(Reg dst, Reg base, i32 displacement)
+    {
+        emit_rex(true, dst, base);
+        emit8(0x8b);
+        emit_modrm_indirect(dst, base, displacement);
+    }
+
+    // mov [base + displacement], src
+    void store64(Reg base, i32 displacement, Reg src)
+    {
+        emit_rex(true, src, base);
+        emit8(0x89);
+        emit_modrm_indirect(src, base, displacement);
+    }
+
+    void add32(Reg dst, Reg src) { emit_alu(false, 0x01, dst, src); }
+    void sub32(Reg dst, Reg src) { emit_alu(false, 0x29, dst, src); }
+    void cmp32(Reg lhs, Reg rhs) { emit_alu(false, 0x39, lhs, rhs); }
+    void test32(Reg lhs, Reg rhs) { emit_alu(false, 0x85, lhs, rhs); }
+    void or64(Reg dst, Reg src) { emit_alu(true, 0x09, dst, src); }
+
+    void add32(Reg dst, i32 immediate) { emit_alu_immediate(0, dst, immediate); }
+    void and32(Reg dst, i32 immediate) { emit_alu_immediate(4, dst, immediate); }
+    void cmp32(Reg lhs, i32 immediate) { emit_alu_immediate(7, lhs, immediate); }
+
+    // shr dst, imm8
+    void shr64(Reg dst, u8 count)
+    {
+        emit_rex(true, Reg::RAX, dst);
+        emit8(0xc1);
+        emit_modrm_direct(5, dst);
+        emit8(count);
+    }
+
+    // setcc dst8; movzx dst32, dst8
+    void set32_if(Condition condition, Reg dst)
+    {
+        // NOTE: Without a REX prefix, the byte registers 4-7 would be AH, CH, DH and BH.
+        emit_rex(false, Reg::RAX, dst, encode_extended(dst) || to_underlying(dst) >= 4);
+        emit8(0x0f);
+        emit8(0x90 | to_underlying(condition));
+        emit_modrm_direct(0, dst);
+
+        emit_rex(false, dst, dst, encode_extended(dst) || to_underlying(dst) >= 4);
+        emit8(0x0f);
+        emit8(0xb6);
+        emit_modrm_direct(dst, dst);
+    }
+
+    void jump(Label& label)
+    {
+        emit8(0xe9);
+        emit_rel32_to(label);
+    }
+
+    void jump_if(Condition condition, Label& label)
+    {
+        emit8(0x0f);
+        emit8(0x80 | to_underlying(condition));
+        emit_rel32_to(label);
+    }
+
+    void jump(Reg target)
+    {
+        emit_rex(false, Reg::RAX, target);
+        emit8(0xff);
+        emit_modrm_direct(4, target);
+    }
+
+    void call(Reg target)
+    {
+        emit_rex(false, Reg::RAX, target);
+        emit8(0xff);
+        emit_modrm_direct(2, target);
+    }
+
+    void push(Reg reg)
+    {
+        emit_rex(false, Reg::RAX, reg);
+        emit8(0x50 | encode(reg));
+    }
+
+    void pop(Reg reg)
+    {
+        emit_rex(false, Reg::RAX, reg);
+        emit8(0x58 | encode(reg));
+    }
+
+    void ret() { emit8(0xc3); }
+
+private:
+    static u8 encode(Reg reg) { return to_underlying(reg) & 7; }
+    static bool encode_extended(Reg reg) { return to_underlying(reg) >= 8; }
+
+    void emit8(u8 value) { m_output.append(value); }
+
+    void emit32(u32 value)
+    {
+        for (size_t i = 0; i < 4; ++i)
+            emit8((value >> (i * 8)) & 0xff);
+    }
+
+    void emit64(u64 value)
+    {
+        for (size_t i = 0; i < 8; ++i)
+            emit8((value >> (i * 8)) & 0xff);
+    }
+
+    // Emits a REX prefix if one is needed. `reg` goes in ModRM.reg, `rm` in ModRM.rm (or the opcode).
+    void emit_rex(bool wide, Reg reg, Reg rm, bool force = false)
+    {
+        u8 rex = 0x40;
+        if (wide)
+            rex |= 0x08;
+        if (encode_extended(reg))
+            rex |= 0x04;
+        if (encode_extended(rm))
+            rex |= 0x01;
+        if (rex != 0x40 || force)
+            emit8(rex);
+    }
+
+    void emit_modrm_direct(Reg reg, Reg rm) { emit_modrm_direct(encode(reg), rm); }
+    void emit_modrm_direct(u8 reg, Reg rm) { emit8(0xc0 | ((reg & 7) << 3) | encode(rm)); }
+
+    void emit_modrm_indirect(Reg reg, Reg base, i32 displacement)
+    {
+        // NOTE: RSP and R12 as a base would need a SIB byte, which we never have a use for.
+        VERIFY(encode(base) != encode(Reg::RSP));
+        emit8(0x80 | (encode(reg) << 3) | encode(base));
+        emit32(static_cast<u32>(displacement));
+    }
+
+    void emit_alu(bool wide, u8 opcode, Reg dst, Reg src)
+    {
+        emit_rex(wide, src, dst);
+        emit8(opcode);
+        emit_modrm_direct(src, dst);
+    }
+
+    void emit_alu_immediate(u8 extension, Reg dst, i32 immediate)
+    {
+        emit_rex(false, Reg::RAX, dst);
+        emit8(0x81);
+        emit_modrm_direct(extension, dst);
+        emit32(static_cast<u32>(immediate));
+    }
+
+    void emit_rel32_to(Label& label)
+    {
+        auto jump_slot_offset = m_output.size();
+        emit32(0);
+        if (label.offset.has_value())
+            patch_rel32(jump_slot_offset, *label.offset);
+        else
+            label.jump_slot_offsets.append(jump_slot_offset);
+    }
+
+    void patch_rel32(size_t jump_slot_offset, size_t target_offset)
+    {
+        auto relative = static_cast<i32>(static_cast<i64>(target_offset) - static_cast<i64>(jump_slot_offset + 4));
+        for (size_t i = 0; i < 4; ++i)
+            m_output[jump_slot_offset + i] = (static_cast<u32>(relative) >> (i * 8)) & 0xff;
+    }
+
+    Vector<u8>& m_output;
+};
+
+}
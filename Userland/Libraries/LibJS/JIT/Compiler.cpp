@@ -0,0 +1,359 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <AK/Platform.h>
+#include <AK/ScopeGuard.h>
+#include <LibCore/System.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/JIT/Compiler.h>
+#include <sys/mman.h>
+
+namespace JS::JIT {
+
+#if ARCH(X86_64)
+
+// NOTE: The generated code keeps these in callee-saved registers for its whole lifetime.
+static constexpr auto REGISTER_ARRAY_BASE = Assembler::Reg::RBX;
+static constexpr auto INTERPRETER = Assembler::Reg::R12;
+
+static constexpr auto RET = Assembler::Reg::RAX;
+static constexpr auto ARG0 = Assembler::Reg::RDI;
+static constexpr auto ARG1 = Assembler::Reg::RSI;
+static constexpr auto ARG2 = Assembler::Reg::RDX;
+
+static constexpr auto GPR0 = Assembler::Reg::RAX;
+static constexpr auto GPR1 = Assembler::Reg::RCX;
+static constexpr auto GPR2 = Assembler::Reg::RDX;
+
+static_assert(sizeof(Value) == sizeof(u64));
+
+// NOTE: Serenity doesn't allow anonymous memory to be executable, nor a mapping that has been writable to become executable.
+//       So the code is written through one mapping of an anonymous file, and run from another one.
+static ErrorOr<void*> map_executable_code(ReadonlyBytes code)
+{
+    auto fd = TRY(Core::System::anon_create(code.size(), O_CLOEXEC));
+    ScopeGuard close_fd = [fd] { (void)Core::System::close(fd); };
+
+    auto* writable_code = TRY(Core::System::mmap(nullptr, code.size(), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+    memcpy(writable_code, code.data(), code.size());
+    TRY(Core::System::munmap(writable_code, code.size()));
+
+    return Core::System::mmap(nullptr, code.size(), PROT_READ | PROT_EXEC, MAP_SHARED, fd, 0);
+}
+
+static u32 cxx_execute_instruction(Bytecode::Interpreter& interpreter, Bytecode::Instruction const& instruction)
+{
+    auto result = instruction.execute(interpreter);
+    if (result.is_error()) {
+        auto const* handler = interpreter.unwind_for_exception(*result.throw_completion().value());
+        if (!handler)
+            return to_underlying(NativeExecutable::ExitReason::Exception);
+        interpreter.jump(Bytecode::Label { *handler });
+        return to_underlying(NativeExecutable::ExitReason::Jump);
+    }
+    if (interpreter.has_pending_jump())
+        return to_underlying(NativeExecutable::ExitReason::Jump);
+    if (interpreter.has_return_value())
+        return to_underlying(NativeExecutable::ExitReason::Return);
+    return to_underlying(NativeExecutable::ExitReason::Continue);
+}
+
+static u32 cxx_to_boolean(Value const& value)
+{
+    return value.to_boolean();
+}
+
+Assembler::Label& Compiler::label_for(Bytecode::BasicBlock const& block)
+{
+    return *m_block_labels.ensure(&block, [] { return make<Assembler::Label>(); });
+}
+
+void Compiler::load_register(Assembler::Reg dst, Bytecode::Register src)
+{
+    m_assembler.load64(dst, REGISTER_ARRAY_BASE, src.index() * sizeof(Value));
+}
+
+void Compiler::store_register(Bytecode::Register dst, Assembler::Reg src)
+{
+    m_assembler.store64(REGISTER_ARRAY_BASE, dst.index() * sizeof(Value), src);
+}
+
+void Compiler::branch_if_not_int32(Assembler::Reg value, Assembler::Label& label)
+{
+    m_assembler.mov64(GPR2, value);
+    m_assembler.shr64(GPR2, TAG_SHIFT);
+    m_assembler.cmp32(GPR2, INT32_TAG);
+    m_assembler.jump_if(Assembler::Condition::NotEqualTo, label);
+}
+
+void Compiler::compile_exit(NativeExecutable::ExitReason reason)
+{
+    m_assembler.mov64(RET, to_underlying(reason));
+    m_assembler.jump(m_exit);
+}
+
+void Compiler::compile_fallback(Bytecode::Instruction const& instruction)
+{
+    m_assembler.mov64(ARG0, INTERPRETER);
+    m_assembler.mov64(ARG1, bit_cast<FlatPtr>(&instruction));
+    m_assembler.mov64(GPR0, bit_cast<FlatPtr>(&cxx_execute_instruction));
+    m_assembler.call(GPR0);
+
+    // Anything but ExitReason::Continue has to be handled by the interpreter.
+    m_assembler.test32(RET, RET);
+    m_assembler.jump_if(Assembler::Condition::NotEqualTo, m_exit);
+}
+
+void Compiler::compile_load_immediate(Bytecode::Op::LoadImmediate const& instruction)
+{
+    m_assembler.mov64(GPR0, instruction.value().encoded());
+    store_register(Bytecode::Register::accumulator(), GPR0);
+}
+
+void Compiler::compile_load(Bytecode::Op::Load const& instruction)
+{
+    load_register(GPR0, instruction.src());
+    store_register(Bytecode::Register::accumulator(), GPR0);
+}
+
+void Compiler::compile_store(Bytecode::Op::Store const& instruction)
+{
+    load_register(GPR0, Bytecode::Register::accumulator());
+    store_register(instruction.dst(), GPR0);
+}
+
+void Compiler::compile_int32_arithmetic(Bytecode::Instruction const& instruction, Bytecode::Register lhs)
+{
+    Assembler::Label slow_case;
+    Assembler::Label done;
+
+    load_register(GPR0, lhs);
+    load_register(GPR1, Bytecode::Register::accumulator());
+    branch_if_not_int32(GPR0, slow_case);
+    branch_if_not_int32(GPR1, slow_case);
+
+    // NOTE: The 32-bit operations clear the upper half of the register, which leaves room for the tag.
+    if (instruction.type() == Bytecode::Instruction::Type::Add)
+        m_assembler.add32(GPR0, GPR1);
+    else
+        m_assembler.sub32(GPR0, GPR1);
+    m_assembler.jump_if(Assembler::Condition::Overflow, slow_case);
+
+    m_assembler.mov64(GPR1, SHIFTED_INT32_TAG);
+    m_assembler.or64(GPR0, GPR1);
+    store_register(Bytecode::Register::accumulator(), GPR0);
+    m_assembler.jump(done);
+
+    m_assembler.link(slow_case);
+    compile_fallback(instruction);
+    m_assembler.link(done);
+}
+
+void Compiler::compile_int32_comparison(Bytecode::Instruction const& instruction, Bytecode::Register lhs, Assembler::Condition condition)
+{
+    Assembler::Label slow_case;
+    Assembler::Label done;
+
+    load_register(GPR0, lhs);
+    load_register(GPR1, Bytecode::Register::accumulator());
+    branch_if_not_int32(GPR0, slow_case);
+    branch_if_not_int32(GPR1, slow_case);
+
+    m_assembler.cmp32(GPR0, GPR1);
+    m_assembler.set32_if(condition, GPR0);
+    m_assembler.mov64(GPR1, BOOLEAN_TAG << TAG_SHIFT);
+    m_assembler.or64(GPR0, GPR1);
+    store_register(Bytecode::Register::accumulator(), GPR0);
+    m_assembler.jump(done);
+
+    m_assembler.link(slow_case);
+    compile_fallback(instruction);
+    m_assembler.link(done);
+}
+
+void Compiler::compile_increment(Bytecode::Op::Increment const& instruction)
+{
+    Assembler::Label slow_case;
+    Assembler::Label done;
+
+    load_register(GPR0, Bytecode::Register::accumulator());
+    branch_if_not_int32(GPR0, slow_case);
+
+    m_assembler.add32(GPR0, 1);
+    m_assembler.jump_if(Assembler::Condition::Overflow, slow_case);
+
+    m_assembler.mov64(GPR1, SHIFTED_INT32_TAG);
+    m_assembler.or64(GPR0, GPR1);
+    store_register(Bytecode::Register::accumulator(), GPR0);
+    m_assembler.jump(done);
+
+    m_assembler.link(slow_case);
+    compile_fallback(instruction);
+    m_assembler.link(done);
+}
+
+void Compiler::compile_jump(Bytecode::Op::Jump const& instruction)
+{
+    m_assembler.jump(label_for(instruction.true_target()->block()));
+}
+
+void Compiler::compile_jump_conditional(Bytecode::Op::JumpConditional const& instruction)
+{
+    Assembler::Label slow_case;
+    Assembler::Label test_payload;
+
+    load_register(GPR0, Bytecode::Register::accumulator());
+
+    // Booleans and int32s are both truthy exactly when their lower 32 bits aren't zero.
+    m_assembler.mov64(GPR1, GPR0);
+    m_assembler.shr64(GPR1, TAG_SHIFT);
+    m_assembler.cmp32(GPR1, BOOLEAN_TAG);
+    m_assembler.jump_if(Assembler::Condition::EqualTo, test_payload);
+    m_assembler.cmp32(GPR1, INT32_TAG);
+    m_assembler.jump_if(Assembler::Condition::NotEqualTo, slow_case);
+
+    m_assembler.link(test_payload);
+    m_assembler.test32(GPR0, GPR0);
+    m_assembler.jump_if(Assembler::Condition::NotEqualTo, label_for(instruction.true_target()->block()));
+    m_assembler.jump(label_for(instruction.false_target()->block()));
+
+    m_assembler.link(slow_case);
+    m_assembler.mov64(ARG0, REGISTER_ARRAY_BASE);
+    m_assembler.mov64(GPR0, bit_cast<FlatPtr>(&cxx_to_boolean));
+    m_assembler.call(GPR0);
+    m_assembler.test32(RET, RET);
+    m_assembler.jump_if(Assembler::Condition::NotEqualTo, label_for(instruction.true_target()->block()));
+    m_assembler.jump(label_for(instruction.false_target()->block()));
+}
+
+void Compiler::compile_jump_nullish(Bytecode::Op::JumpNullish const& instruction)
+{
+    load_register(GPR0, Bytecode::Register::accumulator());
+    m_assembler.shr64(GPR0, TAG_SHIFT);
+    m_assembler.and32(GPR0, IS_NULLISH_EXTRACT_PATTERN);
+    m_assembler.cmp32(GPR0, IS_NULLISH_PATTERN);
+    m_assembler.jump_if(Assembler::Condition::EqualTo, label_for(instruction.true_target()->block()));
+    m_assembler.jump(label_for(instruction.false_target()->block()));
+}
+
+void Compiler::compile_jump_undefined(Bytecode::Op::JumpUndefined const& instruction)
+{
+    load_register(GPR0, Bytecode::Register::accumulator());
+    m_assembler.shr64(GPR0, TAG_SHIFT);
+    m_assembler.cmp32(GPR0, UNDEFINED_TAG);
+    m_assembler.jump_if(Assembler::Condition::EqualTo, label_for(instruction.true_target()->block()));
+    m_assembler.jump(label_for(instruction.false_target()->block()));
+}
+
+OwnPtr<NativeExecutable> Compiler::compile(Bytecode::Executable const& bytecode_executable)
+{
+    Vector<u8> output;
+    Compiler compiler(output);
+    auto& assembler = compiler.m_assembler;
+
+    // The generated code is called as `u32 code(Value* registers, Bytecode::Interpreter*, u8 const* block_entry)`.
+    // NOTE: Pushing three registers after the return address keeps the stack 16-byte aligned for the calls we make.
+    assembler.push(Assembler::Reg::RBP);
+    assembler.mov64(Assembler::Reg::RBP, Assembler::Reg::RSP);
+    assembler.push(REGISTER_ARRAY_BASE);
+    assembler.push(INTERPRETER);
+    assembler.mov64(REGISTER_ARRAY_BASE, ARG0);
+    assembler.mov64(INTERPRETER, ARG1);
+    assembler.jump(ARG2);
+
+    assembler.link(compiler.m_exit);
+    assembler.pop(INTERPRETER);
+    assembler.pop(REGISTER_ARRAY_BASE);
+    assembler.pop(Assembler::Reg::RBP);
+    assembler.ret();
+
+    HashMap<Bytecode::BasicBlock const*, size_t> block_entry_offsets;
+
+    for (auto& block : bytecode_executable.basic_blocks) {
+        block_entry_offsets.set(&block, assembler.size());
+        assembler.link(compiler.label_for(block));
+
+        for (Bytecode::InstructionStreamIterator it(block.instruction_stream()); !it.at_end(); ++it) {
+            auto& instruction = *it;
+            switch (instruction.type()) {
+            case Bytecode::Instruction::Type::LoadImmediate:
+                compiler.compile_load_immediate(static_cast<Bytecode::Op::LoadImmediate const&>(instruction));
+                break;
+            case Bytecode::Instruction::Type::Load:
+                compiler.compile_load(static_cast<Bytecode::Op::Load const&>(instruction));
+                break;
+            case Bytecode::Instruction::Type::Store:
+                compiler.compile_store(static_cast<Bytecode::Op::Store const&>(instruction));
+                break;
+            case Bytecode::Instruction::Type::Add:
+                compiler.compile_int32_arithmetic(instruction, static_cast<Bytecode::Op::Add const&>(instruction).lhs());
+                break;
+            case Bytecode::Instruction::Type::Sub:
+                compiler.compile_int32_arithmetic(instruction, static_cast<Bytecode::Op::Sub const&>(instruction).lhs());
+                break;
+            case Bytecode::Instruction::Type::LessThan:
+                compiler.compile_int32_comparison(instruction, static_cast<Bytecode::Op::LessThan const&>(instruction).lhs(), Assembler::Condition::SignedLessThan);
+                break;
+            case Bytecode::Instruction::Type::LessThanEquals:
+                compiler.compile_int32_comparison(instruction, static_cast<Bytecode::Op::LessThanEquals const&>(instruction).lhs(), Assembler::Condition::SignedLessThanOrEqualTo);
+                break;
+            case Bytecode::Instruction::Type::GreaterThan:
+                compiler.compile_int32_comparison(instruction, static_cast<Bytecode::Op::GreaterThan const&>(instruction).lhs(), Assembler::Condition::SignedGreaterThan);
+                break;
+            case Bytecode::Instruction::Type::GreaterThanEquals:
+                compiler.compile_int32_comparison(instruction, static_cast<Bytecode::Op::GreaterThanEquals const&>(instruction).lhs(), Assembler::Condition::SignedGreaterThanOrEqualTo);
+                break;
+            case Bytecode::Instruction::Type::Increment:
+                compiler.compile_increment(static_cast<Bytecode::Op::Increment const&>(instruction));
+                break;
+            case Bytecode::Instruction::Type::Jump:
+                compiler.compile_jump(static_cast<Bytecode::Op::Jump const&>(instruction));
+                break;
+            case Bytecode::Instruction::Type::JumpConditional:
+                compiler.compile_jump_conditional(static_cast<Bytecode::Op::JumpConditional const&>(instruction));
+                break;
+            case Bytecode::Instruction::Type::JumpNullish:
+                compiler.compile_jump_nullish(static_cast<Bytecode::Op::JumpNullish const&>(instruction));
+                break;
+            case Bytecode::Instruction::Type::JumpUndefined:
+                compiler.compile_jump_undefined(static_cast<Bytecode::Op::JumpUndefined const&>(instruction));
+                break;
+            default:
+                compiler.compile_fallback(instruction);
+                break;
+            }
+        }
+
+        // If we get here, the block had no terminator, which means the executable is done.
+        compiler.compile_exit(NativeExecutable::ExitReason::EndOfBlock);
+    }
+
+    for (auto& it : compiler.m_block_labels)
+        VERIFY(it.value->jump_slot_offsets.is_empty());
+
+    auto code_or_error = map_executable_code(output);
+    if (code_or_error.is_error()) {
+        dbgln("JIT::Compiler: Failed to map machine code: {}", code_or_error.error());
+        return nullptr;
+    }
+    auto* code = code_or_error.release_value();
+
+    dbgln_if(JIT_DEBUG, "JIT::Compiler: Compiled {} bytes of bytecode into {} bytes of machine code", bytecode_executable.bytecode_size(), output.size());
+    return make<NativeExecutable>(code, output.size(), move(block_entry_offsets));
+}
+
+#else
+
+OwnPtr<NativeExecutable> Compiler::compile(Bytecode::Executable const&)
+{
+    return nullptr;
+}
+
+#endif
+
+}
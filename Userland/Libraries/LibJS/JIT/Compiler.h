@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/OwnPtr.h>
+#include <LibJS/Bytecode/Executable.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/JIT/Assembler.h>
+#include <LibJS/JIT/NativeExecutable.h>
+
+namespace JS::JIT {
+
+// A baseline compiler, which turns each instruction into machine code on its own.
+// Loads, stores, jumps and int32 arithmetic get inline fast paths, everything else is handed back to the interpreter.
+class Compiler {
+public:
+    // Returns null if the JIT isn't supported on this platform.
+    static OwnPtr<NativeExecutable> compile(Bytecode::Executable const&);
+
+private:
+    explicit Compiler(Vector<u8>& output)
+        : m_assembler(output)
+    {
+    }
+
+    void compile_load_immediate(Bytecode::Op::LoadImmediate const&);
+    void compile_load(Bytecode::Op::Load const&);
+    void compile_store(Bytecode::Op::Store const&);
+    void compile_int32_arithmetic(Bytecode::Instruction const&, Bytecode::Register lhs);
+    void compile_int32_comparison(Bytecode::Instruction const&, Bytecode::Register lhs, Assembler::Condition);
+    void compile_increment(Bytecode::Op::Increment const&);
+    void compile_jump(Bytecode::Op::Jump const&);
+    void compile_jump_conditional(Bytecode::Op::JumpConditional const&);
+    void compile_jump_nullish(Bytecode::Op::JumpNullish const&);
+    void compile_jump_undefined(Bytecode::Op::JumpUndefined const&);
+
+    void compile_fallback(Bytecode::Instruction const&);
+    void compile_exit(NativeExecutable::ExitReason);
+
+    void load_register(Assembler::Reg, Bytecode::Register);
+    void store_register(Bytecode::Register, Assembler::Reg);
+    void branch_if_not_int32(Assembler::Reg value, Assembler::Label&);
+
+    Assembler::Label& label_for(Bytecode::BasicBlock const&);
+
+    Assembler m_assembler;
+    Assembler::Label m_exit;
+    HashMap<Bytecode::BasicBlock const*, NonnullOwnPtr<Assembler::Label>> m_block_labels;
+};
+
+}
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/JIT/NativeExecutable.h>
+#include <sys/mman.h>
+
+namespace JS::JIT {
+
+NativeExecutable::NativeExecutable(void* code, size_t size, HashMap<Bytecode::BasicBlock const*, size_t> block_entry_offsets)
+    : m_code(code)
+    , m_size(size)
+    , m_block_entry_offsets(move(block_entry_offsets))
+{
+}
+
+NativeExecutable::~NativeExecutable()
+{
+    munmap(m_code, m_size);
+}
+
+NativeExecutable::ExitReason NativeExecutable::run(Bytecode::Interpreter& interpreter, Value* registers, Bytecode::BasicBlock const& entry_point) const
+{
+    using EntryPoint = u32 (*)(Value* registers, Bytecode::Interpreter*, u8 const* block_entry);
+    auto block_entry_offset = m_block_entry_offsets.get(&entry_point).value();
+    auto entry = reinterpret_cast<EntryPoint>(m_code);
+    return static_cast<ExitReason>(entry(registers, &interpreter, static_cast<u8 const*>(m_code) + block_entry_offset));
+}
+
+}
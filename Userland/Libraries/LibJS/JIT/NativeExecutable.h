@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/Noncopyable.h>
+#include <AK/Types.h>
+#include <LibJS/Forward.h>
+
+namespace JS::JIT {
+
+// Machine code for a whole Bytecode::Executable, which can be entered at the start of any of its basic blocks.
+class NativeExecutable {
+    AK_MAKE_NONCOPYABLE(NativeExecutable);
+    AK_MAKE_NONMOVABLE(NativeExecutable);
+
+public:
+    enum class ExitReason : u32 {
+        // Only seen by the generated code, when an instruction it handed back to the interpreter finished normally.
+        Continue = 0,
+        // The end of a block without a terminator was reached, so the executable is done.
+        EndOfBlock,
+        // An instruction requested a jump through the interpreter, which the caller has to take before entering again.
+        Jump,
+        Return,
+        Exception,
+    };
+
+    NativeExecutable(void* code, size_t size, HashMap<Bytecode::BasicBlock const*, size_t> block_entry_offsets);
+    ~NativeExecutable();
+
+    ExitReason run(Bytecode::Interpreter&, Value* registers, Bytecode::BasicBlock const& entry_point) const;
+
+    size_t size() const { return m_size; }
+
+private:
+    void* m_code { nullptr };
+    size_t m_size { 0 };
+    HashMap<Bytecode::BasicBlock const*, size_t> m_block_entry_offsets;
+};
+
+}
@@ -65,6 +65,28 @@ Array::Array(Object& prototype)
 {
 }
 
+SimpleIndexedPropertyStorage const* Array::packed_elements(size_t length) const
+{
+    auto const* storage = indexed_properties().packed_storage();
+    if (!storage || storage->array_like_size() < length)
+        return nullptr;
+    return storage;
+}
+
+bool Array::can_append_elements_directly() const
+{
+    if (!m_length_writable || !m_is_extensible || !indexed_properties().packed_storage())
+        return false;
+
+    auto& intrinsics = shape().realm().intrinsics();
+    auto const* array_prototype = intrinsics.array_prototype();
+    auto const* object_prototype = intrinsics.object_prototype();
+    return shape().prototype() == array_prototype
+        && array_prototype->indexed_properties().is_empty()
+        && array_prototype->shape().prototype() == object_prototype
+        && object_prototype->indexed_properties().is_empty();
+}
+
 // 10.4.2.4 ArraySetLength ( A, Desc ), https://tc39.es/ecma262/#sec-arraysetlength
 ThrowCompletionOr<bool> Array::set_length(PropertyDescriptor const& property_descriptor)
 {
@@ -75,7 +97,7 @@ ThrowCompletionOr<bool> Array::set_length(PropertyDescriptor const& property_des
     // 2. Let newLenDesc be a copy of Desc.
     // NOTE: Handled by step 16
 
-    size_t new_length = indexed_properties().array_like_size();
+    size_t new_length = static_cast<Array const&>(*this).indexed_properties().array_like_size();
     if (property_descriptor.value.has_value()) {
         // 3. Let newLen be ? ToUint32(Desc.[[Value]]).
         new_length = TRY(property_descriptor.value->to_u32(vm));
@@ -127,7 +149,7 @@ ThrowCompletionOr<bool> Array::set_length(PropertyDescriptor const& property_des
         if (property_descriptor.writable.has_value() && *property_descriptor.writable)
             return false;
         // ii. If Desc has a [[Value]] field and SameValue(Desc.[[Value]], current.[[Value]]) is false, return false.
-        if (new_length != indexed_properties().array_like_size())
+        if (new_length != static_cast<Array const&>(*this).indexed_properties().array_like_size())
             return false;
     }
 
@@ -135,7 +157,7 @@ ThrowCompletionOr<bool> Array::set_length(PropertyDescriptor const& property_des
     // a. Let deleteSucceeded be ! A.[[Delete]](P).
     // b. If deleteSucceeded is false, then
     // i. Set newLenDesc.[[Value]] to ! ToUint32(P) + 1𝔽.
-    bool success = indexed_properties().set_array_like_size(new_length);
+    bool success = set_indexed_property_array_like_size(new_length);
 
     // ii. If newWritable is false, set newLenDesc.[[Writable]] to false.
     // iii. Perform ! OrdinaryDefineOwnProperty(A, "length", newLenDesc).
@@ -215,9 +237,17 @@ ThrowCompletionOr<MarkedVector<Value>> sort_indexed_properties(VM& vm, Object co
     // 1. Let items be a new empty List.
     auto items = MarkedVector<Value> { vm.heap() };
 
+    // OPTIMIZATION: Packed elements are all present and have no getters, so we can copy them without HasProperty() and Get().
+    auto const* packed_elements = is<Array>(object) ? static_cast<Array const&>(object).packed_elements(length) : nullptr;
+    if (packed_elements) {
+        items.ensure_capacity(length);
+        for (size_t k = 0; k < length; ++k)
+            items.unchecked_append(packed_elements->element(k));
+    }
+
     // 2. Let k be 0.
     // 3. Repeat, while k < len,
-    for (size_t k = 0; k < length; ++k) {
+    for (size_t k = packed_elements ? length : 0; k < length; ++k) {
         // a. Let Pk be ! ToString(𝔽(k)).
         auto property_key = PropertyKey { k };
 
@@ -292,7 +322,7 @@ ThrowCompletionOr<bool> Array::internal_define_own_property(PropertyKey const& p
         // f. Let index be ! ToUint32(P).
 
         // g. If index ≥ oldLen and oldLenDesc.[[Writable]] is false, return false.
-        if (property_key.as_number() >= indexed_properties().array_like_size() && !m_length_writable)
+        if (property_key.as_number() >= static_cast<Array const&>(*this).indexed_properties().array_like_size() && !m_length_writable)
             return false;
 
         // h. Let succeeded be ! OrdinaryDefineOwnProperty(A, P, Desc).
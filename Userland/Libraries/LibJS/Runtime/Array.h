@@ -19,6 +19,7 @@ namespace JS {
 
 class Array : public Object {
     JS_OBJECT(Array, Object);
+    JS_CELL_HAS_WRITE_BARRIER(Array);
 
 public:
     static ThrowCompletionOr<Array*> create(Realm&, u64 length, Object* prototype = nullptr);
@@ -44,6 +45,14 @@ public:
 
     [[nodiscard]] bool length_is_writable() const { return m_length_writable; };
 
+    // Returns the element storage if the first `length` elements are all present in packed storage. Those are then
+    // own data properties with default attributes, which can be read and overwritten without the internal methods.
+    SimpleIndexedPropertyStorage const* packed_elements(size_t length) const;
+
+    // Whether new elements can be appended without [[Set]], since neither this array nor its (intrinsic) prototypes
+    // could intercept an index past the end.
+    bool can_append_elements_directly() const;
+
 protected:
     explicit Array(Object& prototype);
 
@@ -910,6 +910,46 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::includes)
     return Value(false);
 }
 
+// Performs the search loop of Array.prototype.indexOf on packed elements, which only needs to look at the
+// elements of the matching kind.
+static Value packed_index_of(SimpleIndexedPropertyStorage const& elements, Value search_element, size_t from_index, size_t length)
+{
+    using ElementKind = SimpleIndexedPropertyStorage::ElementKind;
+
+    switch (elements.element_kind()) {
+    case ElementKind::PackedInt32:
+    case ElementKind::PackedDouble: {
+        // A number can only be strictly equal to another number.
+        if (!search_element.is_number())
+            return Value(-1);
+        auto search_number = search_element.as_double();
+        if (elements.element_kind() == ElementKind::PackedInt32) {
+            auto const& int32_elements = elements.int32_elements();
+            for (size_t k = from_index; k < length; ++k) {
+                if (int32_elements[k] == search_number)
+                    return Value(k);
+            }
+        } else {
+            // NOTE: Comparing doubles matches IsStrictlyEqual(): NaN is never equal to anything, and +0 equals -0.
+            auto const& double_elements = elements.double_elements();
+            for (size_t k = from_index; k < length; ++k) {
+                if (double_elements[k] == search_number)
+                    return Value(k);
+            }
+        }
+        return Value(-1);
+    }
+    default: {
+        auto const& value_elements = elements.value_elements();
+        for (size_t k = from_index; k < length; ++k) {
+            if (is_strictly_equal(search_element, value_elements[k]))
+                return Value(k);
+        }
+        return Value(-1);
+    }
+    }
+}
+
 // 23.1.3.17 Array.prototype.indexOf ( searchElement [ , fromIndex ] ), https://tc39.es/ecma262/#sec-array.prototype.indexof
 JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::index_of)
 {
@@ -955,6 +995,10 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::index_of)
         k = max(length + n, 0);
     }
 
+    // OPTIMIZATION: Packed elements are all present and have no getters, and comparing them can't run user code.
+    if (auto const* packed_elements = is<Array>(*object) ? static_cast<Array const&>(*object).packed_elements(length) : nullptr)
+        return packed_index_of(*packed_elements, search_element, k, length);
+
     // 10. Repeat, while k < len,
     for (; k < length; ++k) {
         auto property_key = PropertyKey { k };
@@ -1118,13 +1162,21 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::map)
         // a. Let Pk be ! ToString(𝔽(k)).
         auto property_key = PropertyKey { k };
 
+        // OPTIMIZATION: A packed element is present and has no getter, so it can be read directly.
+        //               The callback may change the array in any way, so this has to be checked for every element.
+        Optional<Value> packed_element;
+        if (is<Array>(*object)) {
+            if (auto const* packed_elements = static_cast<Array const&>(*object).packed_elements(k + 1))
+                packed_element = packed_elements->element(k);
+        }
+
         // b. Let kPresent be ? HasProperty(O, Pk).
-        auto k_present = TRY(object->has_property(property_key));
+        auto k_present = packed_element.has_value() || TRY(object->has_property(property_key));
 
         // c. If kPresent is true, then
         if (k_present) {
             // i. Let kValue be ? Get(O, Pk).
-            auto k_value = TRY(object->get(property_key));
+            auto k_value = packed_element.has_value() ? *packed_element : TRY(object->get(property_key));
 
             // ii. Let mappedValue be ? Call(callbackfn, thisArg, « kValue, 𝔽(k), O »).
             auto mapped_value = TRY(call(vm, callback_function.as_function(), this_arg, k_value, Value(k), object));
@@ -1165,6 +1217,14 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::push)
     auto new_length = length + argument_count;
     if (new_length > MAX_ARRAY_LIKE_INDEX)
         return vm.throw_completion<TypeError>(ErrorType::ArrayMaxSize);
+
+    // OPTIMIZATION: Nothing can observe the stores to a plain array, so we can append to its storage directly.
+    if (is<Array>(*this_object) && new_length <= NumericLimits<u32>::max() && static_cast<Array const&>(*this_object).can_append_elements_directly()) {
+        for (size_t i = 0; i < argument_count; ++i)
+            this_object->append_indexed_property(vm.argument(i));
+        return Value(new_length);
+    }
+
     for (size_t i = 0; i < argument_count; ++i)
         TRY(this_object->set(length + i, vm.argument(i), Object::ShouldThrowExceptions::Yes));
     auto new_length_value = Value(new_length);
@@ -1585,6 +1645,12 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::sort)
     // 8. Let j be 0.
     size_t j = 0;
 
+    // OPTIMIZATION: Setting a packed element just overwrites it, so we can skip [[Set]] while the array stays packed.
+    if (is<Array>(*object) && static_cast<Array const&>(*object).packed_elements(item_count)) {
+        for (; j < item_count; ++j)
+            object->put_indexed_property(j, sorted_list[j]);
+    }
+
     // 9. Repeat, while j < itemCount,
     for (; j < item_count; ++j) {
         // a. Perform ? Set(obj, ! ToString(𝔽(j)), sortedList[j], true).
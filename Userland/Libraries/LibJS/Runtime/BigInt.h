@@ -14,6 +14,7 @@ namespace JS {
 
 class BigInt final : public Cell {
     JS_CELL(BigInt, Cell);
+    JS_CELL_HAS_WRITE_BARRIER(BigInt);
 
 public:
     virtual ~BigInt() override = default;
@@ -111,6 +111,7 @@ ThrowCompletionOr<void> DeclarativeEnvironment::initialize_binding_direct(VM&, B
 
     // 2. Set the bound value for N in envRec to V.
     binding.value = value;
+    write_barrier();
 
     // 3. Record that the binding for N in envRec has been initialized.
     binding.initialized = true;
@@ -161,6 +162,7 @@ ThrowCompletionOr<void> DeclarativeEnvironment::set_mutable_binding_direct(VM& v
 
     if (binding.mutable_) {
         binding.value = value;
+        write_barrier();
     } else {
         if (strict)
             return vm.throw_completion<TypeError>(ErrorType::InvalidAssignToConst);
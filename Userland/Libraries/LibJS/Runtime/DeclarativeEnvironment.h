@@ -17,6 +17,7 @@ namespace JS {
 
 class DeclarativeEnvironment : public Environment {
     JS_ENVIRONMENT(DeclarativeEnvironment, Environment);
+    JS_CELL_HAS_WRITE_BARRIER(DeclarativeEnvironment);
 
     struct Binding {
         FlyString name;
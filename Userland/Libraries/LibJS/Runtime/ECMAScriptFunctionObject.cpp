@@ -316,6 +316,7 @@ void ECMAScriptFunctionObject::make_method(Object& home_object)
 {
     // 1. Set F.[[HomeObject]] to homeObject.
     m_home_object = &home_object;
+    write_barrier();
 
     // 2. Return unused.
 }
@@ -443,7 +444,7 @@ ThrowCompletionOr<void> ECMAScriptFunctionObject::function_declaration_instantia
                 if (parameter.is_rest) {
                     auto* array = MUST(Array::create(realm, 0));
                     for (size_t rest_index = i; rest_index < execution_context_arguments.size(); ++rest_index)
-                        array->indexed_properties().append(execution_context_arguments[rest_index]);
+                        array->append_indexed_property(execution_context_arguments[rest_index]);
                     argument_value = array;
                 } else if (i < execution_context_arguments.size() && !execution_context_arguments[i].is_undefined()) {
                     argument_value = execution_context_arguments[i];
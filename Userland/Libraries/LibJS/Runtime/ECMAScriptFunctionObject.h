@@ -19,6 +19,7 @@ void async_block_start(VM&, NonnullRefPtr<Statement> const& parse_node, PromiseC
 // 10.2 ECMAScript Function Objects, https://tc39.es/ecma262/#sec-ecmascript-function-objects
 class ECMAScriptFunctionObject final : public FunctionObject {
     JS_OBJECT(ECMAScriptFunctionObject, FunctionObject);
+    JS_CELL_HAS_WRITE_BARRIER(ECMAScriptFunctionObject);
 
 public:
     enum class ConstructorKind : u8 {
@@ -62,13 +63,21 @@ public:
     ThisMode this_mode() const { return m_this_mode; }
 
     Object* home_object() const { return m_home_object; }
-    void set_home_object(Object* home_object) { m_home_object = home_object; }
+    void set_home_object(Object* home_object)
+    {
+        m_home_object = home_object;
+        write_barrier();
+    }
 
     String const& source_text() const { return m_source_text; }
     void set_source_text(String source_text) { m_source_text = move(source_text); }
 
     Vector<ClassFieldDefinition> const& fields() const { return m_fields; }
-    void add_field(ClassFieldDefinition field) { m_fields.append(move(field)); }
+    void add_field(ClassFieldDefinition field)
+    {
+        m_fields.append(move(field));
+        write_barrier();
+    }
 
     Vector<PrivateElement> const& private_methods() const { return m_private_methods; }
     void add_private_method(PrivateElement method) { m_private_methods.append(move(method)); };
@@ -83,7 +92,11 @@ public:
 
     // This is used by LibWeb to disassociate event handler attribute callback functions from the nearest script on the call stack.
     // https://html.spec.whatwg.org/multipage/webappapis.html#getting-the-current-value-of-the-event-handler Step 3.11
-    void set_script_or_module(ScriptOrModule script_or_module) { m_script_or_module = move(script_or_module); }
+    void set_script_or_module(ScriptOrModule script_or_module)
+    {
+        m_script_or_module = move(script_or_module);
+        write_barrier();
+    }
 
     Variant<PropertyKey, PrivateName, Empty> const& class_field_initializer_name() const { return m_class_field_initializer_name; }
 
@@ -21,6 +21,7 @@ struct Variable {
 
 class Environment : public Cell {
     JS_CELL(Environment, Cell);
+    JS_CELL_HAS_WRITE_BARRIER(Environment);
 
 public:
     virtual bool has_this_binding() const { return false; }
@@ -37,9 +37,13 @@ bool FinalizationRegistry::remove_by_token(Cell& unregister_token)
 
 void FinalizationRegistry::remove_dead_cells(Badge<Heap>)
 {
+    // NOTE: We may be unreachable ourselves and just waiting to be swept, in which case there's nobody left to clean up for.
+    if (is_dead())
+        return;
+
     auto any_cells_were_removed = false;
     for (auto& record : m_records) {
-        if (!record.target || record.target->state() == Cell::State::Live)
+        if (!record.target || !record.target->is_dead())
             continue;
         record.target = nullptr;
         any_cells_were_removed = true;
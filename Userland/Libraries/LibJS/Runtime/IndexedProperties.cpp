@@ -15,78 +15,195 @@ constexpr const size_t LENGTH_SETTER_GENERIC_STORAGE_THRESHOLD = 4 * MiB;
 
 SimpleIndexedPropertyStorage::SimpleIndexedPropertyStorage(Vector<Value>&& initial_values)
     : m_array_size(initial_values.size())
-    , m_packed_elements(move(initial_values))
 {
+    bool all_int32 = true;
+    bool all_numbers = true;
+    bool any_holes = false;
+    for (auto& value : initial_values) {
+        all_int32 = all_int32 && value.is_int32();
+        all_numbers = all_numbers && value.is_number();
+        any_holes = any_holes || value.is_empty();
+    }
+
+    if (all_int32) {
+        m_element_kind = ElementKind::PackedInt32;
+        m_int32_elements.ensure_capacity(m_array_size);
+        for (auto& value : initial_values)
+            m_int32_elements.unchecked_append(value.as_i32());
+    } else if (all_numbers) {
+        m_element_kind = ElementKind::PackedDouble;
+        m_double_elements.ensure_capacity(m_array_size);
+        for (auto& value : initial_values)
+            m_double_elements.unchecked_append(value.as_double());
+    } else {
+        m_element_kind = any_holes ? ElementKind::HoleyValue : ElementKind::PackedValue;
+        m_value_elements = move(initial_values);
+    }
 }
 
-bool SimpleIndexedPropertyStorage::has_index(u32 index) const
+bool SimpleIndexedPropertyStorage::fits_element_kind(ElementKind kind, Value value)
 {
-    return index < m_array_size && !m_packed_elements[index].is_empty();
+    switch (kind) {
+    case ElementKind::PackedInt32:
+        return value.is_int32();
+    case ElementKind::PackedDouble:
+        return value.is_number();
+    case ElementKind::PackedValue:
+        return !value.is_empty();
+    case ElementKind::HoleyValue:
+        return true;
+    }
+    VERIFY_NOT_REACHED();
 }
 
-Optional<ValueAndAttributes> SimpleIndexedPropertyStorage::get(u32 index) const
+void SimpleIndexedPropertyStorage::transition_to(ElementKind new_kind)
 {
-    if (!has_index(index))
-        return {};
-    return ValueAndAttributes { m_packed_elements[index], default_attributes };
+    VERIFY(new_kind > m_element_kind);
+
+    if (m_element_kind == ElementKind::PackedInt32 && new_kind == ElementKind::PackedDouble) {
+        m_double_elements.ensure_capacity(m_int32_elements.capacity());
+        for (auto element : m_int32_elements)
+            m_double_elements.unchecked_append(element);
+        m_int32_elements.clear();
+    } else if (m_element_kind == ElementKind::PackedInt32 || m_element_kind == ElementKind::PackedDouble) {
+        m_value_elements.ensure_capacity(max(m_int32_elements.capacity(), m_double_elements.capacity()));
+        for (size_t i = 0; i < m_array_size; ++i)
+            m_value_elements.unchecked_append(element(i));
+        m_int32_elements.clear();
+        m_double_elements.clear();
+    }
+
+    m_element_kind = new_kind;
 }
 
-void SimpleIndexedPropertyStorage::grow_storage_if_needed()
+template<typename T>
+void SimpleIndexedPropertyStorage::append_element(Vector<T>& elements, T element)
 {
-    if (m_array_size <= m_packed_elements.size())
-        return;
+    // When the array is actually full grow storage by 25% at a time.
+    if (elements.size() == elements.capacity())
+        elements.ensure_capacity(elements.size() + max<size_t>(elements.size() / 4, 1));
+    elements.unchecked_append(element);
+}
 
-    if (m_array_size <= m_packed_elements.capacity()) {
-        m_packed_elements.resize_and_keep_capacity(m_array_size);
-    } else {
-        // When the array is actually full grow storage by 25% at a time.
-        m_packed_elements.resize_and_keep_capacity(m_array_size + (m_array_size / 4));
+void SimpleIndexedPropertyStorage::resize_storage(size_t new_size)
+{
+    // Growing the storage other than by appending leaves holes, which only the holey kind can represent.
+    if (new_size > m_array_size && m_element_kind != ElementKind::HoleyValue)
+        transition_to(ElementKind::HoleyValue);
+
+    switch (m_element_kind) {
+    case ElementKind::PackedInt32:
+        m_int32_elements.resize_and_keep_capacity(new_size);
+        break;
+    case ElementKind::PackedDouble:
+        m_double_elements.resize_and_keep_capacity(new_size);
+        break;
+    default:
+        m_value_elements.resize_and_keep_capacity(new_size);
+        break;
     }
+    m_array_size = new_size;
+}
+
+bool SimpleIndexedPropertyStorage::has_index(u32 index) const
+{
+    if (index >= m_array_size)
+        return false;
+    return m_element_kind != ElementKind::HoleyValue || !m_value_elements[index].is_empty();
+}
+
+Optional<ValueAndAttributes> SimpleIndexedPropertyStorage::get(u32 index) const
+{
+    if (!has_index(index))
+        return {};
+    return ValueAndAttributes { element(index), default_attributes };
 }
 
 void SimpleIndexedPropertyStorage::put(u32 index, Value value, PropertyAttributes attributes)
 {
     VERIFY(attributes == default_attributes);
 
-    if (index >= m_array_size) {
-        m_array_size = index + 1;
-        grow_storage_if_needed();
+    if (index > m_array_size)
+        resize_storage(index);
+
+    if (!fits_element_kind(m_element_kind, value)) {
+        if (value.is_number())
+            transition_to(ElementKind::PackedDouble);
+        else
+            transition_to(value.is_empty() ? ElementKind::HoleyValue : ElementKind::PackedValue);
+    }
+
+    bool is_append = index == m_array_size;
+    if (is_append)
+        ++m_array_size;
+
+    switch (m_element_kind) {
+    case ElementKind::PackedInt32:
+        if (is_append)
+            append_element(m_int32_elements, value.as_i32());
+        else
+            m_int32_elements[index] = value.as_i32();
+        break;
+    case ElementKind::PackedDouble:
+        if (is_append)
+            append_element(m_double_elements, value.as_double());
+        else
+            m_double_elements[index] = value.as_double();
+        break;
+    default:
+        if (is_append)
+            append_element(m_value_elements, value);
+        else
+            m_value_elements[index] = value;
+        break;
     }
-    m_packed_elements[index] = value;
 }
 
 void SimpleIndexedPropertyStorage::remove(u32 index)
 {
     VERIFY(index < m_array_size);
-    m_packed_elements[index] = {};
+    if (m_element_kind != ElementKind::HoleyValue)
+        transition_to(ElementKind::HoleyValue);
+    m_value_elements[index] = {};
 }
 
 ValueAndAttributes SimpleIndexedPropertyStorage::take_first()
 {
     m_array_size--;
-    return { m_packed_elements.take_first(), default_attributes };
+    switch (m_element_kind) {
+    case ElementKind::PackedInt32:
+        return { Value(m_int32_elements.take_first()), default_attributes };
+    case ElementKind::PackedDouble:
+        return { Value(m_double_elements.take_first()), default_attributes };
+    default:
+        return { m_value_elements.take_first(), default_attributes };
+    }
 }
 
 ValueAndAttributes SimpleIndexedPropertyStorage::take_last()
 {
     m_array_size--;
-    auto last_element = m_packed_elements[m_array_size];
-    m_packed_elements[m_array_size] = {};
-    return { last_element, default_attributes };
+    switch (m_element_kind) {
+    case ElementKind::PackedInt32:
+        return { Value(m_int32_elements.take_last()), default_attributes };
+    case ElementKind::PackedDouble:
+        return { Value(m_double_elements.take_last()), default_attributes };
+    default:
+        return { m_value_elements.take_last(), default_attributes };
+    }
 }
 
 bool SimpleIndexedPropertyStorage::set_array_like_size(size_t new_size)
 {
-    m_array_size = new_size;
-    m_packed_elements.resize_and_keep_capacity(new_size);
+    resize_storage(new_size);
     return true;
 }
 
 GenericIndexedPropertyStorage::GenericIndexedPropertyStorage(SimpleIndexedPropertyStorage&& storage)
 {
     m_array_size = storage.array_like_size();
-    for (size_t i = 0; i < storage.m_packed_elements.size(); ++i) {
-        auto value = storage.m_packed_elements[i];
+    for (size_t i = 0; i < m_array_size; ++i) {
+        auto value = storage.element(i);
         if (!value.is_empty())
             m_sparse_elements.set(i, { value, default_attributes });
     }
@@ -265,9 +382,11 @@ size_t IndexedProperties::real_size() const
     if (!m_storage)
         return 0;
     if (m_storage->is_simple_storage()) {
-        auto& packed_elements = static_cast<SimpleIndexedPropertyStorage const&>(*m_storage).elements();
+        auto const& storage = static_cast<SimpleIndexedPropertyStorage const&>(*m_storage);
+        if (storage.is_packed())
+            return storage.array_like_size();
         size_t size = 0;
-        for (auto& element : packed_elements) {
+        for (auto& element : storage.value_elements()) {
             if (!element.is_empty())
                 ++size;
         }
@@ -282,11 +401,10 @@ Vector<u32> IndexedProperties::indices() const
         return {};
     if (m_storage->is_simple_storage()) {
         auto const& storage = static_cast<SimpleIndexedPropertyStorage const&>(*m_storage);
-        auto const& elements = storage.elements();
         Vector<u32> indices;
         indices.ensure_capacity(storage.array_like_size());
-        for (size_t i = 0; i < elements.size(); ++i) {
-            if (!elements.at(i).is_empty())
+        for (size_t i = 0; i < storage.array_like_size(); ++i) {
+            if (storage.has_index(i))
                 indices.unchecked_append(i);
         }
         return indices;
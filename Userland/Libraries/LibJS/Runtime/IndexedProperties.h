@@ -42,6 +42,19 @@ public:
 
 class SimpleIndexedPropertyStorage final : public IndexedPropertyStorage {
 public:
+    // What the elements are known to be, from the most to the least specific.
+    // Storage only ever transitions towards HoleyValue, on the first store that doesn't fit the current kind.
+    enum class ElementKind : u8 {
+        // Every element is an int32, stored unboxed.
+        PackedInt32,
+        // Every element is a number, stored as a double.
+        PackedDouble,
+        // Every element is present, but may be any value.
+        PackedValue,
+        // Elements may be missing, which is represented by an empty value.
+        HoleyValue,
+    };
+
     SimpleIndexedPropertyStorage() = default;
     explicit SimpleIndexedPropertyStorage(Vector<Value>&& initial_values);
 
@@ -53,20 +66,50 @@ public:
     virtual ValueAndAttributes take_first() override;
     virtual ValueAndAttributes take_last() override;
 
-    virtual size_t size() const override { return m_packed_elements.size(); }
+    virtual size_t size() const override { return m_array_size; }
     virtual size_t array_like_size() const override { return m_array_size; }
     virtual bool set_array_like_size(size_t new_size) override;
 
     virtual bool is_simple_storage() const override { return true; }
-    Vector<Value> const& elements() const { return m_packed_elements; }
+
+    ElementKind element_kind() const { return m_element_kind; }
+    bool is_packed() const { return m_element_kind != ElementKind::HoleyValue; }
+
+    // Returns the element at the given index, which is empty for holes.
+    Value element(size_t index) const
+    {
+        VERIFY(index < m_array_size);
+        switch (m_element_kind) {
+        case ElementKind::PackedInt32:
+            return Value(m_int32_elements[index]);
+        case ElementKind::PackedDouble:
+            return Value(m_double_elements[index]);
+        default:
+            return m_value_elements[index];
+        }
+    }
+
+    Vector<i32> const& int32_elements() const { return m_int32_elements; }
+    Vector<double> const& double_elements() const { return m_double_elements; }
+    Vector<Value> const& value_elements() const { return m_value_elements; }
 
 private:
     friend GenericIndexedPropertyStorage;
 
-    void grow_storage_if_needed();
+    static bool fits_element_kind(ElementKind, Value);
+    void transition_to(ElementKind);
+    void resize_storage(size_t new_size);
+
+    template<typename T>
+    void append_element(Vector<T>&, T);
 
     size_t m_array_size { 0 };
-    Vector<Value> m_packed_elements;
+    ElementKind m_element_kind { ElementKind::PackedInt32 };
+
+    // NOTE: Only the vector matching the element kind is in use, and it always has exactly m_array_size elements.
+    Vector<i32> m_int32_elements;
+    Vector<double> m_double_elements;
+    Vector<Value> m_value_elements;
 };
 
 class GenericIndexedPropertyStorage final : public IndexedPropertyStorage {
@@ -140,14 +183,27 @@ public:
 
     Vector<u32> indices() const;
 
+    // Returns the storage if it's simple and has no holes, in which case every index below array_like_size()
+    // is an own data property with default attributes.
+    SimpleIndexedPropertyStorage const* packed_storage() const
+    {
+        if (!m_storage || !m_storage->is_simple_storage())
+            return nullptr;
+        auto const& storage = static_cast<SimpleIndexedPropertyStorage const&>(*m_storage);
+        return storage.is_packed() ? &storage : nullptr;
+    }
+
     template<typename Callback>
     void for_each_value(Callback callback)
     {
         if (!m_storage)
             return;
         if (m_storage->is_simple_storage()) {
-            for (auto& value : static_cast<SimpleIndexedPropertyStorage&>(*m_storage).elements())
+            auto& storage = static_cast<SimpleIndexedPropertyStorage const&>(*m_storage);
+            for (size_t i = 0; i < storage.array_like_size(); ++i) {
+                auto value = storage.element(i);
                 callback(value);
+            }
         } else {
             for (auto& element : static_cast<GenericIndexedPropertyStorage const&>(*m_storage).sparse_elements())
                 callback(element.value.value);
@@ -15,6 +15,8 @@ ModuleNamespaceObject::ModuleNamespaceObject(Realm& realm, Module* module, Vecto
     , m_module(module)
     , m_exports(move(exports))
 {
+    set_has_exotic_property_access();
+
     // Note: We just perform step 6 of 10.4.6.12 ModuleNamespaceCreate ( module, exports ), https://tc39.es/ecma262/#sec-modulenamespacecreate
     // 6. Let sortedExports be a List whose elements are the elements of exports ordered as if an Array of the same values had been sorted using %Array.prototype.sort% using undefined as comparefn.
     quick_sort(m_exports, [&](FlyString const& lhs, FlyString const& rhs) {
@@ -478,6 +478,7 @@ ThrowCompletionOr<void> Object::private_field_add(PrivateName const& name, Value
 
     // 4. Append PrivateElement { [[Key]]: P, [[Kind]]: field, [[Value]]: value } to O.[[PrivateElements]].
     m_private_elements->empend(name, PrivateElement::Kind::Field, value);
+    write_barrier();
 
     // 5. Return unused.
     return {};
@@ -506,6 +507,7 @@ ThrowCompletionOr<void> Object::private_method_or_accessor_add(PrivateElement el
 
     // 5. Append method to O.[[PrivateElements]].
     m_private_elements->append(move(element));
+    write_barrier();
 
     // 6. Return unused.
     return {};
@@ -545,6 +547,7 @@ ThrowCompletionOr<void> Object::private_set(PrivateName const& name, Value value
 
     if (entry->kind == PrivateElement::Kind::Field) {
         entry->value = value;
+        write_barrier();
         return {};
     } else if (entry->kind == PrivateElement::Kind::Method) {
         return vm.throw_completion<TypeError>(ErrorType::PrivateFieldSetMethod, name.description);
@@ -1009,6 +1012,7 @@ void Object::storage_set(PropertyKey const& property_key, ValueAndAttributes con
     if (property_key.is_number()) {
         auto index = property_key.as_number();
         m_indexed_properties.put(index, value, attributes);
+        write_barrier();
         return;
     }
 
@@ -1028,10 +1032,13 @@ void Object::storage_set(PropertyKey const& property_key, ValueAndAttributes con
             set_shape(*m_shape->create_put_transition(property_key_string_or_symbol, attributes));
 
         m_storage.append(value);
+        write_barrier();
+        invalidate_prototype_chain_caches_if_needed();
         return;
     }
 
     if (attributes != metadata->attributes) {
+        invalidate_prototype_chain_caches_if_needed();
         if (m_shape->is_unique())
             m_shape->reconfigure_property_in_unique_shape(property_key_string_or_symbol, attributes);
         else
@@ -1039,6 +1046,7 @@ void Object::storage_set(PropertyKey const& property_key, ValueAndAttributes con
     }
 
     m_storage[metadata->offset] = value;
+    write_barrier();
 }
 
 void Object::storage_delete(PropertyKey const& property_key)
@@ -1056,17 +1064,20 @@ void Object::storage_delete(PropertyKey const& property_key)
 
     shape().remove_property_from_unique_shape(property_key.to_string_or_symbol(), metadata->offset);
     m_storage.remove(metadata->offset);
+    invalidate_prototype_chain_caches_if_needed();
 }
 
 void Object::set_prototype(Object* new_prototype)
 {
     if (prototype() == new_prototype)
         return;
+    invalidate_prototype_chain_caches_if_needed();
     auto& shape = this->shape();
     if (shape.is_unique())
         shape.set_prototype_without_transition(new_prototype);
     else
         m_shape = shape.create_prototype_transition(new_prototype);
+    write_barrier();
 }
 
 void Object::define_native_accessor(Realm& realm, PropertyKey const& property_key, Function<ThrowCompletionOr<Value>(VM&)> getter, Function<ThrowCompletionOr<Value>(VM&)> setter, PropertyAttributes attribute)
@@ -1103,6 +1114,7 @@ void Object::ensure_shape_is_unique()
         return;
 
     m_shape = m_shape->create_unique_clone();
+    write_barrier();
 }
 
 // Simple side-effect free property lookup, following the prototype chain. Non-standard.
@@ -1118,6 +1130,54 @@ Value Object::get_without_side_effects(PropertyKey const& property_key) const
     return {};
 }
 
+// Finds the storage slot of a data property the same way OrdinaryGet would, but only if the result may be remembered
+// by an inline cache keyed on this object's shape. Non-standard.
+Optional<CacheablePropertyMetadata> Object::cacheable_property_lookup(PropertyKey const& property_key)
+{
+    // Unique shapes are mutated in place, so they can't identify an object layout.
+    if (shape().is_unique() || m_has_exotic_property_access)
+        return {};
+
+    // NOTE: Array exotic objects synthesize "length" and TypedArrays intercept canonical numeric strings, neither of
+    //       which is backed by shape storage.
+    if (!property_key.is_string() || property_key.as_string() == "length"sv)
+        return {};
+    if (!canonical_numeric_index_string(property_key, CanonicalIndexMode::DetectNumericRoundtrip).is_undefined())
+        return {};
+
+    auto key = property_key.to_string_or_symbol();
+    for (auto* object = this; object; object = object->prototype()) {
+        if (object->m_has_exotic_property_access)
+            return {};
+
+        auto metadata = object->shape().lookup(key);
+        if (!metadata.has_value())
+            continue;
+
+        if (object->m_storage[metadata->offset].is_accessor())
+            return {};
+
+        if (object == this)
+            return CacheablePropertyMetadata { .property_offset = metadata->offset, .attributes = metadata->attributes, .prototype = nullptr };
+
+        // The receiver's shape only pins down its own properties and its prototype. Anything further up the chain is
+        // validated by having these objects invalidate all prototype chain caches whenever their shape changes.
+        for (auto* prototype = this->prototype(); prototype; prototype = prototype->prototype()) {
+            prototype->m_is_part_of_cached_prototype_chain = true;
+            if (prototype == object)
+                break;
+        }
+        return CacheablePropertyMetadata { .property_offset = metadata->offset, .attributes = metadata->attributes, .prototype = object };
+    }
+    return {};
+}
+
+void Object::invalidate_prototype_chain_caches_if_needed()
+{
+    if (m_is_part_of_cached_prototype_chain)
+        vm().invalidate_prototype_chain_caches();
+}
+
 void Object::define_native_function(Realm& realm, PropertyKey const& property_key, Function<ThrowCompletionOr<Value>(VM&)> native_function, i32 length, PropertyAttributes attribute)
 {
     auto* function = NativeFunction::create(realm, move(native_function), length, property_key, &realm);
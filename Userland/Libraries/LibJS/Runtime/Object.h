@@ -27,6 +27,15 @@ namespace JS {
 
 #define JS_OBJECT(class_, base_class) JS_CELL(class_, base_class)
 
+// The location of a data property, as remembered by the bytecode inline caches.
+struct CacheablePropertyMetadata {
+    u32 property_offset { 0 };
+    PropertyAttributes attributes { 0 };
+
+    // The object the property was found on if it's not an own property of the receiver.
+    Object* prototype { nullptr };
+};
+
 struct PrivateElement {
     enum class Kind {
         Field,
@@ -41,6 +50,7 @@ struct PrivateElement {
 
 class Object : public Cell {
     JS_CELL(Object, Cell);
+    JS_CELL_HAS_WRITE_BARRIER(Object);
 
 public:
     static Object* create(Realm&, Object* prototype);
@@ -147,6 +157,8 @@ public:
 
     Value get_without_side_effects(PropertyKey const&) const;
 
+    Optional<CacheablePropertyMetadata> cacheable_property_lookup(PropertyKey const&);
+
     void define_direct_property(PropertyKey const& property_key, Value value, PropertyAttributes attributes) { storage_set(property_key, { value, attributes }); };
     void define_direct_accessor(PropertyKey const&, FunctionObject* getter, FunctionObject* setter, PropertyAttributes attributes);
 
@@ -167,13 +179,44 @@ public:
     bool has_parameter_map() const { return m_has_parameter_map; }
     void set_has_parameter_map() { m_has_parameter_map = true; }
 
+    // Objects that override [[GetPrototypeOf]], [[GetOwnProperty]], [[Get]] or [[Set]] for string keys must set this,
+    // so that the bytecode inline caches never bypass those internal methods.
+    bool has_exotic_property_access() const { return m_has_exotic_property_access; }
+    void set_has_exotic_property_access() { m_has_exotic_property_access = true; }
+
     virtual void visit_edges(Cell::Visitor&) override;
 
     Value get_direct(size_t index) const { return m_storage[index]; }
+    void put_direct(size_t index, Value value)
+    {
+        m_storage[index] = value;
+        write_barrier();
+    }
 
     IndexedProperties const& indexed_properties() const { return m_indexed_properties; }
-    IndexedProperties& indexed_properties() { return m_indexed_properties; }
-    void set_indexed_property_elements(Vector<Value>&& values) { m_indexed_properties = IndexedProperties(move(values)); }
+    // NOTE: Stores through the returned reference can't be tracked, so the write barrier is given up on.
+    IndexedProperties& indexed_properties()
+    {
+        disable_write_barrier();
+        return m_indexed_properties;
+    }
+    void set_indexed_property_elements(Vector<Value>&& values)
+    {
+        m_indexed_properties = IndexedProperties(move(values));
+        write_barrier();
+    }
+    void put_indexed_property(u32 index, Value value, PropertyAttributes attributes = default_attributes)
+    {
+        m_indexed_properties.put(index, value, attributes);
+        write_barrier();
+    }
+    void append_indexed_property(Value value, PropertyAttributes attributes = default_attributes)
+    {
+        m_indexed_properties.append(value, attributes);
+        write_barrier();
+    }
+    // NOTE: Resizing only adds holes or drops elements, so no cell pointers are stored.
+    bool set_indexed_property_array_like_size(size_t new_size) { return m_indexed_properties.set_array_like_size(new_size); }
 
     Shape& shape() { return *m_shape; }
     Shape const& shape() const { return *m_shape; }
@@ -201,12 +244,22 @@ protected:
     // [[ParameterMap]]
     bool m_has_parameter_map { false };
 
+    bool m_has_exotic_property_access { false };
+
 private:
-    void set_shape(Shape& shape) { m_shape = &shape; }
+    void set_shape(Shape& shape)
+    {
+        m_shape = &shape;
+        write_barrier();
+    }
+    void invalidate_prototype_chain_caches_if_needed();
 
     Object* prototype() { return shape().prototype(); }
     Object const* prototype() const { return shape().prototype(); }
 
+    // Set once an inline cache has relied on this object's shape as part of a prototype chain lookup.
+    bool m_is_part_of_cached_prototype_chain { false };
+
     Shape* m_shape { nullptr };
     Vector<Value> m_storage;
     IndexedProperties m_indexed_properties;
@@ -19,6 +19,7 @@ PrimitiveString::PrimitiveString(PrimitiveString& lhs, PrimitiveString& rhs)
     : m_is_rope(true)
     , m_lhs(&lhs)
     , m_rhs(&rhs)
+    , m_rope_depth(max(lhs.m_rope_depth, rhs.m_rope_depth) + 1)
 {
 }
 
@@ -36,7 +37,10 @@ PrimitiveString::PrimitiveString(Utf16String string)
 
 PrimitiveString::~PrimitiveString()
 {
-    vm().string_cache().remove(m_utf8_string);
+    // The cache may already point to a newer string with the same contents, see js_string().
+    auto& string_cache = vm().string_cache();
+    if (auto it = string_cache.find(m_utf8_string); it != string_cache.end() && it->value == this)
+        string_cache.remove(it);
 }
 
 void PrimitiveString::visit_edges(Cell::Visitor& visitor)
@@ -87,15 +91,56 @@ Utf16View PrimitiveString::utf16_string_view() const
     return utf16_string().view();
 }
 
+size_t PrimitiveString::length_in_code_units() const
+{
+    if (m_has_utf16_string)
+        return m_utf16_string.length_in_code_units();
+    if (m_length_in_code_units.has_value())
+        return *m_length_in_code_units;
+
+    if (!m_is_rope) {
+        // NOTE: This counts the code units the same way converting to UTF-16 would, without allocating them.
+        size_t length = 0;
+        for (auto code_point : Utf8View(m_utf8_string))
+            length += code_point < 0x10000 ? 1 : 2;
+        m_length_in_code_units = length;
+        return length;
+    }
+
+    // NOTE: Joining surrogate halves across pieces doesn't change the number of code units, so the
+    //       length of a rope is the sum of its sides. We don't recurse, as ropes can be quite deep.
+    Vector<PrimitiveString const*> stack;
+    stack.append(this);
+    while (!stack.is_empty()) {
+        auto const* current = stack.last();
+        if (!current->m_is_rope || current->m_length_in_code_units.has_value()) {
+            stack.take_last();
+            continue;
+        }
+
+        bool sides_are_known = true;
+        for (auto const* side : { current->m_lhs, current->m_rhs }) {
+            if (side->m_is_rope && !side->m_length_in_code_units.has_value()) {
+                stack.append(side);
+                sides_are_known = false;
+            }
+        }
+        if (!sides_are_known)
+            continue;
+
+        current->m_length_in_code_units = current->m_lhs->length_in_code_units() + current->m_rhs->length_in_code_units();
+        stack.take_last();
+    }
+    return *m_length_in_code_units;
+}
+
 Optional<Value> PrimitiveString::get(VM& vm, PropertyKey const& property_key) const
 {
     if (property_key.is_symbol())
         return {};
     if (property_key.is_string()) {
-        if (property_key.as_string() == vm.names.length.as_string()) {
-            auto length = utf16_string().length_in_code_units();
-            return Value(static_cast<double>(length));
-        }
+        if (property_key.as_string() == vm.names.length.as_string())
+            return Value(static_cast<double>(length_in_code_units()));
     }
     auto index = canonical_numeric_index_string(property_key, CanonicalIndexMode::IgnoreNumericRoundtrip);
     if (!index.is_index())
@@ -149,7 +194,8 @@ PrimitiveString* js_string(Heap& heap, String string)
 
     auto& string_cache = heap.vm().string_cache();
     auto it = string_cache.find(string);
-    if (it == string_cache.end()) {
+    // NOTE: A cached string that the last collection found to be dead must not be handed out again, as it's about to be swept.
+    if (it == string_cache.end() || it->value->is_dead()) {
         auto* new_string = heap.allocate_without_realm<PrimitiveString>(string);
         string_cache.set(move(string), new_string);
         return new_string;
@@ -179,6 +225,13 @@ PrimitiveString* js_rope_string(VM& vm, PrimitiveString& lhs, PrimitiveString& r
     if (rhs_empty)
         return &lhs;
 
+    // Flatten the deeper side once the rope gets too deep. For the common `string += piece` pattern,
+    // this copies the accumulated string once every max_rope_depth concatenations.
+    if (lhs.m_rope_depth >= PrimitiveString::max_rope_depth)
+        lhs.resolve_rope_if_needed();
+    if (rhs.m_rope_depth >= PrimitiveString::max_rope_depth)
+        rhs.resolve_rope_if_needed();
+
     return vm.heap().allocate_without_realm<PrimitiveString>(lhs, rhs);
 }
 
@@ -203,6 +256,7 @@ void PrimitiveString::resolve_rope_if_needed() const
         m_is_rope = false;
         m_lhs = nullptr;
         m_rhs = nullptr;
+        m_rope_depth = 0;
         return;
     }
 
@@ -291,6 +345,7 @@ void PrimitiveString::resolve_rope_if_needed() const
     m_is_rope = false;
     m_lhs = nullptr;
     m_rhs = nullptr;
+    m_rope_depth = 0;
 }
 
 }
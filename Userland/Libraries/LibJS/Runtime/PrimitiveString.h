@@ -17,6 +17,7 @@ namespace JS {
 
 class PrimitiveString final : public Cell {
     JS_CELL(PrimitiveString, Cell);
+    JS_CELL_HAS_WRITE_BARRIER(PrimitiveString);
 
 public:
     virtual ~PrimitiveString();
@@ -33,9 +34,18 @@ public:
     Utf16View utf16_string_view() const;
     bool has_utf16_string() const { return m_has_utf16_string; }
 
+    // The length of the string in UTF-16 code units, which doesn't require resolving a rope.
+    size_t length_in_code_units() const;
+
     Optional<Value> get(VM&, PropertyKey const&) const;
 
+    // Ropes deeper than this are flattened as they're concatenated onto, which bounds the
+    // number of rope cells (and the resolve traversal) a single string can accumulate.
+    static constexpr u32 max_rope_depth = 4096;
+
 private:
+    friend PrimitiveString* js_rope_string(VM&, PrimitiveString&, PrimitiveString&);
+
     explicit PrimitiveString(PrimitiveString&, PrimitiveString&);
     explicit PrimitiveString(String);
     explicit PrimitiveString(Utf16String);
@@ -50,6 +60,9 @@ private:
 
     mutable PrimitiveString* m_lhs { nullptr };
     mutable PrimitiveString* m_rhs { nullptr };
+    mutable u32 m_rope_depth { 0 };
+
+    mutable Optional<size_t> m_length_in_code_units;
 
     mutable String m_utf8_string;
 
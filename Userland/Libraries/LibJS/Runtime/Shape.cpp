@@ -29,7 +29,7 @@ Shape* Shape::get_or_prune_cached_forward_transition(TransitionKey const& key)
     auto it = m_forward_transitions->find(key);
     if (it == m_forward_transitions->end())
         return nullptr;
-    if (!it->value) {
+    if (!it->value || it->value->is_dead()) {
         // The cached forward transition has gone stale (from garbage collection). Prune it.
         m_forward_transitions->remove(it);
         return nullptr;
@@ -44,7 +44,7 @@ Shape* Shape::get_or_prune_cached_prototype_transition(Object* prototype)
     auto it = m_prototype_transitions->find(prototype);
     if (it == m_prototype_transitions->end())
         return nullptr;
-    if (!it->value) {
+    if (!it->value || it->value->is_dead()) {
         // The cached prototype transition has gone stale (from garbage collection). Prune it.
         m_prototype_transitions->remove(it);
         return nullptr;
@@ -193,6 +193,7 @@ void Shape::add_property_to_unique_shape(StringOrSymbol const& property_key, Pro
     VERIFY(m_property_table);
     VERIFY(!m_property_table->contains(property_key));
     m_property_table->set(property_key, { static_cast<u32>(m_property_table->size()), attributes });
+    write_barrier();
 
     VERIFY(m_property_count < NumericLimits<u32>::max());
     ++m_property_count;
@@ -229,6 +230,7 @@ void Shape::add_property_without_transition(StringOrSymbol const& property_key,
         VERIFY(m_property_count < NumericLimits<u32>::max());
         ++m_property_count;
     }
+    write_barrier();
 }
 
 FLATTEN void Shape::add_property_without_transition(PropertyKey const& property_key, PropertyAttributes attributes)
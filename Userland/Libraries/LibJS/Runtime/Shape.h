@@ -38,6 +38,7 @@ class Shape final
     : public Cell
     , public Weakable<Shape> {
     JS_CELL(Shape, Cell);
+    JS_CELL_HAS_WRITE_BARRIER(Shape);
 
 public:
     virtual ~Shape() override = default;
@@ -75,7 +76,11 @@ public:
 
     Vector<Property> property_table_ordered() const;
 
-    void set_prototype_without_transition(Object* new_prototype) { m_prototype = new_prototype; }
+    void set_prototype_without_transition(Object* new_prototype)
+    {
+        m_prototype = new_prototype;
+        write_barrier();
+    }
 
     void remove_property_from_unique_shape(StringOrSymbol const&, size_t offset);
     void add_property_to_unique_shape(StringOrSymbol const&, PropertyAttributes attributes);
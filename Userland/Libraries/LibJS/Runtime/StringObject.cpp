@@ -30,7 +30,7 @@ void StringObject::initialize(Realm& realm)
 {
     auto& vm = this->vm();
     Object::initialize(realm);
-    define_direct_property(vm.names.length, Value(m_string.utf16_string_view().length_in_code_units()), 0);
+    define_direct_property(vm.names.length, Value(m_string.length_in_code_units()), 0);
 }
 
 void StringObject::visit_edges(Cell::Visitor& visitor)
@@ -14,6 +14,7 @@ namespace JS {
 
 class Symbol final : public Cell {
     JS_CELL(Symbol, Cell);
+    JS_CELL_HAS_WRITE_BARRIER(Symbol);
     AK_MAKE_NONCOPYABLE(Symbol);
     AK_MAKE_NONMOVABLE(Symbol);
 
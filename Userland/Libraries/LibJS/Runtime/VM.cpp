@@ -187,27 +187,24 @@ VM::InterpreterExecutionScope::~InterpreterExecutionScope()
     m_interpreter.vm().pop_interpreter(m_interpreter);
 }
 
-void VM::gather_roots(HashTable<Cell*>& roots)
+void VM::gather_roots(Cell::Visitor& visitor)
 {
-    roots.set(m_empty_string);
+    visitor.visit(m_empty_string);
     for (auto* string : m_single_ascii_character_strings)
-        roots.set(string);
+        visitor.visit(string);
 
-    auto gather_roots_from_execution_context_stack = [&roots](Vector<ExecutionContext*> const& stack) {
+    auto gather_roots_from_execution_context_stack = [&visitor](Vector<ExecutionContext*> const& stack) {
         for (auto& execution_context : stack) {
-            if (execution_context->this_value.is_cell())
-                roots.set(&execution_context->this_value.as_cell());
-            for (auto& argument : execution_context->arguments) {
-                if (argument.is_cell())
-                    roots.set(&argument.as_cell());
-            }
-            roots.set(execution_context->lexical_environment);
-            roots.set(execution_context->variable_environment);
-            roots.set(execution_context->private_environment);
+            visitor.visit(execution_context->this_value);
+            for (auto& argument : execution_context->arguments)
+                visitor.visit(argument);
+            visitor.visit(execution_context->lexical_environment);
+            visitor.visit(execution_context->variable_environment);
+            visitor.visit(execution_context->private_environment);
             execution_context->script_or_module.visit(
                 [](Empty) {},
                 [&](auto& script_or_module) {
-                    roots.set(script_or_module.ptr());
+                    visitor.visit(script_or_module.ptr());
                 });
         }
     };
@@ -217,15 +214,15 @@ void VM::gather_roots(HashTable<Cell*>& roots)
         gather_roots_from_execution_context_stack(saved_stack);
 
 #define __JS_ENUMERATE(SymbolName, snake_name) \
-    roots.set(well_known_symbol_##snake_name());
+    visitor.visit(well_known_symbol_##snake_name());
     JS_ENUMERATE_WELL_KNOWN_SYMBOLS
 #undef __JS_ENUMERATE
 
     for (auto& symbol : m_global_symbol_map)
-        roots.set(symbol.value);
+        visitor.visit(symbol.value);
 
     for (auto* finalization_registry : m_finalization_registry_cleanup_jobs)
-        roots.set(finalization_registry);
+        visitor.visit(finalization_registry);
 }
 
 Symbol* VM::get_global_symbol(String const& description)
@@ -480,7 +477,7 @@ ThrowCompletionOr<void> VM::iterator_binding_initialization(BindingPattern const
                 }
 
                 // f. Perform ! CreateDataPropertyOrThrow(A, ! ToString(𝔽(n)), nextValue).
-                array->indexed_properties().append(next_value.value());
+                array->append_indexed_property(next_value.value());
 
                 // g. Set n to n + 1.
             }
@@ -63,7 +63,7 @@ public:
         Interpreter& m_interpreter;
     };
 
-    void gather_roots(HashTable<Cell*>&);
+    void gather_roots(Cell::Visitor&);
 
 #define __JS_ENUMERATE(SymbolName, snake_name)     \
     Symbol* well_known_symbol_##snake_name() const \
@@ -165,6 +165,10 @@ public:
     u32 execution_generation() const { return m_execution_generation; }
     void finish_execution_generation() { ++m_execution_generation; }
 
+    // Inline cache entries for properties found on the prototype chain are only valid while this is unchanged.
+    u64 prototype_chain_validity() const { return m_prototype_chain_validity; }
+    void invalidate_prototype_chain_caches() { ++m_prototype_chain_validity; }
+
     ThrowCompletionOr<Reference> resolve_binding(FlyString const&, Environment* = nullptr);
     ThrowCompletionOr<Reference> get_identifier_reference(Environment*, FlyString, bool strict, size_t hops = 0);
 
@@ -292,6 +296,8 @@ private:
 
     u32 m_execution_generation { 0 };
 
+    u64 m_prototype_chain_validity { 0 };
+
     OwnPtr<CustomData> m_custom_data;
 };
 
@@ -0,0 +1,107 @@
+describe("element kind transitions", () => {
+    test("int32 elements transition to doubles and then to any value", () => {
+        const a = [1, 2, 3];
+        a.push(4.5);
+        expect(a).toEqual([1, 2, 3, 4.5]);
+        a.push(-0);
+        expect(Object.is(a[4], -0)).toBeTrue();
+        a[1] = "two";
+        expect(a).toEqual([1, "two", 3, 4.5, -0]);
+        a.push({ five: 5 });
+        expect(a[5].five).toBe(5);
+    });
+
+    test("holes are preserved when growing, deleting and shrinking", () => {
+        const a = [1, 2, 3];
+        a[5] = 6;
+        expect(a).toHaveLength(6);
+        expect(3 in a).toBeFalse();
+        expect(a[3]).toBeUndefined();
+
+        delete a[0];
+        expect(0 in a).toBeFalse();
+        expect(a.indexOf(2)).toBe(1);
+
+        a.length = 2;
+        expect(a).toHaveLength(2);
+        expect(a[1]).toBe(2);
+
+        const b = [1.5, 2.5];
+        b.length = 4;
+        expect(2 in b).toBeFalse();
+        expect(b.indexOf(undefined)).toBe(-1);
+    });
+
+    test("shift and pop on typed storage", () => {
+        const a = [1, 2, 3];
+        expect(a.shift()).toBe(1);
+        expect(a.pop()).toBe(3);
+        expect(a).toEqual([2]);
+
+        const b = [0.5, 1.5];
+        expect(b.pop()).toBe(1.5);
+        expect(b.shift()).toBe(0.5);
+        expect(b).toHaveLength(0);
+    });
+});
+
+describe("fast paths for packed arrays", () => {
+    test("indexOf follows IsStrictlyEqual", () => {
+        expect([1, 2, 3].indexOf(2)).toBe(1);
+        expect([1, 2, 3].indexOf(2.0)).toBe(1);
+        expect([1, 2, 3].indexOf("2")).toBe(-1);
+        expect([0, 1].indexOf(-0)).toBe(0);
+        expect([1.5, NaN].indexOf(NaN)).toBe(-1);
+        expect([1.5, -0].indexOf(0)).toBe(1);
+        expect([1.5, 2.5].indexOf(2.5, -1)).toBe(1);
+        expect([1, 2, 3].indexOf(1, 1)).toBe(-1);
+        expect(["a", 1, null].indexOf(null)).toBe(2);
+    });
+
+    test("push calls setters on the prototype chain", () => {
+        const calls = [];
+        Object.defineProperty(Array.prototype, 2, {
+            set(value) {
+                calls.push(value);
+            },
+            configurable: true,
+        });
+        const a = [0, 1];
+        a.push(2);
+        delete Array.prototype[2];
+        Array.prototype.length = 0;
+
+        expect(calls).toEqual([2]);
+        expect(a).toHaveLength(3);
+        expect(2 in a).toBeFalse();
+    });
+
+    test("push on a non-extensible array throws", () => {
+        const a = Object.preventExtensions([1, 2]);
+        expect(() => a.push(3)).toThrow(TypeError);
+        expect(a).toHaveLength(2);
+    });
+
+    test("map sees changes made by its callback", () => {
+        const a = [1, 2, 3, 4];
+        const result = a.map((value, index) => {
+            if (index === 0) {
+                a[1] = "changed";
+                a.length = 3;
+            }
+            return value;
+        });
+        expect(result).toHaveLength(4);
+        expect(result[1]).toBe("changed");
+        expect(3 in result).toBeFalse();
+    });
+
+    test("sort writes back all elements", () => {
+        const numbers = [3, 1, 10, 2];
+        expect(numbers.sort()).toEqual([1, 10, 2, 3]);
+        expect(numbers.sort((a, b) => a - b)).toEqual([1, 2, 3, 10]);
+
+        const doubles = [0.5, -1.5, 2.25];
+        expect(doubles.sort((a, b) => a - b)).toEqual([-1.5, 0.5, 2.25]);
+    });
+});
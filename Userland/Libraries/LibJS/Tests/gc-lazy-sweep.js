@@ -0,0 +1,68 @@
+// NOTE: A full collection leaves the dead cells for the allocators to sweep later on. Until then, the caches
+//       that only hold on to cells weakly still point to them, and must not hand them out again.
+
+function allocateUntilSwept() {
+    for (let i = 0; i < 50000; ++i) ({ value: i, string: "x" + i });
+}
+
+test("cached strings that died in a full collection are not reused", () => {
+    (() => {
+        for (let i = 0; i < 1000; ++i) String(i + 1000000);
+    })();
+    gc();
+
+    const strings = [];
+    for (let i = 0; i < 1000; ++i) strings.push(String(i + 1000000));
+
+    allocateUntilSwept();
+    gc();
+
+    for (let i = 0; i < 1000; ++i) expect(strings[i]).toBe(String(i + 1000000));
+});
+
+test("shape transitions that died in a full collection are not reused", () => {
+    (() => {
+        for (let i = 0; i < 100; ++i) {
+            const object = {};
+            object.lazySweepFirst = i;
+            object.lazySweepSecond = i;
+        }
+    })();
+    gc();
+
+    const objects = [];
+    for (let i = 0; i < 100; ++i) {
+        const object = {};
+        object.lazySweepFirst = i;
+        object.lazySweepSecond = i;
+        objects.push(object);
+    }
+
+    allocateUntilSwept();
+    gc();
+
+    for (let i = 0; i < 100; ++i) {
+        expect(objects[i].lazySweepFirst).toBe(i);
+        expect(objects[i].lazySweepSecond).toBe(i);
+        expect(Object.keys(objects[i])).toEqual(["lazySweepFirst", "lazySweepSecond"]);
+    }
+});
+
+test("prototype transitions that died in a full collection are not reused", () => {
+    const prototype = { inherited: 1 };
+    (() => {
+        for (let i = 0; i < 100; ++i) Object.setPrototypeOf({}, prototype);
+    })();
+    gc();
+
+    const objects = [];
+    for (let i = 0; i < 100; ++i) objects.push(Object.setPrototypeOf({}, prototype));
+
+    allocateUntilSwept();
+    gc();
+
+    for (let i = 0; i < 100; ++i) {
+        expect(Object.getPrototypeOf(objects[i])).toBe(prototype);
+        expect(objects[i].inherited).toBe(1);
+    }
+});
@@ -0,0 +1,69 @@
+// NOTE: These allocate enough cells to go through a number of young generation collections,
+//       while old cells are the only thing keeping the young ones alive.
+
+test("young cells stored in old objects survive", () => {
+    const old = {};
+    const oldArray = [];
+    gc();
+
+    for (let i = 0; i < 50000; ++i) {
+        old["property" + (i % 100)] = { value: i };
+        oldArray[i % 100] = { value: i };
+    }
+
+    for (let i = 0; i < 100; ++i) {
+        expect(old["property" + i].value % 100).toBe(i);
+        expect(oldArray[i].value % 100).toBe(i);
+    }
+});
+
+test("young cells stored in old private fields survive", () => {
+    class Holder {
+        #value;
+        set(value) {
+            this.#value = value;
+        }
+        get() {
+            return this.#value;
+        }
+    }
+
+    const holder = new Holder();
+    gc();
+
+    for (let i = 0; i < 50000; ++i) holder.set({ value: i, string: "x" + i });
+
+    expect(holder.get().value).toBe(49999);
+    expect(holder.get().string).toBe("x49999");
+});
+
+test("young prototypes of old objects survive", () => {
+    const old = {};
+    gc();
+
+    for (let i = 0; i < 50000; ++i) Object.setPrototypeOf(old, { value: i });
+
+    expect(old.value).toBe(49999);
+});
+
+test("young generation collections don't have to visit the whole old heap", () => {
+    const makeOldCells = count => {
+        const cells = [];
+        for (let i = 0; i < count; ++i) {
+            const object = { value: i, string: "old" + i };
+            cells.push(object, [object, i], () => object, "string" + i);
+        }
+        return cells;
+    };
+
+    const small = makeOldCells(100);
+    gc();
+    const rememberedWithSmallHeap = getRememberedCellCount();
+
+    const large = makeOldCells(20000);
+    gc();
+    const rememberedWithLargeHeap = getRememberedCellCount();
+
+    expect(small.length + large.length).toBe(80400);
+    expect(rememberedWithLargeHeap - rememberedWithSmallHeap).toBeLessThan(100);
+});
@@ -0,0 +1,42 @@
+test("int32 overflow produces doubles", () => {
+    let max = 2147483647;
+    let min = -2147483648;
+    expect(max + 1).toBe(2147483648);
+    expect(min - 1).toBe(-2147483649);
+    expect(max * 2).toBe(4294967294);
+    expect(min * -1).toBe(2147483648);
+
+    let x = max;
+    x++;
+    expect(x).toBe(2147483648);
+    let y = min;
+    y--;
+    expect(y).toBe(-2147483649);
+});
+
+test("int32 multiplication producing negative zero", () => {
+    let zero = 0;
+    let minusOne = -1;
+    expect(Object.is(zero * minusOne, -0)).toBeTrue();
+    expect(Object.is(minusOne * zero, -0)).toBeTrue();
+    expect(Object.is(zero * 5, 0)).toBeTrue();
+});
+
+test("int32 modulo with negative operands", () => {
+    let a = -7;
+    let b = 7;
+    expect(Object.is(a % b, -0)).toBeTrue();
+    expect(-8 % 3).toBe(-2);
+    expect(8 % -3).toBe(2);
+    expect(-2147483648 % -1).toBe(-0);
+    expect(Number.isNaN(5 % 0)).toBeTrue();
+});
+
+test("int32 shifts mask their shift count", () => {
+    let one = 1;
+    let minusOne = -1;
+    expect(one << 33).toBe(2);
+    expect(minusOne >> 40).toBe(-1);
+    expect(minusOne >>> 0).toBe(4294967295);
+    expect(minusOne >>> 31).toBe(1);
+});
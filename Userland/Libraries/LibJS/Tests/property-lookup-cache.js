@@ -0,0 +1,113 @@
+test("own property lookups across shapes", () => {
+    const get = o => o.x;
+    const objects = [
+        { x: 1 },
+        { y: 0, x: 2 },
+        { z: 0, y: 0, x: 3 },
+        { w: 0, x: 4 },
+        { v: 0, x: 5 },
+        { x: 6 },
+    ];
+    for (let i = 0; i < 3; ++i) {
+        expect(objects.map(get)).toEqual([1, 2, 3, 4, 5, 6]);
+    }
+});
+
+test("own property assignment is observed by later lookups", () => {
+    const o = { x: 1 };
+    for (let i = 0; i < 5; ++i) {
+        o.x = i;
+        expect(o.x).toBe(i);
+    }
+});
+
+test("property found on the prototype chain", () => {
+    const proto = {
+        greet() {
+            return "hello";
+        },
+    };
+    const objects = [Object.create(proto), Object.create(proto)];
+    const results = [];
+    for (let i = 0; i < 3; ++i) {
+        for (const o of objects) results.push(o.greet());
+    }
+    expect(results).toEqual(Array(6).fill("hello"));
+});
+
+test("prototype property changes invalidate cached lookups", () => {
+    const grandparent = { value: "grandparent" };
+    const parent = Object.create(grandparent);
+    const child = Object.create(parent);
+    const get = o => o.value;
+
+    expect(get(child)).toBe("grandparent");
+    expect(get(child)).toBe("grandparent");
+
+    parent.value = "parent";
+    expect(get(child)).toBe("parent");
+
+    delete parent.value;
+    expect(get(child)).toBe("grandparent");
+
+    Object.setPrototypeOf(parent, { value: "other" });
+    expect(get(child)).toBe("other");
+
+    Object.defineProperty(parent, "value", { get: () => "getter" });
+    expect(get(child)).toBe("getter");
+});
+
+test("own property shadowing a cached prototype property", () => {
+    const proto = { value: 1 };
+    const o = Object.create(proto);
+    const get = o => o.value;
+    expect(get(o)).toBe(1);
+    expect(get(o)).toBe(1);
+    o.value = 2;
+    expect(get(o)).toBe(2);
+});
+
+test("redefining a data property as an accessor", () => {
+    const o = { x: 1 };
+    const get = o => o.x;
+    expect(get(o)).toBe(1);
+    expect(get(o)).toBe(1);
+    Object.defineProperty(o, "x", { get: () => 2, enumerable: true, configurable: true });
+    expect(get(o)).toBe(2);
+});
+
+test("assignment to non-writable property is not cached", () => {
+    "use strict";
+    const o = { x: 1 };
+    const set = (o, v) => {
+        o.x = v;
+    };
+    set(o, 2);
+    set(o, 3);
+    Object.freeze(o);
+    expect(() => set(o, 4)).toThrow(TypeError);
+    expect(o.x).toBe(3);
+});
+
+test("proxies sharing a shape with plain objects", () => {
+    const plain = {};
+    const proxy = new Proxy({}, { get: () => "trapped" });
+    const get = o => o.toString;
+    expect(get(plain)).toBe(Object.prototype.toString);
+    expect(get(plain)).toBe(Object.prototype.toString);
+    expect(get(proxy)).toBe("trapped");
+});
+
+test("Array length is never served from the cache", () => {
+    Object.prototype.length = "nope";
+    try {
+        const array = [];
+        Object.setPrototypeOf(array, Object.prototype);
+        const get = o => o.length;
+        expect(get({})).toBe("nope");
+        expect(get({})).toBe("nope");
+        expect(get(array)).toBe(0);
+    } finally {
+        delete Object.prototype.length;
+    }
+});
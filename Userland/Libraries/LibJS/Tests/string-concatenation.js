@@ -28,3 +28,28 @@ test("adding strings with dangling surrogates", () => {
     expect("\ud834a" + "\udf06").toBe("\ud834a\udf06");
     expect("\ud834" + "a\udf06").toBe("\ud834a\udf06");
 });
+
+test("length of concatenated strings", () => {
+    let s = "";
+    for (let i = 0; i < 10000; ++i) {
+        s += i % 2 ? "a" : "ß";
+        expect(s.length).toBe(i + 1);
+    }
+    expect(s.slice(0, 4)).toBe("ßaßa");
+
+    expect(("\ud834" + "\udf06").length).toBe(2);
+    expect(("x\ud834" + "\udf06" + "😀").length).toBe(5);
+});
+
+test("deeply nested concatenations", () => {
+    let s = "";
+    for (let i = 0; i < 20000; ++i) s += "ab";
+    expect(s.length).toBe(40000);
+    expect(s.startsWith("abab")).toBeTrue();
+    expect(s.endsWith("abab")).toBeTrue();
+
+    let t = "";
+    for (let i = 0; i < 20000; ++i) t = "c" + t;
+    expect(t.length).toBe(20000);
+    expect(t.indexOf("d")).toBe(-1);
+});
@@ -69,3 +69,17 @@ test("invalid escapes should give syntax error", () => {
     expect("`\\01`").not.toEval();
     expect("`\\u{10FFFFF}`").not.toEval();
 });
+
+test("substitutions are converted with ToString", () => {
+    const object = {
+        toString() {
+            return "string";
+        },
+        valueOf() {
+            return "value";
+        },
+    };
+    expect(`${object}`).toBe("string");
+    expect(`a${object}b${1}c${null}`).toBe("astringb1cnull");
+    expect(() => `${Symbol()}`).toThrow(TypeError);
+});
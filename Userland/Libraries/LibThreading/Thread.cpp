@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Debug.h>
 #include <LibThreading/Thread.h>
 #include <pthread.h>
 #include <string.h>
@@ -24,7 +25,8 @@ Threading::Thread::Thread(Function<intptr_t()> action, StringView thread_name)
 Threading::Thread::~Thread()
 {
     if (m_tid && !m_detached) {
-        dbgln("Destroying thread \"{}\"({}) while it is still running!", m_thread_name, m_tid);
+        if (!m_has_exited)
+            dbgln("Destroying thread \"{}\"({}) while it is still running!", m_thread_name, m_tid);
         [[maybe_unused]] auto res = join();
     }
 }
@@ -37,7 +39,8 @@ void Threading::Thread::start()
         [](void* arg) -> void* {
             Thread* self = static_cast<Thread*>(arg);
             auto exit_code = self->m_action();
-            self->m_tid = 0;
+            // NOTE: m_tid is left alone, as join() still needs it to reap the thread.
+            self->m_has_exited = true;
             return reinterpret_cast<void*>(exit_code);
         },
         static_cast<void*>(this));
@@ -49,7 +52,7 @@ void Threading::Thread::start()
         VERIFY(rc == 0);
     }
 #endif
-    dbgln("Started thread \"{}\", tid = {}", m_thread_name, m_tid);
+    dbgln_if(THREADING_DEBUG, "Started thread \"{}\", tid = {}", m_thread_name, m_tid);
     m_started = true;
 }
 
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
 #include <AK/DistinctNumeric.h>
 #include <AK/Function.h>
 #include <AK/Result.h>
@@ -41,6 +42,7 @@ private:
     String m_thread_name;
     bool m_detached { false };
     bool m_started { false };
+    Atomic<bool> m_has_exited { false };
 };
 
 template<typename T>
@@ -24,6 +24,7 @@ namespace Web::Bindings {
 LocationObject::LocationObject(JS::Realm& realm)
     : PlatformObject(realm)
 {
+    set_has_exotic_property_access();
     set_prototype(&cached_web_prototype(realm, "Location"));
 }
 
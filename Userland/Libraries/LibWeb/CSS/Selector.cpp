@@ -23,6 +23,50 @@ Selector::Selector(Vector<CompoundSelector>&& compound_selectors)
             }
         }
     }
+
+    collect_ancestor_hashes();
+}
+
+void Selector::collect_ancestor_hashes()
+{
+    size_t next_hash_index = 0;
+    auto append_unique_hash = [&](u32 hash) -> bool {
+        if (hash == 0)
+            return false;
+        for (size_t i = 0; i < next_hash_index; ++i) {
+            if (m_ancestor_hashes[i] == hash)
+                return false;
+        }
+        m_ancestor_hashes[next_hash_index++] = hash;
+        return next_hash_index == m_ancestor_hashes.size();
+    };
+
+    // A compound selector followed by a descendant or child combinator must match an ancestor of the subject.
+    // (Even across sibling combinators further right: siblings share their ancestors.)
+    for (ssize_t compound_index = m_compound_selectors.size() - 1; compound_index > 0; --compound_index) {
+        auto combinator = m_compound_selectors[compound_index].combinator;
+        if (combinator != Combinator::Descendant && combinator != Combinator::ImmediateChild)
+            continue;
+
+        for (auto const& simple_selector : m_compound_selectors[compound_index - 1].simple_selectors) {
+            u32 hash = 0;
+            switch (simple_selector.type) {
+            case SimpleSelector::Type::Id:
+                hash = id_hash(simple_selector.name());
+                break;
+            case SimpleSelector::Type::Class:
+                hash = class_hash(simple_selector.name());
+                break;
+            case SimpleSelector::Type::TagName:
+                hash = tag_name_hash(simple_selector.name());
+                break;
+            default:
+                continue;
+            }
+            if (append_unique_hash(hash))
+                return;
+        }
+    }
 }
 
 // https://www.w3.org/TR/selectors-4/#specificity-rules
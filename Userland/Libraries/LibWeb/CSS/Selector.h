@@ -7,9 +7,11 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/FlyString.h>
 #include <AK/NonnullRefPtrVector.h>
 #include <AK/RefCounted.h>
+#include <AK/StringHash.h>
 #include <AK/String.h>
 #include <AK/Vector.h>
 
@@ -199,10 +201,23 @@ public:
     u32 specificity() const;
     String serialize() const;
 
+    // Hashes of the ids, classes and tag names that some ancestor of a matching element must have.
+    // Used to reject selectors early with the StyleComputer's ancestor filter. Zero-terminated if not full.
+    static constexpr size_t max_ancestor_hashes = 8;
+    Array<u32, max_ancestor_hashes> const& ancestor_hashes() const { return m_ancestor_hashes; }
+
+    static u32 id_hash(StringView id) { return string_hash(id.characters_without_null_termination(), id.length()) * 17; }
+    static u32 class_hash(FlyString const& class_name) { return class_name.hash() * 11; }
+    // NOTE: Tag names may match case-insensitively, depending on the document type.
+    static u32 tag_name_hash(StringView tag_name) { return AK::case_insensitive_string_hash(tag_name.characters_without_null_termination(), tag_name.length()) * 13; }
+
 private:
     explicit Selector(Vector<CompoundSelector>&&);
 
+    void collect_ancestor_hashes();
+
     Vector<CompoundSelector> m_compound_selectors;
+    Array<u32, max_ancestor_hashes> m_ancestor_hashes {};
     mutable Optional<u32> m_specificity;
     Optional<Selector::PseudoElement> m_pseudo_element;
 };
@@ -25,9 +25,17 @@
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
 #include <LibWeb/FontCache.h>
+#include <LibWeb/HTML/HTMLButtonElement.h>
+#include <LibWeb/HTML/HTMLFieldSetElement.h>
 #include <LibWeb/HTML/HTMLHtmlElement.h>
+#include <LibWeb/HTML/HTMLInputElement.h>
+#include <LibWeb/HTML/HTMLOptGroupElement.h>
+#include <LibWeb/HTML/HTMLOptionElement.h>
+#include <LibWeb/HTML/HTMLSelectElement.h>
+#include <LibWeb/HTML/HTMLTextAreaElement.h>
 #include <LibWeb/Loader/ResourceLoader.h>
 #include <LibWeb/Platform/FontPlugin.h>
+#include <LibWeb/TraceEvents.h>
 #include <stdio.h>
 
 namespace Web::CSS {
@@ -148,6 +156,8 @@ void StyleComputer::for_each_stylesheet(CascadeOrigin cascade_origin, Callback c
 
 Vector<MatchingRule> StyleComputer::collect_matching_rules(DOM::Element const& element, CascadeOrigin cascade_origin, Optional<CSS::Selector::PseudoElement> pseudo_element) const
 {
+    bool use_ancestor_filter = can_use_ancestor_filter_for(element);
+
     if (cascade_origin == CascadeOrigin::Author) {
         Vector<MatchingRule> rules_to_run;
         if (pseudo_element.has_value()) {
@@ -171,6 +181,8 @@ Vector<MatchingRule> StyleComputer::collect_matching_rules(DOM::Element const& e
         matching_rules.ensure_capacity(rules_to_run.size());
         for (auto const& rule_to_run : rules_to_run) {
             auto const& selector = rule_to_run.rule->selectors()[rule_to_run.selector_index];
+            if (use_ancestor_filter && should_reject_with_ancestor_filter(selector))
+                continue;
             if (SelectorEngine::matches(selector, element, pseudo_element))
                 matching_rules.append(rule_to_run);
         }
@@ -184,7 +196,7 @@ Vector<MatchingRule> StyleComputer::collect_matching_rules(DOM::Element const& e
         sheet.for_each_effective_style_rule([&](auto const& rule) {
             size_t selector_index = 0;
             for (auto& selector : rule.selectors()) {
-                if (SelectorEngine::matches(selector, element, pseudo_element)) {
+                if (!(use_ancestor_filter && should_reject_with_ancestor_filter(selector)) && SelectorEngine::matches(selector, element, pseudo_element)) {
                     matching_rules.append({ &rule, style_sheet_index, rule_index, selector_index, selector.specificity() });
                     break;
                 }
@@ -1216,10 +1228,155 @@ NonnullRefPtr<StyleProperties> StyleComputer::create_document_style() const
     return style;
 }
 
+void StyleComputer::reject_style_sharing(StyleSharingRejection reason) const
+{
+    ++m_style_sharing_statistics.rejections[to_underlying(reason)];
+}
+
+static bool is_in_interactive_state(DOM::Element const& element)
+{
+    auto const& document = element.document();
+    if (element.is_active())
+        return true;
+    if (auto const* hovered_node = document.hovered_node(); hovered_node && element.is_inclusive_ancestor_of(*hovered_node))
+        return true;
+    if (auto const* focused_element = document.focused_element(); focused_element && element.is_inclusive_ancestor_of(*focused_element))
+        return true;
+    return false;
+}
+
+static bool have_same_attributes(DOM::Element const& a, DOM::Element const& b)
+{
+    if (a.attribute_list_size() != b.attribute_list_size())
+        return false;
+    for (size_t i = 0; i < a.attributes()->length(); ++i) {
+        auto const* attribute = a.attributes()->item(i);
+        auto const* other_attribute = b.attributes()->get_attribute(attribute->name());
+        if (!other_attribute || other_attribute->value() != attribute->value())
+            return false;
+    }
+    return true;
+}
+
+// NOTE: Form controls can match :checked, :disabled and :enabled based on state that isn't reflected in their attributes.
+static bool has_state_not_reflected_in_attributes(DOM::Element const& element)
+{
+    return is<HTML::HTMLButtonElement>(element) || is<HTML::HTMLInputElement>(element) || is<HTML::HTMLSelectElement>(element)
+        || is<HTML::HTMLTextAreaElement>(element) || is<HTML::HTMLOptGroupElement>(element) || is<HTML::HTMLOptionElement>(element)
+        || is<HTML::HTMLFieldSetElement>(element);
+}
+
+// Whether children of `parent` may share style with children of `uncle`, a previous sibling of `parent`.
+// Having the same computed style is not enough, since that may be stale: elements are only restyled when a change
+// affects their own style, so a parent whose attributes changed can keep the style it shared with its siblings while
+// rules like `.x > span` now apply to its children. The ancestors above them are shared, so comparing the two
+// elements themselves covers everything child rules can depend on, except for sibling-sensitive selectors,
+// which the caller has to rule out.
+static bool are_equivalent_parents_for_style_sharing(DOM::Element const& parent, DOM::Element const& uncle)
+{
+    return uncle.computed_css_values() == parent.computed_css_values()
+        && uncle.local_name() == parent.local_name()
+        && uncle.namespace_() == parent.namespace_()
+        && have_same_attributes(uncle, parent)
+        && !has_state_not_reflected_in_attributes(uncle)
+        && !is_in_interactive_state(uncle)
+        && !is_in_interactive_state(parent);
+}
+
+bool StyleComputer::can_share_style_with(DOM::Element const& element, DOM::Element const& candidate) const
+{
+    auto const* candidate_style = candidate.computed_css_values();
+    if (!candidate_style || candidate.needs_style_update())
+        return false;
+
+    // NOTE: For cousins, find_shared_style() has already checked that the parents are equivalent beyond their style.
+    auto const* candidate_parent = candidate.parent_element();
+    if (!candidate_parent || candidate_parent->computed_css_values() != element.parent_element()->computed_css_values()) {
+        reject_style_sharing(StyleSharingRejection::ParentStyleMismatch);
+        return false;
+    }
+
+    if (candidate.local_name() != element.local_name()
+        || candidate.namespace_() != element.namespace_()
+        || !have_same_attributes(candidate, element)) {
+        reject_style_sharing(StyleSharingRejection::ElementMismatch);
+        return false;
+    }
+
+    if (is_in_interactive_state(candidate)) {
+        reject_style_sharing(StyleSharingRejection::ElementInInteractiveState);
+        return false;
+    }
+
+    for (auto const* selector : m_rule_cache->sibling_sensitive_selectors) {
+        if (SelectorEngine::matches(*selector, element) != SelectorEngine::matches(*selector, candidate)) {
+            reject_style_sharing(StyleSharingRejection::SiblingSensitiveRuleMismatch);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Returns the computed style of a previous sibling or cousin that provably ends up with the same style as `element`.
+RefPtr<StyleProperties> StyleComputer::find_shared_style(DOM::Element& element) const
+{
+    static constexpr size_t max_candidates_to_check = 8;
+
+    auto const* parent = element.parent_element();
+    if (!parent || !parent->computed_css_values() || element.shadow_root() || has_state_not_reflected_in_attributes(element)) {
+        reject_style_sharing(StyleSharingRejection::ElementNotShareable);
+        ++m_style_sharing_statistics.misses;
+        return nullptr;
+    }
+
+    if (is_in_interactive_state(element)) {
+        reject_style_sharing(StyleSharingRejection::ElementInInteractiveState);
+        ++m_style_sharing_statistics.misses;
+        return nullptr;
+    }
+
+    size_t candidates_checked = 0;
+    auto try_candidate = [&](DOM::Element const& candidate) -> RefPtr<StyleProperties> {
+        ++candidates_checked;
+        if (!can_share_style_with(element, candidate))
+            return nullptr;
+        ++m_style_sharing_statistics.hits;
+        element.set_custom_properties(candidate.custom_properties());
+        return const_cast<StyleProperties*>(candidate.computed_css_values());
+    };
+
+    for (auto const* sibling = element.previous_element_sibling(); sibling && candidates_checked < max_candidates_to_check; sibling = sibling->previous_element_sibling()) {
+        if (auto style = try_candidate(*sibling))
+            return style;
+    }
+
+    if (!m_rule_cache->has_sibling_sensitive_ancestor_selectors) {
+        for (auto const* uncle = parent->previous_element_sibling(); uncle && candidates_checked < max_candidates_to_check; uncle = uncle->previous_element_sibling()) {
+            if (!are_equivalent_parents_for_style_sharing(*parent, *uncle))
+                continue;
+            for (auto const* cousin = uncle->last_child_of_type<DOM::Element>(); cousin && candidates_checked < max_candidates_to_check; cousin = cousin->previous_element_sibling()) {
+                if (auto style = try_candidate(*cousin))
+                    return style;
+            }
+        }
+    }
+
+    ++m_style_sharing_statistics.misses;
+    return nullptr;
+}
+
 NonnullRefPtr<StyleProperties> StyleComputer::compute_style(DOM::Element& element, Optional<CSS::Selector::PseudoElement> pseudo_element) const
 {
+    ScopedTraceEvent trace_event("StyleComputer::compute_style"sv, "style"sv);
+
     build_rule_cache_if_needed();
 
+    if (!pseudo_element.has_value()) {
+        if (auto shared_style = find_shared_style(element))
+            return shared_style.release_nonnull();
+    }
+
     auto style = StyleProperties::create();
     // 1. Perform the cascade. This produces the "specified style"
     compute_cascaded_values(style, element, pseudo_element);
@@ -1276,6 +1433,122 @@ void StyleComputer::build_rule_cache_if_needed() const
     const_cast<StyleComputer&>(*this).build_rule_cache();
 }
 
+static void collect_invalidation_scopes(Selector const& selector, StyleInvalidationScope subject_scope, auto& rule_cache)
+{
+    auto scope = subject_scope;
+    auto const& compound_selectors = selector.compound_selectors();
+    for (ssize_t compound_index = compound_selectors.size() - 1; compound_index >= 0; --compound_index) {
+        auto const& compound_selector = compound_selectors[compound_index];
+        for (auto const& simple_selector : compound_selector.simple_selectors) {
+            switch (simple_selector.type) {
+            case Selector::SimpleSelector::Type::Id:
+                rule_cache.id_invalidation_scopes.ensure(simple_selector.name()) |= scope;
+                break;
+            case Selector::SimpleSelector::Type::Class:
+                rule_cache.class_name_invalidation_scopes.ensure(simple_selector.name()) |= scope;
+                break;
+            case Selector::SimpleSelector::Type::Attribute:
+                rule_cache.attribute_invalidation_scopes.ensure(simple_selector.attribute().name.to_lowercase()) |= scope;
+                break;
+            case Selector::SimpleSelector::Type::PseudoClass: {
+                auto const& pseudo_class = simple_selector.pseudo_class();
+                // NOTE: The "of S" list of :nth-child() and :nth-last-child() is matched against the element's siblings too.
+                auto argument_scope = scope;
+                if (pseudo_class.type == Selector::SimpleSelector::PseudoClass::Type::NthChild || pseudo_class.type == Selector::SimpleSelector::PseudoClass::Type::NthLastChild)
+                    argument_scope |= StyleInvalidationScope::Siblings;
+                for (auto const& argument_selector : pseudo_class.argument_selector_list)
+                    collect_invalidation_scopes(argument_selector, argument_scope, rule_cache);
+                break;
+            }
+            default:
+                break;
+            }
+        }
+
+        // The compound selector to the left matches an ancestor or a sibling of the elements matched so far.
+        scope &= ~StyleInvalidationScope::Self;
+        switch (compound_selector.combinator) {
+        case Selector::Combinator::None:
+            break;
+        case Selector::Combinator::ImmediateChild:
+        case Selector::Combinator::Descendant:
+            scope |= StyleInvalidationScope::Descendants;
+            break;
+        case Selector::Combinator::NextSibling:
+        case Selector::Combinator::SubsequentSibling:
+            scope |= StyleInvalidationScope::Siblings;
+            break;
+        case Selector::Combinator::Column:
+            scope |= StyleInvalidationScope::Descendants | StyleInvalidationScope::Siblings;
+            break;
+        }
+    }
+}
+
+static bool is_sibling_sensitive_pseudo_class(Selector::SimpleSelector::PseudoClass::Type type)
+{
+    switch (type) {
+    case Selector::SimpleSelector::PseudoClass::Type::FirstChild:
+    case Selector::SimpleSelector::PseudoClass::Type::LastChild:
+    case Selector::SimpleSelector::PseudoClass::Type::OnlyChild:
+    case Selector::SimpleSelector::PseudoClass::Type::Empty:
+    case Selector::SimpleSelector::PseudoClass::Type::FirstOfType:
+    case Selector::SimpleSelector::PseudoClass::Type::LastOfType:
+    case Selector::SimpleSelector::PseudoClass::Type::OnlyOfType:
+    case Selector::SimpleSelector::PseudoClass::Type::NthChild:
+    case Selector::SimpleSelector::PseudoClass::Type::NthLastChild:
+    case Selector::SimpleSelector::PseudoClass::Type::NthOfType:
+    case Selector::SimpleSelector::PseudoClass::Type::NthLastOfType:
+        return true;
+    default:
+        return false;
+    }
+}
+
+struct SiblingSensitivity {
+    bool subject { false };
+    bool ancestors { false };
+};
+
+static void collect_sibling_sensitivity(Selector const& selector, bool starts_in_ancestor_position, SiblingSensitivity& sensitivity)
+{
+    bool in_ancestor_position = starts_in_ancestor_position;
+    auto note_sensitivity = [&] {
+        if (in_ancestor_position)
+            sensitivity.ancestors = true;
+        else
+            sensitivity.subject = true;
+    };
+
+    auto const& compound_selectors = selector.compound_selectors();
+    for (ssize_t compound_index = compound_selectors.size() - 1; compound_index >= 0; --compound_index) {
+        auto const& compound_selector = compound_selectors[compound_index];
+        for (auto const& simple_selector : compound_selector.simple_selectors) {
+            if (simple_selector.type != Selector::SimpleSelector::Type::PseudoClass)
+                continue;
+            auto const& pseudo_class = simple_selector.pseudo_class();
+            if (is_sibling_sensitive_pseudo_class(pseudo_class.type))
+                note_sensitivity();
+            for (auto const& argument_selector : pseudo_class.argument_selector_list)
+                collect_sibling_sensitivity(argument_selector, in_ancestor_position, sensitivity);
+        }
+
+        switch (compound_selector.combinator) {
+        case Selector::Combinator::ImmediateChild:
+        case Selector::Combinator::Descendant:
+            in_ancestor_position = true;
+            break;
+        case Selector::Combinator::NextSibling:
+        case Selector::Combinator::SubsequentSibling:
+        case Selector::Combinator::Column:
+            note_sensitivity();
+            break;
+        case Selector::Combinator::None:
+            break;
+        }
+    }
+}
+
 void StyleComputer::build_rule_cache()
 {
     // FIXME: Make a rule cache for UA style as well.
@@ -1337,6 +1610,23 @@ void StyleComputer::build_rule_cache()
         ++style_sheet_index;
     });
 
+    for (auto cascade_origin : { CascadeOrigin::UserAgent, CascadeOrigin::Author }) {
+        for_each_stylesheet(cascade_origin, [&](auto& sheet) {
+            sheet.for_each_effective_style_rule([&](auto const& rule) {
+                for (auto const& selector : rule.selectors()) {
+                    collect_invalidation_scopes(selector, StyleInvalidationScope::Self, *m_rule_cache);
+
+                    SiblingSensitivity sensitivity;
+                    collect_sibling_sensitivity(selector, false, sensitivity);
+                    if (sensitivity.subject)
+                        m_rule_cache->sibling_sensitive_selectors.append(&selector);
+                    if (sensitivity.ancestors)
+                        m_rule_cache->has_sibling_sensitive_ancestor_selectors = true;
+                }
+            });
+        });
+    }
+
     if constexpr (LIBWEB_CSS_DEBUG) {
         dbgln("Built rule cache!");
         dbgln("           ID: {}", num_id_rules);
@@ -1353,6 +1643,72 @@ void StyleComputer::invalidate_rule_cache()
     m_rule_cache = nullptr;
 }
 
+StyleInvalidationScope StyleComputer::invalidation_scope_for_class_name(FlyString const& class_name) const
+{
+    build_rule_cache_if_needed();
+    return m_rule_cache->class_name_invalidation_scopes.get(class_name).value_or(StyleInvalidationScope::None);
+}
+
+StyleInvalidationScope StyleComputer::invalidation_scope_for_id(FlyString const& id) const
+{
+    build_rule_cache_if_needed();
+    return m_rule_cache->id_invalidation_scopes.get(id).value_or(StyleInvalidationScope::None);
+}
+
+StyleInvalidationScope StyleComputer::invalidation_scope_for_attribute(FlyString const& attribute_name) const
+{
+    build_rule_cache_if_needed();
+    return m_rule_cache->attribute_invalidation_scopes.get(attribute_name.to_lowercase()).value_or(StyleInvalidationScope::None);
+}
+
+template<typename Callback>
+static void for_each_ancestor_filter_hash(DOM::Element const& element, Callback callback)
+{
+    callback(Selector::tag_name_hash(element.local_name()));
+    if (auto id = element.get_attribute(HTML::AttributeNames::id); !id.is_null())
+        callback(Selector::id_hash(id));
+    for (auto const& class_name : element.class_names())
+        callback(Selector::class_hash(class_name));
+}
+
+void StyleComputer::push_ancestor(DOM::Element const& element)
+{
+    size_t hash_count = 0;
+    for_each_ancestor_filter_hash(element, [&](u32 hash) {
+        m_ancestor_filter.increment(hash);
+        m_ancestor_hashes.append(hash);
+        ++hash_count;
+    });
+    m_ancestor_stack.append({ &element, hash_count });
+}
+
+void StyleComputer::pop_ancestor(DOM::Element const& element)
+{
+    auto ancestor = m_ancestor_stack.take_last();
+    VERIFY(ancestor.element == &element);
+
+    // NOTE: We remove the hashes we added, rather than recomputing them, in case the element's classes or id have changed since.
+    for (size_t i = 0; i < ancestor.hash_count; ++i)
+        m_ancestor_filter.decrement(m_ancestor_hashes.take_last());
+}
+
+// The filter describes the ancestors of an element only while the style update walk is inside its parent.
+bool StyleComputer::can_use_ancestor_filter_for(DOM::Element const& element) const
+{
+    return !m_ancestor_stack.is_empty() && m_ancestor_stack.last().element == element.parent();
+}
+
+bool StyleComputer::should_reject_with_ancestor_filter(Selector const& selector) const
+{
+    for (auto hash : selector.ancestor_hashes()) {
+        if (hash == 0)
+            break;
+        if (!m_ancestor_filter.may_contain(hash))
+            return true;
+    }
+    return false;
+}
+
 Gfx::IntRect StyleComputer::viewport_rect() const
 {
     if (auto const* browsing_context = document().browsing_context())
@@ -7,6 +7,9 @@
 
 #pragma once
 
+#include <AK/Array.h>
+#include <AK/CountingBloomFilter.h>
+#include <AK/EnumBits.h>
 #include <AK/HashMap.h>
 #include <AK/NonnullRefPtrVector.h>
 #include <AK/Optional.h>
@@ -29,6 +32,30 @@ struct MatchingRule {
     u32 specificity { 0 };
 };
 
+// Which elements may match different rules after a class, id or attribute changes on an element.
+enum class StyleInvalidationScope : u8 {
+    None = 0,
+    Self = 1 << 0,
+    Descendants = 1 << 1,
+    Siblings = 1 << 2, // All siblings, and their descendants.
+};
+AK_ENUM_BITWISE_OPERATORS(StyleInvalidationScope);
+
+enum class StyleSharingRejection : u8 {
+    ElementNotShareable,
+    ElementInInteractiveState,
+    ParentStyleMismatch,
+    ElementMismatch,
+    SiblingSensitiveRuleMismatch,
+    __Count,
+};
+
+struct StyleSharingStatistics {
+    size_t hits { 0 };
+    size_t misses { 0 };
+    Array<size_t, to_underlying(StyleSharingRejection::__Count)> rejections {};
+};
+
 class PropertyDependencyNode : public RefCounted<PropertyDependencyNode> {
 public:
     static NonnullRefPtr<PropertyDependencyNode> create(String name)
@@ -71,6 +98,17 @@ public:
 
     void invalidate_rule_cache();
 
+    StyleInvalidationScope invalidation_scope_for_class_name(FlyString const&) const;
+    StyleInvalidationScope invalidation_scope_for_id(FlyString const&) const;
+    StyleInvalidationScope invalidation_scope_for_attribute(FlyString const&) const;
+
+    // While walking the DOM to update style, the walker pushes each element before visiting its children,
+    // so selectors whose required ancestors can't be present get rejected without walking up the tree.
+    void push_ancestor(DOM::Element const&);
+    void pop_ancestor(DOM::Element const&);
+
+    StyleSharingStatistics const& style_sharing_statistics() const { return m_style_sharing_statistics; }
+
     Gfx::Font const& initial_font() const;
 
     void did_load_font(FlyString const& family_name);
@@ -105,6 +143,13 @@ private:
     void build_rule_cache();
     void build_rule_cache_if_needed() const;
 
+    RefPtr<StyleProperties> find_shared_style(DOM::Element&) const;
+    bool can_share_style_with(DOM::Element const&, DOM::Element const& candidate) const;
+    void reject_style_sharing(StyleSharingRejection) const;
+
+    bool can_use_ancestor_filter_for(DOM::Element const&) const;
+    bool should_reject_with_ancestor_filter(Selector const&) const;
+
     DOM::Document& m_document;
 
     struct RuleCache {
@@ -113,9 +158,30 @@ private:
         HashMap<FlyString, Vector<MatchingRule>> rules_by_tag_name;
         HashMap<Selector::PseudoElement, Vector<MatchingRule>> rules_by_pseudo_element;
         Vector<MatchingRule> other_rules;
+
+        // Where each class, id and attribute name appears in the selectors of all style sheets (including UA style).
+        HashMap<FlyString, StyleInvalidationScope> class_name_invalidation_scopes;
+        HashMap<FlyString, StyleInvalidationScope> id_invalidation_scopes;
+        HashMap<FlyString, StyleInvalidationScope> attribute_invalidation_scopes;
+
+        // Selectors whose match depends on an element's position among its siblings (or on its children, for :empty).
+        // Elements may only share style if they agree on all of these.
+        Vector<Selector const*> sibling_sensitive_selectors;
+        // Whether any selector depends on the sibling position of an ancestor, which rules out sharing style between cousins.
+        bool has_sibling_sensitive_ancestor_selectors { false };
     };
     OwnPtr<RuleCache> m_rule_cache;
 
+    struct Ancestor {
+        DOM::Element const* element { nullptr };
+        size_t hash_count { 0 };
+    };
+    CountingBloomFilter<u8, 14> m_ancestor_filter;
+    Vector<Ancestor> m_ancestor_stack;
+    Vector<u32> m_ancestor_hashes;
+
+    mutable StyleSharingStatistics m_style_sharing_statistics;
+
     class FontLoader;
     HashMap<String, NonnullOwnPtr<FontLoader>> m_loaded_fonts;
 };
@@ -71,6 +71,7 @@
 #include <LibWeb/UIEvents/EventNames.h>
 #include <LibWeb/UIEvents/FocusEvent.h>
 #include <LibWeb/UIEvents/KeyboardEvent.h>
+#include <LibWeb/TraceEvents.h>
 #include <LibWeb/UIEvents/MouseEvent.h>
 #include <LibWeb/WebIDL/DOMException.h>
 #include <LibWeb/WebIDL/ExceptionOr.h>
@@ -671,6 +672,8 @@ void Document::set_title(String const& title)
 
 void Document::tear_down_layout_tree()
 {
+    m_previous_layout_state = nullptr;
+
     if (!m_layout_root)
         return;
 
@@ -771,6 +774,15 @@ AK::URL Document::parse_url(String const& url) const
 }
 
 void Document::set_needs_layout()
+{
+    m_previous_layout_state = nullptr;
+    if (m_needs_layout)
+        return;
+    m_needs_layout = true;
+    schedule_layout_update();
+}
+
+void Document::did_mark_layout_node_as_needing_layout(Badge<Layout::Node>)
 {
     if (m_needs_layout)
         return;
@@ -792,6 +804,8 @@ void Document::invalidate_layout()
 
 void Document::update_layout()
 {
+    ScopedTraceEvent trace_event("Document::update_layout"sv, "layout"sv);
+
     // NOTE: If our parent document needs a relayout, we must do that *first*.
     //       This is necessary as the parent layout may cause our viewport to change.
     if (browsing_context() && browsing_context()->container())
@@ -813,14 +827,15 @@ void Document::update_layout()
         m_layout_root = static_ptr_cast<Layout::InitialContainingBlock>(tree_builder.build(*this));
     }
 
-    Layout::LayoutState layout_state;
-    layout_state.used_values_per_layout_node.resize(layout_node_count());
+    auto layout_state = make<Layout::LayoutState>();
+    layout_state->used_values_per_layout_node.resize(layout_node_count());
+    layout_state->previous_layout = m_previous_layout_state.ptr();
 
     {
-        Layout::BlockFormattingContext root_formatting_context(layout_state, *m_layout_root, nullptr);
+        Layout::BlockFormattingContext root_formatting_context(*layout_state, *m_layout_root, nullptr);
 
         auto& icb = static_cast<Layout::InitialContainingBlock&>(*m_layout_root);
-        auto& icb_state = layout_state.get_mutable(icb);
+        auto& icb_state = layout_state->get_mutable(icb);
         icb_state.set_content_width(viewport_rect.width());
         icb_state.set_content_height(viewport_rect.height());
 
@@ -832,7 +847,10 @@ void Document::update_layout()
                 Layout::AvailableSize::make_definite(viewport_rect.height())));
     }
 
-    layout_state.commit();
+    layout_state->commit();
+    layout_state->previous_layout = nullptr;
+    m_previous_layout_state = move(layout_state);
+    m_layout_root->clear_needs_layout();
 
     browsing_context()->set_needs_display();
 
@@ -862,11 +880,16 @@ void Document::update_layout()
                     needs_relayout |= update_style_recursively(*shadow_root);
             }
         }
+        auto* element = is<Element>(node) ? static_cast<Element*>(&node) : nullptr;
+        if (element)
+            node.document().style_computer().push_ancestor(*element);
         node.for_each_child([&](auto& child) {
             if (needs_full_style_update || child.needs_style_update() || child.child_needs_style_update())
                 needs_relayout |= update_style_recursively(child);
             return IterationDecision::Continue;
         });
+        if (element)
+            node.document().style_computer().pop_ancestor(*element);
     }
 
     node.set_child_needs_style_update(false);
@@ -91,6 +91,7 @@ public:
     JS::GCPtr<Selection::Selection> get_selection();
 
     size_t next_layout_node_serial_id(Badge<Layout::Node>) { return m_next_layout_node_serial_id++; }
+    void did_mark_layout_node_as_needing_layout(Badge<Layout::Node>);
     size_t layout_node_count() const { return m_next_layout_node_serial_id; }
 
     String cookie(Cookie::Source = Cookie::Source::NonHttp);
@@ -99,9 +100,6 @@ public:
     String referrer() const;
     void set_referrer(String);
 
-    bool should_invalidate_styles_on_attribute_changes() const { return m_should_invalidate_styles_on_attribute_changes; }
-    void set_should_invalidate_styles_on_attribute_changes(bool b) { m_should_invalidate_styles_on_attribute_changes = b; }
-
     void set_url(const AK::URL& url) { m_url = url; }
     AK::URL url() const { return m_url; }
     AK::URL fallback_base_url() const;
@@ -469,6 +467,10 @@ private:
 
     RefPtr<Layout::InitialContainingBlock> m_layout_root;
 
+    // The state of the last layout, which is reused for boxes with no layout nodes inside that need layout.
+    // NOTE: This is dropped whenever something needs layout without saying which layout node is affected.
+    OwnPtr<Layout::LayoutState> m_previous_layout_state;
+
     Optional<Color> m_link_color;
     Optional<Color> m_active_link_color;
     Optional<Color> m_visited_link_color;
@@ -513,8 +515,6 @@ private:
     JS::GCPtr<DOMImplementation> m_implementation;
     JS::GCPtr<HTML::HTMLScriptElement> m_current_script;
 
-    bool m_should_invalidate_styles_on_attribute_changes { true };
-
     u32 m_ignore_destructive_writes_counter { 0 };
 
     // https://html.spec.whatwg.org/multipage/browsing-the-web.html#unload-counter
@@ -105,6 +105,7 @@ WebIDL::ExceptionOr<void> Element::set_attribute(FlyString const& name, String c
 
     // 3. Let attribute be the first attribute in this’s attribute list whose qualified name is qualifiedName, and null otherwise.
     auto* attribute = m_attributes->get_attribute(name);
+    auto old_value = attribute ? attribute->value() : String {};
 
     // 4. If attribute is null, create an attribute whose local name is qualifiedName, value is value, and node document is this’s node document, then append this attribute to this, and then return.
     if (!attribute) {
@@ -119,10 +120,10 @@ WebIDL::ExceptionOr<void> Element::set_attribute(FlyString const& name, String c
         attribute->set_value(value);
     }
 
+    auto old_classes = m_classes;
     parse_attribute(attribute->local_name(), value);
 
-    // FIXME: Invalidate less.
-    document().invalidate_style();
+    invalidate_style_after_attribute_change(attribute->local_name(), old_value, old_classes);
 
     return {};
 }
@@ -185,12 +186,14 @@ WebIDL::ExceptionOr<void> Element::set_attribute_ns(FlyString const& namespace_,
 // https://dom.spec.whatwg.org/#dom-element-removeattribute
 void Element::remove_attribute(FlyString const& name)
 {
+    auto old_value = get_attribute(name);
+    auto old_classes = m_classes;
+
     m_attributes->remove_attribute(name);
 
     did_remove_attribute(name);
 
-    // FIXME: Invalidate less.
-    document().invalidate_style();
+    invalidate_style_after_attribute_change(name, old_value, old_classes);
 }
 
 // https://dom.spec.whatwg.org/#dom-element-hasattribute
@@ -221,10 +224,10 @@ WebIDL::ExceptionOr<bool> Element::toggle_attribute(FlyString const& name, Optio
             auto new_attribute = Attr::create(document(), insert_as_lowercase ? name.to_lowercase() : name, "");
             m_attributes->append_attribute(new_attribute);
 
+            auto old_classes = m_classes;
             parse_attribute(new_attribute->local_name(), "");
 
-            // FIXME: Invalidate less.
-            document().invalidate_style();
+            invalidate_style_after_attribute_change(new_attribute->local_name(), {}, old_classes);
 
             return true;
         }
@@ -235,18 +238,73 @@ WebIDL::ExceptionOr<bool> Element::toggle_attribute(FlyString const& name, Optio
 
     // 5. Otherwise, if force is not given or is false, remove an attribute given qualifiedName and this, and then return false.
     if (!force.has_value() || !force.value()) {
+        auto old_value = attribute->value();
+        auto old_classes = m_classes;
+
         m_attributes->remove_attribute(name);
 
         did_remove_attribute(name);
 
-        // FIXME: Invalidate less.
-        document().invalidate_style();
+        invalidate_style_after_attribute_change(name, old_value, old_classes);
     }
 
     // 6. Return true.
     return true;
 }
 
+// Marks only the elements whose matched rules may differ after the attribute `name` changed from `old_value`,
+// based on where the class, id and attribute names involved appear in the document's selectors.
+void Element::invalidate_style_after_attribute_change(FlyString const& name, String const& old_value, Vector<FlyString> const& old_classes)
+{
+    // NOTE: Elements that aren't in a document get their style computed when they are inserted.
+    if (!is_connected())
+        return;
+
+    auto const& style_computer = document().style_computer();
+    auto scope = style_computer.invalidation_scope_for_attribute(name);
+
+    if (name == HTML::AttributeNames::class_) {
+        for (auto const& class_name : old_classes) {
+            if (!m_classes.contains_slow(class_name))
+                scope |= style_computer.invalidation_scope_for_class_name(class_name);
+        }
+        for (auto const& class_name : m_classes) {
+            if (!old_classes.contains_slow(class_name))
+                scope |= style_computer.invalidation_scope_for_class_name(class_name);
+        }
+    } else if (name == HTML::AttributeNames::id) {
+        auto new_value = get_attribute(name);
+        if (old_value != new_value) {
+            if (!old_value.is_empty())
+                scope |= style_computer.invalidation_scope_for_id(old_value);
+            if (!new_value.is_empty())
+                scope |= style_computer.invalidation_scope_for_id(new_value);
+        }
+    } else {
+        // NOTE: Any other attribute may feed presentational hints, the style attribute or pseudo-classes like :checked and :link.
+        scope |= CSS::StyleInvalidationScope::Self;
+        // FIXME: :lang() and :disabled also match descendants based on these attributes, so be conservative.
+        if (name == HTML::AttributeNames::lang || name == HTML::AttributeNames::disabled)
+            scope |= CSS::StyleInvalidationScope::Descendants;
+    }
+
+    if (has_flag(scope, CSS::StyleInvalidationScope::Self))
+        set_needs_style_update(true);
+
+    if (has_flag(scope, CSS::StyleInvalidationScope::Descendants)) {
+        for_each_child([](auto& child) { child.invalidate_style(); });
+        if (m_shadow_root)
+            m_shadow_root->invalidate_style();
+    }
+
+    if (has_flag(scope, CSS::StyleInvalidationScope::Siblings) && parent()) {
+        parent()->for_each_child([this](auto& sibling) {
+            if (&sibling != this)
+                sibling.invalidate_style();
+        });
+    }
+}
+
 // https://dom.spec.whatwg.org/#dom-element-getattributenames
 Vector<String> Element::get_attribute_names() const
 {
@@ -407,6 +465,13 @@ Element::NeedsRelayout Element::recompute_style()
 
     m_computed_css_values = move(new_computed_css_values);
 
+    // NOTE: Inherited values may have changed, so the children have to be restyled as well.
+    if (!document().needs_full_style_update()) {
+        for_each_child_of_type<Element>([](auto& child) { child.set_needs_style_update(true); });
+        if (m_shadow_root)
+            m_shadow_root->for_each_child_of_type<Element>([](auto& child) { child.set_needs_style_update(true); });
+    }
+
     if (required_invalidation == RequiredInvalidation::RepaintOnly && layout_node()) {
         layout_node()->apply_style(*m_computed_css_values);
         layout_node()->set_needs_display();
@@ -16,6 +16,7 @@
 #include <LibWeb/CSS/CSSStyleSheet.h>
 #include <LibWeb/CSS/CSSSupportsRule.h>
 #include <LibWeb/CSS/PropertyID.h>
+#include <LibWeb/CSS/StyleComputer.h>
 #include <LibWeb/DOM/Comment.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
@@ -671,4 +672,31 @@ void dump_sheet(StringBuilder& builder, CSS::StyleSheet const& sheet)
     }
 }
 
+void dump_style_sharing_statistics(CSS::StyleComputer const& style_computer)
+{
+    StringBuilder builder;
+    dump_style_sharing_statistics(builder, style_computer);
+    dbgln("{}", builder.string_view());
+}
+
+void dump_style_sharing_statistics(StringBuilder& builder, CSS::StyleComputer const& style_computer)
+{
+    auto const& statistics = style_computer.style_sharing_statistics();
+    auto total = statistics.hits + statistics.misses;
+
+    builder.appendff("Style sharing: {} hit(s), {} miss(es)", statistics.hits, statistics.misses);
+    if (total != 0)
+        builder.appendff(" ({}% shared)", statistics.hits * 100 / total);
+    builder.append('\n');
+
+    auto dump_rejection = [&](StringView reason, CSS::StyleSharingRejection rejection) {
+        builder.appendff("  Rejected, {}: {}\n", reason, statistics.rejections[to_underlying(rejection)]);
+    };
+    dump_rejection("element not shareable"sv, CSS::StyleSharingRejection::ElementNotShareable);
+    dump_rejection("element in interactive state"sv, CSS::StyleSharingRejection::ElementInInteractiveState);
+    dump_rejection("parent style mismatch"sv, CSS::StyleSharingRejection::ParentStyleMismatch);
+    dump_rejection("element mismatch"sv, CSS::StyleSharingRejection::ElementMismatch);
+    dump_rejection("sibling-sensitive rule mismatch"sv, CSS::StyleSharingRejection::SiblingSensitiveRuleMismatch);
+}
+
 }
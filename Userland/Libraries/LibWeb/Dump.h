@@ -27,5 +27,7 @@ void dump_style_rule(StringBuilder&, CSS::CSSStyleRule const&, int indent_levels
 void dump_supports_rule(StringBuilder&, CSS::CSSSupportsRule const&, int indent_levels = 0);
 void dump_selector(StringBuilder&, CSS::Selector const&);
 void dump_selector(CSS::Selector const&);
+void dump_style_sharing_statistics(StringBuilder&, CSS::StyleComputer const&);
+void dump_style_sharing_statistics(CSS::StyleComputer const&);
 
 }
@@ -348,12 +348,15 @@ namespace Web::Painting {
 enum class PaintPhase;
 class ButtonPaintable;
 class CheckBoxPaintable;
+class DisplayList;
 class LabelablePaintable;
 class Paintable;
 class PaintableBox;
 class PaintableWithLines;
+class RecordingPainter;
 class StackingContext;
 class TextPaintable;
+class TileCache;
 struct BorderRadiusData;
 struct BorderRadiiData;
 struct LinearGradientData;
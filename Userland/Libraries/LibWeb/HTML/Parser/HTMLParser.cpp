@@ -7,6 +7,7 @@
 
 #include <AK/Debug.h>
 #include <AK/SourceLocation.h>
+#include <AK/TemporaryChange.h>
 #include <AK/Utf32View.h>
 #include <LibTextCodec/Decoder.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
@@ -31,7 +32,9 @@
 #include <LibWeb/HighResolutionTime/TimeOrigin.h>
 #include <LibWeb/Infra/CharacterTypes.h>
 #include <LibWeb/Namespace.h>
+#include <LibWeb/Platform/Timer.h>
 #include <LibWeb/SVG/TagNames.h>
+#include <LibWeb/TraceEvents.h>
 
 namespace Web::HTML {
 
@@ -98,6 +101,9 @@ static Vector<FlyString> s_quirks_public_ids = {
     "-//WebTechs//DTD Mozilla HTML//"
 };
 
+// How long the parser may work on streamed input before it gives the event loop a chance to run.
+static constexpr i64 streamed_input_slice_duration_ms = 100;
+
 // https://html.spec.whatwg.org/multipage/parsing.html#mathml-text-integration-point
 static bool is_mathml_text_integration_point(DOM::Element const&)
 {
@@ -128,7 +134,6 @@ HTMLParser::HTMLParser(DOM::Document& document, StringView input, String const&
 {
     m_tokenizer.set_parser({}, *this);
     m_document->set_parser({}, *this);
-    m_document->set_should_invalidate_styles_on_attribute_changes(false);
     auto standardized_encoding = TextCodec::get_standardized_encoding(encoding);
     VERIFY(standardized_encoding.has_value());
     m_document->set_encoding(standardized_encoding.value());
@@ -142,13 +147,12 @@ HTMLParser::HTMLParser(DOM::Document& document)
     m_tokenizer.set_parser({}, *this);
 }
 
-HTMLParser::~HTMLParser()
-{
-    m_document->set_should_invalidate_styles_on_attribute_changes(true);
-}
+HTMLParser::~HTMLParser() = default;
 
 void HTMLParser::run()
 {
+    ScopedTraceEvent trace_event("HTMLParser::run"sv, "parse"sv);
+
     for (;;) {
         // FIXME: Find a better way to say that we come from Document::close() and want to process EOF.
         if (!m_tokenizer.is_eof_inserted() && m_tokenizer.is_insertion_point_reached())
@@ -189,6 +193,12 @@ void HTMLParser::run()
             dbgln_if(HTML_PARSER_DEBUG, "Stop parsing{}! :^)", m_parsing_fragment ? " fragment" : "");
             break;
         }
+
+        // Streamed input is parsed in slices, so that the document can be laid out and painted while it's loading.
+        if (m_is_parsing_streamed_input && m_script_nesting_level == 0 && m_streamed_input_slice_timer.elapsed() >= streamed_input_slice_duration_ms) {
+            m_should_yield_streamed_input_slice = true;
+            break;
+        }
     }
 
     flush_character_insertions();
@@ -203,6 +213,108 @@ void HTMLParser::run(const AK::URL& url)
     m_document->detach_parser({});
 }
 
+// Returns how many bytes at the end of the input belong to a character that's only complete with the next chunk.
+static size_t length_of_incomplete_character_at_end(ReadonlyBytes input, StringView encoding)
+{
+    if (encoding == "UTF-8"sv) {
+        for (size_t length = 1; length <= min<size_t>(3, input.size()); ++length) {
+            u8 byte = input[input.size() - length];
+            if ((byte & 0xC0) == 0x80)
+                continue;
+            size_t sequence_length = 1;
+            if ((byte & 0xE0) == 0xC0)
+                sequence_length = 2;
+            else if ((byte & 0xF0) == 0xE0)
+                sequence_length = 3;
+            else if ((byte & 0xF8) == 0xF0)
+                sequence_length = 4;
+            return sequence_length > length ? length : 0;
+        }
+        return 0;
+    }
+    if (encoding.is_one_of("UTF-16BE"sv, "UTF-16LE"sv))
+        return input.size() % 2;
+    return 0;
+}
+
+void HTMLParser::append_streamed_input(ReadonlyBytes input)
+{
+    VERIFY(m_streamed_input_decoder);
+    if (m_aborted || m_stop_parsing)
+        return;
+
+    auto buffer = ByteBuffer::copy(m_undecoded_streamed_input).release_value_but_fixme_should_propagate_errors();
+    buffer.append(input);
+    auto incomplete_length = length_of_incomplete_character_at_end(buffer, m_streamed_input_encoding);
+    m_undecoded_streamed_input = ByteBuffer::copy(buffer.bytes().slice(buffer.size() - incomplete_length)).release_value_but_fixme_should_propagate_errors();
+    StringView complete_input { buffer.bytes().slice(0, buffer.size() - incomplete_length) };
+
+    // NOTE: Only the very beginning of the input may contain a BOM, which to_utf8() strips.
+    if (!m_has_decoded_streamed_input) {
+        m_tokenizer.append_input(m_streamed_input_decoder->to_utf8(complete_input));
+        m_has_decoded_streamed_input = !complete_input.is_empty();
+    } else if (m_streamed_input_encoding == "UTF-8"sv) {
+        m_tokenizer.append_input(complete_input);
+    } else {
+        StringBuilder builder { complete_input.length() };
+        m_streamed_input_decoder->process(complete_input, [&](u32 code_point) { builder.append_code_point(code_point); });
+        m_tokenizer.append_input(builder.string_view());
+    }
+
+    parse_streamed_input();
+}
+
+void HTMLParser::finish_streamed_input(Function<void()> on_complete)
+{
+    VERIFY(m_streamed_input_decoder);
+    if (m_aborted)
+        return;
+
+    // Whatever is left of an incomplete character is decoded as-is, which will likely turn it into a replacement character.
+    if (!m_undecoded_streamed_input.is_empty()) {
+        m_tokenizer.append_input(m_streamed_input_decoder->to_utf8(m_undecoded_streamed_input));
+        m_undecoded_streamed_input.clear();
+    }
+
+    m_on_streamed_input_parsed = move(on_complete);
+    m_tokenizer.insert_eof();
+    parse_streamed_input();
+}
+
+void HTMLParser::parse_streamed_input()
+{
+    // NOTE: If we're already parsing, e.g. further up the stack while waiting for a script to load,
+    //       that will pick up the new input as soon as it continues.
+    if (m_is_parsing_streamed_input || m_aborted || m_stop_parsing)
+        return;
+
+    NonnullRefPtr protector = *this;
+    {
+        TemporaryChange change(m_is_parsing_streamed_input, true);
+        m_should_yield_streamed_input_slice = false;
+        m_streamed_input_slice_timer.start();
+        run();
+    }
+
+    if (m_aborted)
+        return;
+
+    if (m_stop_parsing) {
+        m_document->set_source(m_tokenizer.source());
+        the_end();
+        m_document->detach_parser({});
+        if (m_on_streamed_input_parsed)
+            m_on_streamed_input_parsed();
+        return;
+    }
+
+    if (m_should_yield_streamed_input_slice) {
+        if (!m_streamed_input_timer)
+            m_streamed_input_timer = Platform::Timer::create_single_shot(0, [this] { parse_streamed_input(); });
+        m_streamed_input_timer->start();
+    }
+}
+
 // https://html.spec.whatwg.org/multipage/parsing.html#the-end
 void HTMLParser::the_end()
 {
@@ -2214,6 +2326,19 @@ void HTMLParser::decrement_script_nesting_level()
     --m_script_nesting_level;
 }
 
+void HTMLParser::run_preload_scanner()
+{
+    // NOTE: Unless more input has arrived or been inserted by a script since the last scan, everything after the current position has been scanned already.
+    auto input_length = m_tokenizer.source().length();
+    if (m_preload_scanner && input_length == m_preload_scanned_input_length)
+        return;
+    m_preload_scanned_input_length = input_length;
+
+    if (!m_preload_scanner)
+        m_preload_scanner = make<HTMLPreloadScanner>(*m_document);
+    m_preload_scanner->scan(m_tokenizer.unconsumed_input());
+}
+
 // https://html.spec.whatwg.org/multipage/parsing.html#parsing-main-incdata
 void HTMLParser::handle_text(HTMLToken& token)
 {
@@ -2268,6 +2393,8 @@ void HTMLParser::handle_text(HTMLToken& token)
                 // that is blocking scripts and the script's "ready to be parser-executed"
                 // flag is set.
                 if (m_document->has_a_style_sheet_that_is_blocking_scripts() || !script->is_ready_to_be_parser_executed()) {
+                    // NOTE: While we wait, start loading the resources further down in the document.
+                    run_preload_scanner();
                     main_thread_event_loop().spin_until([&] {
                         return !m_document->has_a_style_sheet_that_is_blocking_scripts() && script->is_ready_to_be_parser_executed();
                     });
@@ -3440,6 +3567,17 @@ NonnullRefPtr<HTMLParser> HTMLParser::create_with_uncertain_encoding(DOM::Docume
     return adopt_ref(*new HTMLParser(document, input, encoding));
 }
 
+NonnullRefPtr<HTMLParser> HTMLParser::create_for_streamed_input(DOM::Document& document, ByteBuffer const& first_chunk)
+{
+    auto encoding = document.has_encoding() ? document.encoding().value() : run_encoding_sniffing_algorithm(document, first_chunk);
+    dbgln_if(HTML_PARSER_DEBUG, "Parsing streamed input with encoding '{}'", encoding);
+    auto parser = adopt_ref(*new HTMLParser(document, {}, encoding));
+    parser->m_tokenizer.set_input_is_streamed();
+    parser->m_streamed_input_decoder = TextCodec::decoder_for(encoding);
+    parser->m_streamed_input_encoding = document.encoding().value();
+    return parser;
+}
+
 NonnullRefPtr<HTMLParser> HTMLParser::create(DOM::Document& document, StringView input, String const& encoding)
 {
     return adopt_ref(*new HTMLParser(document, input, encoding));
@@ -6,11 +6,17 @@
 
 #pragma once
 
+#include <LibCore/ElapsedTimer.h>
 #include <LibWeb/DOM/Node.h>
+#include <LibWeb/HTML/Parser/HTMLPreloadScanner.h>
 #include <LibWeb/HTML/Parser/HTMLTokenizer.h>
 #include <LibWeb/HTML/Parser/ListOfActiveFormattingElements.h>
 #include <LibWeb/HTML/Parser/StackOfOpenElements.h>
 
+namespace TextCodec {
+class Decoder;
+}
+
 namespace Web::HTML {
 
 #define ENUMERATE_INSERTION_MODES               \
@@ -51,6 +57,13 @@ public:
     void run();
     void run(const AK::URL&);
 
+    // A parser for a document that's still loading. The encoding is determined from the first chunk of the input,
+    // and the input (including that first chunk) is then fed to the parser as it arrives.
+    static NonnullRefPtr<HTMLParser> create_for_streamed_input(DOM::Document&, ByteBuffer const& first_chunk);
+    void append_streamed_input(ReadonlyBytes);
+    // Parses whatever input is left and runs "the end". on_complete is called once that's done.
+    void finish_streamed_input(Function<void()> on_complete);
+
     DOM::Document& document();
 
     static Vector<JS::Handle<DOM::Node>> parse_html_fragment(DOM::Element& context_element, StringView);
@@ -139,6 +152,8 @@ private:
     void parse_generic_raw_text_element(HTMLToken&);
     void increment_script_nesting_level();
     void decrement_script_nesting_level();
+    void run_preload_scanner();
+    void parse_streamed_input();
     void reset_the_insertion_mode_appropriately();
 
     void adjust_mathml_attributes(HTMLToken&);
@@ -166,6 +181,20 @@ private:
 
     HTMLTokenizer m_tokenizer;
 
+    OwnPtr<HTMLPreloadScanner> m_preload_scanner;
+    size_t m_preload_scanned_input_length { 0 };
+
+    TextCodec::Decoder* m_streamed_input_decoder { nullptr };
+    String m_streamed_input_encoding;
+    bool m_has_decoded_streamed_input { false };
+    // The end of the last chunk, if it stopped in the middle of a character.
+    ByteBuffer m_undecoded_streamed_input;
+    bool m_is_parsing_streamed_input { false };
+    bool m_should_yield_streamed_input_slice { false };
+    Core::ElapsedTimer m_streamed_input_slice_timer;
+    RefPtr<Platform::Timer> m_streamed_input_timer;
+    Function<void()> m_on_streamed_input_parsed;
+
     bool m_foster_parenting { false };
     bool m_frameset_ok { true };
     bool m_parsing_fragment { false };
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/HTML/AttributeNames.h>
+#include <LibWeb/HTML/HTMLBaseElement.h>
+#include <LibWeb/HTML/Parser/HTMLPreloadScanner.h>
+#include <LibWeb/HTML/Parser/HTMLToken.h>
+#include <LibWeb/HTML/Parser/HTMLTokenizer.h>
+#include <LibWeb/HTML/TagNames.h>
+#include <LibWeb/Infra/CharacterTypes.h>
+#include <LibWeb/Infra/Strings.h>
+#include <LibWeb/Loader/LoadRequest.h>
+#include <LibWeb/Loader/ResourceLoader.h>
+#include <LibWeb/MimeSniff/MimeType.h>
+
+namespace Web::HTML {
+
+HTMLPreloadScanner::HTMLPreloadScanner(DOM::Document& document)
+    : m_document(document)
+    , m_base_url(document.base_url())
+    , m_found_base_url(document.first_base_element_with_href_in_tree_order())
+{
+}
+
+void HTMLPreloadScanner::scan(StringView input)
+{
+    HTMLTokenizer tokenizer { input, "utf-8" };
+
+    for (;;) {
+        auto token = tokenizer.next_token();
+        if (!token.has_value() || token->is_end_of_file())
+            break;
+        if (!token->is_start_tag())
+            continue;
+
+        handle_start_tag(*token);
+
+        // NOTE: There's no tree builder to switch the tokenizer state for us, so we do it here for the elements
+        //       whose contents would otherwise be mistaken for markup.
+        auto const& tag_name = token->tag_name();
+        if (tag_name == HTML::TagNames::script)
+            tokenizer.switch_to(HTMLTokenizer::State::ScriptData);
+        else if (tag_name.is_one_of(HTML::TagNames::style, HTML::TagNames::xmp, HTML::TagNames::iframe, HTML::TagNames::noembed, HTML::TagNames::noframes))
+            tokenizer.switch_to(HTMLTokenizer::State::RAWTEXT);
+        else if (tag_name.is_one_of(HTML::TagNames::textarea, HTML::TagNames::title))
+            tokenizer.switch_to(HTMLTokenizer::State::RCDATA);
+        else if (tag_name == HTML::TagNames::plaintext)
+            break;
+    }
+}
+
+void HTMLPreloadScanner::handle_start_tag(HTMLToken& token)
+{
+    auto const& tag_name = token.tag_name();
+
+    if (tag_name == HTML::TagNames::base) {
+        // Only the first base element with an href attribute counts, see Document::base_url().
+        auto href = token.attribute(HTML::AttributeNames::href);
+        if (!m_found_base_url && !href.is_null()) {
+            m_base_url = m_document.fallback_base_url().complete_url(href);
+            m_found_base_url = true;
+        }
+        return;
+    }
+
+    if (tag_name == HTML::TagNames::script) {
+        auto src = token.attribute(HTML::AttributeNames::src);
+        if (src.is_empty() || token.has_attribute(HTML::AttributeNames::nomodule))
+            return;
+        // NOTE: Module scripts are fetched through a different path, so only classic scripts are worth preloading.
+        //       This follows the script type detection in HTMLScriptElement::prepare_script().
+        auto type = token.attribute(HTML::AttributeNames::type);
+        auto language = token.attribute(HTML::AttributeNames::language);
+        if (!type.is_empty() && !MimeSniff::is_javascript_mime_type_essence_match(String(type).trim(Infra::ASCII_WHITESPACE)))
+            return;
+        if (type.is_null() && !language.is_empty() && !MimeSniff::is_javascript_mime_type_essence_match(String::formatted("text/{}", language)))
+            return;
+        preload(Resource::Type::Generic, src);
+        return;
+    }
+
+    if (tag_name == HTML::TagNames::link) {
+        auto href = token.attribute(HTML::AttributeNames::href);
+        if (href.is_empty())
+            return;
+
+        // This follows the link type parsing in HTMLLinkElement::parse_attribute().
+        bool is_stylesheet = false;
+        bool is_alternate = false;
+        bool is_preload = false;
+        auto rel = String(token.attribute(HTML::AttributeNames::rel)).to_lowercase();
+        for (auto part : rel.split_view(Infra::is_ascii_whitespace)) {
+            if (part == "stylesheet"sv)
+                is_stylesheet = true;
+            else if (part == "alternate"sv)
+                is_alternate = true;
+            else if (part == "preload"sv)
+                is_preload = true;
+        }
+
+        if (is_stylesheet && !is_alternate)
+            preload(Resource::Type::Generic, href);
+        // NOTE: HTMLLinkElement loads preloads without any page-specific headers, so we have to match that for the cache to hit.
+        if (is_preload)
+            preload(Resource::Type::Generic, href, false);
+        return;
+    }
+
+    if (tag_name == HTML::TagNames::img) {
+        auto src = token.attribute(HTML::AttributeNames::src);
+        if (!src.is_empty())
+            preload(Resource::Type::Image, src);
+        return;
+    }
+}
+
+void HTMLPreloadScanner::preload(Resource::Type type, StringView url_string, bool for_page)
+{
+    auto url = m_base_url.complete_url(url_string);
+    if (!url.is_valid())
+        return;
+
+    // NOTE: file: URLs aren't cached by ResourceLoader, so loading them early would just mean loading them twice.
+    //       data: URLs are cached, but they have nothing to fetch, so there's nothing to gain from loading them early.
+    if (url.scheme() == "file"sv || url.scheme() == "data"sv)
+        return;
+
+    if (m_preloaded_urls.set(String::formatted("{}:{}", to_underlying(type), url)) != AK::HashSetResult::InsertedNewEntry)
+        return;
+
+    dbgln_if(HTML_PARSER_DEBUG, "HTMLPreloadScanner: Preloading {}", url);
+
+    LoadRequest request;
+    if (for_page) {
+        request = LoadRequest::create_for_url_on_page(url, m_document.page());
+    } else {
+        request.set_url(url);
+    }
+    (void)ResourceLoader::the().load_resource(type, request);
+}
+
+}
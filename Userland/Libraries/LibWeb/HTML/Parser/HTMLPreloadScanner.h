@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashTable.h>
+#include <AK/String.h>
+#include <AK/URL.h>
+#include <LibWeb/Forward.h>
+#include <LibWeb/Loader/Resource.h>
+
+namespace Web::HTML {
+
+class HTMLToken;
+
+// A lightweight stand-in for the "speculative HTML parser". While the real parser is blocked on a script,
+// it tokenizes ahead over the rest of the input and starts loading the scripts, style sheets and images it finds.
+// The resources end up in the ResourceLoader cache, where the elements created by the real parser pick them up.
+// https://html.spec.whatwg.org/multipage/parsing.html#speculative-html-parsing
+class HTMLPreloadScanner {
+public:
+    explicit HTMLPreloadScanner(DOM::Document&);
+
+    void scan(StringView input);
+
+private:
+    void handle_start_tag(HTMLToken&);
+    void preload(Resource::Type, StringView url, bool for_page = true);
+
+    DOM::Document& m_document;
+    AK::URL m_base_url;
+    bool m_found_base_url { false };
+
+    HashTable<String> m_preloaded_urls;
+};
+
+}
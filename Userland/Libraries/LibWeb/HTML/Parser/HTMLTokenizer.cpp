@@ -185,8 +185,11 @@ static inline void log_parse_error(SourceLocation const& location = SourceLocati
 
 Optional<u32> HTMLTokenizer::next_code_point()
 {
-    if (m_utf8_iterator == m_utf8_view.end())
+    if (m_utf8_iterator == m_utf8_view.end()) {
+        if (is_waiting_for_more_input())
+            m_ran_out_of_input = true;
         return {};
+    }
 
     u32 code_point;
     // https://html.spec.whatwg.org/multipage/parsing.html#preprocessing-the-input-stream:tokenization
@@ -232,8 +235,11 @@ Optional<u32> HTMLTokenizer::peek_code_point(size_t offset) const
     auto it = m_utf8_iterator;
     for (size_t i = 0; i < offset && it != m_utf8_view.end(); ++i)
         ++it;
-    if (it == m_utf8_view.end())
+    if (it == m_utf8_view.end()) {
+        if (is_waiting_for_more_input())
+            m_ran_out_of_input = true;
         return {};
+    }
     return *it;
 }
 
@@ -247,6 +253,51 @@ HTMLToken::Position HTMLTokenizer::nth_last_position(size_t n)
 }
 
 Optional<HTMLToken> HTMLTokenizer::next_token()
+{
+    if (!is_waiting_for_more_input())
+        return consume_next_token();
+
+    // Since we don't know what the rest of the input looks like, a token that runs into the end of the input that's
+    // available so far could turn out differently once more input arrives. In that case, we rewind to where the token
+    // started and try again with more input. Everything else in the tokenizer is either derived from the state saved
+    // here, or overwritten before it's used again.
+    auto state = m_state;
+    auto return_state = m_return_state;
+    auto temporary_buffer = m_temporary_buffer;
+    auto current_builder_contents = m_current_builder.is_empty() ? Optional<String> {} : m_current_builder.to_string();
+    auto utf8_iterator = m_utf8_iterator;
+    auto prev_utf8_iterator = m_prev_utf8_iterator;
+    auto last_emitted_start_tag_name = m_last_emitted_start_tag_name;
+    auto character_reference_code = m_character_reference_code;
+    auto source_position = m_source_positions.is_empty() ? Optional<HTMLToken::Position> {} : m_source_positions.last();
+    bool had_queued_tokens = !m_queued_tokens.is_empty();
+
+    m_ran_out_of_input = false;
+    auto token = consume_next_token();
+    if (!m_ran_out_of_input)
+        return token;
+
+    VERIFY(!had_queued_tokens);
+    dbgln_if(TOKENIZER_TRACE_DEBUG, "(Tokenizer) Ran out of input in state {}, waiting for more", state_name(m_state));
+    m_state = state;
+    m_return_state = return_state;
+    m_temporary_buffer = move(temporary_buffer);
+    m_current_builder.clear();
+    if (current_builder_contents.has_value())
+        m_current_builder.append(*current_builder_contents);
+    m_utf8_iterator = utf8_iterator;
+    m_prev_utf8_iterator = prev_utf8_iterator;
+    m_last_emitted_start_tag_name = move(last_emitted_start_tag_name);
+    m_character_reference_code = character_reference_code;
+    m_has_emitted_eof = false;
+    m_queued_tokens.clear();
+    m_source_positions.clear_with_capacity();
+    if (source_position.has_value())
+        m_source_positions.append(*source_position);
+    return {};
+}
+
+Optional<HTMLToken> HTMLTokenizer::consume_next_token()
 {
     if (!m_source_positions.is_empty()) {
         auto last_position = m_source_positions.last();
@@ -1640,6 +1691,10 @@ _StartOfFunction:
             {
                 size_t byte_offset = m_utf8_view.byte_offset_of(m_prev_utf8_iterator);
 
+                // The longest match could still be cut off by the end of the available input.
+                if (is_waiting_for_more_input() && m_decoded_input.length() - byte_offset < longest_entity_length)
+                    m_ran_out_of_input = true;
+
                 auto match = HTML::code_points_from_entity(m_decoded_input.substring_view(byte_offset, m_decoded_input.length() - byte_offset));
 
                 if (match.has_value()) {
@@ -2824,6 +2879,23 @@ void HTMLTokenizer::insert_input_at_insertion_point(String const& input)
     m_insertion_point.position += input.length();
 }
 
+void HTMLTokenizer::append_input(StringView input)
+{
+    VERIFY(m_input_is_streamed && !m_explicit_eof_inserted);
+
+    auto utf8_iterator_byte_offset = m_utf8_view.byte_offset_of(m_utf8_iterator);
+    auto prev_utf8_iterator_byte_offset = m_utf8_view.byte_offset_of(m_prev_utf8_iterator);
+
+    StringBuilder builder { m_decoded_input.length() + input.length() };
+    builder.append(m_decoded_input);
+    builder.append(input);
+    m_decoded_input = builder.build();
+
+    m_utf8_view = Utf8View(m_decoded_input);
+    m_utf8_iterator = m_utf8_view.iterator_at_byte_offset(utf8_iterator_byte_offset);
+    m_prev_utf8_iterator = m_utf8_view.iterator_at_byte_offset(prev_utf8_iterator_byte_offset);
+}
+
 void HTMLTokenizer::insert_eof()
 {
     m_explicit_eof_inserted = true;
@@ -124,6 +124,13 @@ public:
     bool is_blocked() const { return m_blocked; }
 
     String source() const { return m_decoded_input; }
+    // The part of the input that hasn't been consumed yet.
+    StringView unconsumed_input() const { return m_decoded_input.substring_view(m_utf8_view.iterator_offset(m_utf8_iterator)); }
+
+    // Network parsers receive their input in chunks. Until insert_eof() is called, running out of input then makes
+    // next_token() return nothing instead of an end-of-file token, and tokenizing resumes once more input is appended.
+    void set_input_is_streamed() { m_input_is_streamed = true; }
+    void append_input(StringView input);
 
     void insert_input_at_insertion_point(String const& input);
     void insert_eof();
@@ -147,6 +154,9 @@ public:
     void abort() { m_aborted = true; }
 
 private:
+    Optional<HTMLToken> consume_next_token();
+    bool is_waiting_for_more_input() const { return m_input_is_streamed && !m_explicit_eof_inserted; }
+
     void skip(size_t count);
     Optional<u32> next_code_point();
     Optional<u32> peek_code_point(size_t offset) const;
@@ -204,6 +214,9 @@ private:
     bool m_explicit_eof_inserted { false };
     bool m_has_emitted_eof { false };
 
+    bool m_input_is_streamed { false };
+    mutable bool m_ran_out_of_input { false };
+
     Queue<HTMLToken> m_queued_tokens;
 
     u32 m_character_reference_code { 0 };
@@ -11,6 +11,7 @@
 #include <LibWeb/HTML/Scripting/ClassicScript.h>
 #include <LibWeb/HTML/Scripting/Environments.h>
 #include <LibWeb/HTML/Scripting/ExceptionReporter.h>
+#include <LibWeb/TraceEvents.h>
 #include <LibWeb/WebIDL/DOMException.h>
 
 namespace Web::HTML {
@@ -93,6 +94,7 @@ JS::Completion ClassicScript::run(RethrowErrors rethrow_errors)
         evaluation_status = vm.throw_completion<JS::SyntaxError>(m_error_to_rethrow.value().to_string());
     } else {
         auto timer = Core::ElapsedTimer::start_new();
+        ScopedTraceEvent trace_event("ClassicScript::run"sv, "script"sv, filename());
 
         // 6. Otherwise, set evaluationStatus to ScriptEvaluation(script's record).
         auto interpreter = JS::Interpreter::create_with_existing_realm(m_script_record->realm());
@@ -8,6 +8,7 @@
 #include <LibWeb/HTML/Scripting/Environments.h>
 #include <LibWeb/HTML/Scripting/Fetching.h>
 #include <LibWeb/HTML/Scripting/ModuleScript.h>
+#include <LibWeb/TraceEvents.h>
 #include <LibWeb/WebIDL/DOMException.h>
 
 namespace Web::HTML {
@@ -122,6 +123,7 @@ JS::Promise* JavaScriptModuleScript::run(PreventErrorReporting)
         JS::VM::InterpreterExecutionScope scope(*interpreter);
 
         // 2. Set evaluationPromise to record.Evaluate().
+        ScopedTraceEvent trace_event("JavaScriptModuleScript::run"sv, "script"sv, filename());
         auto elevation_promise_or_error = record->evaluate(vm());
 
         // NOTE: This step will recursively evaluate all of the module's dependencies.
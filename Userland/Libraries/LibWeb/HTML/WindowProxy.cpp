@@ -24,6 +24,7 @@ WindowProxy::WindowProxy(JS::Realm& realm, Window& window)
     : JS::Object(realm, nullptr)
     , m_window(window)
 {
+    set_has_exotic_property_access();
 }
 
 // 7.4.1 [[GetPrototypeOf]] ( ), https://html.spec.whatwg.org/multipage/window-object.html#windowproxy-getprototypeof
@@ -46,6 +46,8 @@ public:
 
     String to_string() const;
 
+    bool operator==(AvailableSize const& other) const { return m_type == other.m_type && m_value == other.m_value; }
+
 private:
     AvailableSize(Type type, float);
 
@@ -65,6 +67,8 @@ public:
     AvailableSize height;
 
     String to_string() const;
+
+    bool operator==(AvailableSpace const& other) const { return width == other.width && height == other.height; }
 };
 
 }
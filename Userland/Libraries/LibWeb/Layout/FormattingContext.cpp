@@ -188,15 +188,109 @@ OwnPtr<FormattingContext> FormattingContext::layout_inside(Box const& child_box,
     if (!child_box.can_have_children())
         return {};
 
+    if (auto cached_formatting_context = reuse_previous_inside_layout_if_possible(child_box, layout_mode, available_space))
+        return cached_formatting_context;
+
     auto independent_formatting_context = create_independent_formatting_context_if_needed(m_state, child_box);
-    if (independent_formatting_context)
-        independent_formatting_context->run(child_box, layout_mode, available_space);
-    else
+    if (!independent_formatting_context) {
         run(child_box, layout_mode, available_space);
+        return {};
+    }
+
+    auto& child_state = m_state.get_mutable(child_box);
+    auto content_width_before_layout = child_state.content_width();
+    Optional<float> definite_content_height_before_layout;
+    if (child_state.has_definite_height())
+        definite_content_height_before_layout = child_state.content_height();
+
+    independent_formatting_context->run(child_box, layout_mode, available_space);
+
+    if (layout_mode == LayoutMode::Normal && !m_state.m_parent) {
+        child_state.inside_layout = LayoutState::UsedValues::InsideLayout {
+            .available_space = available_space,
+            .content_width = content_width_before_layout,
+            .definite_content_height = definite_content_height_before_layout,
+            .content_height_after_layout = child_state.content_height(),
+            .automatic_content_width = independent_formatting_context->automatic_content_width(),
+            .automatic_content_height = independent_formatting_context->automatic_content_height(),
+        };
+    }
 
     return independent_formatting_context;
 }
 
+// If nothing inside `box` needs layout, and it's being laid out with the same width, definite height and available space
+// as in the previous layout, the used values of its whole subtree are copied over from there instead.
+OwnPtr<FormattingContext> FormattingContext::reuse_previous_inside_layout_if_possible(Box const& box, LayoutMode layout_mode, AvailableSpace const& available_space)
+{
+    auto const* previous_layout = m_state.previous_layout;
+    if (layout_mode != LayoutMode::Normal || m_state.m_parent || !previous_layout || box.needs_layout())
+        return {};
+
+    auto const& previous_used_values = previous_layout->used_values_per_layout_node;
+    if (box.serial_id() >= previous_used_values.size() || !previous_used_values[box.serial_id()])
+        return {};
+
+    auto const& previous_box_state = *previous_used_values[box.serial_id()];
+    if (!previous_box_state.inside_layout.has_value())
+        return {};
+
+    auto const& inside_layout = *previous_box_state.inside_layout;
+    auto& box_state = m_state.get_mutable(box);
+    Optional<float> definite_content_height;
+    if (box_state.has_definite_height())
+        definite_content_height = box_state.content_height();
+    if (!(inside_layout.available_space == available_space)
+        || inside_layout.content_width != box_state.content_width()
+        || inside_layout.definite_content_height != definite_content_height) {
+        return {};
+    }
+
+    // NOTE: Absolutely positioned boxes are laid out once their containing block has been fully dimensioned,
+    //       which may depend on more than the inputs compared above.
+    bool has_absolutely_positioned_descendant = false;
+    box.for_each_in_subtree([&](auto const& descendant) {
+        if (descendant.is_absolutely_positioned()) {
+            has_absolutely_positioned_descendant = true;
+            return IterationDecision::Break;
+        }
+        return IterationDecision::Continue;
+    });
+    if (has_absolutely_positioned_descendant)
+        return {};
+
+    box.for_each_in_subtree([&](auto const& descendant) {
+        auto serial_id = descendant.serial_id();
+        if (is<NodeWithStyleAndBoxModelMetrics>(descendant) && serial_id < previous_used_values.size() && previous_used_values[serial_id])
+            m_state.used_values_per_layout_node[serial_id] = adopt_own(*new LayoutState::UsedValues(*previous_used_values[serial_id]));
+        return IterationDecision::Continue;
+    });
+
+    box_state.line_boxes = previous_box_state.line_boxes;
+    for (auto const* floating_box : previous_box_state.floating_descendants())
+        box_state.add_floating_descendant(*floating_box);
+    box_state.set_content_height(inside_layout.content_height_after_layout);
+    box_state.inside_layout = inside_layout;
+
+    // NOTE: This stands in for the independent formatting context that laid out the box last time,
+    //       answering the questions the parent context may still ask about it.
+    struct CachedFormattingContext : public FormattingContext {
+        CachedFormattingContext(LayoutState& state, Box const& box, float automatic_content_width, float automatic_content_height)
+            : FormattingContext(Type::Block, state, box)
+            , m_automatic_content_width(automatic_content_width)
+            , m_automatic_content_height(automatic_content_height)
+        {
+        }
+        virtual float automatic_content_width() const override { return m_automatic_content_width; }
+        virtual float automatic_content_height() const override { return m_automatic_content_height; }
+        virtual void run(Box const&, LayoutMode, AvailableSpace const&) override { }
+
+        float m_automatic_content_width { 0 };
+        float m_automatic_content_height { 0 };
+    };
+    return make<CachedFormattingContext>(m_state, box, inside_layout.automatic_content_width, inside_layout.automatic_content_height);
+}
+
 float FormattingContext::greatest_child_width(Box const& box)
 {
     float max_width = 0;
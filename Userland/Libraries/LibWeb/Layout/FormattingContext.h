@@ -85,6 +85,7 @@ protected:
     float calculate_fit_content_size(float min_content_size, float max_content_size, AvailableSize const&) const;
 
     OwnPtr<FormattingContext> layout_inside(Box const&, LayoutMode, AvailableSpace const&);
+    OwnPtr<FormattingContext> reuse_previous_inside_layout_if_possible(Box const&, LayoutMode, AvailableSpace const&);
     void compute_inset(Box const& box);
 
     struct SpaceUsedByFloats {
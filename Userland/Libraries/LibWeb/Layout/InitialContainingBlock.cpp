@@ -49,8 +49,15 @@ void InitialContainingBlock::build_stacking_context_tree()
 void InitialContainingBlock::paint_all_phases(PaintContext& context)
 {
     build_stacking_context_tree_if_needed();
-    context.painter().fill_rect(enclosing_int_rect(paint_box()->absolute_rect()), document().background_color(context.palette()));
-    context.painter().translate(-context.viewport_rect().location());
+    // NOTE: The scroll offset of the top-level viewport is left for the display list to apply, so it can be replayed at any scroll position.
+    //       For the same reason, the background is filled in document coordinates, over everything the context was asked to paint.
+    if (browsing_context().is_top_level()) {
+        context.painter().apply_scroll_offset(context.viewport_rect().location());
+        context.painter().fill_rect(context.viewport_rect(), document().background_color(context.palette()));
+    } else {
+        context.painter().fill_rect(enclosing_int_rect(paint_box()->absolute_rect()), document().background_color(context.palette()));
+        context.painter().translate(-context.viewport_rect().location());
+    }
     paint_box()->stacking_context()->paint(context);
 }
 
@@ -78,7 +78,7 @@ void LayoutState::commit()
             auto& paint_box = const_cast<Painting::PaintableBox&>(*box.paint_box());
             paint_box.set_offset(used_values.offset);
             paint_box.set_content_size(used_values.content_width(), used_values.content_height());
-            paint_box.set_overflow_data(move(used_values.overflow_data));
+            paint_box.set_overflow_data(used_values.overflow_data);
             paint_box.set_containing_line_box_fragment(used_values.containing_line_box_fragment);
 
             if (is<Layout::BlockContainer>(box)) {
@@ -88,7 +88,8 @@ void LayoutState::commit()
                             text_nodes.set(static_cast<Layout::TextNode*>(const_cast<Layout::Node*>(&fragment.layout_node())));
                     }
                 }
-                static_cast<Painting::PaintableWithLines&>(paint_box).set_line_boxes(move(used_values.line_boxes));
+                // NOTE: The line boxes are copied rather than moved, since the next layout may reuse them.
+                static_cast<Painting::PaintableWithLines&>(paint_box).set_line_boxes(Vector<LineBox> { used_values.line_boxes });
             }
         }
     }
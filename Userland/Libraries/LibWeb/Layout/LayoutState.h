@@ -8,6 +8,7 @@
 
 #include <AK/HashMap.h>
 #include <LibGfx/Point.h>
+#include <LibWeb/Layout/AvailableSpace.h>
 #include <LibWeb/Layout/Box.h>
 #include <LibWeb/Layout/LineBox.h>
 #include <LibWeb/Painting/PaintableBox.h>
@@ -20,9 +21,6 @@ enum class SizeConstraint {
     MaxContent,
 };
 
-class AvailableSize;
-class AvailableSpace;
-
 struct LayoutState {
     LayoutState()
         : m_root(*this)
@@ -124,6 +122,18 @@ struct LayoutState {
 
         Optional<LineBoxFragmentCoordinate> containing_line_box_fragment;
 
+        // The inputs and results of the last Normal layout of this box's insides by an independent formatting context.
+        // If the inputs are the same in the next layout and nothing inside the box needs layout, its subtree can be copied over.
+        struct InsideLayout {
+            AvailableSpace available_space;
+            float content_width { 0 };
+            Optional<float> definite_content_height;
+            float content_height_after_layout { 0 };
+            float automatic_content_width { 0 };
+            float automatic_content_height { 0 };
+        };
+        Optional<InsideLayout> inside_layout;
+
         void add_floating_descendant(Box const& box) { m_floating_descendants.set(&box); }
         auto const& floating_descendants() const { return m_floating_descendants; }
 
@@ -173,6 +183,10 @@ struct LayoutState {
 
     HashMap<NodeWithStyleAndBoxModelMetrics const*, NonnullOwnPtr<IntrinsicSizes>> mutable intrinsic_sizes;
 
+    // The committed state of the previous layout of the same layout tree, if its results can still be trusted
+    // for layout nodes that haven't been marked as needing layout since.
+    LayoutState const* previous_layout { nullptr };
+
     LayoutState const* m_parent { nullptr };
     LayoutState const& m_root;
 };
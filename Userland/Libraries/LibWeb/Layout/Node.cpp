@@ -14,6 +14,7 @@
 #include <LibWeb/Layout/InitialContainingBlock.h>
 #include <LibWeb/Layout/Node.h>
 #include <LibWeb/Layout/TextNode.h>
+#include <LibWeb/Painting/PaintableBox.h>
 #include <LibWeb/Platform/FontPlugin.h>
 #include <typeinfo>
 
@@ -125,8 +126,30 @@ InitialContainingBlock& Node::root()
     return *document().layout_node();
 }
 
+void Node::set_needs_layout()
+{
+    // NOTE: Ancestors of a node that needs layout always need layout as well, so we can stop at the first one that does.
+    for (auto* node = this; node && !node->m_needs_layout; node = node->parent())
+        node->m_needs_layout = true;
+    document().did_mark_layout_node_as_needing_layout({});
+}
+
+void Node::clear_needs_layout()
+{
+    if (!m_needs_layout)
+        return;
+    m_needs_layout = false;
+    for_each_child([](auto& child) { child.clear_needs_layout(); });
+}
+
 void Node::set_needs_display()
 {
+    // NOTE: Boxes don't show up as fragments of their containing block, so invalidate everything they paint directly.
+    if (is<Box>(*this)) {
+        if (auto const* paint_box = static_cast<Box const&>(*this).paint_box())
+            browsing_context().set_needs_display(enclosing_int_rect(paint_box->absolute_paint_rect()));
+    }
+
     auto* containing_block = this->containing_block();
     if (!containing_block)
         return;
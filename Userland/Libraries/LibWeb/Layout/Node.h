@@ -121,6 +121,11 @@ public:
 
     virtual void set_needs_display();
 
+    // A node needs layout if it, or anything inside it, changed in a way that affects layout since the last layout.
+    bool needs_layout() const { return m_needs_layout; }
+    void set_needs_layout();
+    void clear_needs_layout();
+
     bool children_are_inline() const { return m_children_are_inline; }
     void set_children_are_inline(bool value) { m_children_are_inline = value; }
 
@@ -156,6 +161,7 @@ private:
 
     bool m_is_flex_item { false };
     bool m_generated { false };
+    bool m_needs_layout { true };
 };
 
 class NodeWithStyle : public Node {
@@ -232,7 +232,13 @@ bool FrameLoader::load(LoadRequest& request, Type type)
     if (!request.headers().contains("Accept"))
         request.set_header("Accept", "text/html,application/xhtml+xml,application/xml;q=0.9,*/*;q=0.8");
 
-    set_resource(ResourceLoader::the().load_resource(Resource::Type::Generic, request));
+    // A new load stops the parser of a document that's still loading.
+    if (m_streaming_parser)
+        m_streaming_parser->document().abort();
+    m_streaming_parser = nullptr;
+    m_streamed_data_size = 0;
+
+    set_resource(ResourceLoader::the().load_resource(Resource::Type::Generic, request, ResourceLoader::StreamResponse::Yes));
 
     if (type == Type::IFrame)
         return true;
@@ -381,30 +387,91 @@ void FrameLoader::store_response_cookies(AK::URL const& url, String const& cooki
     }
 }
 
+static bool is_redirect(Resource const& resource)
+{
+    // For 3xx (Redirection) responses, the Location value refers to the preferred target resource for automatically redirecting the request.
+    auto status_code = resource.status_code();
+    return status_code.has_value() && *status_code >= 300 && *status_code <= 399 && resource.response_headers().contains("Location");
+}
+
+// HTML documents are parsed while they're still loading, so that they can be displayed before the last byte has arrived.
+void FrameLoader::resource_did_receive_data()
+{
+    auto& data = resource()->encoded_data();
+
+    if (!m_streaming_parser) {
+        if (resource()->mime_type() != "text/html" || is_redirect(*resource()))
+            return;
+
+        // The encoding sniffing algorithm looks at up to 1024 bytes, so we wait for that many before we start parsing.
+        // https://html.spec.whatwg.org/multipage/parsing.html#prescan-a-byte-stream-to-determine-its-encoding
+        if (data.size() < 1024)
+            return;
+
+        auto url = resource()->url();
+        if (auto set_cookie = resource()->response_headers().get("Set-Cookie"); set_cookie.has_value())
+            store_response_cookies(url, *set_cookie);
+        m_redirects_count = 0;
+
+        auto document = create_document_for_resource();
+        m_streaming_parser = HTML::HTMLParser::create_for_streamed_input(*document, data);
+    }
+
+    if (m_streamed_data_size == data.size())
+        return;
+
+    // NOTE: Parsing may spin the event loop, during which more data can arrive and reenter this function.
+    auto chunk = data.bytes().slice(m_streamed_data_size);
+    m_streamed_data_size = data.size();
+    NonnullRefPtr parser = *m_streaming_parser;
+    parser->append_streamed_input(chunk);
+}
+
 void FrameLoader::resource_did_load()
 {
     auto url = resource()->url();
 
+    if (m_streaming_parser) {
+        auto parser = m_streaming_parser.release_nonnull();
+        if (m_streamed_data_size < resource()->encoded_data().size())
+            parser->append_streamed_input(resource()->encoded_data().bytes().slice(m_streamed_data_size));
+        m_streamed_data_size = 0;
+        parser->finish_streamed_input([weak_this = make_weak_ptr<FrameLoader>(), url]() mutable {
+            if (weak_this)
+                weak_this->did_finish_loading_document(url);
+        });
+        return;
+    }
+
     if (auto set_cookie = resource()->response_headers().get("Set-Cookie"); set_cookie.has_value())
         store_response_cookies(url, *set_cookie);
 
-    // For 3xx (Redirection) responses, the Location value refers to the preferred target resource for automatically redirecting the request.
-    auto status_code = resource()->status_code();
-    if (status_code.has_value() && *status_code >= 300 && *status_code <= 399) {
-        auto location = resource()->response_headers().get("Location");
-        if (location.has_value()) {
-            if (m_redirects_count > maximum_redirects_allowed) {
-                m_redirects_count = 0;
-                load_error_page(url, "Too many redirects");
-                return;
-            }
-            m_redirects_count++;
-            load(url.complete_url(location.value()), FrameLoader::Type::Navigation);
+    if (is_redirect(*resource())) {
+        if (m_redirects_count > maximum_redirects_allowed) {
+            m_redirects_count = 0;
+            load_error_page(url, "Too many redirects");
             return;
         }
+        m_redirects_count++;
+        load(url.complete_url(resource()->response_headers().get("Location").value()), FrameLoader::Type::Navigation);
+        return;
     }
     m_redirects_count = 0;
 
+    auto document = create_document_for_resource();
+
+    if (!parse_document(*document, resource()->encoded_data())) {
+        load_error_page(url, "Failed to parse content.");
+        return;
+    }
+
+    did_finish_loading_document(url);
+}
+
+JS::NonnullGCPtr<DOM::Document> FrameLoader::create_document_for_resource()
+{
+    auto url = resource()->url();
+
     if (resource()->has_encoding()) {
         dbgln_if(RESOURCE_DEBUG, "This content has MIME type '{}', encoding '{}'", resource()->mime_type(), resource()->encoding().value());
     } else {
@@ -445,11 +512,11 @@ void FrameLoader::resource_did_load()
     if (auto* page = browsing_context().page())
         page->client().page_did_create_main_document();
 
-    if (!parse_document(*document, resource()->encoded_data())) {
-        load_error_page(url, "Failed to parse content.");
-        return;
-    }
+    return document;
+}
 
+void FrameLoader::did_finish_loading_document(AK::URL const& url)
+{
     if (!url.fragment().is_empty())
         browsing_context().scroll_to_anchor(url.fragment());
     else
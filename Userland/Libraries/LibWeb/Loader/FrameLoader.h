@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/Forward.h>
+#include <LibJS/Heap/GCPtr.h>
 #include <LibWeb/Forward.h>
 #include <LibWeb/Loader/Resource.h>
 
@@ -39,17 +40,24 @@ public:
 
 private:
     // ^ResourceClient
+    virtual void resource_did_receive_data() override;
     virtual void resource_did_load() override;
     virtual void resource_did_fail() override;
 
     void load_error_page(const AK::URL& failed_url, String const& error_message);
     void load_favicon(RefPtr<Gfx::Bitmap> bitmap = nullptr);
     bool parse_document(DOM::Document&, ByteBuffer const& data);
+    JS::NonnullGCPtr<DOM::Document> create_document_for_resource();
+    void did_finish_loading_document(AK::URL const&);
 
     void store_response_cookies(AK::URL const& url, String const& cookies);
 
     HTML::BrowsingContext& m_browsing_context;
     size_t m_redirects_count { 0 };
+
+    // HTML documents are parsed while they're loading, see resource_did_receive_data().
+    RefPtr<HTML::HTMLParser> m_streaming_parser;
+    size_t m_streamed_data_size { 0 };
 };
 
 }
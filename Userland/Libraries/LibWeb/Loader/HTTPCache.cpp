@@ -0,0 +1,428 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <AK/Endian.h>
+#include <AK/GenericShorthands.h>
+#include <AK/Hex.h>
+#include <AK/JsonObject.h>
+#include <AK/LexicalPath.h>
+#include <AK/QuickSort.h>
+#include <AK/Time.h>
+#include <LibCore/DirIterator.h>
+#include <LibCore/Stream.h>
+#include <LibCore/System.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <LibWeb/Loader/HTTPCache.h>
+#include <LibWeb/Loader/LoadRequest.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace Web {
+
+// Bump this when the layout of entry files changes.
+static constexpr u32 entry_file_version = 1;
+static constexpr size_t max_entry_size = 32 * MiB;
+static constexpr size_t max_cache_size = 256 * MiB;
+static constexpr size_t stores_between_prunes = 64;
+
+using ResponseHeaders = HashMap<String, String, CaseInsensitiveStringTraits>;
+
+HTTPCache& HTTPCache::the()
+{
+    static HTTPCache cache;
+    return cache;
+}
+
+static i64 current_time()
+{
+    return time(nullptr);
+}
+
+// https://httpwg.org/specs/rfc9110.html#http.date
+// NOTE: Only IMF-fixdate (e.g. "Sun, 06 Nov 1994 08:49:37 GMT") is supported, since that's the format all senders have to use.
+static Optional<i64> parse_http_date(StringView string)
+{
+    static constexpr Array month_names { "Jan"sv, "Feb"sv, "Mar"sv, "Apr"sv, "May"sv, "Jun"sv, "Jul"sv, "Aug"sv, "Sep"sv, "Oct"sv, "Nov"sv, "Dec"sv };
+
+    auto parts = string.trim_whitespace().split_view(' ');
+    if (parts.size() != 6 || parts[5] != "GMT"sv)
+        return {};
+
+    auto day = parts[1].to_uint();
+    auto year = parts[3].to_uint();
+    Optional<unsigned> month;
+    for (size_t i = 0; i < month_names.size(); ++i) {
+        if (parts[2] == month_names[i])
+            month = i + 1;
+    }
+
+    auto time_parts = parts[4].split_view(':');
+    if (time_parts.size() != 3)
+        return {};
+    auto hour = time_parts[0].to_uint();
+    auto minute = time_parts[1].to_uint();
+    auto second = time_parts[2].to_uint();
+
+    if (!day.has_value() || !month.has_value() || !year.has_value() || !hour.has_value() || !minute.has_value() || !second.has_value())
+        return {};
+    if (*day < 1 || *day > 31 || *year < 1970 || *hour > 23 || *minute > 59 || *second > 60)
+        return {};
+
+    return static_cast<i64>(days_since_epoch(*year, *month, *day)) * 86400 + *hour * 3600 + *minute * 60 + *second;
+}
+
+static Optional<i64> parse_http_date_header(ResponseHeaders const& headers, StringView name)
+{
+    auto value = headers.get(name);
+    if (!value.has_value())
+        return {};
+    return parse_http_date(*value);
+}
+
+// https://httpwg.org/specs/rfc9111.html#field.cache-control
+struct CacheControl {
+    bool no_store { false };
+    bool no_cache { false };
+    Optional<i64> max_age;
+};
+
+static CacheControl parse_cache_control(Optional<String> const& header)
+{
+    CacheControl cache_control;
+    if (!header.has_value())
+        return cache_control;
+
+    for (auto directive : header->split_view(',')) {
+        directive = directive.trim_whitespace();
+        auto name = directive;
+        StringView value;
+        if (auto equals = directive.find('='); equals.has_value()) {
+            name = directive.substring_view(0, *equals).trim_whitespace();
+            value = directive.substring_view(*equals + 1).trim_whitespace().trim("\""sv);
+        }
+
+        if (name.equals_ignoring_case("no-store"sv))
+            cache_control.no_store = true;
+        else if (name.equals_ignoring_case("no-cache"sv))
+            cache_control.no_cache = true;
+        else if (name.equals_ignoring_case("max-age"sv)) {
+            if (auto seconds = value.to_uint<u32>(); seconds.has_value())
+                cache_control.max_age = *seconds;
+        }
+    }
+    return cache_control;
+}
+
+// https://httpwg.org/specs/rfc9111.html#response.cacheability
+static bool is_storable(u32 status_code, ResponseHeaders const& response_headers)
+{
+    // NOTE: These are the cacheable status codes that ResourceLoader doesn't treat as a failure.
+    if (!first_is_one_of(status_code, 200u, 203u, 204u, 300u, 301u, 308u))
+        return false;
+
+    if (parse_cache_control(response_headers.get("Cache-Control"sv)).no_store)
+        return false;
+
+    // NOTE: Replaying these would set the cookies again every time the response is used.
+    if (response_headers.contains("Set-Cookie"sv))
+        return false;
+
+    // We send the same request headers every time, apart from Accept-Encoding which never varies,
+    // so the only responses that can't be reused are the ones that vary on something else.
+    if (auto vary = response_headers.get("Vary"sv); vary.has_value()) {
+        for (auto field : vary->split_view(',')) {
+            if (!field.trim_whitespace().equals_ignoring_case("Accept-Encoding"sv))
+                return false;
+        }
+    }
+
+    // Without any of these, the response would be stale right away and there'd be no way to revalidate it.
+    return response_headers.contains("Cache-Control"sv)
+        || response_headers.contains("Expires"sv)
+        || response_headers.contains("ETag"sv)
+        || response_headers.contains("Last-Modified"sv);
+}
+
+bool HTTPCache::can_use_cache_for(LoadRequest const& request) const
+{
+    if (!is_enabled())
+        return false;
+    if (!request.url().scheme().is_one_of("http"sv, "https"sv))
+        return false;
+    if (!request.method().equals_ignoring_case("GET"sv) || !request.body().is_empty())
+        return false;
+
+    auto const& headers = request.headers();
+    if (parse_cache_control(headers.get("Cache-Control"sv)).no_store)
+        return false;
+
+    // Requests that are already conditional or ask for a part of the resource expect to see the server's own response.
+    return !headers.contains("If-None-Match"sv)
+        && !headers.contains("If-Modified-Since"sv)
+        && !headers.contains("Range"sv);
+}
+
+String HTTPCache::path_for(AK::URL const& url) const
+{
+    ::Crypto::Hash::SHA256 hash;
+    hash.update(url.to_string());
+    auto digest = hash.digest();
+    return LexicalPath::join(m_directory, String::formatted("{}.entry", encode_hex(digest.bytes()))).string();
+}
+
+// Entry files are laid out as:
+//   u32 version, u32 metadata size, metadata (JSON), body
+// All numbers are little endian.
+Optional<HTTPCache::Entry> HTTPCache::read_entry(NonnullRefPtr<Core::MappedFile> file)
+{
+    auto bytes = file->bytes();
+    if (bytes.size() < 2 * sizeof(u32))
+        return {};
+
+    auto read_u32 = [&](size_t offset) {
+        LittleEndian<u32> value;
+        memcpy(&value, bytes.offset(offset), sizeof(value));
+        return static_cast<u32>(value);
+    };
+
+    if (read_u32(0) != entry_file_version)
+        return {};
+    size_t metadata_size = read_u32(sizeof(u32));
+    size_t body_offset = 2 * sizeof(u32) + metadata_size;
+    if (body_offset > bytes.size())
+        return {};
+
+    auto metadata_or_error = JsonValue::from_string(StringView { bytes.slice(2 * sizeof(u32), metadata_size) });
+    if (metadata_or_error.is_error() || !metadata_or_error.value().is_object())
+        return {};
+    auto const& metadata = metadata_or_error.value().as_object();
+    if (!metadata.has_string("url"sv) || !metadata.has_object("headers"sv))
+        return {};
+
+    Entry entry { move(file), body_offset };
+    entry.m_url = metadata.get("url"sv).as_string();
+    entry.m_status_code = metadata.get("status_code"sv).to_u32();
+    entry.m_request_time = metadata.get("request_time"sv).to_i64();
+    entry.m_response_time = metadata.get("response_time"sv).to_i64();
+    metadata.get("headers"sv).as_object().for_each_member([&](auto& name, auto& value) {
+        entry.m_response_headers.set(name, value.as_string_or({}));
+    });
+    return entry;
+}
+
+// https://httpwg.org/specs/rfc9111.html#expiration.model
+bool HTTPCache::is_fresh(Entry const& entry, LoadRequest const& request)
+{
+    auto request_cache_control = parse_cache_control(request.headers().get("Cache-Control"sv));
+    if (request_cache_control.no_cache || request.headers().get("Pragma"sv) == "no-cache"sv)
+        return false;
+
+    auto const& headers = entry.m_response_headers;
+    auto cache_control = parse_cache_control(headers.get("Cache-Control"sv));
+    if (cache_control.no_cache)
+        return false;
+
+    auto date = parse_http_date_header(headers, "Date"sv).value_or(entry.m_response_time);
+
+    // https://httpwg.org/specs/rfc9111.html#calculating.freshness.lifetime
+    i64 freshness_lifetime = 0;
+    if (cache_control.max_age.has_value()) {
+        freshness_lifetime = *cache_control.max_age;
+    } else if (headers.contains("Expires"sv)) {
+        // NOTE: Invalid dates (like "0") mean the response has already expired.
+        if (auto expires = parse_http_date_header(headers, "Expires"sv); expires.has_value())
+            freshness_lifetime = *expires - date;
+    } else if (auto last_modified = parse_http_date_header(headers, "Last-Modified"sv); last_modified.has_value()) {
+        // https://httpwg.org/specs/rfc9111.html#heuristic.freshness
+        // A typical heuristic is 10% of the time since the response was last modified.
+        freshness_lifetime = (date - *last_modified) / 10;
+    }
+
+    // https://httpwg.org/specs/rfc9111.html#age.calculations
+    auto age_value = headers.get("Age"sv).value_or({}).to_uint<u32>().value_or(0);
+    auto apparent_age = max<i64>(0, entry.m_response_time - date);
+    auto response_delay = entry.m_response_time - entry.m_request_time;
+    auto corrected_age_value = static_cast<i64>(age_value) + response_delay;
+    auto corrected_initial_age = max(apparent_age, corrected_age_value);
+    auto resident_time = current_time() - entry.m_response_time;
+    auto current_age = corrected_initial_age + resident_time;
+
+    return freshness_lifetime > current_age;
+}
+
+Optional<HTTPCache::Entry> HTTPCache::lookup(LoadRequest const& request)
+{
+    VERIFY(can_use_cache_for(request));
+
+    auto file_or_error = Core::MappedFile::map(path_for(request.url()));
+    if (file_or_error.is_error()) {
+        ++m_statistics.misses;
+        return {};
+    }
+
+    auto entry = read_entry(file_or_error.release_value());
+    // NOTE: Entries are keyed by a hash of the URL, so make sure this is actually the one we're looking for.
+    if (!entry.has_value() || entry->m_url != request.url()) {
+        ++m_statistics.misses;
+        return {};
+    }
+
+    entry->m_is_fresh = is_fresh(*entry, request);
+    if (entry->m_is_fresh)
+        ++m_statistics.hits;
+    else
+        ++m_statistics.stale_hits;
+    dbgln_if(CACHE_DEBUG, "HTTPCache: Found {} entry for {}", entry->m_is_fresh ? "fresh" : "stale", request.url());
+    return entry;
+}
+
+// https://httpwg.org/specs/rfc9111.html#validation.sent
+void HTTPCache::add_revalidation_headers(Entry const& entry, HashMap<String, String>& request_headers) const
+{
+    if (auto etag = entry.m_response_headers.get("ETag"sv); etag.has_value())
+        request_headers.set("If-None-Match", *etag);
+    if (auto last_modified = entry.m_response_headers.get("Last-Modified"sv); last_modified.has_value())
+        request_headers.set("If-Modified-Since", *last_modified);
+}
+
+ErrorOr<void> HTTPCache::write_entry(AK::URL const& url, i64 request_time, i64 response_time, u32 status_code, ResponseHeaders const& response_headers, ReadonlyBytes body)
+{
+    JsonObject headers;
+    for (auto& it : response_headers)
+        headers.set(it.key, it.value);
+
+    JsonObject metadata;
+    metadata.set("url", url.to_string());
+    metadata.set("status_code", status_code);
+    metadata.set("request_time", request_time);
+    metadata.set("response_time", response_time);
+    metadata.set("headers", move(headers));
+    auto serialized_metadata = metadata.to_string();
+
+    if (auto result = Core::System::mkdir(m_directory, 0700); result.is_error() && result.error().code() != EEXIST)
+        return result.release_error();
+
+    // Write to a temporary file first, so other processes never see a partially written entry.
+    auto path = path_for(url);
+    auto temporary_path = String::formatted("{}.{}.tmp", path, getpid());
+    {
+        auto file = TRY(Core::Stream::File::open(temporary_path, Core::Stream::OpenMode::Write | Core::Stream::OpenMode::Truncate, 0600));
+        LittleEndian<u32> version = entry_file_version;
+        LittleEndian<u32> metadata_size = serialized_metadata.length();
+        if (!file->write_or_error({ &version, sizeof(version) })
+            || !file->write_or_error({ &metadata_size, sizeof(metadata_size) })
+            || !file->write_or_error(serialized_metadata.bytes())
+            || !file->write_or_error(body)) {
+            (void)Core::System::unlink(temporary_path);
+            return AK::Error::from_string_literal("Failed to write cache entry");
+        }
+    }
+    TRY(Core::System::rename(temporary_path, path));
+    return {};
+}
+
+void HTTPCache::store(LoadRequest const& request, i64 request_time, u32 status_code, ResponseHeaders const& response_headers, ReadonlyBytes body)
+{
+    VERIFY(can_use_cache_for(request));
+
+    if (!is_storable(status_code, response_headers) || body.size() > max_entry_size)
+        return;
+
+    if (auto result = write_entry(request.url(), request_time, current_time(), status_code, response_headers, body); result.is_error()) {
+        dbgln("HTTPCache: Failed to store {}: {}", request.url(), result.error());
+        return;
+    }
+
+    dbgln_if(CACHE_DEBUG, "HTTPCache: Stored {} ({} bytes)", request.url(), body.size());
+    ++m_statistics.stores;
+    if (++m_stores_since_last_prune >= stores_between_prunes) {
+        m_stores_since_last_prune = 0;
+        prune_if_needed();
+    }
+}
+
+// https://httpwg.org/specs/rfc9111.html#freshening.responses
+void HTTPCache::did_revalidate(Entry& entry, i64 request_time, ResponseHeaders const& response_headers)
+{
+    ++m_statistics.revalidations;
+
+    // https://httpwg.org/specs/rfc9111.html#update
+    for (auto& it : response_headers) {
+        if (it.key.is_one_of_ignoring_case("Content-Length"sv, "Content-Encoding"sv, "Transfer-Encoding"sv, "Content-Range"sv))
+            continue;
+        entry.m_response_headers.set(it.key, it.value);
+    }
+    entry.m_request_time = request_time;
+    entry.m_response_time = current_time();
+
+    if (auto result = write_entry(entry.m_url, entry.m_request_time, entry.m_response_time, entry.m_status_code, entry.m_response_headers, entry.body()); result.is_error())
+        dbgln("HTTPCache: Failed to update {}: {}", entry.m_url, result.error());
+}
+
+// Deletes the least recently stored entries once the cache grows too large.
+void HTTPCache::prune_if_needed()
+{
+    struct EntryFile {
+        String path;
+        size_t size { 0 };
+        time_t modification_time { 0 };
+    };
+    Vector<EntryFile> entry_files;
+    size_t total_size = 0;
+
+    Core::DirIterator iterator(m_directory, Core::DirIterator::SkipDots);
+    while (iterator.has_next()) {
+        auto path = iterator.next_full_path();
+        if (!path.ends_with(".entry"sv))
+            continue;
+        auto stat_or_error = Core::System::stat(path);
+        if (stat_or_error.is_error())
+            continue;
+        auto size = static_cast<size_t>(stat_or_error.value().st_size);
+        entry_files.append({ move(path), size, stat_or_error.value().st_mtime });
+        total_size += size;
+    }
+
+    if (total_size <= max_cache_size)
+        return;
+
+    quick_sort(entry_files, [](auto& a, auto& b) { return a.modification_time < b.modification_time; });
+    for (auto& entry_file : entry_files) {
+        if (total_size <= max_cache_size * 3 / 4)
+            break;
+        if (Core::System::unlink(entry_file.path).is_error())
+            continue;
+        total_size -= entry_file.size;
+    }
+}
+
+void HTTPCache::clear()
+{
+    if (!is_enabled())
+        return;
+
+    Core::DirIterator iterator(m_directory, Core::DirIterator::SkipDots);
+    while (iterator.has_next()) {
+        auto path = iterator.next_full_path();
+        if (path.ends_with(".entry"sv))
+            (void)Core::System::unlink(path);
+    }
+}
+
+void HTTPCache::dump_statistics() const
+{
+    auto lookups = m_statistics.hits + m_statistics.misses + m_statistics.stale_hits;
+    dbgln("HTTP cache statistics ({}):", is_enabled() ? m_directory.view() : "disabled"sv);
+    dbgln("  Lookups:       {}", lookups);
+    dbgln("  Fresh hits:    {} ({}%)", m_statistics.hits, lookups ? m_statistics.hits * 100 / lookups : 0);
+    dbgln("  Stale hits:    {}, {} of them revalidated", m_statistics.stale_hits, m_statistics.revalidations);
+    dbgln("  Misses:        {}", m_statistics.misses);
+    dbgln("  Stores:        {}", m_statistics.stores);
+}
+
+}
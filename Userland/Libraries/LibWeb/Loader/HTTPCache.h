@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <AK/URL.h>
+#include <LibCore/MappedFile.h>
+#include <LibWeb/Forward.h>
+
+namespace Web {
+
+// A private HTTP cache for GET responses, following https://httpwg.org/specs/rfc9111.html.
+// Entries live in a directory that every WebContent process of a session shares. Each entry is a single file
+// named after a hash of its URL (so the directory itself is the index), holding the response metadata as JSON
+// followed by the body. Entries are replaced atomically, so processes never see each other's partial writes.
+class HTTPCache {
+public:
+    static HTTPCache& the();
+
+    class Entry {
+    public:
+        u32 status_code() const { return m_status_code; }
+        HashMap<String, String, CaseInsensitiveStringTraits> const& response_headers() const { return m_response_headers; }
+        ReadonlyBytes body() const { return m_file->bytes().slice(m_body_offset); }
+
+        // Fresh responses can be used without contacting the server, stale ones have to be revalidated first.
+        bool is_fresh() const { return m_is_fresh; }
+
+    private:
+        friend class HTTPCache;
+
+        Entry(NonnullRefPtr<Core::MappedFile> file, size_t body_offset)
+            : m_file(move(file))
+            , m_body_offset(body_offset)
+        {
+        }
+
+        AK::URL m_url;
+        u32 m_status_code { 0 };
+        HashMap<String, String, CaseInsensitiveStringTraits> m_response_headers;
+        i64 m_request_time { 0 };
+        i64 m_response_time { 0 };
+        NonnullRefPtr<Core::MappedFile> m_file;
+        size_t m_body_offset { 0 };
+        bool m_is_fresh { false };
+    };
+
+    struct Statistics {
+        size_t hits { 0 };
+        size_t misses { 0 };
+        size_t stale_hits { 0 };
+        size_t revalidations { 0 };
+        size_t stores { 0 };
+    };
+
+    bool is_enabled() const { return !m_directory.is_null(); }
+    void set_directory(String directory) { m_directory = move(directory); }
+
+    bool can_use_cache_for(LoadRequest const&) const;
+
+    // Returns the stored response for the request's URL, whether or not it's still fresh.
+    Optional<Entry> lookup(LoadRequest const&);
+    void add_revalidation_headers(Entry const&, HashMap<String, String>& request_headers) const;
+
+    // Called with the time the request was sent, once the response has arrived.
+    void store(LoadRequest const&, i64 request_time, u32 status_code, HashMap<String, String, CaseInsensitiveStringTraits> const& response_headers, ReadonlyBytes body);
+    // Updates a stored response with the headers of a 304 (Not Modified) response to a revalidation request.
+    void did_revalidate(Entry&, i64 request_time, HashMap<String, String, CaseInsensitiveStringTraits> const& response_headers);
+
+    void clear();
+
+    Statistics const& statistics() const { return m_statistics; }
+    void dump_statistics() const;
+
+private:
+    HTTPCache() = default;
+
+    String path_for(AK::URL const&) const;
+    static Optional<Entry> read_entry(NonnullRefPtr<Core::MappedFile>);
+    static bool is_fresh(Entry const&, LoadRequest const&);
+    ErrorOr<void> write_entry(AK::URL const&, i64 request_time, i64 response_time, u32 status_code, HashMap<String, String, CaseInsensitiveStringTraits> const& response_headers, ReadonlyBytes body);
+    void prune_if_needed();
+
+    String m_directory;
+    Statistics m_statistics;
+    size_t m_stores_since_last_prune { 0 };
+};
+
+}
@@ -86,14 +86,36 @@ static bool is_valid_encoding(String const& encoding)
     return TextCodec::decoder_for(encoding);
 }
 
+void Resource::did_receive_data(Badge<ResourceLoader>, ReadonlyBytes chunk, HashMap<String, String, CaseInsensitiveStringTraits> const& headers, Optional<u32> status_code)
+{
+    VERIFY(!m_loaded);
+    if (m_encoded_data.is_empty())
+        did_receive_response(headers, status_code);
+    // FIXME: Handle OOM failure.
+    m_encoded_data.append(chunk);
+
+    for_each_client([](auto& client) {
+        client.resource_did_receive_data();
+    });
+}
+
 void Resource::did_load(Badge<ResourceLoader>, ReadonlyBytes data, HashMap<String, String, CaseInsensitiveStringTraits> const& headers, Optional<u32> status_code)
 {
     VERIFY(!m_loaded);
     // FIXME: Handle OOM failure.
     m_encoded_data = ByteBuffer::copy(data).release_value_but_fixme_should_propagate_errors();
+    m_loaded = true;
+    did_receive_response(headers, status_code);
+
+    for_each_client([](auto& client) {
+        client.resource_did_load();
+    });
+}
+
+void Resource::did_receive_response(HashMap<String, String, CaseInsensitiveStringTraits> const& headers, Optional<u32> status_code)
+{
     m_response_headers = headers;
     m_status_code = move(status_code);
-    m_loaded = true;
 
     auto content_type = headers.get("Content-Type");
 
@@ -125,10 +147,6 @@ void Resource::did_load(Badge<ResourceLoader>, ReadonlyBytes data, HashMap<Strin
             m_encoding = encoding.value();
         }
     }
-
-    for_each_client([](auto& client) {
-        client.resource_did_load();
-    });
 }
 
 void Resource::did_fail(Badge<ResourceLoader>, String const& error, Optional<u32> status_code)
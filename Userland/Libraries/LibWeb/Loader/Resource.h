@@ -60,6 +60,7 @@ public:
 
     void for_each_client(Function<void(ResourceClient&)>);
 
+    void did_receive_data(Badge<ResourceLoader>, ReadonlyBytes chunk, HashMap<String, String, CaseInsensitiveStringTraits> const& headers, Optional<u32> status_code);
     void did_load(Badge<ResourceLoader>, ReadonlyBytes data, HashMap<String, String, CaseInsensitiveStringTraits> const& headers, Optional<u32> status_code);
     void did_fail(Badge<ResourceLoader>, String const& error, Optional<u32> status_code);
 
@@ -68,6 +69,8 @@ protected:
     Resource(Type, Resource&);
 
 private:
+    void did_receive_response(HashMap<String, String, CaseInsensitiveStringTraits> const& headers, Optional<u32> status_code);
+
     LoadRequest m_request;
     ByteBuffer m_encoded_data;
     Type m_type { Type::Generic };
@@ -86,6 +89,8 @@ class ResourceClient : public Weakable<ResourceClient> {
 public:
     virtual ~ResourceClient();
 
+    // Only called for resources that are loaded with ResourceLoader::StreamResponse::Yes, whenever more of encoded_data() has arrived.
+    virtual void resource_did_receive_data() { }
     virtual void resource_did_load() { }
     virtual void resource_did_fail() { }
 
@@ -11,12 +11,14 @@
 #include <LibCore/ElapsedTimer.h>
 #include <LibCore/File.h>
 #include <LibWeb/Loader/ContentFilter.h>
+#include <LibWeb/Loader/HTTPCache.h>
 #include <LibWeb/Loader/LoadRequest.h>
 #include <LibWeb/Loader/ProxyMappings.h>
 #include <LibWeb/Loader/Resource.h>
 #include <LibWeb/Loader/ResourceLoader.h>
 #include <LibWeb/Platform/EventLoopPlugin.h>
 #include <LibWeb/Platform/Timer.h>
+#include <time.h>
 
 #ifdef AK_OS_SERENITY
 #    include <serenity.h>
@@ -82,7 +84,7 @@ void ResourceLoader::preconnect(AK::URL const& url)
 
 static HashMap<LoadRequest, NonnullRefPtr<Resource>> s_resource_cache;
 
-RefPtr<Resource> ResourceLoader::load_resource(Resource::Type type, LoadRequest& request)
+RefPtr<Resource> ResourceLoader::load_resource(Resource::Type type, LoadRequest& request, StreamResponse stream_response)
 {
     if (!request.is_valid())
         return nullptr;
@@ -106,6 +108,13 @@ RefPtr<Resource> ResourceLoader::load_resource(Resource::Type type, LoadRequest&
     if (use_cache)
         s_resource_cache.set(request, resource);
 
+    Function<void(ReadonlyBytes, HashMap<String, String, CaseInsensitiveStringTraits> const&, Optional<u32>)> data_callback;
+    if (stream_response == StreamResponse::Yes) {
+        data_callback = [=](auto chunk, auto& headers, auto status_code) {
+            const_cast<Resource&>(*resource).did_receive_data({}, chunk, headers, status_code);
+        };
+    }
+
     load(
         request,
         [=](auto data, auto& headers, auto status_code) {
@@ -113,11 +122,69 @@ RefPtr<Resource> ResourceLoader::load_resource(Resource::Type type, LoadRequest&
         },
         [=](auto& error, auto status_code) {
             const_cast<Resource&>(*resource).did_fail({}, error, status_code);
-        });
+        },
+        {}, nullptr, move(data_callback));
 
     return resource;
 }
 
+// Collects a response body that's streamed into it, and passes each chunk on as soon as the response headers are known.
+class StreamedResponse final
+    : public Core::Stream::Stream
+    , public RefCounted<StreamedResponse> {
+public:
+    using DataCallback = Function<void(ReadonlyBytes, HashMap<String, String, CaseInsensitiveStringTraits> const&, Optional<u32>)>;
+
+    explicit StreamedResponse(DataCallback data_callback)
+        : m_data_callback(move(data_callback))
+    {
+    }
+
+    ByteBuffer const& body() const { return m_body; }
+    HashMap<String, String, CaseInsensitiveStringTraits> const& response_headers() const { return m_response_headers; }
+    Optional<u32> status_code() const { return m_status_code; }
+
+    void did_receive_headers(HashMap<String, String, CaseInsensitiveStringTraits> const& response_headers, Optional<u32> status_code)
+    {
+        m_response_headers = response_headers;
+        m_status_code = status_code;
+        m_has_received_headers = true;
+
+        // NOTE: The body may start arriving before the headers do.
+        if (!m_body.is_empty())
+            did_receive_data(m_body);
+    }
+
+    // ^Core::Stream::Stream
+    virtual bool is_writable() const override { return true; }
+    virtual ErrorOr<Bytes> read(Bytes) override { return Error::from_errno(EBADF); }
+    virtual ErrorOr<size_t> write(ReadonlyBytes bytes) override
+    {
+        TRY(m_body.try_append(bytes));
+        if (m_has_received_headers)
+            did_receive_data(bytes);
+        return bytes.size();
+    }
+    virtual bool is_eof() const override { return false; }
+    virtual bool is_open() const override { return true; }
+    virtual void close() override { }
+
+private:
+    void did_receive_data(ReadonlyBytes chunk)
+    {
+        // Error responses and revalidated cache entries are only delivered as a whole.
+        if (m_status_code.has_value() && (*m_status_code == 304 || *m_status_code >= 400))
+            return;
+        m_data_callback(chunk, m_response_headers, m_status_code);
+    }
+
+    DataCallback m_data_callback;
+    ByteBuffer m_body;
+    HashMap<String, String, CaseInsensitiveStringTraits> m_response_headers;
+    Optional<u32> m_status_code;
+    bool m_has_received_headers { false };
+};
+
 static String sanitized_url_for_logging(AK::URL const& url)
 {
     if (url.scheme() == "data"sv)
@@ -138,7 +205,7 @@ static void emit_signpost(String const& message, int id)
 
 static size_t resource_id = 0;
 
-void ResourceLoader::load(LoadRequest& request, Function<void(ReadonlyBytes, HashMap<String, String, CaseInsensitiveStringTraits> const& response_headers, Optional<u32> status_code)> success_callback, Function<void(String const&, Optional<u32> status_code)> error_callback, Optional<u32> timeout, Function<void()> timeout_callback)
+void ResourceLoader::load(LoadRequest& request, Function<void(ReadonlyBytes, HashMap<String, String, CaseInsensitiveStringTraits> const& response_headers, Optional<u32> status_code)> success_callback, Function<void(String const&, Optional<u32> status_code)> error_callback, Optional<u32> timeout, Function<void()> timeout_callback, Function<void(ReadonlyBytes chunk, HashMap<String, String, CaseInsensitiveStringTraits> const& response_headers, Optional<u32> status_code)> data_callback)
 {
     auto& url = request.url();
     request.start_timer();
@@ -274,6 +341,22 @@ void ResourceLoader::load(LoadRequest& request, Function<void(ReadonlyBytes, Has
             headers.set(it.key, it.value);
         }
 
+        Optional<HTTPCache::Entry> cached_entry;
+        bool use_http_cache = HTTPCache::the().can_use_cache_for(request);
+        if (use_http_cache) {
+            cached_entry = HTTPCache::the().lookup(request);
+            if (cached_entry.has_value() && cached_entry->is_fresh()) {
+                log_success(request);
+                Platform::EventLoopPlugin::the().deferred_invoke([success_callback = move(success_callback), cached_entry = cached_entry.release_value()] {
+                    success_callback(cached_entry.body(), cached_entry.response_headers(), cached_entry.status_code());
+                });
+                return;
+            }
+            if (cached_entry.has_value())
+                HTTPCache::the().add_revalidation_headers(*cached_entry, headers);
+        }
+        auto request_time = time(nullptr);
+
         auto protocol_request = m_connector->start_request(request.method(), url, headers, request.body(), proxy);
         if (!protocol_request) {
             auto start_request_failure_msg = "Failed to initiate load"sv;
@@ -295,7 +378,7 @@ void ResourceLoader::load(LoadRequest& request, Function<void(ReadonlyBytes, Has
 
         m_active_requests.set(*protocol_request);
 
-        protocol_request->on_buffered_request_finish = [this, success_callback = move(success_callback), error_callback = move(error_callback), log_success, log_failure, request, &protocol_request = *protocol_request](bool success, auto, auto& response_headers, auto status_code, ReadonlyBytes payload) {
+        protocol_request->on_buffered_request_finish = [this, success_callback = move(success_callback), error_callback = move(error_callback), log_success, log_failure, request, use_http_cache, cached_entry = move(cached_entry), request_time, &protocol_request = *protocol_request](bool success, auto, auto& response_headers, auto status_code, ReadonlyBytes payload) mutable {
             --m_pending_loads;
             if (on_load_counter_change)
                 on_load_counter_change();
@@ -311,12 +394,32 @@ void ResourceLoader::load(LoadRequest& request, Function<void(ReadonlyBytes, Has
                 return;
             }
             log_success(request);
-            success_callback(payload, response_headers, status_code);
+            if (cached_entry.has_value() && status_code == 304u) {
+                // The server told us that our stale copy is still good to use.
+                HTTPCache::the().did_revalidate(*cached_entry, request_time, response_headers);
+                success_callback(cached_entry->body(), cached_entry->response_headers(), cached_entry->status_code());
+            } else {
+                if (use_http_cache && status_code.has_value())
+                    HTTPCache::the().store(request, request_time, *status_code, response_headers, payload);
+                success_callback(payload, response_headers, status_code);
+            }
             Platform::EventLoopPlugin::the().deferred_invoke([this, &protocol_request] {
                 m_active_requests.remove(protocol_request);
             });
         };
-        protocol_request->set_should_buffer_all_input(true);
+        if (data_callback) {
+            // NOTE: Connectors that can't stream will still call on_buffered_request_finish with the whole response.
+            auto streamed_response = adopt_ref(*new StreamedResponse(move(data_callback)));
+            protocol_request->on_headers_received = [streamed_response](auto& response_headers, auto status_code) mutable {
+                streamed_response->did_receive_headers(response_headers, status_code);
+            };
+            protocol_request->on_finish = [streamed_response, &protocol_request = *protocol_request](bool success, u32 total_size) {
+                protocol_request.on_buffered_request_finish(success, total_size, streamed_response->response_headers(), streamed_response->status_code(), streamed_response->body());
+            };
+            protocol_request->stream_into(*streamed_response);
+        } else {
+            protocol_request->set_should_buffer_all_input(true);
+        }
         protocol_request->on_certificate_requested = []() -> ResourceLoaderConnectorRequest::CertificateAndKey {
             return {};
         };
@@ -356,6 +459,7 @@ void ResourceLoader::clear_cache()
 {
     dbgln_if(CACHE_DEBUG, "Clearing {} items from ResourceLoader cache", s_resource_cache.size());
     s_resource_cache.clear();
+    HTTPCache::the().clear();
 }
 
 void ResourceLoader::evict_from_cache(LoadRequest const& request)
@@ -63,6 +63,7 @@ public:
     Function<void(bool success, u32 total_size, HashMap<String, String, CaseInsensitiveStringTraits> const& response_headers, Optional<u32> response_code, ReadonlyBytes payload)> on_buffered_request_finish;
     Function<void(bool success, u32 total_size)> on_finish;
     Function<void(Optional<u32> total_size, u32 downloaded_size)> on_progress;
+    Function<void(HashMap<String, String, CaseInsensitiveStringTraits> const& response_headers, Optional<u32> response_code)> on_headers_received;
     Function<CertificateAndKey()> on_certificate_requested;
 
 protected:
@@ -88,9 +89,16 @@ public:
     static void initialize(RefPtr<ResourceLoaderConnector>);
     static ResourceLoader& the();
 
-    RefPtr<Resource> load_resource(Resource::Type, LoadRequest&);
+    enum class StreamResponse {
+        No,
+        Yes,
+    };
+    // With StreamResponse::Yes, the resource's clients are notified about each chunk of the response body as it arrives.
+    RefPtr<Resource> load_resource(Resource::Type, LoadRequest&, StreamResponse = StreamResponse::No);
 
-    void load(LoadRequest&, Function<void(ReadonlyBytes, HashMap<String, String, CaseInsensitiveStringTraits> const& response_headers, Optional<u32> status_code)> success_callback, Function<void(String const&, Optional<u32> status_code)> error_callback = nullptr, Optional<u32> timeout = {}, Function<void()> timeout_callback = nullptr);
+    // If data_callback is set, it's called with each chunk of a successful response body as it arrives (which may not happen at all,
+    // e.g. for responses that come from the cache). success_callback is called with the whole body either way.
+    void load(LoadRequest&, Function<void(ReadonlyBytes, HashMap<String, String, CaseInsensitiveStringTraits> const& response_headers, Optional<u32> status_code)> success_callback, Function<void(String const&, Optional<u32> status_code)> error_callback = nullptr, Optional<u32> timeout = {}, Function<void()> timeout_callback = nullptr, Function<void(ReadonlyBytes chunk, HashMap<String, String, CaseInsensitiveStringTraits> const& response_headers, Optional<u32> status_code)> data_callback = nullptr);
     void load(const AK::URL&, Function<void(ReadonlyBytes, HashMap<String, String, CaseInsensitiveStringTraits> const& response_headers, Optional<u32> status_code)> success_callback, Function<void(String const&, Optional<u32> status_code)> error_callback = nullptr, Optional<u32> timeout = {}, Function<void()> timeout_callback = nullptr);
 
     ResourceLoaderConnector& connector() { return *m_connector; }
@@ -6,7 +6,6 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
-#include <LibGfx/AntiAliasingPainter.h>
 #include <LibGfx/Painter.h>
 #include <LibWeb/Layout/InitialContainingBlock.h>
 #include <LibWeb/Layout/Node.h>
@@ -75,8 +74,7 @@ void paint_background(PaintContext& context, Layout::NodeWithStyleAndBoxModelMet
         }
     }
 
-    Gfx::AntiAliasingPainter aa_painter { painter };
-    aa_painter.fill_rect_with_rounded_corners(color_box.rect.to_rounded<int>(),
+    painter.fill_rect_with_rounded_corners(color_box.rect.to_rounded<int>(),
         background_color, color_box.radii.top_left.as_corner(), color_box.radii.top_right.as_corner(), color_box.radii.bottom_right.as_corner(), color_box.radii.bottom_left.as_corner());
 
     if (!has_paintable_layers)
@@ -106,7 +104,7 @@ void paint_background(PaintContext& context, Layout::NodeWithStyleAndBoxModelMet
     for (auto& layer : background_layers->in_reverse()) {
         if (!layer_is_paintable(layer))
             continue;
-        Gfx::PainterStateSaver state { painter };
+        RecordingPainterStateSaver state { painter };
 
         // Clip
         auto clip_box = get_box(layer.clip);
@@ -128,6 +126,7 @@ void paint_background(PaintContext& context, Layout::NodeWithStyleAndBoxModelMet
         switch (layer.attachment) {
         case CSS::BackgroundAttachment::Fixed:
             background_positioning_area = layout_node.root().browsing_context().viewport_rect().to_type<float>();
+            painter.set_depends_on_scroll_offset();
             break;
         case CSS::BackgroundAttachment::Local:
         case CSS::BackgroundAttachment::Scroll:
@@ -134,8 +134,7 @@ void paint_border(PaintContext& context, BorderEdge edge, Gfx::IntRect const& re
             break;
         }
         if (border_style == CSS::LineStyle::Dotted) {
-            Gfx::AntiAliasingPainter aa_painter { context.painter() };
-            aa_painter.draw_line(p1.to_type<float>(), p2.to_type<float>(), color, int_width, gfx_line_style);
+            context.painter().draw_anti_aliased_line(p1.to_type<float>(), p2.to_type<float>(), color, int_width, gfx_line_style);
             return;
         }
         context.painter().draw_line(p1, p2, color, int_width, gfx_line_style);
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/RefCounted.h>
 #include <LibGfx/AntiAliasingPainter.h>
 #include <LibWeb/Painting/BorderPainting.h>
 
@@ -16,14 +17,16 @@ enum class CornerClip {
     Inside
 };
 
-class BorderRadiusCornerClipper {
+class RecordingPainter;
+
+class BorderRadiusCornerClipper : public RefCounted<BorderRadiusCornerClipper> {
 public:
     enum class UseCachedBitmap {
         Yes,
         No
     };
 
-    static ErrorOr<BorderRadiusCornerClipper> create(Gfx::IntRect const& border_rect, BorderRadiiData const& border_radii, CornerClip corner_clip = CornerClip::Outside, UseCachedBitmap use_cached_bitmap = UseCachedBitmap::Yes);
+    static ErrorOr<NonnullRefPtr<BorderRadiusCornerClipper>> create(Gfx::IntRect const& border_rect, BorderRadiiData const& border_radii, CornerClip corner_clip = CornerClip::Outside, UseCachedBitmap use_cached_bitmap = UseCachedBitmap::Yes);
 
     void sample_under_corners(Gfx::Painter& page_painter);
     void blit_corner_clipping(Gfx::Painter& page_painter);
@@ -61,31 +64,15 @@ private:
 };
 
 struct ScopedCornerRadiusClip {
-    ScopedCornerRadiusClip(Gfx::Painter& painter, Gfx::IntRect const& border_rect, BorderRadiiData const& border_radii, CornerClip corner_clip = CornerClip::Outside, BorderRadiusCornerClipper::UseCachedBitmap use_cached_bitmap = BorderRadiusCornerClipper::UseCachedBitmap::Yes)
-        : m_painter(painter)
-    {
-        if (border_radii.has_any_radius()) {
-            auto clipper = BorderRadiusCornerClipper::create(border_rect, border_radii, corner_clip, use_cached_bitmap);
-            if (!clipper.is_error()) {
-                m_corner_clipper = clipper.release_value();
-                m_corner_clipper->sample_under_corners(m_painter);
-            }
-        }
-    }
-
-    ~ScopedCornerRadiusClip()
-    {
-        if (m_corner_clipper.has_value()) {
-            m_corner_clipper->blit_corner_clipping(m_painter);
-        }
-    }
+    ScopedCornerRadiusClip(RecordingPainter& painter, Gfx::IntRect const& border_rect, BorderRadiiData const& border_radii, CornerClip corner_clip = CornerClip::Outside, BorderRadiusCornerClipper::UseCachedBitmap use_cached_bitmap = BorderRadiusCornerClipper::UseCachedBitmap::Yes);
+    ~ScopedCornerRadiusClip();
 
     AK_MAKE_NONMOVABLE(ScopedCornerRadiusClip);
     AK_MAKE_NONCOPYABLE(ScopedCornerRadiusClip);
 
 private:
-    Gfx::Painter& m_painter;
-    Optional<BorderRadiusCornerClipper> m_corner_clipper;
+    RecordingPainter& m_painter;
+    RefPtr<BorderRadiusCornerClipper> m_corner_clipper;
 };
 
 }
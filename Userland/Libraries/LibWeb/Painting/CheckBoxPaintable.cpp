@@ -42,8 +42,11 @@ void CheckBoxPaintable::paint(PaintContext& context, PaintPhase phase) const
     PaintableBox::paint(context, phase);
 
     auto const& checkbox = static_cast<HTML::HTMLInputElement const&>(layout_box().dom_node());
-    if (phase == PaintPhase::Foreground)
-        Gfx::StylePainter::paint_check_box(context.painter(), enclosing_int_rect(absolute_rect()), context.palette(), layout_box().dom_node().enabled(), checkbox.checked(), being_pressed());
+    if (phase == PaintPhase::Foreground) {
+        context.painter().paint_with_painter("CheckBox", [rect = enclosing_int_rect(absolute_rect()), palette = context.palette(), enabled = layout_box().dom_node().enabled(), checked = checkbox.checked(), pressed = being_pressed()](Gfx::Painter& painter) {
+            Gfx::StylePainter::paint_check_box(painter, rect, palette, enabled, checked, pressed);
+        });
+    }
 }
 
 }
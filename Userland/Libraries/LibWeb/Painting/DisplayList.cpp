@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/AntiAliasingPainter.h>
+#include <LibGfx/Painter.h>
+#include <LibWeb/Painting/BorderRadiusCornerClipper.h>
+#include <LibWeb/Painting/DisplayList.h>
+
+namespace Web::Painting {
+
+DisplayList::~DisplayList() = default;
+
+void DisplayList::append(Command command)
+{
+    m_commands.append(move(command));
+}
+
+void DisplayList::execute(Gfx::Painter& painter, Optional<Gfx::IntPoint> scroll_offset) const
+{
+    Gfx::PainterStateSaver saver(painter);
+    auto base_translation = painter.translation();
+
+    for (auto const& command : m_commands) {
+        command.visit(
+            [&](Save const&) {
+                painter.save();
+            },
+            [&](Restore const&) {
+                painter.restore();
+            },
+            [&](Translate const& command) {
+                painter.translate(command.offset);
+            },
+            [&](ResetTranslation const&) {
+                painter.translate(base_translation - painter.translation());
+            },
+            [&](ApplyScrollOffset const& command) {
+                painter.translate(-scroll_offset.value_or(command.scroll_offset));
+            },
+            [&](AddClipRect const& command) {
+                painter.add_clip_rect(command.rect);
+            },
+            [&](ClearClipRect const&) {
+                painter.clear_clip_rect();
+            },
+            [&](FillRect const& command) {
+                painter.fill_rect(command.rect, command.color);
+            },
+            [&](DrawRect const& command) {
+                painter.draw_rect(command.rect, command.color, command.rough);
+            },
+            [&](DrawLine const& command) {
+                painter.draw_line(command.from, command.to, command.color, command.thickness, command.style);
+            },
+            [&](DrawFocusRect const& command) {
+                painter.draw_focus_rect(command.rect, command.color);
+            },
+            [&](DrawTriangleWave const& command) {
+                painter.draw_triangle_wave(command.from, command.to, command.color, command.amplitude, command.thickness);
+            },
+            [&](DrawText const& command) {
+                painter.draw_text(command.rect, command.text, *command.font, command.alignment, command.color, command.elision);
+            },
+            [&](DrawGlyphRun const& command) {
+                for (auto const& glyph : command.glyphs) {
+                    if (glyph.emoji)
+                        painter.draw_emoji(glyph.position, *glyph.emoji, *command.font);
+                    else
+                        painter.draw_glyph(glyph.position, glyph.code_point, *command.font, command.color);
+                }
+            },
+            [&](DrawTextRun const& command) {
+                painter.draw_text_run(command.baseline_start, Utf8View(command.text), *command.font, command.color);
+            },
+            [&](DrawScaledBitmap const& command) {
+                painter.draw_scaled_bitmap(command.dst_rect, *command.bitmap, command.src_rect, command.opacity, command.scaling_mode);
+            },
+            [&](Blit const& command) {
+                painter.blit(command.position, *command.bitmap, command.src_rect, command.opacity);
+            },
+            [&](FillRectWithRoundedCorners const& command) {
+                Gfx::AntiAliasingPainter aa_painter { painter };
+                aa_painter.fill_rect_with_rounded_corners(command.rect, command.color, command.top_left, command.top_right, command.bottom_right, command.bottom_left);
+            },
+            [&](DrawAntiAliasedLine const& command) {
+                Gfx::AntiAliasingPainter aa_painter { painter };
+                aa_painter.draw_line(command.from, command.to, command.color, command.thickness, command.style);
+            },
+            [&](DrawEllipse const& command) {
+                Gfx::AntiAliasingPainter aa_painter { painter };
+                aa_painter.draw_ellipse(command.rect, command.color, command.thickness);
+            },
+            [&](FillEllipse const& command) {
+                Gfx::AntiAliasingPainter aa_painter { painter };
+                aa_painter.fill_ellipse(command.rect, command.color);
+            },
+            [&](FillPath const& command) {
+                Gfx::AntiAliasingPainter aa_painter { painter };
+                aa_painter.translate(command.translation);
+                // NOTE: AntiAliasingPainter::fill_path() wants a mutable path, since it may split it into lines.
+                auto path = command.path;
+                aa_painter.fill_path(path, command.color, command.winding_rule);
+            },
+            [&](StrokePath const& command) {
+                Gfx::AntiAliasingPainter aa_painter { painter };
+                aa_painter.translate(command.translation);
+                aa_painter.stroke_path(command.path, command.color, command.thickness);
+            },
+            [&](SampleUnderCorners const& command) {
+                command.clipper->sample_under_corners(painter);
+            },
+            [&](BlitCornerClipping const& command) {
+                command.clipper->blit_corner_clipping(painter);
+            },
+            [&](DrawLayer const& command) {
+                execute_layer(painter, command);
+            },
+            [&](PaintWithPainter const& command) {
+                command.callback(painter);
+            });
+    }
+}
+
+void DisplayList::execute_layer(Gfx::Painter& painter, DrawLayer const& layer)
+{
+    auto source_rect = layer.paint_rect.translated(-layer.transform_origin);
+    auto transformed_destination_rect = layer.transform.map(source_rect).translated(layer.transform_origin);
+    auto destination_rect = transformed_destination_rect.to_rounded<int>();
+
+    // FIXME: We should find a way to scale the paintable, rather than paint into a separate bitmap,
+    // then scale it. This snippet now copies the background at the destination, then scales it down/up
+    // to the size of the source (which could add some artefacts, though just scaling the bitmap already does that).
+    // We need to copy the background at the destination because a bunch of our rendering effects now rely on
+    // being able to sample the painter (see border radii, shadows, filters, etc).
+    Gfx::FloatPoint destination_clipped_fixup {};
+    auto try_get_scaled_destination_bitmap = [&]() -> ErrorOr<NonnullRefPtr<Gfx::Bitmap>> {
+        Gfx::IntRect actual_destination_rect;
+        auto bitmap = TRY(painter.get_region_bitmap(destination_rect, Gfx::BitmapFormat::BGRA8888, actual_destination_rect));
+        // get_region_bitmap() may clip to a smaller region if the requested rect goes outside the painter, so we need to account for that.
+        destination_clipped_fixup = Gfx::FloatPoint { destination_rect.location() - actual_destination_rect.location() };
+        destination_rect = actual_destination_rect;
+        if (source_rect.size() != transformed_destination_rect.size()) {
+            auto sx = static_cast<float>(source_rect.width()) / transformed_destination_rect.width();
+            auto sy = static_cast<float>(source_rect.height()) / transformed_destination_rect.height();
+            bitmap = TRY(bitmap->scaled(sx, sy));
+            destination_clipped_fixup.scale_by(sx, sy);
+        }
+        return bitmap;
+    };
+
+    auto bitmap_or_error = try_get_scaled_destination_bitmap();
+    if (bitmap_or_error.is_error())
+        return;
+    auto bitmap = bitmap_or_error.release_value_but_fixme_should_propagate_errors();
+    Gfx::Painter layer_painter(bitmap);
+    layer_painter.translate((-layer.paint_rect.location() + destination_clipped_fixup).to_rounded<int>());
+    layer.contents->execute(layer_painter);
+
+    if (destination_rect.size() == bitmap->size())
+        painter.blit(destination_rect.location(), *bitmap, bitmap->rect(), layer.opacity);
+    else
+        painter.draw_scaled_bitmap(destination_rect, *bitmap, bitmap->rect(), layer.opacity, Gfx::Painter::ScalingMode::BilinearBlend);
+}
+
+void DisplayList::dump(StringBuilder& builder, size_t indent) const
+{
+    for (auto const& command : m_commands) {
+        builder.append_repeated(' ', indent * 2);
+        command.visit(
+            [&](Save const&) {
+                builder.append("Save"sv);
+            },
+            [&](Restore const&) {
+                builder.append("Restore"sv);
+            },
+            [&](Translate const& command) {
+                builder.appendff("Translate offset={}", command.offset);
+            },
+            [&](ResetTranslation const&) {
+                builder.append("ResetTranslation"sv);
+            },
+            [&](ApplyScrollOffset const& command) {
+                builder.appendff("ApplyScrollOffset scroll_offset={}", command.scroll_offset);
+            },
+            [&](AddClipRect const& command) {
+                builder.appendff("AddClipRect rect={}", command.rect);
+            },
+            [&](ClearClipRect const&) {
+                builder.append("ClearClipRect"sv);
+            },
+            [&](FillRect const& command) {
+                builder.appendff("FillRect rect={} color={}", command.rect, command.color);
+            },
+            [&](DrawRect const& command) {
+                builder.appendff("DrawRect rect={} color={} rough={}", command.rect, command.color, command.rough);
+            },
+            [&](DrawLine const& command) {
+                builder.appendff("DrawLine from={} to={} color={} thickness={} style={}", command.from, command.to, command.color, command.thickness, to_underlying(command.style));
+            },
+            [&](DrawFocusRect const& command) {
+                builder.appendff("DrawFocusRect rect={} color={}", command.rect, command.color);
+            },
+            [&](DrawTriangleWave const& command) {
+                builder.appendff("DrawTriangleWave from={} to={} color={} amplitude={} thickness={}", command.from, command.to, command.color, command.amplitude, command.thickness);
+            },
+            [&](DrawText const& command) {
+                builder.appendff("DrawText rect={} font=\"{}\" color={} text=\"{}\"", command.rect, command.font->qualified_name(), command.color, command.text);
+            },
+            [&](DrawGlyphRun const& command) {
+                StringBuilder text_builder;
+                for (auto const& glyph : command.glyphs)
+                    text_builder.append_code_point(glyph.code_point);
+                builder.appendff("DrawGlyphRun origin={} glyphs={} font=\"{}\" color={} text=\"{}\"", command.glyphs.first().position, command.glyphs.size(), command.font->qualified_name(), command.color, text_builder.string_view());
+            },
+            [&](DrawTextRun const& command) {
+                builder.appendff("DrawTextRun baseline_start={} font=\"{}\" color={} text=\"{}\"", command.baseline_start, command.font->qualified_name(), command.color, command.text);
+            },
+            [&](DrawScaledBitmap const& command) {
+                builder.appendff("DrawScaledBitmap dst_rect={} bitmap={} src_rect={} opacity={}", command.dst_rect, command.bitmap->size(), command.src_rect, command.opacity);
+            },
+            [&](Blit const& command) {
+                builder.appendff("Blit position={} bitmap={} src_rect={} opacity={}", command.position, command.bitmap->size(), command.src_rect, command.opacity);
+            },
+            [&](FillRectWithRoundedCorners const& command) {
+                builder.appendff("FillRectWithRoundedCorners rect={} color={}", command.rect, command.color);
+            },
+            [&](DrawAntiAliasedLine const& command) {
+                builder.appendff("DrawAntiAliasedLine from={} to={} color={} thickness={} style={}", command.from, command.to, command.color, command.thickness, to_underlying(command.style));
+            },
+            [&](DrawEllipse const& command) {
+                builder.appendff("DrawEllipse rect={} color={} thickness={}", command.rect, command.color, command.thickness);
+            },
+            [&](FillEllipse const& command) {
+                builder.appendff("FillEllipse rect={} color={}", command.rect, command.color);
+            },
+            [&](FillPath const& command) {
+                builder.appendff("FillPath bounding_box={} color={} translation={}", command.path.bounding_box(), command.color, command.translation);
+            },
+            [&](StrokePath const& command) {
+                builder.appendff("StrokePath bounding_box={} color={} thickness={} translation={}", command.path.bounding_box(), command.color, command.thickness, command.translation);
+            },
+            [&](SampleUnderCorners const&) {
+                builder.append("SampleUnderCorners"sv);
+            },
+            [&](BlitCornerClipping const&) {
+                builder.append("BlitCornerClipping"sv);
+            },
+            [&](DrawLayer const& command) {
+                builder.appendff("DrawLayer paint_rect={} transform={} transform_origin={} opacity={}\n", command.paint_rect, command.transform, command.transform_origin, command.opacity);
+                command.contents->dump(builder, indent + 1);
+            },
+            [&](PaintWithPainter const& command) {
+                builder.appendff("PaintWithPainter {}", command.name);
+            });
+        if (!command.has<DrawLayer>())
+            builder.append('\n');
+    }
+}
+
+String DisplayList::dump() const
+{
+    StringBuilder builder;
+    dump(builder);
+    return builder.to_string();
+}
+
+}
@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <AK/StringBuilder.h>
+#include <AK/Variant.h>
+#include <AK/Vector.h>
+#include <LibGfx/AffineTransform.h>
+#include <LibGfx/AntiAliasingPainter.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/Color.h>
+#include <LibGfx/Font/Font.h>
+#include <LibGfx/Painter.h>
+#include <LibGfx/Path.h>
+#include <LibGfx/Rect.h>
+#include <LibGfx/TextAlignment.h>
+#include <LibGfx/TextElision.h>
+
+namespace Web::Painting {
+
+class BorderRadiusCornerClipper;
+
+// A list of painting commands, recorded once per layout by a RecordingPainter and replayed
+// onto a Gfx::Painter for every repaint of the page (scrolling, exposed regions, etc.)
+// Coordinates are in the same space the paintables work in; the scroll offset of the top-level
+// viewport is applied at replay time, so the same list can be used for every scroll position.
+class DisplayList {
+    AK_MAKE_NONCOPYABLE(DisplayList);
+    AK_MAKE_NONMOVABLE(DisplayList);
+
+public:
+    using CornerRadius = Gfx::AntiAliasingPainter::CornerRadius;
+
+    struct Save {
+    };
+    struct Restore {
+    };
+    struct Translate {
+        Gfx::IntPoint offset;
+    };
+    // Used by fixed position boxes, which are painted relative to the viewport and not the document.
+    struct ResetTranslation {
+    };
+    struct ApplyScrollOffset {
+        Gfx::IntPoint scroll_offset;
+    };
+    struct AddClipRect {
+        Gfx::IntRect rect;
+    };
+    struct ClearClipRect {
+    };
+
+    struct FillRect {
+        Gfx::IntRect rect;
+        Color color;
+    };
+    struct DrawRect {
+        Gfx::IntRect rect;
+        Color color;
+        bool rough { false };
+    };
+    struct DrawLine {
+        Gfx::IntPoint from;
+        Gfx::IntPoint to;
+        Color color;
+        int thickness { 1 };
+        Gfx::Painter::LineStyle style { Gfx::Painter::LineStyle::Solid };
+    };
+    struct DrawFocusRect {
+        Gfx::IntRect rect;
+        Color color;
+    };
+    struct DrawTriangleWave {
+        Gfx::IntPoint from;
+        Gfx::IntPoint to;
+        Color color;
+        int amplitude { 0 };
+        int thickness { 1 };
+    };
+
+    struct DrawText {
+        Gfx::IntRect rect;
+        String text;
+        NonnullRefPtr<Gfx::Font const> font;
+        Gfx::TextAlignment alignment;
+        Color color;
+        Gfx::TextElision elision;
+    };
+    // A run of text with its glyphs (or emoji) already picked and positioned, so replaying it doesn't have to measure anything.
+    struct DrawGlyphRun {
+        struct Glyph {
+            Gfx::IntPoint position;
+            u32 code_point { 0 };
+            RefPtr<Gfx::Bitmap const> emoji;
+        };
+        Vector<Glyph> glyphs;
+        NonnullRefPtr<Gfx::Font const> font;
+        Color color;
+    };
+    // A run of text in a vector font. Those cache their laid out runs themselves (see Gfx::ScaledFont::glyph_run()),
+    // so replaying this only has to look the run up, and can place the glyphs between whole pixels.
+    struct DrawTextRun {
+        Gfx::FloatPoint baseline_start;
+        String text;
+        NonnullRefPtr<Gfx::Font const> font;
+        Color color;
+    };
+
+    struct DrawScaledBitmap {
+        Gfx::IntRect dst_rect;
+        NonnullRefPtr<Gfx::Bitmap const> bitmap;
+        Gfx::IntRect src_rect;
+        float opacity { 1.0f };
+        Gfx::Painter::ScalingMode scaling_mode { Gfx::Painter::ScalingMode::NearestNeighbor };
+    };
+    struct Blit {
+        Gfx::IntPoint position;
+        NonnullRefPtr<Gfx::Bitmap const> bitmap;
+        Gfx::IntRect src_rect;
+        float opacity { 1.0f };
+    };
+
+    struct FillRectWithRoundedCorners {
+        Gfx::IntRect rect;
+        Color color;
+        CornerRadius top_left;
+        CornerRadius top_right;
+        CornerRadius bottom_right;
+        CornerRadius bottom_left;
+    };
+    struct DrawAntiAliasedLine {
+        Gfx::FloatPoint from;
+        Gfx::FloatPoint to;
+        Color color;
+        float thickness { 1 };
+        Gfx::Painter::LineStyle style { Gfx::Painter::LineStyle::Solid };
+    };
+    struct DrawEllipse {
+        Gfx::IntRect rect;
+        Color color;
+        int thickness { 1 };
+    };
+    struct FillEllipse {
+        Gfx::IntRect rect;
+        Color color;
+    };
+    struct FillPath {
+        Gfx::Path path;
+        Color color;
+        Gfx::Painter::WindingRule winding_rule;
+        Gfx::FloatPoint translation;
+    };
+    struct StrokePath {
+        Gfx::Path path;
+        Color color;
+        float thickness { 1 };
+        Gfx::FloatPoint translation;
+    };
+
+    // NOTE: The clipper is shared between the two commands, and keeps the pixels sampled from under the corners in between them.
+    struct SampleUnderCorners {
+        NonnullRefPtr<BorderRadiusCornerClipper> mutable clipper;
+    };
+    struct BlitCornerClipping {
+        NonnullRefPtr<BorderRadiusCornerClipper> mutable clipper;
+    };
+
+    // The contents of a stacking context with opacity or a non-translation transform, which get
+    // painted into a separate bitmap that's then composited onto the page.
+    struct DrawLayer {
+        NonnullOwnPtr<DisplayList> contents;
+        Gfx::FloatRect paint_rect;
+        Gfx::AffineTransform transform;
+        Gfx::FloatPoint transform_origin;
+        float opacity { 1.0f };
+    };
+
+    // Painting that needs direct access to the target bitmap (e.g. to sample what's been painted so far),
+    // or that's done by code that only knows how to paint with a Gfx::Painter.
+    struct PaintWithPainter {
+        String name;
+        Function<void(Gfx::Painter&)> callback;
+    };
+
+    using Command = Variant<
+        Save,
+        Restore,
+        Translate,
+        ResetTranslation,
+        ApplyScrollOffset,
+        AddClipRect,
+        ClearClipRect,
+        FillRect,
+        DrawRect,
+        DrawLine,
+        DrawFocusRect,
+        DrawTriangleWave,
+        DrawText,
+        DrawGlyphRun,
+        DrawTextRun,
+        DrawScaledBitmap,
+        Blit,
+        FillRectWithRoundedCorners,
+        DrawAntiAliasedLine,
+        DrawEllipse,
+        FillEllipse,
+        FillPath,
+        StrokePath,
+        SampleUnderCorners,
+        BlitCornerClipping,
+        DrawLayer,
+        PaintWithPainter>;
+
+    DisplayList() = default;
+    ~DisplayList();
+
+    void append(Command);
+
+    size_t command_count() const { return m_commands.size(); }
+    bool is_empty() const { return m_commands.is_empty(); }
+
+    // Set when something was painted relative to the scroll position at recording time (e.g. fixed backgrounds),
+    // in which case the list can't be replayed at a different scroll offset.
+    bool depends_on_scroll_offset() const { return m_depends_on_scroll_offset; }
+    void set_depends_on_scroll_offset() { m_depends_on_scroll_offset = true; }
+
+    // Set when the list contains fixed position boxes, which are painted relative to the viewport.
+    bool has_fixed_position_content() const { return m_has_fixed_position_content; }
+    void set_has_fixed_position_content() { m_has_fixed_position_content = true; }
+
+    // If a scroll offset is given, it replaces the one the list was recorded with.
+    void execute(Gfx::Painter&, Optional<Gfx::IntPoint> scroll_offset = {}) const;
+
+    void dump(StringBuilder&, size_t indent = 0) const;
+    String dump() const;
+
+private:
+    static void execute_layer(Gfx::Painter&, DrawLayer const&);
+
+    Vector<Command> m_commands;
+    bool m_depends_on_scroll_offset { false };
+    bool m_has_fixed_position_content { false };
+};
+
+}
@@ -205,25 +205,28 @@ void paint_linear_gradient(PaintContext& context, Gfx::IntRect const& gradient_r
         gradient_line_colors[loc] = gradient_color;
     }
 
-    auto lookup_color = [&](int loc) {
-        return gradient_line_colors[clamp(loc, 0, gradient_color_count - 1)];
-    };
+    // The gradient line is resolved while recording, the pixels are only filled in when the display list is replayed.
+    context.painter().paint_with_painter("LinearGradient", [=, gradient_line_colors = move(gradient_line_colors), repeat_length = data.repeat_length](Gfx::Painter& painter) {
+        auto lookup_color = [&](int loc) {
+            return gradient_line_colors[clamp(loc, 0, gradient_color_count - 1)];
+        };
 
-    auto repeat_wrap_if_required = [&](float loc) {
-        if (data.repeat_length.has_value())
-            loc = AK::fmod(loc + length, *data.repeat_length);
-        return loc;
-    };
+        auto repeat_wrap_if_required = [&](float loc) {
+            if (repeat_length.has_value())
+                loc = AK::fmod(loc + length, *repeat_length);
+            return loc;
+        };
 
-    for (int y = 0; y < gradient_rect.height(); y++) {
-        for (int x = 0; x < gradient_rect.width(); x++) {
-            auto loc = repeat_wrap_if_required((x * cos_angle - (gradient_rect.height() - y) * -sin_angle) - rotated_start_point_x - start_offset);
-            auto blend = loc - static_cast<int>(loc);
-            // Blend between the two neighbouring colors (this fixes some nasty aliasing issues at small angles)
-            auto gradient_color = lookup_color(loc).mixed_with(lookup_color(repeat_wrap_if_required(loc + 1)), blend);
-            context.painter().set_pixel(gradient_rect.x() + x, gradient_rect.y() + y, gradient_color, gradient_color.alpha() < 255);
+        for (int y = 0; y < gradient_rect.height(); y++) {
+            for (int x = 0; x < gradient_rect.width(); x++) {
+                auto loc = repeat_wrap_if_required((x * cos_angle - (gradient_rect.height() - y) * -sin_angle) - rotated_start_point_x - start_offset);
+                auto blend = loc - static_cast<int>(loc);
+                // Blend between the two neighbouring colors (this fixes some nasty aliasing issues at small angles)
+                auto gradient_color = lookup_color(loc).mixed_with(lookup_color(repeat_wrap_if_required(loc + 1)), blend);
+                painter.set_pixel(gradient_rect.x() + x, gradient_rect.y() + y, gradient_color, gradient_color.alpha() < 255);
+            }
         }
-    }
+    });
 }
 
 }
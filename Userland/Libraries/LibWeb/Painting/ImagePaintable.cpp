@@ -43,7 +43,9 @@ void ImagePaintable::paint(PaintContext& context, PaintPhase phase) const
         if (layout_box().renders_as_alt_text()) {
             auto& image_element = verify_cast<HTML::HTMLImageElement>(*dom_node());
             context.painter().set_font(Platform::FontPlugin::the().default_font());
-            Gfx::StylePainter::paint_frame(context.painter(), enclosing_int_rect(absolute_rect()), context.palette(), Gfx::FrameShape::Container, Gfx::FrameShadow::Sunken, 2);
+            context.painter().paint_with_painter("ImageAltTextFrame", [rect = enclosing_int_rect(absolute_rect()), palette = context.palette()](Gfx::Painter& painter) {
+                Gfx::StylePainter::paint_frame(painter, rect, palette, Gfx::FrameShape::Container, Gfx::FrameShadow::Sunken, 2);
+            });
             auto alt = image_element.alt();
             if (alt.is_empty())
                 alt = image_element.src();
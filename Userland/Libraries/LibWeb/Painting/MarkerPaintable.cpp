@@ -4,7 +4,6 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
-#include <LibGfx/AntiAliasingPainter.h>
 #include <LibGfx/StylePainter.h>
 #include <LibWeb/Layout/ListItemMarkerBox.h>
 #include <LibWeb/Painting/MarkerPaintable.h>
@@ -52,17 +51,15 @@ void MarkerPaintable::paint(PaintContext& context, PaintPhase phase) const
 
     auto color = computed_values().color();
 
-    Gfx::AntiAliasingPainter aa_painter { context.painter() };
-
     switch (layout_box().list_style_type()) {
     case CSS::ListStyleType::Square:
         context.painter().fill_rect(marker_rect, color);
         break;
     case CSS::ListStyleType::Circle:
-        aa_painter.draw_ellipse(marker_rect, color, 1);
+        context.painter().draw_ellipse(marker_rect, color, 1);
         break;
     case CSS::ListStyleType::Disc:
-        aa_painter.fill_ellipse(marker_rect, color);
+        context.painter().fill_ellipse(marker_rect, color);
         break;
     case CSS::ListStyleType::Decimal:
     case CSS::ListStyleType::DecimalLeadingZero:
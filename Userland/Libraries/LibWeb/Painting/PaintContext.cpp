@@ -8,7 +8,7 @@
 
 namespace Web {
 
-PaintContext::PaintContext(Gfx::Painter& painter, Palette const& palette, Gfx::IntPoint const& scroll_offset)
+PaintContext::PaintContext(Painting::RecordingPainter& painter, Palette const& palette, Gfx::IntPoint const& scroll_offset)
     : m_painter(painter)
     , m_palette(palette)
     , m_scroll_offset(scroll_offset)
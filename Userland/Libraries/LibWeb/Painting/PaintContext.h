@@ -10,15 +10,16 @@
 #include <LibGfx/Forward.h>
 #include <LibGfx/Palette.h>
 #include <LibGfx/Rect.h>
+#include <LibWeb/Painting/RecordingPainter.h>
 #include <LibWeb/SVG/SVGContext.h>
 
 namespace Web {
 
 class PaintContext {
 public:
-    PaintContext(Gfx::Painter& painter, Palette const& palette, Gfx::IntPoint const& scroll_offset);
+    PaintContext(Painting::RecordingPainter& painter, Palette const& palette, Gfx::IntPoint const& scroll_offset);
 
-    Gfx::Painter& painter() const { return m_painter; }
+    Painting::RecordingPainter& painter() const { return m_painter; }
     Palette const& palette() const { return m_palette; }
 
     bool has_svg_context() const { return m_svg_context.has_value(); }
@@ -37,7 +38,7 @@ public:
     bool has_focus() const { return m_focus; }
     void set_has_focus(bool focus) { m_focus = focus; }
 
-    PaintContext clone(Gfx::Painter& painter) const
+    PaintContext clone(Painting::RecordingPainter& painter) const
     {
         auto clone = PaintContext(painter, m_palette, m_scroll_offset);
         clone.m_viewport_rect = m_viewport_rect;
@@ -48,7 +49,7 @@ public:
     }
 
 private:
-    Gfx::Painter& m_painter;
+    Painting::RecordingPainter& m_painter;
     Palette m_palette;
     Optional<SVGContext> m_svg_context;
     Gfx::IntRect m_viewport_rect;
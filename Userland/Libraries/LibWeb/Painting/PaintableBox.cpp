@@ -338,7 +338,7 @@ void PaintableBox::before_children_paint(PaintContext& context, PaintPhase phase
             }
             clip_overflow();
             m_overflow_corner_radius_clipper = corner_clipper.release_value();
-            m_overflow_corner_radius_clipper->sample_under_corners(context.painter());
+            context.painter().sample_under_corners(*m_overflow_corner_radius_clipper);
         }
     }
 }
@@ -356,9 +356,8 @@ void PaintableBox::after_children_paint(PaintContext& context, PaintPhase phase,
         context.painter().restore();
         m_clipping_overflow = false;
     }
-    if (m_overflow_corner_radius_clipper.has_value()) {
-        m_overflow_corner_radius_clipper->blit_corner_clipping(context.painter());
-        m_overflow_corner_radius_clipper = {};
+    if (m_overflow_corner_radius_clipper) {
+        context.painter().blit_corner_clipping(m_overflow_corner_radius_clipper.release_nonnull());
     }
 }
 
@@ -392,7 +391,7 @@ static void paint_cursor_if_needed(PaintContext& context, Layout::TextNode const
     context.painter().draw_rect(cursor_rect, text_node.computed_values().color());
 }
 
-static void paint_text_decoration(Gfx::Painter& painter, Layout::Node const& text_node, Layout::LineBoxFragment const& fragment)
+static void paint_text_decoration(RecordingPainter& painter, Layout::Node const& text_node, Layout::LineBoxFragment const& fragment)
 {
     auto& font = fragment.layout_node().font();
     auto fragment_box = enclosing_int_rect(fragment.absolute_rect());
@@ -498,7 +497,7 @@ static void paint_text_fragment(PaintContext& context, Layout::TextNode const& t
         auto selection_rect = fragment.selection_rect(text_node.font());
         if (!selection_rect.is_empty()) {
             painter.fill_rect(enclosing_int_rect(selection_rect), context.palette().selection());
-            Gfx::PainterStateSaver saver(painter);
+            RecordingPainterStateSaver saver(painter);
             painter.add_clip_rect(enclosing_int_rect(selection_rect));
             painter.draw_text_run(baseline_start, view, fragment.layout_node().font(), context.palette().selection_text());
         }
@@ -519,7 +518,7 @@ void PaintableWithLines::paint(PaintContext& context, PaintPhase phase) const
         return;
 
     bool should_clip_overflow = computed_values().overflow_x() != CSS::Overflow::Visible && computed_values().overflow_y() != CSS::Overflow::Visible;
-    Optional<BorderRadiusCornerClipper> corner_clipper;
+    RefPtr<BorderRadiusCornerClipper> corner_clipper;
 
     if (should_clip_overflow) {
         context.painter().save();
@@ -534,7 +533,7 @@ void PaintableWithLines::paint(PaintContext& context, PaintPhase phase) const
             auto clipper = BorderRadiusCornerClipper::create(clip_box, border_radii);
             if (!clipper.is_error()) {
                 corner_clipper = clipper.release_value();
-                corner_clipper->sample_under_corners(context.painter());
+                context.painter().sample_under_corners(*corner_clipper);
             }
         }
     }
@@ -584,8 +583,8 @@ void PaintableWithLines::paint(PaintContext& context, PaintPhase phase) const
 
     if (should_clip_overflow) {
         context.painter().restore();
-        if (corner_clipper.has_value())
-            corner_clipper->blit_corner_clipping(context.painter());
+        if (corner_clipper)
+            context.painter().blit_corner_clipping(*corner_clipper);
     }
 
     // FIXME: Merge this loop with the above somehow..
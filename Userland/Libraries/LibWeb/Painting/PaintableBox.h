@@ -154,7 +154,7 @@ private:
     Optional<Gfx::FloatRect> mutable m_absolute_paint_rect;
 
     mutable bool m_clipping_overflow { false };
-    Optional<BorderRadiusCornerClipper> mutable m_overflow_corner_radius_clipper;
+    RefPtr<BorderRadiusCornerClipper> mutable m_overflow_corner_radius_clipper;
 };
 
 class PaintableWithLines : public PaintableBox {
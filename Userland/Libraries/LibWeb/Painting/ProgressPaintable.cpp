@@ -32,8 +32,12 @@ void ProgressPaintable::paint(PaintContext& context, PaintPhase phase) const
     if (phase == PaintPhase::Foreground) {
         auto progress_rect = absolute_rect().to_rounded<int>();
         auto frame_thickness = min(min(progress_rect.width(), progress_rect.height()) / 6, 3);
-        Gfx::StylePainter::paint_progressbar(context.painter(), progress_rect.shrunken(frame_thickness, frame_thickness), context.palette(), 0, round_to<int>(layout_box().dom_node().max()), round_to<int>(layout_box().dom_node().value()), ""sv);
-        Gfx::StylePainter::paint_frame(context.painter(), progress_rect, context.palette(), Gfx::FrameShape::Box, Gfx::FrameShadow::Raised, frame_thickness);
+        auto max = round_to<int>(layout_box().dom_node().max());
+        auto value = round_to<int>(layout_box().dom_node().value());
+        context.painter().paint_with_painter("Progress", [=, palette = context.palette()](Gfx::Painter& painter) {
+            Gfx::StylePainter::paint_progressbar(painter, progress_rect.shrunken(frame_thickness, frame_thickness), palette, 0, max, value, ""sv);
+            Gfx::StylePainter::paint_frame(painter, progress_rect, palette, Gfx::FrameShape::Box, Gfx::FrameShadow::Raised, frame_thickness);
+        });
     }
 }
 
@@ -33,8 +33,11 @@ void RadioButtonPaintable::paint(PaintContext& context, PaintPhase phase) const
     PaintableBox::paint(context, phase);
 
     auto const& radio_box = static_cast<HTML::HTMLInputElement const&>(layout_box().dom_node());
-    if (phase == PaintPhase::Foreground)
-        Gfx::StylePainter::paint_radio_button(context.painter(), enclosing_int_rect(absolute_rect()), context.palette(), radio_box.checked(), being_pressed());
+    if (phase == PaintPhase::Foreground) {
+        context.painter().paint_with_painter("RadioButton", [rect = enclosing_int_rect(absolute_rect()), palette = context.palette(), checked = radio_box.checked(), pressed = being_pressed()](Gfx::Painter& painter) {
+            Gfx::StylePainter::paint_radio_button(painter, rect, palette, checked, pressed);
+        });
+    }
 }
 
 }
@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/CharacterTypes.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/Font/Emoji.h>
+#include <LibGfx/Font/FontDatabase.h>
+#include <LibGfx/Font/ScaledFont.h>
+#include <LibWeb/Painting/BorderRadiusCornerClipper.h>
+#include <LibWeb/Painting/RecordingPainter.h>
+
+namespace Web::Painting {
+
+RecordingPainter::RecordingPainter(DisplayList& display_list, Gfx::IntRect const& clip_rect)
+    : m_display_list(display_list)
+    , m_clip_origin(clip_rect)
+{
+    m_state_stack.append(State { .font = nullptr, .translation = {}, .clip_rect = clip_rect });
+}
+
+void RecordingPainter::fill_rect(Gfx::IntRect const& rect, Color color)
+{
+    m_display_list.append(DisplayList::FillRect { rect, color });
+}
+
+void RecordingPainter::draw_rect(Gfx::IntRect const& rect, Color color, bool rough)
+{
+    m_display_list.append(DisplayList::DrawRect { rect, color, rough });
+}
+
+void RecordingPainter::draw_line(Gfx::IntPoint const& from, Gfx::IntPoint const& to, Color color, int thickness, Gfx::Painter::LineStyle style)
+{
+    m_display_list.append(DisplayList::DrawLine { from, to, color, thickness, style });
+}
+
+void RecordingPainter::draw_focus_rect(Gfx::IntRect const& rect, Color color)
+{
+    m_display_list.append(DisplayList::DrawFocusRect { rect, color });
+}
+
+void RecordingPainter::draw_triangle_wave(Gfx::IntPoint const& from, Gfx::IntPoint const& to, Color color, int amplitude, int thickness)
+{
+    m_display_list.append(DisplayList::DrawTriangleWave { from, to, color, amplitude, thickness });
+}
+
+void RecordingPainter::draw_text(Gfx::IntRect const& rect, StringView text, Gfx::TextAlignment alignment, Color color, Gfx::TextElision elision)
+{
+    draw_text(rect, text, font(), alignment, color, elision);
+}
+
+void RecordingPainter::draw_text(Gfx::IntRect const& rect, StringView text, Gfx::Font const& font, Gfx::TextAlignment alignment, Color color, Gfx::TextElision elision)
+{
+    m_display_list.append(DisplayList::DrawText { rect, text, font, alignment, color, elision });
+}
+
+// NOTE: This picks and positions the glyphs exactly like Gfx::Painter::draw_text_run() and draw_glyph_or_emoji() do.
+void RecordingPainter::draw_text_run(Gfx::FloatPoint const& baseline_start, Utf8View const& string, Gfx::Font const& font, Color color)
+{
+    if (is<Gfx::ScaledFont>(font)) {
+        if (!string.is_empty())
+            m_display_list.append(DisplayList::DrawTextRun { baseline_start, string.as_string(), font, color });
+        return;
+    }
+
+    // FIXME: These should live somewhere else.
+    constexpr u32 text_variation_selector = 0xFE0E;
+    constexpr u32 emoji_variation_selector = 0xFE0F;
+    constexpr u32 regional_indicator_symbol_a = 0x1F1E6;
+    constexpr u32 regional_indicator_symbol_z = 0x1F1FF;
+
+    auto pixel_metrics = font.pixel_metrics();
+    float x = baseline_start.x();
+    int y = baseline_start.y() - pixel_metrics.ascent;
+    float space_width = font.glyph_or_emoji_width(' ');
+
+    Vector<DisplayList::DrawGlyphRun::Glyph> glyphs;
+    u32 last_code_point = 0;
+
+    for (auto code_point_iterator = string.begin(); code_point_iterator != string.end(); ++code_point_iterator) {
+        auto code_point = *code_point_iterator;
+        if (is_ascii_space(code_point) || code_point == 0xa0) {
+            x += space_width + font.glyph_spacing();
+            last_code_point = code_point;
+            continue;
+        }
+
+        // FIXME: this is probably not the real space taken for complex emojis
+        x += font.glyphs_horizontal_kerning(last_code_point, code_point);
+        Gfx::IntPoint position { static_cast<int>(x), y };
+
+        auto initial_iterator = code_point_iterator;
+        auto next_code_point = code_point_iterator.peek(1);
+        auto code_point_is_regional_indicator = code_point >= regional_indicator_symbol_a && code_point <= regional_indicator_symbol_z;
+        auto font_contains_glyph = font.contains_glyph(code_point);
+        auto check_for_emoji = code_point_is_regional_indicator || next_code_point == emoji_variation_selector;
+
+        Gfx::Bitmap const* emoji = nullptr;
+        if (!font_contains_glyph || check_for_emoji)
+            emoji = Gfx::Emoji::emoji_for_code_point_iterator(code_point_iterator);
+
+        if (emoji)
+            glyphs.append({ position, code_point, emoji });
+        else
+            glyphs.append({ position, font_contains_glyph ? code_point : 0xFFFD, nullptr });
+
+        // If we didn't advance the iterator to consume an emoji sequence, discard one code point if it's a variation selector.
+        if (initial_iterator == code_point_iterator) {
+            auto next_code_point = code_point_iterator.peek(1);
+            if (next_code_point == text_variation_selector || next_code_point == emoji_variation_selector)
+                ++code_point_iterator;
+        }
+
+        x += font.glyph_or_emoji_width(code_point) + font.glyph_spacing();
+        last_code_point = code_point;
+    }
+
+    if (glyphs.is_empty())
+        return;
+
+    m_display_list.append(DisplayList::DrawGlyphRun { move(glyphs), font, color });
+}
+
+void RecordingPainter::draw_scaled_bitmap(Gfx::IntRect const& dst_rect, Gfx::Bitmap const& bitmap, Gfx::IntRect const& src_rect, float opacity, Gfx::Painter::ScalingMode scaling_mode)
+{
+    m_display_list.append(DisplayList::DrawScaledBitmap { dst_rect, bitmap, src_rect, opacity, scaling_mode });
+}
+
+void RecordingPainter::blit(Gfx::IntPoint const& position, Gfx::Bitmap const& bitmap, Gfx::IntRect const& src_rect, float opacity)
+{
+    m_display_list.append(DisplayList::Blit { position, bitmap, src_rect, opacity });
+}
+
+void RecordingPainter::blit_filtered(Gfx::IntPoint const& position, Gfx::Bitmap const& source, Gfx::IntRect const& src_rect, Function<Color(Color)> filter)
+{
+    auto safe_src_rect = src_rect.intersected(source.rect());
+    if (safe_src_rect.is_empty())
+        return;
+
+    auto filtered_bitmap_or_error = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRA8888, safe_src_rect.size(), source.scale());
+    if (filtered_bitmap_or_error.is_error()) {
+        dbgln("Failed to allocate bitmap for filtered blit: {}", filtered_bitmap_or_error.error());
+        return;
+    }
+    auto filtered_bitmap = filtered_bitmap_or_error.release_value();
+
+    auto physical_src_rect = safe_src_rect * source.scale();
+    for (int y = 0; y < physical_src_rect.height(); ++y) {
+        for (int x = 0; x < physical_src_rect.width(); ++x) {
+            auto color = source.get_pixel(physical_src_rect.x() + x, physical_src_rect.y() + y);
+            // Fully transparent pixels are skipped by Gfx::Painter::blit_filtered(), so they don't get filtered either.
+            filtered_bitmap->set_pixel(x, y, color.alpha() == 0 ? Color::Transparent : filter(color));
+        }
+    }
+
+    blit(position, filtered_bitmap, filtered_bitmap->rect());
+}
+
+void RecordingPainter::fill_rect_with_rounded_corners(Gfx::IntRect const& rect, Color color, CornerRadius top_left, CornerRadius top_right, CornerRadius bottom_right, CornerRadius bottom_left)
+{
+    m_display_list.append(DisplayList::FillRectWithRoundedCorners { rect, color, top_left, top_right, bottom_right, bottom_left });
+}
+
+void RecordingPainter::draw_anti_aliased_line(Gfx::FloatPoint const& from, Gfx::FloatPoint const& to, Color color, float thickness, Gfx::Painter::LineStyle style)
+{
+    m_display_list.append(DisplayList::DrawAntiAliasedLine { from, to, color, thickness, style });
+}
+
+void RecordingPainter::draw_ellipse(Gfx::IntRect const& rect, Color color, int thickness)
+{
+    m_display_list.append(DisplayList::DrawEllipse { rect, color, thickness });
+}
+
+void RecordingPainter::fill_ellipse(Gfx::IntRect const& rect, Color color)
+{
+    m_display_list.append(DisplayList::FillEllipse { rect, color });
+}
+
+void RecordingPainter::fill_path(Gfx::Path const& path, Color color, Gfx::Painter::WindingRule winding_rule, Gfx::FloatPoint const& translation)
+{
+    m_display_list.append(DisplayList::FillPath { path, color, winding_rule, translation });
+}
+
+void RecordingPainter::stroke_path(Gfx::Path const& path, Color color, float thickness, Gfx::FloatPoint const& translation)
+{
+    m_display_list.append(DisplayList::StrokePath { path, color, thickness, translation });
+}
+
+void RecordingPainter::sample_under_corners(NonnullRefPtr<BorderRadiusCornerClipper> clipper)
+{
+    m_display_list.append(DisplayList::SampleUnderCorners { move(clipper) });
+}
+
+void RecordingPainter::blit_corner_clipping(NonnullRefPtr<BorderRadiusCornerClipper> clipper)
+{
+    m_display_list.append(DisplayList::BlitCornerClipping { move(clipper) });
+}
+
+void RecordingPainter::draw_layer(NonnullOwnPtr<DisplayList> contents, Gfx::FloatRect const& paint_rect, Gfx::AffineTransform const& transform, Gfx::FloatPoint const& transform_origin, float opacity)
+{
+    if (contents->depends_on_scroll_offset())
+        m_display_list.set_depends_on_scroll_offset();
+    if (contents->has_fixed_position_content())
+        m_display_list.set_has_fixed_position_content();
+    m_display_list.append(DisplayList::DrawLayer { move(contents), paint_rect, transform, transform_origin, opacity });
+}
+
+void RecordingPainter::paint_with_painter(String name, Function<void(Gfx::Painter&)> callback)
+{
+    m_display_list.append(DisplayList::PaintWithPainter { move(name), move(callback) });
+}
+
+Gfx::Font const& RecordingPainter::font() const
+{
+    if (!state().font)
+        return Gfx::FontDatabase::default_font();
+    return *state().font;
+}
+
+void RecordingPainter::translate(Gfx::IntPoint const& delta)
+{
+    state().translation.translate_by(delta);
+    m_display_list.append(DisplayList::Translate { delta });
+}
+
+void RecordingPainter::reset_translation()
+{
+    state().translation = {};
+    m_display_list.set_has_fixed_position_content();
+    m_display_list.append(DisplayList::ResetTranslation {});
+}
+
+void RecordingPainter::apply_scroll_offset(Gfx::IntPoint const& scroll_offset)
+{
+    state().translation.translate_by(-scroll_offset);
+    m_display_list.append(DisplayList::ApplyScrollOffset { scroll_offset });
+}
+
+void RecordingPainter::add_clip_rect(Gfx::IntRect const& rect)
+{
+    state().clip_rect.intersect(rect.translated(translation()));
+    m_display_list.append(DisplayList::AddClipRect { rect });
+}
+
+void RecordingPainter::clear_clip_rect()
+{
+    state().clip_rect = m_clip_origin;
+    m_display_list.append(DisplayList::ClearClipRect {});
+}
+
+void RecordingPainter::save()
+{
+    m_state_stack.append(m_state_stack.last());
+    m_display_list.append(DisplayList::Save {});
+}
+
+void RecordingPainter::restore()
+{
+    VERIFY(m_state_stack.size() > 1);
+    m_state_stack.take_last();
+    m_display_list.append(DisplayList::Restore {});
+}
+
+}
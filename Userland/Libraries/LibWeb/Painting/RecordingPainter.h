@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+#include <AK/Utf8View.h>
+#include <AK/Vector.h>
+#include <LibGfx/Forward.h>
+#include <LibGfx/Painter.h>
+#include <LibWeb/Painting/DisplayList.h>
+
+namespace Web::Painting {
+
+// A painter with (a subset of) the interface of Gfx::Painter, that appends commands to a DisplayList
+// instead of drawing. It keeps track of the translation and clip rect itself, so paintables can still
+// skip the parts of the page that are out of view.
+class RecordingPainter {
+    AK_MAKE_NONCOPYABLE(RecordingPainter);
+    AK_MAKE_NONMOVABLE(RecordingPainter);
+
+public:
+    using CornerRadius = DisplayList::CornerRadius;
+
+    RecordingPainter(DisplayList&, Gfx::IntRect const& clip_rect);
+
+    void fill_rect(Gfx::IntRect const&, Color);
+    void draw_rect(Gfx::IntRect const&, Color, bool rough = false);
+    void draw_line(Gfx::IntPoint const&, Gfx::IntPoint const&, Color, int thickness = 1, Gfx::Painter::LineStyle = Gfx::Painter::LineStyle::Solid);
+    void draw_focus_rect(Gfx::IntRect const&, Color);
+    void draw_triangle_wave(Gfx::IntPoint const&, Gfx::IntPoint const&, Color, int amplitude, int thickness = 1);
+
+    void draw_text(Gfx::IntRect const&, StringView, Gfx::TextAlignment = Gfx::TextAlignment::TopLeft, Color = Color::Black, Gfx::TextElision = Gfx::TextElision::None);
+    void draw_text(Gfx::IntRect const&, StringView, Gfx::Font const&, Gfx::TextAlignment = Gfx::TextAlignment::TopLeft, Color = Color::Black, Gfx::TextElision = Gfx::TextElision::None);
+    void draw_text_run(Gfx::FloatPoint const& baseline_start, Utf8View const&, Gfx::Font const&, Color);
+
+    void draw_scaled_bitmap(Gfx::IntRect const& dst_rect, Gfx::Bitmap const&, Gfx::IntRect const& src_rect, float opacity = 1.0f, Gfx::Painter::ScalingMode = Gfx::Painter::ScalingMode::NearestNeighbor);
+    void blit(Gfx::IntPoint const&, Gfx::Bitmap const&, Gfx::IntRect const& src_rect, float opacity = 1.0f);
+    // NOTE: The filter is applied while recording, so the source bitmap is free to change afterwards.
+    void blit_filtered(Gfx::IntPoint const&, Gfx::Bitmap const&, Gfx::IntRect const& src_rect, Function<Color(Color)>);
+
+    void fill_rect_with_rounded_corners(Gfx::IntRect const&, Color, CornerRadius top_left, CornerRadius top_right, CornerRadius bottom_right, CornerRadius bottom_left);
+    void draw_anti_aliased_line(Gfx::FloatPoint const&, Gfx::FloatPoint const&, Color, float thickness = 1, Gfx::Painter::LineStyle = Gfx::Painter::LineStyle::Solid);
+    void draw_ellipse(Gfx::IntRect const&, Color, int thickness);
+    void fill_ellipse(Gfx::IntRect const&, Color);
+    void fill_path(Gfx::Path const&, Color, Gfx::Painter::WindingRule, Gfx::FloatPoint const& translation = {});
+    void stroke_path(Gfx::Path const&, Color, float thickness, Gfx::FloatPoint const& translation = {});
+
+    void sample_under_corners(NonnullRefPtr<BorderRadiusCornerClipper>);
+    void blit_corner_clipping(NonnullRefPtr<BorderRadiusCornerClipper>);
+
+    void draw_layer(NonnullOwnPtr<DisplayList> contents, Gfx::FloatRect const& paint_rect, Gfx::AffineTransform const&, Gfx::FloatPoint const& transform_origin, float opacity);
+
+    // Escape hatch for painting that has to happen directly on the target, e.g. because it samples the pixels painted so far.
+    void paint_with_painter(String name, Function<void(Gfx::Painter&)>);
+
+    void set_depends_on_scroll_offset() { m_display_list.set_depends_on_scroll_offset(); }
+
+    Gfx::Font const& font() const;
+    void set_font(Gfx::Font const& font) { state().font = &font; }
+
+    void translate(int dx, int dy) { translate({ dx, dy }); }
+    void translate(Gfx::IntPoint const&);
+    Gfx::IntPoint translation() const { return state().translation; }
+    void reset_translation();
+    void apply_scroll_offset(Gfx::IntPoint const&);
+
+    void add_clip_rect(Gfx::IntRect const&);
+    void clear_clip_rect();
+    Gfx::IntRect clip_rect() const { return state().clip_rect; }
+
+    void save();
+    void restore();
+
+private:
+    struct State {
+        Gfx::Font const* font { nullptr };
+        Gfx::IntPoint translation;
+        Gfx::IntRect clip_rect;
+    };
+
+    State& state() { return m_state_stack.last(); }
+    State const& state() const { return m_state_stack.last(); }
+
+    DisplayList& m_display_list;
+    Gfx::IntRect m_clip_origin;
+    Vector<State, 4> m_state_stack;
+};
+
+class RecordingPainterStateSaver {
+public:
+    explicit RecordingPainterStateSaver(RecordingPainter& painter)
+        : m_painter(painter)
+    {
+        m_painter.save();
+    }
+
+    ~RecordingPainterStateSaver()
+    {
+        m_painter.restore();
+    }
+
+private:
+    RecordingPainter& m_painter;
+};
+
+}
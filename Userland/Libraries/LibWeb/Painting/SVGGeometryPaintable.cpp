@@ -4,7 +4,6 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
-#include <LibGfx/AntiAliasingPainter.h>
 #include <LibWeb/Layout/ImageBox.h>
 #include <LibWeb/Painting/SVGGeometryPaintable.h>
 #include <LibWeb/SVG/SVGSVGElement.h>
@@ -38,11 +37,9 @@ void SVGGeometryPaintable::paint(PaintContext& context, PaintPhase phase) const
 
     auto& geometry_element = layout_box().dom_node();
 
-    Gfx::AntiAliasingPainter painter { context.painter() };
     auto& svg_context = context.svg_context();
 
     auto offset = svg_context.svg_element_position();
-    painter.translate(offset);
 
     auto const* svg_element = geometry_element.first_ancestor_of_type<SVG::SVGSVGElement>();
     auto maybe_view_box = svg_element->view_box();
@@ -102,20 +99,21 @@ void SVGGeometryPaintable::paint(PaintContext& context, PaintPhase phase) const
         closed_path.close();
 
         // Fills are computed as though all paths are closed (https://svgwg.org/svg2-draft/painting.html#FillProperties)
-        painter.fill_path(
+        context.painter().fill_path(
             closed_path,
             fill_color,
-            Gfx::Painter::WindingRule::EvenOdd);
+            Gfx::Painter::WindingRule::EvenOdd,
+            offset);
     }
 
     if (auto stroke_color = geometry_element.stroke_color().value_or(svg_context.stroke_color()); stroke_color.alpha() > 0) {
-        painter.stroke_path(
+        context.painter().stroke_path(
             path,
             stroke_color,
-            geometry_element.stroke_width().value_or(svg_context.stroke_width()));
+            geometry_element.stroke_width().value_or(svg_context.stroke_width()),
+            offset);
     }
 
-    painter.translate(-offset);
     context.painter().clear_clip_rect();
 }
 
@@ -232,7 +232,7 @@ void paint_box_shadow(PaintContext& context, Gfx::IntRect const& content_rect, B
         auto bottom_right_corner_blit_pos = inner_bounding_rect.bottom_right().translated(-bottom_right_corner_size.width() + 1 + double_radius, -bottom_right_corner_size.height() + 1 + double_radius);
 
         auto paint_shadow = [&](Gfx::IntRect clip_rect) {
-            Gfx::PainterStateSaver save { painter };
+            RecordingPainterStateSaver save { painter };
             painter.add_clip_rect(clip_rect);
 
             paint_shadow_infill();
@@ -18,6 +18,7 @@
 #include <LibWeb/Layout/ReplacedBox.h>
 #include <LibWeb/Painting/PaintableBox.h>
 #include <LibWeb/Painting/StackingContext.h>
+#include <LibWeb/TraceEvents.h>
 
 namespace Web::Painting {
 
@@ -297,9 +298,11 @@ Gfx::AffineTransform StackingContext::affine_transform_matrix() const
 
 void StackingContext::paint(PaintContext& context) const
 {
-    Gfx::PainterStateSaver saver(context.painter());
+    ScopedTraceEvent trace_event("StackingContext::paint"sv, "paint"sv);
+
+    RecordingPainterStateSaver saver(context.painter());
     if (m_box.is_fixed_position()) {
-        context.painter().translate(-context.painter().translation());
+        context.painter().reset_translation();
     }
 
     auto opacity = m_box.computed_values().opacity();
@@ -309,47 +312,16 @@ void StackingContext::paint(PaintContext& context) const
     auto affine_transform = affine_transform_matrix();
 
     if (opacity < 1.0f || !affine_transform.is_identity_or_translation()) {
-        auto transform_origin = this->transform_origin();
-        auto source_rect = paintable().absolute_paint_rect().translated(-transform_origin);
-        auto transformed_destination_rect = affine_transform.map(source_rect).translated(transform_origin);
-        auto destination_rect = transformed_destination_rect.to_rounded<int>();
-
-        // FIXME: We should find a way to scale the paintable, rather than paint into a separate bitmap,
-        // then scale it. This snippet now copies the background at the destination, then scales it down/up
-        // to the size of the source (which could add some artefacts, though just scaling the bitmap already does that).
-        // We need to copy the background at the destination because a bunch of our rendering effects now rely on
-        // being able to sample the painter (see border radii, shadows, filters, etc).
-        Gfx::FloatPoint destination_clipped_fixup {};
-        auto try_get_scaled_destination_bitmap = [&]() -> ErrorOr<NonnullRefPtr<Gfx::Bitmap>> {
-            Gfx::IntRect actual_destination_rect;
-            auto bitmap = TRY(context.painter().get_region_bitmap(destination_rect, Gfx::BitmapFormat::BGRA8888, actual_destination_rect));
-            // get_region_bitmap() may clip to a smaller region if the requested rect goes outside the painter, so we need to account for that.
-            destination_clipped_fixup = Gfx::FloatPoint { destination_rect.location() - actual_destination_rect.location() };
-            destination_rect = actual_destination_rect;
-            if (source_rect.size() != transformed_destination_rect.size()) {
-                auto sx = static_cast<float>(source_rect.width()) / transformed_destination_rect.width();
-                auto sy = static_cast<float>(source_rect.height()) / transformed_destination_rect.height();
-                bitmap = TRY(bitmap->scaled(sx, sy));
-                destination_clipped_fixup.scale_by(sx, sy);
-            }
-            return bitmap;
-        };
-
-        auto bitmap_or_error = try_get_scaled_destination_bitmap();
-        if (bitmap_or_error.is_error())
-            return;
-        auto bitmap = bitmap_or_error.release_value_but_fixme_should_propagate_errors();
-        Gfx::Painter painter(bitmap);
-        painter.translate((-paintable().absolute_paint_rect().location() + destination_clipped_fixup).to_rounded<int>());
+        // The contents get recorded into their own display list, which is painted into a separate bitmap
+        // and composited with the given opacity and transform when the display list is replayed.
+        auto paint_rect = paintable().absolute_paint_rect();
+        auto contents = make<DisplayList>();
+        RecordingPainter painter(*contents, enclosing_int_rect(paint_rect));
         auto paint_context = context.clone(painter);
         paint_internal(paint_context);
-
-        if (destination_rect.size() == bitmap->size())
-            context.painter().blit(destination_rect.location(), *bitmap, bitmap->rect(), opacity);
-        else
-            context.painter().draw_scaled_bitmap(destination_rect, *bitmap, bitmap->rect(), opacity, Gfx::Painter::ScalingMode::BilinearBlend);
+        context.painter().draw_layer(move(contents), paint_rect, affine_transform, transform_origin(), opacity);
     } else {
-        Gfx::PainterStateSaver saver(context.painter());
+        RecordingPainterStateSaver saver(context.painter());
         context.painter().translate(affine_transform.translation().to_rounded<int>());
         paint_internal(context);
     }
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/Painter.h>
+#include <LibWeb/Painting/DisplayList.h>
+#include <LibWeb/Painting/TileCache.h>
+
+namespace Web::Painting {
+
+Gfx::IntRect TileCache::tile_rect(Gfx::IntPoint const& tile_index)
+{
+    return { tile_index.x() * tile_size, tile_index.y() * tile_size, tile_size, tile_size };
+}
+
+void TileCache::invalidate(Gfx::IntRect const& content_rect)
+{
+    // NOTE: Fixed position content moves across the tiles when scrolling, so we can't tell which tiles it's been painted into.
+    if (m_has_fixed_position_content) {
+        m_tiles.clear();
+        return;
+    }
+
+    m_tiles.remove_all_matching([&](auto& tile_index, auto&) {
+        return tile_rect(tile_index).intersects(content_rect);
+    });
+}
+
+ErrorOr<NonnullRefPtr<Gfx::Bitmap>> TileCache::rasterize_tile(DisplayList const& display_list, Gfx::IntPoint const& tile_index, Color background_color) const
+{
+    auto tile = TRY(Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, { tile_size, tile_size }, m_scale));
+    Gfx::Painter painter(*tile);
+    painter.fill_rect(tile->rect(), background_color);
+
+    // NOTE: Translating by the scroll offset here and replaying with the same offset puts the document at the tile's position,
+    //       while fixed position content still ends up where it is in the viewport.
+    painter.translate(m_scroll_offset - tile_rect(tile_index).location());
+    display_list.execute(painter, m_scroll_offset);
+    return tile;
+}
+
+void TileCache::paint(DisplayList const& display_list, Gfx::IntRect const& content_rect, Gfx::Bitmap& target, Color background_color)
+{
+    auto scroll_offset = content_rect.location();
+    if (target.scale() != m_scale
+        || (scroll_offset != m_scroll_offset && (display_list.depends_on_scroll_offset() || display_list.has_fixed_position_content()))) {
+        m_tiles.clear();
+    }
+    m_scroll_offset = scroll_offset;
+    m_scale = target.scale();
+    m_has_fixed_position_content = display_list.has_fixed_position_content();
+
+    Gfx::Painter painter(target);
+    painter.fill_rect({ {}, content_rect.size() }, background_color);
+
+    auto first_tile_x = max(0, content_rect.left()) / tile_size;
+    auto first_tile_y = max(0, content_rect.top()) / tile_size;
+    auto last_tile_x = max(0, content_rect.right()) / tile_size;
+    auto last_tile_y = max(0, content_rect.bottom()) / tile_size;
+
+    for (int tile_y = first_tile_y; tile_y <= last_tile_y; ++tile_y) {
+        for (int tile_x = first_tile_x; tile_x <= last_tile_x; ++tile_x) {
+            Gfx::IntPoint tile_index { tile_x, tile_y };
+            auto it = m_tiles.find(tile_index);
+            if (it == m_tiles.end()) {
+                auto tile_or_error = rasterize_tile(display_list, tile_index, background_color);
+                if (tile_or_error.is_error()) {
+                    dbgln("Failed to rasterize tile {}: {}", tile_index, tile_or_error.error());
+                    continue;
+                }
+                m_tiles.set(tile_index, tile_or_error.release_value());
+                it = m_tiles.find(tile_index);
+            }
+            auto& tile = *it->value;
+            painter.blit(tile_rect(tile_index).location() - content_rect.location(), tile, tile.rect());
+        }
+    }
+
+    // Drop the tiles that are too far away from the viewport to be scrolled into view anytime soon.
+    auto retained_rect = content_rect.inflated(content_rect.width() * 2, content_rect.height() * 2);
+    m_tiles.remove_all_matching([&](auto& tile_index, auto&) {
+        return !tile_rect(tile_index).intersects(retained_rect);
+    });
+}
+
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/Color.h>
+#include <LibGfx/Rect.h>
+#include <LibWeb/Forward.h>
+
+namespace Web::Painting {
+
+// Rasterizes a display list into a grid of tiles in document coordinates, keyed by their position in the grid.
+// Tiles are kept until something paints over them, so scrolling only has to rasterize the newly exposed ones.
+class TileCache {
+public:
+    static constexpr int tile_size = 256;
+
+    // Paints the content rect of the page into the target, which is the size of the content rect.
+    void paint(DisplayList const&, Gfx::IntRect const& content_rect, Gfx::Bitmap& target, Color background_color);
+
+    // Discards the tiles something was painted over, after which they're rasterized again from a new display list.
+    void invalidate(Gfx::IntRect const& content_rect);
+    void clear() { m_tiles.clear(); }
+
+    size_t tile_count() const { return m_tiles.size(); }
+
+private:
+    static Gfx::IntRect tile_rect(Gfx::IntPoint const& tile_index);
+
+    ErrorOr<NonnullRefPtr<Gfx::Bitmap>> rasterize_tile(DisplayList const&, Gfx::IntPoint const& tile_index, Color background_color) const;
+
+    HashMap<Gfx::IntPoint, NonnullRefPtr<Gfx::Bitmap>> m_tiles;
+    Gfx::IntPoint m_scroll_offset;
+    int m_scale { 1 };
+    bool m_has_fixed_position_content { false };
+};
+
+}
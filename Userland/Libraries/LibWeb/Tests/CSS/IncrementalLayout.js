@@ -0,0 +1,83 @@
+describe("Incremental layout", () => {
+    loadLocalPage("IncrementalLayout.html");
+
+    afterInitialPageLoad(page => {
+        // The position and size of each box, relative to the container, so that an edited container
+        // can be compared against a reference container that was laid out with the final text from the start.
+        const geometryOf = (id, selector) => {
+            const container = page.document.getElementById(id);
+            return Array.from(container.querySelectorAll(selector)).map(element => [
+                element.offsetLeft - container.offsetLeft,
+                element.offsetTop - container.offsetTop,
+                element.offsetWidth,
+                element.offsetHeight,
+            ]);
+        };
+        const textOf = (id, selector, index) =>
+            page.document.getElementById(id).querySelectorAll(selector)[index].firstChild;
+
+        test("Editing the text of a flex item resizes it and moves the items after it", () => {
+            const initialGeometry = geometryOf("flex", ".item");
+            const text = textOf("flex", ".item", 1);
+
+            text.data = "Two, but a good deal longer";
+            const editedGeometry = geometryOf("flex", ".item");
+            expect(editedGeometry).toEqual(geometryOf("flex-reference", ".item"));
+            expect(editedGeometry[0]).toEqual(initialGeometry[0]);
+            expect(editedGeometry[1][2]).toBeGreaterThan(initialGeometry[1][2]);
+            expect(editedGeometry[2][0]).toBeGreaterThan(initialGeometry[2][0]);
+
+            text.data = "Two";
+            expect(geometryOf("flex", ".item")).toEqual(initialGeometry);
+        });
+
+        test("Editing the text of an inline-block grows it and its line", () => {
+            const initialGeometry = geometryOf("inline-blocks", ".box");
+            const initialHeight = page.document.getElementById("inline-blocks").offsetHeight;
+            const text = textOf("inline-blocks", ".box", 0);
+
+            text.data = "Not so short any more, so this has to wrap";
+            const editedGeometry = geometryOf("inline-blocks", ".box");
+            expect(editedGeometry).toEqual(geometryOf("inline-blocks-reference", ".box"));
+            expect(editedGeometry[0][3]).toBeGreaterThan(initialGeometry[0][3]);
+            expect(page.document.getElementById("inline-blocks").offsetHeight).toBe(
+                page.document.getElementById("inline-blocks-reference").offsetHeight
+            );
+
+            text.data = "Short";
+            expect(geometryOf("inline-blocks", ".box")).toEqual(initialGeometry);
+            expect(page.document.getElementById("inline-blocks").offsetHeight).toBe(initialHeight);
+        });
+
+        test("Editing the text of a table cell resizes its column", () => {
+            const initialGeometry = geometryOf("table", "td");
+            const text = textOf("table", "td", 0);
+
+            text.data = "A, widened";
+            const editedGeometry = geometryOf("table", "td");
+            expect(editedGeometry).toEqual(geometryOf("table-reference", "td"));
+            // The cell below is in the same column, so it has to grow along with the edited one.
+            expect(editedGeometry[2][2]).toBeGreaterThan(initialGeometry[2][2]);
+
+            text.data = "A";
+            expect(geometryOf("table", "td")).toEqual(initialGeometry);
+        });
+
+        test("Several edits between layouts all take effect", () => {
+            const initialGeometry = geometryOf("flex", ".item");
+            const first = textOf("flex", ".item", 0);
+            const last = textOf("flex", ".item", 2);
+
+            first.data = "One, but longer";
+            last.data = "Three, but longer";
+            const editedGeometry = geometryOf("flex", ".item");
+            expect(editedGeometry[0][2]).toBeGreaterThan(initialGeometry[0][2]);
+            expect(editedGeometry[2][2]).toBeGreaterThan(initialGeometry[2][2]);
+
+            first.data = "One";
+            last.data = "Three";
+            expect(geometryOf("flex", ".item")).toEqual(initialGeometry);
+        });
+    });
+    waitForPageToLoad();
+});
@@ -0,0 +1,83 @@
+describe("Style invalidation", () => {
+    loadLocalPage("StyleInvalidation.html");
+
+    afterInitialPageLoad(page => {
+        const colorOf = id =>
+            page.getComputedStyle(page.document.getElementById(id)).getPropertyValue("color");
+        const black = "rgb(0, 0, 0)";
+
+        test("Class in the subject of a selector restyles the element", () => {
+            const target = page.document.getElementById("target");
+            target.classList.add("subject");
+            expect(colorOf("target")).toBe("rgb(255, 0, 0)");
+            target.classList.remove("subject");
+            expect(colorOf("target")).toBe(black);
+        });
+
+        test("Class left of a descendant combinator restyles descendants", () => {
+            const container = page.document.getElementById("container");
+            container.className = "ancestor";
+            expect(colorOf("target")).toBe("rgb(0, 128, 0)");
+            expect(colorOf("later")).toBe("rgb(0, 128, 0)");
+            expect(colorOf("unrelated")).toBe(black);
+            container.className = "";
+            expect(colorOf("target")).toBe(black);
+        });
+
+        test("Class left of a sibling combinator restyles following siblings", () => {
+            const target = page.document.getElementById("target");
+            target.classList.add("previous");
+            expect(colorOf("next")).toBe("rgb(0, 0, 255)");
+            expect(colorOf("later")).toBe(black);
+            target.classList.replace("previous", "earlier");
+            expect(colorOf("next")).toBe("rgb(128, 0, 128)");
+            expect(colorOf("later")).toBe("rgb(128, 0, 128)");
+            target.classList.remove("earlier");
+            expect(colorOf("next")).toBe(black);
+            expect(colorOf("later")).toBe(black);
+        });
+
+        test("Changing an id restyles what the old and new ids matched", () => {
+            const container = page.document.getElementById("container");
+            const other = page.document.getElementById("other");
+            other.id = "named";
+            expect(colorOf("unrelated")).toBe("rgb(0, 128, 128)");
+            expect(colorOf("target")).toBe(black);
+            other.id = "other";
+            expect(colorOf("unrelated")).toBe(black);
+            container.id = "named";
+            expect(colorOf("target")).toBe("rgb(0, 128, 128)");
+            container.id = "container";
+            expect(colorOf("target")).toBe(black);
+        });
+
+        test("Attribute selectors restyle descendants", () => {
+            const container = page.document.getElementById("container");
+            container.setAttribute("data-state", "on");
+            expect(colorOf("target")).toBe("rgb(128, 128, 0)");
+            container.setAttribute("data-state", "off");
+            expect(colorOf("target")).toBe(black);
+            container.setAttribute("data-state", "on");
+            container.removeAttribute("data-state");
+            expect(colorOf("target")).toBe(black);
+        });
+
+        test("Classes inside :not() are tracked too", () => {
+            const notContainer = page.document.getElementById("not-container");
+            expect(colorOf("inside-not")).toBe("rgb(255, 165, 0)");
+            notContainer.classList.add("excluded");
+            expect(colorOf("inside-not")).not.toBe("rgb(255, 165, 0)");
+            notContainer.classList.remove("excluded");
+            expect(colorOf("inside-not")).toBe("rgb(255, 165, 0)");
+        });
+
+        test("Inherited values reach the children of a restyled element", () => {
+            const inheritContainer = page.document.getElementById("inherit-container");
+            inheritContainer.classList.add("inherited");
+            expect(colorOf("inheriting")).toBe("rgb(0, 0, 128)");
+            inheritContainer.classList.remove("inherited");
+            expect(colorOf("inheriting")).not.toBe("rgb(0, 0, 128)");
+        });
+    });
+    waitForPageToLoad();
+});
@@ -0,0 +1,25 @@
+describe("Style sharing", () => {
+    loadLocalPage("StyleSharing.html");
+
+    afterInitialPageLoad(page => {
+        const colorsOfChildren = id =>
+            Array.from(page.document.getElementById(id).children).map(
+                child => page.getComputedStyle(child).getPropertyValue("color")
+            );
+
+        test("Toggling a class on one of two identical parents only restyles its own children", () => {
+            expect(colorsOfChildren("first")).toEqual(["rgb(0, 0, 0)", "rgb(0, 0, 0)"]);
+            expect(colorsOfChildren("second")).toEqual(["rgb(0, 0, 0)", "rgb(0, 0, 0)"]);
+
+            page.document.getElementById("second").classList.add("x");
+            expect(colorsOfChildren("first")).toEqual(["rgb(0, 0, 0)", "rgb(0, 0, 0)"]);
+            expect(colorsOfChildren("second")).toEqual(["rgb(255, 0, 0)", "rgb(255, 0, 0)"]);
+
+            page.document.getElementById("second").classList.remove("x");
+            page.document.getElementById("first").classList.add("x");
+            expect(colorsOfChildren("first")).toEqual(["rgb(255, 0, 0)", "rgb(255, 0, 0)"]);
+            expect(colorsOfChildren("second")).toEqual(["rgb(0, 0, 0)", "rgb(0, 0, 0)"]);
+        });
+    });
+    waitForPageToLoad();
+});
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashMap.h>
+#include <AK/JsonArraySerializer.h>
+#include <AK/JsonObjectSerializer.h>
+#include <AK/QuickSort.h>
+#include <AK/StringBuilder.h>
+#include <LibWeb/TraceEvents.h>
+
+namespace Web {
+
+TraceEventRecorder& TraceEventRecorder::the()
+{
+    static TraceEventRecorder recorder;
+    return recorder;
+}
+
+void TraceEventRecorder::set_enabled(bool enabled)
+{
+    if (m_enabled == enabled)
+        return;
+    m_enabled = enabled;
+    if (enabled)
+        m_origin = Time::now_monotonic();
+}
+
+void TraceEventRecorder::begin_event(StringView name)
+{
+    m_open_events.append({ name, Time::zero() });
+}
+
+void TraceEventRecorder::end_event(StringView name, StringView category, Time start, String detail)
+{
+    // Events that were open while recording was turned off and on again don't have a matching begin_event().
+    if (m_open_events.is_empty())
+        return;
+
+    auto duration = Time::now_monotonic() - start;
+    auto open_event = m_open_events.take_last();
+
+    bool is_nested_in_same_event = false;
+    for (auto& enclosing_event : m_open_events) {
+        if (enclosing_event.name == name) {
+            is_nested_in_same_event = true;
+            break;
+        }
+    }
+    if (!m_open_events.is_empty())
+        m_open_events.last().child_duration += duration;
+
+    m_events.append({
+        .name = name,
+        .category = category,
+        .start = start - m_origin,
+        .duration = duration,
+        .self_duration = duration - open_event.child_duration,
+        .is_nested_in_same_event = is_nested_in_same_event,
+        .detail = move(detail),
+    });
+}
+
+String TraceEventRecorder::to_chrome_trace_json() const
+{
+    StringBuilder builder;
+    auto trace = MUST(JsonObjectSerializer<>::try_create(builder));
+    MUST(trace.add("displayTimeUnit"sv, "ms"sv));
+    auto trace_events = MUST(trace.add_array("traceEvents"sv));
+    for (auto& event : m_events) {
+        auto object = MUST(trace_events.add_object());
+        MUST(object.add("name"sv, event.name));
+        MUST(object.add("cat"sv, event.category));
+        // "Complete" events, which have both a start time and a duration.
+        MUST(object.add("ph"sv, "X"sv));
+        MUST(object.add("ts"sv, event.start.to_microseconds()));
+        MUST(object.add("dur"sv, event.duration.to_microseconds()));
+        MUST(object.add("pid"sv, 1));
+        MUST(object.add("tid"sv, 1));
+        if (!event.detail.is_null()) {
+            auto args = MUST(object.add_object("args"sv));
+            MUST(args.add("detail"sv, event.detail));
+            MUST(args.finish());
+        }
+        MUST(object.finish());
+    }
+    MUST(trace_events.finish());
+    MUST(trace.finish());
+    return builder.to_string();
+}
+
+String TraceEventRecorder::summary() const
+{
+    struct Totals {
+        StringView name;
+        StringView category;
+        size_t count { 0 };
+        Time total_duration;
+        Time self_duration;
+    };
+
+    HashMap<StringView, size_t> index_for_name;
+    Vector<Totals> totals;
+    for (auto& event : m_events) {
+        auto index = index_for_name.ensure(event.name, [&] {
+            totals.append({ event.name, event.category, 0, Time::zero(), Time::zero() });
+            return totals.size() - 1;
+        });
+        auto& entry = totals[index];
+        ++entry.count;
+        // Recursive events are already included in the duration of their outermost event.
+        if (!event.is_nested_in_same_event)
+            entry.total_duration += event.duration;
+        entry.self_duration += event.self_duration;
+    }
+
+    quick_sort(totals, [](auto& a, auto& b) { return a.self_duration > b.self_duration; });
+
+    StringBuilder builder;
+    builder.appendff("{:<40} {:<8} {:>10} {:>12} {:>12}\n", "Event", "Category", "Count", "Total (ms)", "Self (ms)");
+    for (auto& entry : totals) {
+        builder.appendff("{:<40} {:<8} {:>10} {:>12.3} {:>12.3}\n",
+            entry.name, entry.category, entry.count,
+            entry.total_duration.to_microseconds() / 1000.0,
+            entry.self_duration.to_microseconds() / 1000.0);
+    }
+    return builder.to_string();
+}
+
+}
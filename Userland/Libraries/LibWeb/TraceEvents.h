@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Noncopyable.h>
+#include <AK/String.h>
+#include <AK/StringView.h>
+#include <AK/Time.h>
+#include <AK/Vector.h>
+
+namespace Web {
+
+// Records how long the engine spends in parsing, style, layout, paint and script, for benchmarking page loads.
+// Recording is off unless someone (e.g. headless-browser) turns it on, in which case the events can be written out
+// in the Chrome trace event format (https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU),
+// which chrome://tracing and Perfetto can open.
+class TraceEventRecorder {
+public:
+    static TraceEventRecorder& the();
+
+    bool is_enabled() const { return m_enabled; }
+    void set_enabled(bool);
+
+    // Event names and categories have to be string literals, as they are kept until the events are written out.
+    void begin_event(StringView name);
+    void end_event(StringView name, StringView category, Time start, String detail);
+
+    size_t event_count() const { return m_events.size(); }
+
+    String to_chrome_trace_json() const;
+
+    // A table of the number of events, and the total and self time spent in them, for each event name.
+    String summary() const;
+
+private:
+    TraceEventRecorder() = default;
+
+    struct Event {
+        StringView name;
+        StringView category;
+        Time start;
+        Time duration;
+        Time self_duration;
+        // Whether an event with the same name encloses this one, e.g. for recursive calls.
+        bool is_nested_in_same_event { false };
+        String detail;
+    };
+
+    struct OpenEvent {
+        StringView name;
+        Time child_duration;
+    };
+
+    bool m_enabled { false };
+    Time m_origin;
+    Vector<Event> m_events;
+
+    // The events that haven't ended yet, with the time spent in their nested events so far (to tell their self time apart).
+    Vector<OpenEvent, 16> m_open_events;
+};
+
+// Records an event for the lifetime of this object, e.g. `ScopedTraceEvent trace_event("Document::update_layout"sv, "layout"sv);`
+class ScopedTraceEvent {
+    AK_MAKE_NONCOPYABLE(ScopedTraceEvent);
+    AK_MAKE_NONMOVABLE(ScopedTraceEvent);
+
+public:
+    ScopedTraceEvent(StringView name, StringView category, String detail = {})
+    {
+        auto& recorder = TraceEventRecorder::the();
+        if (!recorder.is_enabled())
+            return;
+        m_name = name;
+        m_category = category;
+        m_detail = move(detail);
+        m_start = Time::now_monotonic();
+        m_active = true;
+        recorder.begin_event(name);
+    }
+
+    ~ScopedTraceEvent()
+    {
+        if (m_active)
+            TraceEventRecorder::the().end_event(m_name, m_category, m_start, move(m_detail));
+    }
+
+private:
+    bool m_active { false };
+    StringView m_name;
+    StringView m_category;
+    String m_detail;
+    Time m_start;
+};
+
+}
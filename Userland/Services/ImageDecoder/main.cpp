@@ -7,17 +7,20 @@
 #include <ImageDecoder/ConnectionFromClient.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/System.h>
+#include <LibGfx/ImageDecoder.h>
 #include <LibIPC/SingleServer.h>
 #include <LibMain/Main.h>
+#include <unistd.h>
 
 ErrorOr<int> serenity_main(Main::Arguments)
 {
     Core::EventLoop event_loop;
-    TRY(Core::System::pledge("stdio recvfd sendfd unix"));
+    TRY(Core::System::pledge("stdio recvfd sendfd unix thread"));
     TRY(Core::System::unveil(nullptr, nullptr));
 
     auto client = TRY(IPC::take_over_accepted_client_from_system_server<ImageDecoder::ConnectionFromClient>());
 
-    TRY(Core::System::pledge("stdio recvfd sendfd"));
+    TRY(Core::System::pledge("stdio recvfd sendfd thread"));
+    Gfx::ImageDecoder::set_maximum_thread_count(max(sysconf(_SC_NPROCESSORS_ONLN), 1L));
     return event_loop.exec();
 }
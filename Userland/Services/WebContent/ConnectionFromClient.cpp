@@ -26,6 +26,7 @@
 #include <LibWeb/HTML/Window.h>
 #include <LibWeb/Layout/InitialContainingBlock.h>
 #include <LibWeb/Loader/ContentFilter.h>
+#include <LibWeb/Loader/HTTPCache.h>
 #include <LibWeb/Loader/ProxyMappings.h>
 #include <LibWeb/Loader/ResourceLoader.h>
 #include <LibWeb/Painting/PaintableBox.h>
@@ -214,6 +215,15 @@ void ConnectionFromClient::debug_request(String const& request, String const& ar
         }
     }
 
+    if (request == "dump-style-sharing-statistics") {
+        if (auto* doc = page().top_level_browsing_context().active_document())
+            Web::dump_style_sharing_statistics(doc->style_computer());
+    }
+
+    if (request == "dump-http-cache-statistics") {
+        Web::HTTPCache::the().dump_statistics();
+    }
+
     if (request == "collect-garbage") {
         Web::Bindings::main_thread_vm().heap().collect_garbage(JS::Heap::CollectionType::CollectGarbage, true);
     }
@@ -15,6 +15,7 @@ ConsoleGlobalObject::ConsoleGlobalObject(JS::Realm& realm, Web::HTML::Window& pa
     : GlobalObject(realm)
     , m_window_object(&parent_object)
 {
+    set_has_exotic_property_access();
 }
 
 void ConsoleGlobalObject::initialize(JS::Realm& realm)
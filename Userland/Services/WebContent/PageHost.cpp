@@ -14,6 +14,7 @@
 #include <LibWeb/HTML/BrowsingContext.h>
 #include <LibWeb/Layout/InitialContainingBlock.h>
 #include <LibWeb/Painting/PaintableBox.h>
+#include <LibWeb/Painting/RecordingPainter.h>
 #include <LibWeb/Platform/Timer.h>
 #include <WebContent/WebContentClientEndpoint.h>
 
@@ -33,6 +34,13 @@ PageHost::PageHost(ConnectionFromClient& client)
 void PageHost::set_has_focus(bool has_focus)
 {
     m_has_focus = has_focus;
+    discard_display_list_and_tiles();
+}
+
+void PageHost::set_should_show_line_box_borders(bool should_show_line_box_borders)
+{
+    m_should_show_line_box_borders = should_show_line_box_borders;
+    discard_display_list_and_tiles();
 }
 
 void PageHost::setup_palette()
@@ -55,6 +63,7 @@ Gfx::Palette PageHost::palette() const
 void PageHost::set_palette_impl(Gfx::PaletteImpl const& impl)
 {
     m_palette_impl = impl;
+    discard_display_list_and_tiles();
     if (auto* document = page().top_level_browsing_context().active_document())
         document->invalidate_style();
 }
@@ -62,6 +71,7 @@ void PageHost::set_palette_impl(Gfx::PaletteImpl const& impl)
 void PageHost::set_preferred_color_scheme(Web::CSS::PreferredColorScheme color_scheme)
 {
     m_preferred_color_scheme = color_scheme;
+    discard_display_list_and_tiles();
     if (auto* document = page().top_level_browsing_context().active_document())
         document->invalidate_style();
 }
@@ -84,34 +94,62 @@ Web::Layout::InitialContainingBlock* PageHost::layout_root()
     return document->layout_node();
 }
 
-void PageHost::paint(Gfx::IntRect const& content_rect, Gfx::Bitmap& target)
+void PageHost::record_display_list(Web::Layout::InitialContainingBlock& layout_root)
+{
+    // NOTE: The whole page is recorded as if the viewport covered all of it, so that nothing gets culled
+    //       and the display list can be replayed at any scroll offset.
+    auto& paint_box = *layout_root.paint_box();
+    auto page_rect = enclosing_int_rect(paint_box.absolute_rect());
+    if (paint_box.has_overflow())
+        page_rect = page_rect.united(enclosing_int_rect(paint_box.scrollable_overflow_rect().value()));
+    page_rect.set_location({});
+
+    auto display_list = make<Web::Painting::DisplayList>();
+    Web::Painting::RecordingPainter recording_painter(*display_list, page_rect);
+    Web::PaintContext context(recording_painter, palette(), {});
+    context.set_should_show_line_box_borders(m_should_show_line_box_borders);
+    context.set_viewport_rect(page_rect);
+    context.set_has_focus(m_has_focus);
+    layout_root.paint_all_phases(context);
+    m_display_list = move(display_list);
+}
+
+void PageHost::discard_display_list_and_tiles()
 {
-    Gfx::Painter painter(target);
-    Gfx::IntRect bitmap_rect { {}, content_rect.size() };
+    m_display_list = nullptr;
+    m_tile_cache.clear();
+}
 
+void PageHost::paint(Gfx::IntRect const& content_rect, Gfx::Bitmap& target)
+{
     if (auto* document = page().top_level_browsing_context().active_document())
         document->update_layout();
 
     auto* layout_root = this->layout_root();
     if (!layout_root) {
-        painter.fill_rect(bitmap_rect, palette().base());
+        discard_display_list_and_tiles();
+        Gfx::Painter painter(target);
+        painter.fill_rect({ {}, content_rect.size() }, palette().base());
         return;
     }
 
-    Web::PaintContext context(painter, palette(), content_rect.top_left());
-    context.set_should_show_line_box_borders(m_should_show_line_box_borders);
-    context.set_viewport_rect(content_rect);
-    context.set_has_focus(m_has_focus);
-    layout_root->paint_all_phases(context);
+    if (!m_display_list)
+        record_display_list(*layout_root);
+
+    m_tile_cache.paint(*m_display_list, content_rect, target, palette().base());
 }
 
 void PageHost::set_viewport_rect(Gfx::IntRect const& rect)
 {
+    if (m_display_list && m_display_list->depends_on_scroll_offset() && rect.location() != page().top_level_browsing_context().viewport_rect().location())
+        m_display_list = nullptr;
     page().top_level_browsing_context().set_viewport_rect(rect);
 }
 
 void PageHost::page_did_invalidate(Gfx::IntRect const& content_rect)
 {
+    m_tile_cache.invalidate(content_rect);
+    m_display_list = nullptr;
     m_invalidation_rect = m_invalidation_rect.united(content_rect);
     if (!m_invalidation_coalescing_timer->is_active())
         m_invalidation_coalescing_timer->start();
@@ -129,6 +167,7 @@ void PageHost::page_did_request_cursor_change(Gfx::StandardCursor cursor)
 
 void PageHost::page_did_layout()
 {
+    discard_display_list_and_tiles();
     auto* layout_root = this->layout_root();
     VERIFY(layout_root);
     Gfx::IntSize content_size;
@@ -9,6 +9,8 @@
 
 #include <LibGfx/Rect.h>
 #include <LibWeb/Page/Page.h>
+#include <LibWeb/Painting/DisplayList.h>
+#include <LibWeb/Painting/TileCache.h>
 
 namespace WebContent {
 
@@ -31,7 +33,7 @@ public:
     void set_viewport_rect(Gfx::IntRect const&);
     void set_screen_rects(Vector<Gfx::IntRect, 4> const& rects, size_t main_screen_index) { m_screen_rect = rects[main_screen_index]; };
     void set_preferred_color_scheme(Web::CSS::PreferredColorScheme);
-    void set_should_show_line_box_borders(bool b) { m_should_show_line_box_borders = b; }
+    void set_should_show_line_box_borders(bool);
     void set_has_focus(bool);
     void set_is_scripting_enabled(bool);
     void set_is_webdriver_active(bool);
@@ -74,6 +76,8 @@ private:
 
     Web::Layout::InitialContainingBlock* layout_root();
     void setup_palette();
+    void record_display_list(Web::Layout::InitialContainingBlock&);
+    void discard_display_list_and_tiles();
 
     ConnectionFromClient& m_client;
     NonnullOwnPtr<Web::Page> m_page;
@@ -82,6 +86,11 @@ private:
     bool m_should_show_line_box_borders { false };
     bool m_has_focus { false };
 
+    // The painting commands for the whole page, recorded after layout and replayed for every paint request until something changes.
+    OwnPtr<Web::Painting::DisplayList> m_display_list;
+
+    Web::Painting::TileCache m_tile_cache;
+
     RefPtr<Web::Platform::Timer> m_invalidation_coalescing_timer;
     Gfx::IntRect m_invalidation_rect;
     Web::CSS::PreferredColorScheme m_preferred_color_scheme { Web::CSS::PreferredColorScheme::Auto };
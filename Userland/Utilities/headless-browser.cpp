@@ -14,6 +14,7 @@
 #include <AK/Types.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/ConfigFile.h>
+#include <LibCore/ElapsedTimer.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/File.h>
 #include <LibCore/IODevice.h>
@@ -40,10 +41,13 @@
 #include <LibWeb/Layout/InitialContainingBlock.h>
 #include <LibWeb/Loader/ResourceLoader.h>
 #include <LibWeb/Page/Page.h>
+#include <LibWeb/Painting/DisplayList.h>
 #include <LibWeb/Painting/PaintableBox.h>
+#include <LibWeb/Painting/RecordingPainter.h>
 #include <LibWeb/Platform/EventLoopPluginSerenity.h>
 #include <LibWeb/Platform/FontPluginSerenity.h>
 #include <LibWeb/Platform/ImageCodecPlugin.h>
+#include <LibWeb/TraceEvents.h>
 #include <LibWeb/WebSockets/WebSocket.h>
 #include <LibWebSocket/ConnectionInfo.h>
 #include <LibWebSocket/Message.h>
@@ -72,25 +76,34 @@ public:
         page().load(url);
     }
 
-    void paint(Gfx::IntRect const& content_rect, Gfx::Bitmap& target)
+    void update_layout()
     {
-        Gfx::Painter painter(target);
-
         if (auto* document = page().top_level_browsing_context().active_document())
             document->update_layout();
+    }
 
-        painter.fill_rect({ {}, content_rect.size() }, palette().base());
-
+    OwnPtr<Web::Painting::DisplayList> record_display_list(Gfx::IntRect const& content_rect)
+    {
         auto* layout_root = this->layout_root();
-        if (!layout_root) {
-            return;
-        }
+        if (!layout_root)
+            return {};
 
-        Web::PaintContext context(painter, palette(), content_rect.top_left());
+        auto display_list = make<Web::Painting::DisplayList>();
+        Web::Painting::RecordingPainter recording_painter(*display_list, { {}, content_rect.size() });
+        Web::PaintContext context(recording_painter, palette(), content_rect.top_left());
         context.set_should_show_line_box_borders(false);
         context.set_viewport_rect(content_rect);
         context.set_has_focus(true);
         layout_root->paint_all_phases(context);
+        return display_list;
+    }
+
+    void paint(Web::Painting::DisplayList const* display_list, Gfx::IntRect const& content_rect, Gfx::Bitmap& target)
+    {
+        Gfx::Painter painter(target);
+        painter.fill_rect({ {}, content_rect.size() }, palette().base());
+        if (display_list)
+            display_list->execute(painter);
     }
 
     void setup_palette(Core::AnonymousBuffer theme_buffer)
@@ -662,6 +675,10 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     StringView resources_folder;
     StringView error_page_url;
     StringView ca_certs_path;
+    bool dump_display_list = false;
+    int benchmark_paint_iterations = 0;
+    StringView trace_output_path;
+    bool print_trace_summary = false;
 
     Core::EventLoop event_loop;
     Core::ArgsParser args_parser;
@@ -670,6 +687,10 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_option(resources_folder, "Path of the base resources folder (defaults to /res)", "resources", 'r', "resources-root-path");
     args_parser.add_option(error_page_url, "URL for the error page (defaults to file:///res/html/error.html)", "error-page", 'e', "error-page-url");
     args_parser.add_option(ca_certs_path, "The bundled ca certificates file", "certs", 'c', "ca-certs-path");
+    args_parser.add_option(dump_display_list, "Dump the display list the screenshot is painted from", "dump-display-list", 'd');
+    args_parser.add_option(benchmark_paint_iterations, "Time layout, display list recording and [n] display list replays separately", "benchmark-paint", 'b', "n");
+    args_parser.add_option(trace_output_path, "Write a trace of parsing, style, layout, paint and script (in the Chrome trace event format) to the given file", "trace", 't', "path");
+    args_parser.add_option(print_trace_summary, "Print how much time was spent in parsing, style, layout, paint and script", "trace-summary", 'T');
     args_parser.add_positional_argument(url, "URL to open", "url", Core::ArgsParser::Required::Yes);
     args_parser.parse(arguments);
 
@@ -707,6 +728,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     else
         page_client->setup_palette(Gfx::load_system_theme("/res/themes/Default.ini"));
 
+    if (!trace_output_path.is_empty() || print_trace_summary)
+        Web::TraceEventRecorder::the().set_enabled(true);
+
     dbgln("Loading {}", url);
     page_client->load(AK::URL(url));
 
@@ -717,7 +741,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     dbgln("Taking screenshot after {} seconds !", take_screenshot_after);
     auto timer = Core::Timer::create_single_shot(
         take_screenshot_after * 1000,
-        [page_client = move(page_client)]() mutable {
+        [page_client = move(page_client), dump_display_list, benchmark_paint_iterations, trace_output_path = String(trace_output_path), print_trace_summary]() mutable {
             // FIXME: Allow passing the output path as argument
             String output_file_path = "output.png";
             dbgln("Saving to {}", output_file_path);
@@ -730,7 +754,42 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
             auto output_rect = page_client->screen_rect();
             auto output_bitmap = MUST(Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, output_rect.size()));
 
-            page_client->paint(output_rect, output_bitmap);
+            auto layout_timer = Core::ElapsedTimer::start_new();
+            page_client->update_layout();
+            auto layout_time = layout_timer.elapsed_time();
+
+            auto record_timer = Core::ElapsedTimer::start_new();
+            auto display_list = page_client->record_display_list(output_rect);
+            auto record_time = record_timer.elapsed_time();
+
+            auto replay_timer = Core::ElapsedTimer::start_new();
+            page_client->paint(display_list.ptr(), output_rect, output_bitmap);
+            for (int i = 1; i < benchmark_paint_iterations; ++i)
+                page_client->paint(display_list.ptr(), output_rect, output_bitmap);
+            auto replay_time = replay_timer.elapsed_time();
+
+            if (dump_display_list && display_list)
+                out("{}", display_list->dump());
+
+            if (benchmark_paint_iterations > 0) {
+                outln("Layout: {} us", layout_time.to_microseconds());
+                outln("Record: {} us ({} commands)", record_time.to_microseconds(), display_list ? display_list->command_count() : 0);
+                outln("Replay: {} us per paint ({} paints)", replay_time.to_microseconds() / benchmark_paint_iterations, benchmark_paint_iterations);
+            }
+
+            auto& trace_event_recorder = Web::TraceEventRecorder::the();
+            if (!trace_output_path.is_empty()) {
+                dbgln("Writing {} trace events to {}", trace_event_recorder.event_count(), trace_output_path);
+                auto trace_file = Core::File::open(trace_output_path, Core::OpenMode::WriteOnly | Core::OpenMode::Truncate);
+                if (trace_file.is_error()) {
+                    warnln("Failed to open {} for writing: {}", trace_output_path, trace_file.error());
+                } else {
+                    auto trace = trace_event_recorder.to_chrome_trace_json();
+                    trace_file.value()->write(trace.bytes().data(), trace.length());
+                }
+            }
+            if (print_trace_summary)
+                out("{}", trace_event_recorder.summary());
 
             auto image_buffer = Gfx::PNGWriter::encode(output_bitmap);
             output_file->write(image_buffer.data(), image_buffer.size());
@@ -7,16 +7,19 @@
 
 #include <AK/Assertions.h>
 #include <AK/ByteBuffer.h>
+#include <AK/Debug.h>
 #include <AK/Format.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/StringBuilder.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/ConfigFile.h>
+#include <LibCore/ElapsedTimer.h>
 #include <LibCore/File.h>
 #include <LibCore/StandardPaths.h>
 #include <LibCore/System.h>
 #include <LibJS/AST.h>
 #include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/ExecutableCache.h>
 #include <LibJS/Bytecode/Generator.h>
 #include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Bytecode/PassManager.h>
@@ -130,6 +133,10 @@ private:
 static bool s_dump_ast = false;
 static bool s_run_bytecode = false;
 static bool s_opt_bytecode = false;
+static bool s_opt_bytecode_aggressively = false;
+static bool s_dump_bytecode_statistics = false;
+static bool s_report_timings = false;
+static OwnPtr<JS::Bytecode::ExecutableCache> s_bytecode_cache;
 static bool s_as_module = false;
 static bool s_print_last_result = false;
 static bool s_strip_ansi = false;
@@ -1142,6 +1149,26 @@ static bool write_to_file(String const& path)
     return true;
 }
 
+static JS::ThrowCompletionOr<JS::Value> run_executable(JS::Interpreter& interpreter, JS::Bytecode::Executable& executable)
+{
+    JS::Bytecode::Interpreter bytecode_interpreter(interpreter.realm());
+    auto result_or_error = bytecode_interpreter.run_and_return_frame(executable, nullptr);
+
+    if (s_dump_bytecode_statistics) {
+        auto& statistics = JS::Bytecode::Interpreter::optimization_pipeline().statistics();
+        dbgln("Optimized {} executables: {} -> {} instructions, {} -> {} bytes, {} -> {} registers",
+            statistics.executables,
+            statistics.instructions_before, statistics.instructions_after,
+            statistics.bytes_before, statistics.bytes_after,
+            statistics.registers_before, statistics.registers_after);
+        dbgln("Dispatched {} instructions", bytecode_interpreter.dispatch_count());
+    }
+
+    if (result_or_error.value.is_error())
+        return result_or_error.value.release_error();
+    return result_or_error.frame->registers[0];
+}
+
 static bool parse_and_run(JS::Interpreter& interpreter, StringView source, StringView source_name)
 {
     enum class ReturnEarly {
@@ -1151,12 +1178,17 @@ static bool parse_and_run(JS::Interpreter& interpreter, StringView source, Strin
 
     JS::ThrowCompletionOr<JS::Value> result { JS::js_undefined() };
 
+    auto cache_optimized = s_opt_bytecode ? JS::Bytecode::ExecutableCache::Optimized::Yes : JS::Bytecode::ExecutableCache::Optimized::No;
+
     auto run_script_or_module = [&](auto& script_or_module) {
         if (s_dump_ast)
             script_or_module->parse_node().dump(0);
 
         if (JS::Bytecode::g_dump_bytecode || s_run_bytecode) {
+            auto codegen_timer = Core::ElapsedTimer::start_new();
             auto executable_result = JS::Bytecode::Generator::generate(script_or_module->parse_node());
+            if (s_report_timings)
+                dbgln("Codegen took {}us", codegen_timer.elapsed_time().to_microseconds());
             if (executable_result.is_error()) {
                 result = g_vm->throw_completion<JS::InternalError>(executable_result.error().to_string());
                 return ReturnEarly::No;
@@ -1173,16 +1205,16 @@ static bool parse_and_run(JS::Interpreter& interpreter, StringView source, Strin
             if (JS::Bytecode::g_dump_bytecode)
                 executable->dump();
 
-            if (s_run_bytecode) {
-                JS::Bytecode::Interpreter bytecode_interpreter(interpreter.realm());
-                auto result_or_error = bytecode_interpreter.run_and_return_frame(*executable, nullptr);
-                if (result_or_error.value.is_error())
-                    result = result_or_error.value.release_error();
-                else
-                    result = result_or_error.frame->registers[0];
-            } else {
-                return ReturnEarly::Yes;
+            // NOTE: This has to happen before the executable first runs, so none of its inline cache state ends up on disk.
+            if (s_bytecode_cache && !s_as_module) {
+                if (auto store_result = s_bytecode_cache->store(source, cache_optimized, *executable); store_result.is_error())
+                    dbgln_if(JS_BYTECODE_DEBUG, "Not caching {}: {}", source_name, store_result.error());
             }
+
+            if (s_run_bytecode)
+                result = run_executable(interpreter, *executable);
+            else
+                return ReturnEarly::Yes;
         } else {
             result = interpreter.run(*script_or_module);
         }
@@ -1190,8 +1222,26 @@ static bool parse_and_run(JS::Interpreter& interpreter, StringView source, Strin
         return ReturnEarly::No;
     };
 
-    if (!s_as_module) {
+    // Scripts whose bytecode is cached skip lexing, parsing and codegen entirely.
+    // NOTE: Modules are never cached, since linking them requires the AST.
+    OwnPtr<JS::Bytecode::Executable> cached_executable;
+    if (s_bytecode_cache && s_run_bytecode && !s_as_module && !s_dump_ast) {
+        auto load_timer = Core::ElapsedTimer::start_new();
+        cached_executable = s_bytecode_cache->load(source, cache_optimized);
+        if (s_report_timings)
+            dbgln("Bytecode cache {} took {}us", cached_executable ? "hit" : "miss", load_timer.elapsed_time().to_microseconds());
+    }
+
+    if (cached_executable) {
+        cached_executable->name = source_name;
+        if (JS::Bytecode::g_dump_bytecode)
+            cached_executable->dump();
+        result = run_executable(interpreter, *cached_executable);
+    } else if (!s_as_module) {
+        auto parse_timer = Core::ElapsedTimer::start_new();
         auto script_or_error = JS::Script::parse(source, interpreter.realm(), source_name);
+        if (s_report_timings)
+            dbgln("Parsing took {}us", parse_timer.elapsed_time().to_microseconds());
         if (script_or_error.is_error()) {
             auto error = script_or_error.error()[0];
             auto hint = error.source_location_hint(source);
@@ -1205,7 +1255,10 @@ static bool parse_and_run(JS::Interpreter& interpreter, StringView source, Strin
                 return true;
         }
     } else {
+        auto parse_timer = Core::ElapsedTimer::start_new();
         auto module_or_error = JS::SourceTextModule::parse(source, interpreter.realm(), source_name);
+        if (s_report_timings)
+            dbgln("Parsing took {}us", parse_timer.elapsed_time().to_microseconds());
         if (module_or_error.is_error()) {
             auto error = module_or_error.error()[0];
             auto hint = error.source_location_hint(source);
@@ -1507,10 +1560,12 @@ private:
 
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
-    TRY(Core::System::pledge("stdio rpath wpath cpath tty sigaction"));
+    TRY(Core::System::pledge("stdio rpath wpath cpath tty sigaction prot_exec"));
 
     bool gc_on_every_allocation = false;
     bool disable_syntax_highlight = false;
+    bool jit = false;
+    StringView bytecode_cache_directory;
     StringView evaluate_script;
     Vector<StringView> script_paths;
 
@@ -1520,6 +1575,11 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_option(JS::Bytecode::g_dump_bytecode, "Dump the bytecode", "dump-bytecode", 'd');
     args_parser.add_option(s_run_bytecode, "Run the bytecode", "run-bytecode", 'b');
     args_parser.add_option(s_opt_bytecode, "Optimize the bytecode", "optimize-bytecode", 'p');
+    args_parser.add_option(s_opt_bytecode_aggressively, "Optimize the bytecode, including the dataflow passes", "optimize-bytecode-aggressively", 'P');
+    args_parser.add_option(jit, "Compile frequently run bytecode to machine code", "jit", 'J');
+    args_parser.add_option(s_dump_bytecode_statistics, "Print bytecode size and dispatch statistics", "bytecode-statistics", 0);
+    args_parser.add_option(bytecode_cache_directory, "Cache the bytecode of scripts in the given directory", "bytecode-cache", 0, "directory");
+    args_parser.add_option(s_report_timings, "Report parse, codegen and bytecode cache load times", "report-timings", 'T');
     args_parser.add_option(s_as_module, "Treat as module", "as-module", 'm');
     args_parser.add_option(s_print_last_result, "Print last result", "print-last-result", 'l');
     args_parser.add_option(s_strip_ansi, "Disable ANSI colors", "disable-ansi-colors", 'i');
@@ -1530,6 +1590,20 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_positional_argument(script_paths, "Path to script files", "scripts", Core::ArgsParser::Required::No);
     args_parser.parse(arguments);
 
+    if (s_opt_bytecode_aggressively) {
+        s_opt_bytecode = true;
+        JS::Bytecode::Interpreter::set_optimization_level(JS::Bytecode::Interpreter::OptimizationLevel::Aggressive);
+    }
+
+    // The JIT maps the machine code it generates as executable.
+    if (jit)
+        JS::Bytecode::Interpreter::set_jit_threshold(JS::Bytecode::Interpreter::default_jit_threshold);
+    else
+        TRY(Core::System::pledge("stdio rpath wpath cpath tty sigaction"));
+
+    if (!bytecode_cache_directory.is_empty())
+        s_bytecode_cache = make<JS::Bytecode::ExecutableCache>(bytecode_cache_directory);
+
     bool syntax_highlight = !disable_syntax_highlight;
 
     g_vm = JS::VM::create();